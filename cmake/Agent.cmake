@@ -103,6 +103,7 @@ target_link_libraries(fboss_types
 
 add_library(core
   fboss/agent/AclNexthopHandler.cpp
+  fboss/agent/AclPriorityAllocator.cpp
   fboss/agent/ApplyThriftConfig.cpp
   fboss/agent/ArpCache.cpp
   fboss/agent/ArpHandler.cpp
@@ -144,12 +145,14 @@ add_library(core
   fboss/agent/RouteUpdateLogger.cpp
   fboss/agent/RouteUpdateLoggingPrefixTracker.cpp
   fboss/agent/RouteUpdateWrapper.cpp
+  fboss/agent/RxPacketDispatcher.cpp
   fboss/agent/StaticL2ForNeighborObserver.cpp
   fboss/agent/StaticL2ForNeighborUpdater.cpp
   fboss/agent/StaticL2ForNeighborSwSwitchUpdater.cpp
   fboss/agent/SwSwitch.cpp
   fboss/agent/SwSwitchRouteUpdateWrapper.cpp
   fboss/agent/TeFlowNexthopHandler.cpp
+  fboss/agent/TunHostWriter.cpp
   fboss/agent/TunIntf.cpp
   fboss/agent/TunManager.cpp
   fboss/agent/ndp/IPv6RouteAdvertiser.cpp
@@ -194,6 +197,7 @@ target_link_libraries(core
   fsdb_stream_client
   fsdb_pub_sub
   fsdb_flags
+  cow_storage
   ${IPROUTE2}
   ${NETLINK3}
   ${NETLINKROUTE3}
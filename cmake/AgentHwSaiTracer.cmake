@@ -24,6 +24,8 @@ add_library(sai_tracer
   fboss/agent/hw/sai/tracer/QueueApiTracer.cpp
   fboss/agent/hw/sai/tracer/RouteApiTracer.cpp
   fboss/agent/hw/sai/tracer/RouterInterfaceApiTracer.cpp
+  fboss/agent/hw/sai/tracer/SaiTraceConverter.cpp
+  fboss/agent/hw/sai/tracer/SaiTraceRecord.cpp
   fboss/agent/hw/sai/tracer/SaiTracer.cpp
   fboss/agent/hw/sai/tracer/SamplePacketApiTracer.cpp
   fboss/agent/hw/sai/tracer/SchedulerApiTracer.cpp
@@ -61,3 +63,19 @@ target_link_options(sai_tracer
   "LINKER:-wrap,sai_api_uninitialize"
   "LINKER:-wrap,sai_get_object_key"
 )
+
+add_executable(sai_trace_converter
+  fboss/agent/hw/sai/tracer/converter/Main.cpp
+)
+
+target_link_libraries(sai_trace_converter
+  sai_tracer
+  fake_sai
+  Folly::folly
+)
+
+set_target_properties(sai_trace_converter PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
@@ -0,0 +1,25 @@
+# CMake to build libraries and binaries in fboss/agent/hw/sai/tracer/tests
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(sai_tracer_test
+    fboss/agent/test/oss/Main.cpp
+    fboss/agent/hw/sai/tracer/tests/SaiTraceConverterTest.cpp
+)
+
+target_link_libraries(sai_tracer_test
+    sai_tracer
+    fake_sai
+    Folly::folly
+    ${GTEST}
+    ${LIBGMOCK_LIBRARIES}
+)
+
+set_target_properties(sai_tracer_test PROPERTIES COMPILE_FLAGS
+  "-DSAI_VER_MAJOR=${SAI_VER_MAJOR} \
+  -DSAI_VER_MINOR=${SAI_VER_MINOR}  \
+  -DSAI_VER_RELEASE=${SAI_VER_RELEASE}"
+)
+
+gtest_discover_tests(sai_tracer_test)
@@ -0,0 +1,41 @@
+# CMake to build libraries and binaries in fboss/agent/platforms/common/compiler
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(platform_mapping_compiler
+  fboss/agent/platforms/common/compiler/PlatformMappingCompiler.cpp
+)
+
+target_link_libraries(platform_mapping_compiler
+  platform_mapping
+  Folly::folly
+)
+
+# Adds the compact encoding of the JSON platform mapping in
+# fboss/agent/platforms/common/<PLATFORM_DIR>/<MAPPING_CLASS>.cpp to
+# TARGET_LIB, as <MAPPING_CLASS>::compactPlatformMapping(). The mapping source
+# is built with FBOSS_COMPACT_PLATFORM_MAPPING, so that the JSON is left out
+# of the binary.
+function(ADD_COMPACT_PLATFORM_MAPPING TARGET_LIB PLATFORM_DIR MAPPING_CLASS)
+  set(MAPPING_PATH fboss/agent/platforms/common/${PLATFORM_DIR})
+  set(GENERATED_DIR ${CMAKE_CURRENT_BINARY_DIR}/${MAPPING_PATH})
+  set(GENERATED_SRC ${GENERATED_DIR}/${MAPPING_CLASS}Compact.cpp)
+  add_custom_command(
+    OUTPUT ${GENERATED_SRC}
+    COMMAND ${CMAKE_COMMAND} -E make_directory ${GENERATED_DIR}
+    COMMAND platform_mapping_compiler
+      --source ${CMAKE_CURRENT_SOURCE_DIR}/${MAPPING_PATH}/${MAPPING_CLASS}.cpp
+      --header ${MAPPING_PATH}/${MAPPING_CLASS}.h
+      --class_name ${MAPPING_CLASS}
+      --output ${GENERATED_SRC}
+    DEPENDS
+      platform_mapping_compiler
+      ${CMAKE_CURRENT_SOURCE_DIR}/${MAPPING_PATH}/${MAPPING_CLASS}.cpp
+  )
+  target_sources(${TARGET_LIB} PRIVATE ${GENERATED_SRC})
+  set_source_files_properties(
+    ${CMAKE_CURRENT_SOURCE_DIR}/${MAPPING_PATH}/${MAPPING_CLASS}.cpp
+    PROPERTIES COMPILE_DEFINITIONS FBOSS_COMPACT_PLATFORM_MAPPING
+  )
+endfunction()
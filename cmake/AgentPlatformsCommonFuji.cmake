@@ -11,3 +11,6 @@ add_library(fuji_platform_mapping
 target_link_libraries(fuji_platform_mapping
   platform_mapping
 )
+
+ADD_COMPACT_PLATFORM_MAPPING(
+  fuji_platform_mapping fuji Fuji16QPimPlatformMapping)
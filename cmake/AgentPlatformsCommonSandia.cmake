@@ -12,3 +12,8 @@ add_library(sandia_platform_mapping
 target_link_libraries(sandia_platform_mapping
   platform_mapping
 )
+
+ADD_COMPACT_PLATFORM_MAPPING(
+  sandia_platform_mapping sandia Sandia8DDPimPlatformMapping)
+ADD_COMPACT_PLATFORM_MAPPING(
+  sandia_platform_mapping sandia Sandia16QPimPlatformMapping)
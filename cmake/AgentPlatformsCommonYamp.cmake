@@ -11,3 +11,6 @@ add_library(yamp_platform_mapping
 target_link_libraries(yamp_platform_mapping
   platform_mapping
 )
+
+ADD_COMPACT_PLATFORM_MAPPING(
+  yamp_platform_mapping yamp Yamp16QPimPlatformMapping)
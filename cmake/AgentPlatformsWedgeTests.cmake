@@ -0,0 +1,16 @@
+# CMake to build libraries and binaries in fboss/agent/platforms/wedge/tests
+
+# In general, libraries and binaries in fboss/foo/bar are built by
+# cmake/FooBar.cmake
+
+add_executable(platform_mapping_benchmark
+  fboss/agent/platforms/wedge/tests/PlatformMappingBenchmark.cpp
+)
+
+target_link_libraries(platform_mapping_benchmark
+  fuji_platform_mapping
+  sandia_platform_mapping
+  yamp_platform_mapping
+  Folly::folly
+  Folly::follybenchmark
+)
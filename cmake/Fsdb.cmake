@@ -11,3 +11,15 @@ target_link_libraries(fsdb_flags
   fsdb_common_cpp2
   FBThrift::thriftcpp2
 )
+
+add_library(fsdb_stats_columns
+  fboss/fsdb/common/StatsColumns.cpp
+)
+
+target_link_libraries(fsdb_stats_columns
+  fsdb_common_cpp2
+  fsdb_oper_cpp2
+  thrift_cow_serializer
+  Folly::folly
+  FBThrift::thriftcpp2
+)
@@ -28,6 +28,7 @@ target_link_libraries(fsdb_pub_sub
   fsdb_common_cpp2
   fsdb_flags
   fsdb_oper_cpp2
+  fsdb_stats_columns
   fsdb_stream_client
   Folly::folly
   FBThrift::thriftcpp2
@@ -43,6 +44,7 @@ target_link_libraries(fsdb_syncer
   fsdb_common_cpp2
   fsdb_flags
   fsdb_oper_cpp2
+  fsdb_stats_columns
   fsdb_stream_client
   fsdb_pub_sub
   Folly::folly
@@ -3,9 +3,12 @@ add_executable(fsdb_client_test
   fboss/fsdb/client/test/FsdbPubSubManagerTest.cpp
   fboss/fsdb/client/test/FsdbStreamClientTest.cpp
   fboss/fsdb/client/test/FsdbPublisherTest.cpp
+  fboss/fsdb/client/test/StatsColumnsTest.cpp
 )
 
 target_link_libraries(fsdb_client_test
+  agent_stats_cpp2
+  cow_storage
   fsdb_pub_sub
   error
   ${GTEST}
@@ -14,3 +17,14 @@ target_link_libraries(fsdb_client_test
 
 gtest_discover_tests(fsdb_client_test)
 
+add_executable(fsdb_stats_columns_benchmark
+  fboss/fsdb/client/test/StatsColumnsBenchmark.cpp
+)
+
+target_link_libraries(fsdb_stats_columns_benchmark
+  agent_stats_cpp2
+  cow_storage
+  fsdb_stats_columns
+  Folly::folly
+  Folly::follybenchmark
+)
@@ -12,3 +12,43 @@ target_link_libraries(fsdb_oper_metadata_tracker
   fsdb_common_cpp2
   fsdb_oper_cpp2
 )
+
+add_library(local_fsdb_server
+  fboss/fsdb/server/LocalFsdbServer.h
+)
+
+set_target_properties(local_fsdb_server PROPERTIES LINKER_LANGUAGE CXX)
+
+target_link_libraries(local_fsdb_server
+  cow_storage_mgr
+  fsdb_common_cpp2
+  fsdb_oper_cpp2
+  fsdb_stats_columns
+  Folly::folly
+)
+
+add_executable(local_fsdb_server_test
+  fboss/agent/test/oss/Main.cpp
+  fboss/fsdb/server/test/LocalFsdbServerTest.cpp
+)
+
+target_link_libraries(local_fsdb_server_test
+  local_fsdb_server
+  thriftpath_test_cpp2
+  ${GTEST}
+  ${LIBGMOCK_LIBRARIES}
+)
+
+gtest_discover_tests(local_fsdb_server_test)
+
+add_executable(local_fsdb_server_benchmark
+  fboss/fsdb/server/test/LocalFsdbServerBenchmark.cpp
+)
+
+target_link_libraries(local_fsdb_server_benchmark
+  agent_stats_cpp2
+  local_fsdb_server
+  thriftpath_test_cpp2
+  Folly::folly
+  Folly::follybenchmark
+)
@@ -14,6 +14,7 @@ add_fbthrift_cpp_library(
 )
 
 add_executable(thrift_node_tests
+  fboss/thrift_cow/nodes/tests/PersistentMapTests.cpp
   fboss/thrift_cow/nodes/tests/ThriftStructNodeTests.cpp
 )
 
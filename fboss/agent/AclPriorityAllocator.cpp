@@ -0,0 +1,129 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AclPriorityAllocator.h"
+
+#include "fboss/agent/FbossError.h"
+
+#include <algorithm>
+
+namespace facebook::fboss {
+
+AclPriorityAllocator::AclPriorityAllocator(
+    int minPriority,
+    int maxPriority,
+    int gap)
+    : minPriority_(minPriority),
+      maxPriority_(maxPriority),
+      gap_(std::max(gap, 1)) {}
+
+std::vector<bool> AclPriorityAllocator::getKeptPriorities(
+    const std::vector<std::optional<int>>& existingPriorities) const {
+  auto numAcls = existingPriorities.size();
+  std::vector<bool> kept(numAcls, false);
+  // Longest strictly increasing subsequence. tails[len] is the index of the
+  // ACL with the smallest priority ending an increasing run of len + 1 ACLs
+  std::vector<size_t> tails;
+  std::vector<std::optional<size_t>> prevInRun(numAcls);
+  for (size_t i = 0; i < numAcls; ++i) {
+    const auto& priority = existingPriorities[i];
+    if (!priority || *priority < minPriority_ || *priority > maxPriority_) {
+      continue;
+    }
+    auto tail = std::lower_bound(
+        tails.begin(), tails.end(), *priority, [&](size_t idx, int value) {
+          return *existingPriorities[idx] < value;
+        });
+    if (tail != tails.begin()) {
+      prevInRun[i] = *(tail - 1);
+    }
+    if (tail == tails.end()) {
+      tails.push_back(i);
+    } else {
+      *tail = i;
+    }
+  }
+  if (!tails.empty()) {
+    for (std::optional<size_t> i = tails.back(); i; i = prevInRun[*i]) {
+      kept[*i] = true;
+    }
+  }
+  return kept;
+}
+
+std::vector<int> AclPriorityAllocator::allocate(
+    const std::vector<std::optional<int>>& existingPriorities) const {
+  auto numAcls = static_cast<int64_t>(existingPriorities.size());
+  auto kept = getKeptPriorities(existingPriorities);
+  std::vector<int64_t> priorities(numAcls);
+  for (int64_t i = 0; i < numAcls; ++i) {
+    if (kept[i]) {
+      priorities[i] = *existingPriorities[i];
+    }
+  }
+
+  int64_t i = 0;
+  while (i < numAcls) {
+    if (kept[i]) {
+      ++i;
+      continue;
+    }
+    // (before, after) is the window of ACLs to allocate priorities to, all
+    // ACLs before it already have theirs, after is the next kept one
+    auto before = i - 1;
+    auto after = i;
+    while (after < numAcls && !kept[after]) {
+      ++after;
+    }
+    auto low = [&]() {
+      return before >= 0 ? priorities[before] : minPriority_ - 1;
+    };
+    auto high = [&]() {
+      return after < numAcls ? priorities[after] : maxPriority_ + 1;
+    };
+    // Widen the window alternately on each side until it has room
+    bool widenAfter = true;
+    while (high() - low() < after - before) {
+      if (before < 0 && after >= numAcls) {
+        throw FbossError(
+            "Not enough ACL priorities in [",
+            minPriority_,
+            ", ",
+            maxPriority_,
+            "] for ",
+            numAcls,
+            " ACLs");
+      }
+      if ((widenAfter && after < numAcls) || before < 0) {
+        kept[after] = false;
+        ++after;
+        while (after < numAcls && !kept[after]) {
+          ++after;
+        }
+      } else {
+        --before;
+      }
+      widenAfter = !widenAfter;
+    }
+
+    auto count = after - before - 1;
+    auto step = (high() - low()) / (count + 1);
+    if (after >= numAcls && low() + count * gap_ <= maxPriority_) {
+      // Appending, space ACLs by gap instead of over the rest of the range
+      step = gap_;
+    }
+    for (int64_t j = 1; j <= count; ++j) {
+      priorities[before + j] = low() + step * j;
+    }
+    i = after;
+  }
+  return std::vector<int>(priorities.begin(), priorities.end());
+}
+
+} // namespace facebook::fboss
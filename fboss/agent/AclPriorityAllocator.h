@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace facebook::fboss {
+
+/*
+ * AclPriorityAllocator assigns priorities to an ordered list of ACLs, keeping
+ * the priorities ACLs already have wherever the order allows it. Hardware
+ * reprograms an ACL whose priority changes, so adding, removing or moving one
+ * ACL should only change the priorities of a few ACLs around it, not of every
+ * ACL after it.
+ *
+ * New priorities are spaced gap apart, so later inserts find free priorities
+ * between their neighbours. Only when there are none are the neighbours
+ * respaced, widening the range of respaced ACLs until the inserted ones fit.
+ */
+class AclPriorityAllocator {
+ public:
+  // Priorities are allocated in [minPriority, maxPriority]
+  AclPriorityAllocator(int minPriority, int maxPriority, int gap);
+
+  /*
+   * Returns increasing priorities for ACLs in order of precedence, given the
+   * priority each ACL currently has, if any. Throws FbossError if the ACLs
+   * don't fit in the priority range.
+   */
+  std::vector<int> allocate(
+      const std::vector<std::optional<int>>& existingPriorities) const;
+
+ private:
+  // ACLs in the longest run of increasing existing priorities, these keep
+  // their priority
+  std::vector<bool> getKeptPriorities(
+      const std::vector<std::optional<int>>& existingPriorities) const;
+
+  const int64_t minPriority_;
+  const int64_t maxPriority_;
+  const int64_t gap_;
+};
+
+} // namespace facebook::fboss
@@ -18,12 +18,14 @@
 #include <string>
 
 #include "fboss/agent/AclNexthopHandler.h"
+#include "fboss/agent/AclPriorityAllocator.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/LacpTypes.h"
 #include "fboss/agent/LoadBalancerConfigApplier.h"
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/RouteUpdateWrapper.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/if/gen-cpp2/mpls_types.h"
 #include "fboss/agent/normalization/Normalizer.h"
@@ -101,14 +103,15 @@ std::shared_ptr<facebook::fboss::SwitchState> updateFibFromConfig(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const facebook::fboss::RibToFibDelta* ribToFibDelta,
     void* cookie) {
   facebook::fboss::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute, ribToFibDelta);
 
   auto nextStatePtr =
       static_cast<std::shared_ptr<facebook::fboss::SwitchState>*>(cookie);
 
-  fibUpdater(*nextStatePtr);
+  *nextStatePtr = fibUpdater(*nextStatePtr);
   return *nextStatePtr;
 }
 
@@ -130,23 +133,35 @@ class ThriftConfigApplier {
       const cfg::SwitchConfig* config,
       const Platform* platform,
       RoutingInformationBase* rib,
-      AclNexthopHandler* aclNexthopHandler)
+      AclNexthopHandler* aclNexthopHandler,
+      const cfg::SwitchConfig* prevConfig,
+      const std::shared_ptr<SwitchState>& prevConfigState,
+      SwitchStats* switchStats)
       : orig_(orig),
         cfg_(config),
         platform_(platform),
         rib_(rib),
-        aclNexthopHandler_(aclNexthopHandler) {}
+        aclNexthopHandler_(aclNexthopHandler),
+        prevCfg_(prevConfig),
+        prevState_(prevConfigState),
+        switchStats_(switchStats) {}
   ThriftConfigApplier(
       const std::shared_ptr<SwitchState>& orig,
       const cfg::SwitchConfig* config,
       const Platform* platform,
       RouteUpdateWrapper* routeUpdater,
-      AclNexthopHandler* aclNexthopHandler)
+      AclNexthopHandler* aclNexthopHandler,
+      const cfg::SwitchConfig* prevConfig,
+      const std::shared_ptr<SwitchState>& prevConfigState,
+      SwitchStats* switchStats)
       : orig_(orig),
         cfg_(config),
         platform_(platform),
         routeUpdater_(routeUpdater),
-        aclNexthopHandler_(aclNexthopHandler) {}
+        aclNexthopHandler_(aclNexthopHandler),
+        prevCfg_(prevConfig),
+        prevState_(prevConfigState),
+        switchStats_(switchStats) {}
 
   std::shared_ptr<SwitchState> run();
 
@@ -189,6 +204,53 @@ class ThriftConfigApplier {
     return newNode != nullptr;
   }
 
+  /*
+   * Sections of the config that build their own part of the state. A section
+   * is unchanged when none of the config fields its apply function reads
+   * changed since prevCfg_, and its part of orig_ is still the one built in
+   * prevState_. Its part of orig_ is then already up to date.
+   */
+  struct ChangedSections {
+    bool qcm{true};
+    bool controlPlane{true};
+    bool bufferPools{true};
+    bool aggregatePorts{true};
+    bool mirrors{true};
+    bool acls{true};
+    bool qosPolicies{true};
+    bool defaultQosPolicy{true};
+    bool sflowCollectors{true};
+    bool loadBalancers{true};
+    bool tunnels{true};
+    bool udf{true};
+    bool flowletSwitching{true};
+  };
+  ChangedSections getChangedSections() const;
+
+  /*
+   * Apply a section of the config unless it didn't change, and record the
+   * time it took. applyFn returns whether the section changed new_.
+   */
+  template <typename ApplyFn>
+  bool applySection(
+      const std::string& section,
+      bool sectionChanged,
+      ApplyFn applyFn) {
+    if (!sectionChanged) {
+      XLOG(DBG2) << "Skipping unchanged config section " << section;
+      return false;
+    }
+    auto start = std::chrono::steady_clock::now();
+    bool stateChanged = applyFn();
+    if (switchStats_) {
+      switchStats_->configSectionApply(
+          section,
+          std::chrono::duration_cast<std::chrono::microseconds>(
+              std::chrono::steady_clock::now() - start));
+    }
+    return stateChanged;
+  }
+
   // Interface route prefix. IPAddress has mask applied
   typedef std::pair<InterfaceID, folly::IPAddress> IntfAddress;
   typedef boost::container::flat_map<folly::CIDRNetwork, IntfAddress> IntfRoute;
@@ -306,6 +368,15 @@ class ThriftConfigApplier {
       cfg::AclStage aclStage,
       std::vector<cfg::AclEntry> configEntries,
       std::optional<std::string> tableName = std::nullopt);
+  /*
+   * Priorities in [minPriority, maxPriority] for ACLs in order of precedence,
+   * keeping the priorities of origAcls where possible.
+   */
+  std::vector<int> allocateAclPriorities(
+      const AclMap* origAcls,
+      const std::vector<std::string>& aclNames,
+      int minPriority,
+      int maxPriority) const;
   std::shared_ptr<AclEntry> createAcl(
       const cfg::AclEntry* config,
       int priority,
@@ -415,6 +486,10 @@ class ThriftConfigApplier {
   RoutingInformationBase* rib_{nullptr};
   RouteUpdateWrapper* routeUpdater_{nullptr};
   AclNexthopHandler* aclNexthopHandler_{nullptr};
+  const cfg::SwitchConfig* prevCfg_{nullptr};
+  // State last built from prevCfg_
+  std::shared_ptr<SwitchState> prevState_;
+  SwitchStats* switchStats_{nullptr};
 
   struct InterfaceIpInfo {
     InterfaceIpInfo(uint8_t mask, MacAddress mac, InterfaceID intf)
@@ -436,37 +511,110 @@ class ThriftConfigApplier {
   flat_map<PortID, std::vector<int32_t>> port2InterfaceId_;
 };
 
+ThriftConfigApplier::ChangedSections ThriftConfigApplier::getChangedSections()
+    const {
+  ChangedSections changedSections;
+  if (!prevCfg_ || !prevState_) {
+    return changedSections;
+  }
+  const auto& prev = *prevCfg_;
+  const auto& cur = *cfg_;
+  // Each section lists every config field its apply function reads, and the
+  // parts of orig_ it rebuilds. Parts of orig_ modified outside of config
+  // since prevState_ are rebuilt from config.
+  changedSections.qcm = prev.qcmConfig() != cur.qcmConfig() ||
+      orig_->getQcmCfg() != prevState_->getQcmCfg();
+  changedSections.controlPlane = prev.cpuQueues() != cur.cpuQueues() ||
+      prev.cpuTrafficPolicy() != cur.cpuTrafficPolicy() ||
+      prev.dataPlaneTrafficPolicy() != cur.dataPlaneTrafficPolicy() ||
+      prev.qosPolicies() != cur.qosPolicies() ||
+      orig_->getControlPlane() != prevState_->getControlPlane();
+  changedSections.bufferPools =
+      prev.bufferPoolConfigs() != cur.bufferPoolConfigs() ||
+      orig_->getBufferPoolCfgs() != prevState_->getBufferPoolCfgs();
+  changedSections.aggregatePorts =
+      prev.aggregatePorts() != cur.aggregatePorts() ||
+      prev.lacp() != cur.lacp() ||
+      orig_->getAggregatePorts() != prevState_->getAggregatePorts();
+  // Mirrors also read the ports of new_, checked once ports are applied
+  changedSections.mirrors = prev.mirrors() != cur.mirrors() ||
+      orig_->getMirrors() != prevState_->getMirrors();
+  // Acls only look up mirrors of new_ by name, and those follow
+  // cfg_->mirrors()
+  changedSections.acls = prev.acls() != cur.acls() ||
+      prev.aclTableGroup() != cur.aclTableGroup() ||
+      prev.cpuTrafficPolicy() != cur.cpuTrafficPolicy() ||
+      prev.dataPlaneTrafficPolicy() != cur.dataPlaneTrafficPolicy() ||
+      prev.trafficCounters() != cur.trafficCounters() ||
+      prev.mirrors() != cur.mirrors() ||
+      orig_->getAcls() != prevState_->getAcls() ||
+      orig_->getAclTableGroups() != prevState_->getAclTableGroups();
+  // The default data plane qos policy is left out of the qos policies
+  changedSections.qosPolicies = prev.qosPolicies() != cur.qosPolicies() ||
+      prev.dataPlaneTrafficPolicy() != cur.dataPlaneTrafficPolicy() ||
+      orig_->getQosPolicies() != prevState_->getQosPolicies();
+  changedSections.defaultQosPolicy = prev.qosPolicies() != cur.qosPolicies() ||
+      prev.dataPlaneTrafficPolicy() != cur.dataPlaneTrafficPolicy() ||
+      orig_->getDefaultDataPlaneQosPolicy() !=
+          prevState_->getDefaultDataPlaneQosPolicy();
+  changedSections.sflowCollectors =
+      prev.sFlowCollectors() != cur.sFlowCollectors() ||
+      orig_->getSflowCollectors() != prevState_->getSflowCollectors();
+  changedSections.loadBalancers = prev.loadBalancers() != cur.loadBalancers() ||
+      orig_->getLoadBalancers() != prevState_->getLoadBalancers();
+  changedSections.tunnels = prev.ipInIpTunnels() != cur.ipInIpTunnels() ||
+      orig_->getTunnels() != prevState_->getTunnels();
+  // Udf groups used by load balancers are validated against the udf config
+  changedSections.udf = prev.udfConfig() != cur.udfConfig() ||
+      prev.loadBalancers() != cur.loadBalancers() ||
+      orig_->getUdfConfig() != prevState_->getUdfConfig();
+  changedSections.flowletSwitching =
+      prev.flowletSwitchingConfig() != cur.flowletSwitchingConfig() ||
+      orig_->getFlowletSwitchingConfig() !=
+          prevState_->getFlowletSwitchingConfig();
+  return changedSections;
+}
+
 shared_ptr<SwitchState> ThriftConfigApplier::run() {
   new_ = orig_->clone();
   bool changed = false;
+  // Sections whose config didn't change since prevCfg_, and whose state
+  // didn't change since prevState_, keep their part of orig_ as is. Sections
+  // depending on more than the config (ports on transceivers, interfaces and
+  // vlans feeding route setup) always apply.
+  auto changedSections = getChangedSections();
 
-  {
+  changed |= applySection("qcm", changedSections.qcm, [this]() {
     bool qcmChanged = false;
     auto newQcmConfig = updateQcmCfg(&qcmChanged);
     if (qcmChanged) {
       new_->resetQcmCfg(newQcmConfig);
-      changed = true;
     }
-  }
+    return qcmChanged;
+  });
 
-  {
-    auto newControlPlane = updateControlPlane();
-    if (newControlPlane) {
-      new_->resetControlPlane(std::move(newControlPlane));
-      changed = true;
-    }
-  }
+  changed |=
+      applySection("control_plane", changedSections.controlPlane, [this]() {
+        auto newControlPlane = updateControlPlane();
+        if (newControlPlane) {
+          new_->resetControlPlane(std::move(newControlPlane));
+          return true;
+        }
+        return false;
+      });
 
   processVlanPorts();
 
-  {
-    bool bufferPoolConfigChanged = false;
-    auto newBufferPoolCfg = updateBufferPoolConfigs(&bufferPoolConfigChanged);
-    if (bufferPoolConfigChanged) {
-      new_->resetBufferPoolCfgs(newBufferPoolCfg);
-      changed = true;
-    }
-  }
+  changed |=
+      applySection("buffer_pools", changedSections.bufferPools, [this]() {
+        bool bufferPoolConfigChanged = false;
+        auto newBufferPoolCfg =
+            updateBufferPoolConfigs(&bufferPoolConfigChanged);
+        if (bufferPoolConfigChanged) {
+          new_->resetBufferPoolCfgs(newBufferPoolCfg);
+        }
+        return bufferPoolConfigChanged;
+      });
 
   {
     auto newSwitchSettings = updateSwitchSettings();
@@ -487,7 +635,7 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
 
   processInterfaceForPort();
 
-  {
+  changed |= applySection("ports", true, [this]() {
     auto newPorts = updatePorts(new_->getTransceivers());
     if (newPorts) {
       new_->resetPorts(std::move(newPorts));
@@ -499,78 +647,92 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
             new_->getSwitchSettings()->getSwitchId(),
             new_->getSwitchSettings()->getSystemPortRange()));
       }
-      changed = true;
-    }
-  }
-
-  {
-    auto newAggPorts = updateAggregatePorts();
-    if (newAggPorts) {
-      new_->resetAggregatePorts(std::move(newAggPorts));
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
+
+  changed |=
+      applySection("aggregate_ports", changedSections.aggregatePorts, [this]() {
+        auto newAggPorts = updateAggregatePorts();
+        if (newAggPorts) {
+          new_->resetAggregatePorts(std::move(newAggPorts));
+          return true;
+        }
+        return false;
+      });
 
   // updateMirrors must be called after updatePorts, mirror needs ports!
-  {
-    auto newMirrors = updateMirrors();
-    if (newMirrors) {
-      new_->resetMirrors(std::move(newMirrors));
-      changed = true;
-    }
-  }
+  changed |= applySection(
+      "mirrors",
+      changedSections.mirrors || new_->getPorts() != prevState_->getPorts(),
+      [this]() {
+        auto newMirrors = updateMirrors();
+        if (newMirrors) {
+          new_->resetMirrors(std::move(newMirrors));
+          return true;
+        }
+        return false;
+      });
 
   // updateAcls must be called after updateMirrors, acls may need mirror!
-  {
+  changed |= applySection("acls", changedSections.acls, [this]() {
     if (FLAGS_enable_acl_table_group) {
       auto newAclTableGroups = updateAclTableGroups();
       if (newAclTableGroups) {
         new_->resetAclTableGroups(std::move(newAclTableGroups));
-        changed = true;
+        return true;
       }
     } else {
       auto newAcls = updateAcls(cfg::AclStage::INGRESS, *cfg_->acls());
       if (newAcls) {
         new_->resetAcls(std::move(newAcls));
-        changed = true;
+        return true;
       }
     }
-  }
-
-  {
-    auto newQosPolicies = updateQosPolicies();
-    if (newQosPolicies) {
-      new_->resetQosPolicies(std::move(newQosPolicies));
-      changed = true;
-    }
-  }
+    return false;
+  });
+
+  changed |=
+      applySection("qos_policies", changedSections.qosPolicies, [this]() {
+        auto newQosPolicies = updateQosPolicies();
+        if (newQosPolicies) {
+          new_->resetQosPolicies(std::move(newQosPolicies));
+          return true;
+        }
+        return false;
+      });
 
   // reset the default qos policy
-  {
-    auto newDefaultQosPolicy = updateDataplaneDefaultQosPolicy();
-    if (new_->getDefaultDataPlaneQosPolicy() != newDefaultQosPolicy) {
-      new_->setDefaultDataPlaneQosPolicy(newDefaultQosPolicy);
-      changed = true;
-    }
-  }
+  changed |= applySection(
+      "default_qos_policy", changedSections.defaultQosPolicy, [this]() {
+        auto newDefaultQosPolicy = updateDataplaneDefaultQosPolicy();
+        if (new_->getDefaultDataPlaneQosPolicy() != newDefaultQosPolicy) {
+          new_->setDefaultDataPlaneQosPolicy(newDefaultQosPolicy);
+          return true;
+        }
+        return false;
+      });
 
-  {
+  changed |= applySection("interfaces", true, [this]() {
     auto newIntfs = updateInterfaces();
     if (newIntfs) {
       new_->resetIntfs(std::move(newIntfs));
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
 
   // Note: updateInterfaces() must be called before updateVlans(),
   // as updateInterfaces() populates the vlanInterfaces_ data structure.
-  {
+  changed |= applySection("vlans", true, [this]() {
     auto newVlans = updateVlans();
     if (newVlans) {
       new_->resetVlans(std::move(newVlans));
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
 
   if (routeUpdater_) {
     routeUpdater_->setRoutesToConfig(
@@ -725,31 +887,37 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
   }
 
   // Add sFlow collectors
-  {
-    auto newCollectors = updateSflowCollectors();
-    if (newCollectors) {
-      new_->resetSflowCollectors(std::move(newCollectors));
-      changed = true;
-    }
-  }
+  changed |= applySection(
+      "sflow_collectors", changedSections.sflowCollectors, [this]() {
+        auto newCollectors = updateSflowCollectors();
+        if (newCollectors) {
+          new_->resetSflowCollectors(std::move(newCollectors));
+          return true;
+        }
+        return false;
+      });
 
-  {
-    LoadBalancerConfigApplier loadBalancerConfigApplier(
-        orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
-    auto newLoadBalancers = loadBalancerConfigApplier.updateLoadBalancers();
-    if (newLoadBalancers) {
-      new_->resetLoadBalancers(std::move(newLoadBalancers));
-      changed = true;
-    }
-  }
+  changed |=
+      applySection("load_balancers", changedSections.loadBalancers, [this]() {
+        LoadBalancerConfigApplier loadBalancerConfigApplier(
+            orig_->getLoadBalancers(), cfg_->get_loadBalancers(), platform_);
+        auto newLoadBalancers =
+            loadBalancerConfigApplier.updateLoadBalancers();
+        if (newLoadBalancers) {
+          new_->resetLoadBalancers(std::move(newLoadBalancers));
+          return true;
+        }
+        return false;
+      });
 
-  {
+  changed |= applySection("tunnels", changedSections.tunnels, [this]() {
     auto newTunnels = updateIpInIpTunnels();
     if (newTunnels) {
       new_->resetTunnels(std::move(newTunnels));
-      changed = true;
+      return true;
     }
-  }
+    return false;
+  });
 
   // normalizer to refresh counter tags
   if (auto normalizer = Normalizer::getInstance()) {
@@ -776,24 +944,26 @@ shared_ptr<SwitchState> ThriftConfigApplier::run() {
     }
   }
 
-  {
+  changed |= applySection("udf", changedSections.udf, [this]() {
     bool udfCfgChanged = false;
     auto newUdfCfg = updateUdfConfig(&udfCfgChanged);
     if (udfCfgChanged) {
       new_->resetUdfConfig(std::move(newUdfCfg));
-      changed = true;
-    }
-  }
-
-  {
-    bool flowletSwitchingChanged = false;
-    auto newFlowletSwitchingConfig =
-        updateFlowletSwitchingConfig(&flowletSwitchingChanged);
-    if (flowletSwitchingChanged) {
-      new_->resetFlowletSwitchingConfig(std::move(newFlowletSwitchingConfig));
-      changed = true;
     }
-  }
+    return udfCfgChanged;
+  });
+
+  changed |= applySection(
+      "flowlet_switching", changedSections.flowletSwitching, [this]() {
+        bool flowletSwitchingChanged = false;
+        auto newFlowletSwitchingConfig =
+            updateFlowletSwitchingConfig(&flowletSwitchingChanged);
+        if (flowletSwitchingChanged) {
+          new_->resetFlowletSwitchingConfig(
+              std::move(newFlowletSwitchingConfig));
+        }
+        return flowletSwitchingChanged;
+      });
 
   {
     auto switchType = *cfg_->switchSettings()->switchType();
@@ -2689,8 +2859,55 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
   AclMap::NodeContainer newAcls;
   bool changed = false;
   int numExistingProcessed = 0;
-  int priority = AclTable::kDataplaneAclMaxPriority;
-  int cpuPriority = 1;
+
+  // Let's get a map of acls to name so we don't have to search the acl list
+  // for every new use
+  flat_map<std::string, const cfg::AclEntry*> aclByName;
+  folly::gen::from(configEntries) |
+      folly::gen::map([](const cfg::AclEntry& acl) {
+        return std::make_pair(*acl.name(), &acl);
+      }) |
+      folly::gen::appendTo(aclByName);
+
+  // Allocate priorities up front, in the order acls are added below, so that
+  // acls keep their priorities when others are added or removed around them
+  std::vector<std::string> dataplaneAclNames;
+  std::vector<std::string> cpuAclNames;
+  for (const auto& entry : configEntries) {
+    if (*entry.actionType() == cfg::AclActionType::DENY) {
+      dataplaneAclNames.push_back(*entry.name());
+    }
+  }
+  auto addPolicyAclNames = [&](const cfg::TrafficPolicyConfig& policy,
+                               std::vector<std::string>* aclNames) {
+    for (const auto& mta : *policy.matchToAction()) {
+      auto a = aclByName.find(*mta.matcher());
+      if (a != aclByName.end() &&
+          *a->second->actionType() != cfg::AclActionType::DENY) {
+        aclNames->push_back(*mta.matcher());
+      }
+    }
+  };
+  if (cfg_->cpuTrafficPolicy() && cfg_->cpuTrafficPolicy()->trafficPolicy()) {
+    addPolicyAclNames(
+        *cfg_->cpuTrafficPolicy()->trafficPolicy(), &cpuAclNames);
+  }
+  if (auto dataPlaneTrafficPolicy = cfg_->dataPlaneTrafficPolicy()) {
+    addPolicyAclNames(*dataPlaneTrafficPolicy, &dataplaneAclNames);
+  }
+  std::shared_ptr<const AclMap> origAcls = tableName.has_value()
+      ? orig_->getAclsForTable(aclStage, tableName.value())
+      : orig_->getAcls();
+  auto dataplanePriorities = allocateAclPriorities(
+      origAcls.get(),
+      dataplaneAclNames,
+      AclTable::kDataplaneAclMaxPriority,
+      AclTable::kDataplaneAclMaxPriority +
+          platform_->getAsic()->getMaxDataplaneAclPriorities() - 1);
+  auto cpuPriorities = allocateAclPriorities(
+      origAcls.get(), cpuAclNames, 1, AclTable::kDataplaneAclMaxPriority - 1);
+  auto priority = dataplanePriorities.begin();
+  auto cpuPriority = cpuPriorities.begin();
 
   // Start with the DROP acls, these should have highest priority
   auto acls = folly::gen::from(configEntries) |
@@ -2701,7 +2918,7 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
                 auto acl = updateAcl(
                     aclStage,
                     entry,
-                    priority++,
+                    *priority++,
                     &numExistingProcessed,
                     &changed,
                     tableName);
@@ -2709,15 +2926,6 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
               }) |
       folly::gen::appendTo(newAcls);
 
-  // Let's get a map of acls to name so we don't have to search the acl list
-  // for every new use
-  flat_map<std::string, const cfg::AclEntry*> aclByName;
-  folly::gen::from(configEntries) |
-      folly::gen::map([](const cfg::AclEntry& acl) {
-        return std::make_pair(*acl.name(), &acl);
-      }) |
-      folly::gen::appendTo(aclByName);
-
   flat_map<std::string, const cfg::TrafficCounter*> counterByName;
   folly::gen::from(*cfg_->trafficCounters()) |
       folly::gen::map([](const cfg::TrafficCounter& counter) {
@@ -2784,7 +2992,7 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
         auto acl = updateAcl(
             aclStage,
             aclCfg,
-            isCoppAcl ? cpuPriority++ : priority++,
+            isCoppAcl ? *cpuPriority++ : *priority++,
             &numExistingProcessed,
             &changed,
             tableName,
@@ -2850,6 +3058,25 @@ std::shared_ptr<AclMap> ThriftConfigApplier::updateAcls(
   return orig_->getAcls()->clone(std::move(newAcls));
 }
 
+std::vector<int> ThriftConfigApplier::allocateAclPriorities(
+    const AclMap* origAcls,
+    const std::vector<std::string>& aclNames,
+    int minPriority,
+    int maxPriority) const {
+  std::vector<std::optional<int>> existingPriorities;
+  existingPriorities.reserve(aclNames.size());
+  for (const auto& aclName : aclNames) {
+    auto origAcl = origAcls ? origAcls->getEntryIf(aclName) : nullptr;
+    existingPriorities.push_back(
+        origAcl ? std::make_optional(origAcl->getPriority()) : std::nullopt);
+  }
+  return AclPriorityAllocator(
+             minPriority,
+             maxPriority,
+             platform_->getAsic()->getAclPriorityGap())
+      .allocate(existingPriorities);
+}
+
 std::shared_ptr<AclEntry> ThriftConfigApplier::updateAcl(
     cfg::AclStage aclStage,
     const cfg::AclEntry& acl,
@@ -4318,9 +4545,19 @@ shared_ptr<SwitchState> applyThriftConfig(
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib,
-    AclNexthopHandler* aclNexthopHandler) {
-  cfg::SwitchConfig emptyConfig;
-  return ThriftConfigApplier(state, config, platform, rib, aclNexthopHandler)
+    AclNexthopHandler* aclNexthopHandler,
+    const cfg::SwitchConfig* prevConfig,
+    const shared_ptr<SwitchState>& prevConfigState,
+    SwitchStats* switchStats) {
+  return ThriftConfigApplier(
+             state,
+             config,
+             platform,
+             rib,
+             aclNexthopHandler,
+             prevConfig,
+             prevConfigState,
+             switchStats)
       .run();
 }
 shared_ptr<SwitchState> applyThriftConfig(
@@ -4328,10 +4565,19 @@ shared_ptr<SwitchState> applyThriftConfig(
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler) {
-  cfg::SwitchConfig emptyConfig;
+    AclNexthopHandler* aclNexthopHandler,
+    const cfg::SwitchConfig* prevConfig,
+    const shared_ptr<SwitchState>& prevConfigState,
+    SwitchStats* switchStats) {
   return ThriftConfigApplier(
-             state, config, platform, routeUpdater, aclNexthopHandler)
+             state,
+             config,
+             platform,
+             routeUpdater,
+             aclNexthopHandler,
+             prevConfig,
+             prevConfigState,
+             switchStats)
       .run();
 }
 
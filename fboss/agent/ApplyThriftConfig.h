@@ -24,24 +24,38 @@ class Platform;
 class SwitchState;
 class RouteUpdateWrapper;
 class AclNexthopHandler;
+class SwitchStats;
 
 /*
  * Apply a thrift config structure to a SwitchState object.
  *
  * Returns a new SwitchState object with the resulting state, or null if
  * the config file results in no changes.
+ *
+ * prevConfig is the config prevConfigState was last built from, if known.
+ * Sections of config that are the same as in prevConfig, and whose parts of
+ * state are the same as in prevConfigState, are not applied again: their
+ * parts of state are kept as they are. Parts of state modified outside of
+ * config since prevConfigState are reset to config as usual. The time taken
+ * by each section that is applied is recorded to switchStats.
  */
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RoutingInformationBase* rib = nullptr,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr,
+    const std::shared_ptr<SwitchState>& prevConfigState = nullptr,
+    SwitchStats* switchStats = nullptr);
 
 std::shared_ptr<SwitchState> applyThriftConfig(
     const std::shared_ptr<SwitchState>& state,
     const cfg::SwitchConfig* config,
     const Platform* platform,
     RouteUpdateWrapper* routeUpdater,
-    AclNexthopHandler* aclNexthopHandler = nullptr);
+    AclNexthopHandler* aclNexthopHandler = nullptr,
+    const cfg::SwitchConfig* prevConfig = nullptr,
+    const std::shared_ptr<SwitchState>& prevConfigState = nullptr,
+    SwitchStats* switchStats = nullptr);
 } // namespace facebook::fboss
@@ -3,14 +3,20 @@
 #include "fboss/agent/DsfSubscriber.h"
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/Utils.h"
+#include "fboss/agent/gen-cpp2/switch_state_fatal_types.h"
 #include "fboss/agent/state/DsfNode.h"
 #include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/fsdb/client/FsdbPubSubManager.h"
 #include "fboss/fsdb/common/Flags.h"
 #include "fboss/thrift_cow/nodes/Serializer.h"
+#include "fboss/thrift_storage/CowStorage.h"
+
+#include <folly/ScopeGuard.h>
 
 #include <memory>
+#include <set>
+#include <utility>
 
 DEFINE_bool(dsf_subscriber_skip_hw_writes, false, "Skip writing to HW");
 DEFINE_bool(
@@ -23,8 +29,47 @@ namespace facebook::fboss {
 using ThriftMapTypeClass = apache::thrift::type_class::map<
     apache::thrift::type_class::integral,
     apache::thrift::type_class::structure>;
-using SysPortMapThriftType = std::map<int64_t, state::SystemPortFields>;
-using InterfaceMapThriftType = std::map<int32_t, state::InterfaceFields>;
+using RemoteStateNode = thrift_cow::ThriftStructNode<state::SwitchState>;
+
+namespace {
+bool isPrefix(
+    const std::vector<std::string>& prefix,
+    const std::vector<std::string>& path) {
+  return prefix.size() <= path.size() &&
+      std::equal(prefix.begin(), prefix.end(), path.begin());
+}
+} // namespace
+
+struct DsfSubscriber::RemoteNode {
+  bool hasChanges() const {
+    return allSysPortsChanged || allRifsChanged || !changedSysPorts.empty() ||
+        !changedRifs.empty();
+  }
+
+  void clearChanges() {
+    changedSysPorts.clear();
+    changedRifs.clear();
+    allSysPortsChanged = allRifsChanged = false;
+  }
+
+  void mergeChanges(const RemoteNode& other) {
+    changedSysPorts.insert(
+        other.changedSysPorts.begin(), other.changedSysPorts.end());
+    changedRifs.insert(other.changedRifs.begin(), other.changedRifs.end());
+    allSysPortsChanged |= other.allSysPortsChanged;
+    allRifsChanged |= other.allRifsChanged;
+  }
+
+  std::string name;
+  // Sys ports and rifs as published by the node, rooted at switch state
+  std::shared_ptr<RemoteStateNode> state{std::make_shared<RemoteStateNode>()};
+  // Changed since last applied to switch state
+  std::set<int64_t> changedSysPorts;
+  std::set<int32_t> changedRifs;
+  // Whole map replaced, e.g. on (re)connecting to the node
+  bool allSysPortsChanged{false};
+  bool allRifsChanged{false};
+};
 
 DsfSubscriber::DsfSubscriber(SwSwitch* sw) : sw_(sw) {
   sw_->registerStateObserver(this, "DSFSubscriber");
@@ -44,89 +89,228 @@ void DsfSubscriber::scheduleUpdate(
              << " updated # of sys ports: "
              << (newSysPorts ? newSysPorts->size() : 0)
              << " updated # of rifs: " << (newRifs ? newRifs->size() : 0);
-  sw_->updateState(
-      folly::sformat("Update state for node: {}", nodeName),
-      [this, newSysPorts, newRifs, nodeSwitchId, nodeName](
-          const std::shared_ptr<SwitchState>& in) {
-        if (nodeSwitchId == SwitchID(*in->getSwitchSettings()->getSwitchId())) {
+  fsdb::TaggedOperDelta change;
+  change.delta()->protocol() = fsdb::OperProtocol::BINARY;
+  auto replace = [&](const auto& path, const auto& newMap) {
+    fsdb::OperDeltaUnit unit;
+    unit.path()->raw() = path;
+    unit.newState() = thrift_cow::serialize<ThriftMapTypeClass>(
+        fsdb::OperProtocol::BINARY, newMap->toThrift());
+    change.delta()->changes()->push_back(std::move(unit));
+  };
+  if (newSysPorts) {
+    replace(getSystemPortsPath(), newSysPorts);
+  }
+  if (newRifs) {
+    replace(getInterfacesPath(), newRifs);
+  }
+  fsdb::OperSubDeltaUnit operDeltaUnit;
+  operDeltaUnit.changes()->push_back(std::move(change));
+  handleFsdbUpdate(std::move(operDeltaUnit), nodeName, nodeSwitchId);
+}
+
+void DsfSubscriber::handleFsdbUpdate(
+    fsdb::OperSubDeltaUnit&& operDeltaUnit,
+    const std::string& nodeName,
+    SwitchID nodeSwitchId) {
+  const auto sysPortsPath = getSystemPortsPath();
+  const auto rifsPath = getInterfacesPath();
+  auto needsUpdate = remoteNodes_.withWLock([&](auto& remoteNodes) {
+    auto& node = remoteNodes.nodes[nodeSwitchId];
+    if (!node) {
+      node = std::make_unique<RemoteNode>();
+    }
+    node->name = nodeName;
+    CowStorage<state::SwitchState> storage(node->state);
+    for (auto& change : *operDeltaUnit.changes()) {
+      auto& delta = *change.delta();
+      for (auto& unit : *delta.changes()) {
+        // Delta paths start at the FSDB root, make them relative to switch
+        // state and note which sys ports and rifs they change
+        auto& path = *unit.path()->raw();
+        if (isPrefix(sysPortsPath, path)) {
+          if (path.size() == sysPortsPath.size()) {
+            node->allSysPortsChanged = true;
+          } else {
+            node->changedSysPorts.insert(
+                folly::to<int64_t>(path[sysPortsPath.size()]));
+          }
+          path.erase(path.begin(), path.begin() + sysPortsPath.size() - 1);
+        } else if (isPrefix(rifsPath, path)) {
+          if (path.size() == rifsPath.size()) {
+            node->allRifsChanged = true;
+          } else {
+            node->changedRifs.insert(
+                folly::to<int32_t>(path[rifsPath.size()]));
+          }
+          path.erase(path.begin(), path.begin() + rifsPath.size() - 1);
+        } else {
           throw FbossError(
-              " Got updates for my switch ID, from: ",
-              nodeName,
-              " id: ",
-              nodeSwitchId);
+              " Got unexpected state update for : ",
+              folly::join("/", path),
+              " from node: ",
+              nodeName);
         }
-        bool changed{false};
-        auto out = in->clone();
+      }
+      if (auto error = storage.patch(delta)) {
+        throw FbossError(
+            " Failed to apply state update from node: ",
+            nodeName,
+            " error: ",
+            static_cast<int>(*error));
+      }
+    }
+    storage.publish();
+    node->state = storage.root();
+    return !std::exchange(remoteNodes.updateScheduled, true);
+  });
+  if (!needsUpdate) {
+    // Coalesced into the already scheduled update
+    return;
+  }
+  sw_->updateState(
+      "Update state for remote DSF nodes",
+      [this](const std::shared_ptr<SwitchState>& in) {
+        return updateRemoteState(in);
+      });
+}
 
-        auto makeRemoteSysPort = [&](const auto& node) { return node; };
-        auto makeRemoteRif = [&](const auto& node) {
-          auto clonedNode = node->clone();
+std::shared_ptr<SwitchState> DsfSubscriber::updateRemoteState(
+    const std::shared_ptr<SwitchState>& in) {
+  std::map<SwitchID, RemoteNode> changedNodes;
+  remoteNodes_.withWLock([&](auto& remoteNodes) {
+    remoteNodes.updateScheduled = false;
+    for (auto& [switchId, node] : remoteNodes.nodes) {
+      if (node->hasChanges()) {
+        changedNodes.emplace(switchId, *node);
+        node->clearChanges();
+      }
+    }
+  });
+  // Changes not applied to switch state are put back for the next update
+  // to pick up, along with any that arrived in the meantime
+  auto restoreChanges = [&]() {
+    remoteNodes_.withWLock([&](auto& remoteNodes) {
+      for (const auto& [switchId, changes] : changedNodes) {
+        if (auto it = remoteNodes.nodes.find(switchId);
+            it != remoteNodes.nodes.end()) {
+          it->second->mergeChanges(changes);
+        }
+      }
+    });
+  };
+  SCOPE_FAIL {
+    restoreChanges();
+  };
 
-          if (node->isPublished()) {
-            clonedNode->setArpTable(node->getArpTable()->toThrift());
-            clonedNode->setNdpTable(node->getNdpTable()->toThrift());
-          }
+  bool changed{false};
+  auto out = in->clone();
 
-          // Local neighbor entry on one DSF node is remote neighbor entry on
-          // every other DSF node. Thus, for neighbor entry received from other
-          // DSF nodes, set isLocal = False before programming it.
-          for (const auto& arpEntry : *clonedNode->getArpTable()) {
-            arpEntry.second->setIsLocal(false);
-          }
-          for (const auto& ndpEntry : *clonedNode->getNdpTable()) {
-            ndpEntry.second->setIsLocal(false);
-          }
+  auto makeRemoteSysPort = [](state::SystemPortFields fields) {
+    return std::make_shared<SystemPort>(std::move(fields));
+  };
+  auto makeRemoteRif = [](state::InterfaceFields fields) {
+    // Local neighbor entry on one DSF node is remote neighbor entry on
+    // every other DSF node. Thus, for neighbor entry received from other
+    // DSF nodes, set isLocal = False before programming it.
+    for (auto& [ip, arpEntry] : *fields.arpTable()) {
+      arpEntry.isLocal() = false;
+    }
+    for (auto& [ip, ndpEntry] : *fields.ndpTable()) {
+      ndpEntry.isLocal() = false;
+    }
+    return std::make_shared<Interface>(std::move(fields));
+  };
 
-          return clonedNode;
-        };
+  // Only the changed entries are rebuilt, the rest of the remote maps is
+  // left as is
+  auto processChanges = [&](const auto& ids,
+                            const auto& newNodes,
+                            auto remoteMap,
+                            auto& makeRemote) {
+    for (auto id : ids) {
+      auto oldNode = remoteMap->getNodeIf(id);
+      auto newIt = newNodes->find(id);
+      if (newIt == newNodes->end()) {
+        if (oldNode) {
+          remoteMap->removeNode(id);
+          changed = true;
+        }
+        continue;
+      }
+      auto newNode = makeRemote(newIt->second->toThrift());
+      if (!oldNode) {
+        remoteMap->addNode(newNode);
+        changed = true;
+      } else if (*oldNode != *newNode) {
+        remoteMap->updateNode(newNode);
+        changed = true;
+      }
+    }
+  };
 
-        auto processDelta =
-            [&](auto& delta, auto& mapToUpdate, auto& makeRemote) {
-              DeltaFunctions::forEachChanged(
-                  delta,
-                  [&](const auto& oldNode, const auto& newNode) {
-                    if (*oldNode != *newNode) {
-                      // Compare contents as we reconstructed
-                      // map from deserialized FSDB
-                      // subscriptions. So can't just rely on
-                      // pointer comparison here.
-                      auto clonedNode = makeRemote(newNode);
-                      mapToUpdate->updateNode(clonedNode);
-                      changed = true;
-                    }
-                  },
-                  [&](const auto& newNode) {
-                    auto clonedNode = makeRemote(newNode);
-                    mapToUpdate->addNode(clonedNode);
-                    changed = true;
-                  },
-                  [&](const auto& rmNode) {
-                    mapToUpdate->removeNode(rmNode);
-                    changed = true;
-                  });
-            };
+  for (const auto& [nodeSwitchId, node] : changedNodes) {
+    if (in->isLocalSwitchId(nodeSwitchId)) {
+      XLOG(ERR) << " Got updates for my switch ID, from: " << node.name
+                << " id: " << nodeSwitchId;
+      continue;
+    }
+    XLOG(DBG2) << " For , switchId: " << static_cast<int64_t>(nodeSwitchId)
+               << " got,"
+               << " updated # of sys ports: " << node.changedSysPorts.size()
+               << (node.allSysPortsChanged ? " (all)" : "")
+               << " updated # of rifs: " << node.changedRifs.size()
+               << (node.allRifsChanged ? " (all)" : "");
 
-        if (newSysPorts) {
-          auto origSysPorts = out->getSystemPorts(nodeSwitchId);
-          thrift_cow::ThriftMapDelta<SystemPortMap> delta(
-              origSysPorts.get(), newSysPorts.get());
-          auto remoteSysPorts = out->getRemoteSystemPorts()->modify(&out);
-          processDelta(delta, remoteSysPorts, makeRemoteSysPort);
-        }
-        if (newRifs) {
-          auto origRifs = out->getInterfaces(nodeSwitchId);
-          InterfaceMapDelta delta(origRifs.get(), newRifs.get());
-          auto remoteRifs = out->getRemoteInterfaces()->modify(&out);
-          processDelta(delta, remoteRifs, makeRemoteRif);
-        }
-        if (FLAGS_dsf_subscriber_cache_updated_state) {
-          cachedState_ = out;
-        }
-        if (changed && !FLAGS_dsf_subscriber_skip_hw_writes) {
-          return out;
-        }
-        return std::shared_ptr<SwitchState>{};
-      });
+    const auto& newSysPorts =
+        node.state->cref<switch_state_tags::systemPortMap>();
+    auto sysPortIds = node.changedSysPorts;
+    const auto& newRifs = node.state->cref<switch_state_tags::interfaceMap>();
+    auto rifIds = node.changedRifs;
+    if (node.allSysPortsChanged) {
+      for (const auto& [id, sysPort] : std::as_const(*newSysPorts)) {
+        sysPortIds.insert(id);
+      }
+      auto origSysPorts = in->getSystemPorts(nodeSwitchId);
+      for (const auto& [id, sysPort] : std::as_const(*origSysPorts)) {
+        sysPortIds.insert(id);
+      }
+    }
+    if (node.allRifsChanged) {
+      for (const auto& [id, rif] : std::as_const(*newRifs)) {
+        rifIds.insert(id);
+      }
+      auto origRifs = in->getInterfaces(nodeSwitchId);
+      for (const auto& [id, rif] : std::as_const(*origRifs)) {
+        rifIds.insert(id);
+      }
+    }
+    if (!sysPortIds.empty()) {
+      processChanges(
+          sysPortIds,
+          newSysPorts,
+          out->getRemoteSystemPorts()->modify(&out),
+          makeRemoteSysPort);
+    }
+    if (!rifIds.empty()) {
+      processChanges(
+          rifIds,
+          newRifs,
+          out->getRemoteInterfaces()->modify(&out),
+          makeRemoteRif);
+    }
+  }
+  if (FLAGS_dsf_subscriber_cache_updated_state) {
+    cachedState_ = out;
+  }
+  if (!changed) {
+    return std::shared_ptr<SwitchState>{};
+  }
+  if (FLAGS_dsf_subscriber_skip_hw_writes) {
+    restoreChanges();
+    return std::shared_ptr<SwitchState>{};
+  }
+  return out;
 }
 
 void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
@@ -191,7 +375,7 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
     auto nodeName = node->getName();
     auto nodeSwitchId = node->getSwitchId();
     XLOG(DBG2) << " Setting up DSF subscriptions to : " << nodeName;
-    fsdbPubSubMgr_->addStatePathSubscription(
+    fsdbPubSubMgr_->addStateDeltaSubscription(
         {getSystemPortsPath(), getInterfacesPath()},
         [nodeName](auto /*oldState*/, auto newState) {
           XLOG(DBG2) << (newState == fsdb::FsdbStreamClient::State::CONNECTED
@@ -199,35 +383,9 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
                              : "Disconnected from: ")
                      << nodeName;
         },
-        [this, nodeName, nodeSwitchId](fsdb::OperSubPathUnit&& operStateUnit) {
-          std::shared_ptr<SystemPortMap> newSysPorts;
-          std::shared_ptr<InterfaceMap> newRifs;
-          for (const auto& change : *operStateUnit.changes()) {
-            if (change.path()->path() == getSystemPortsPath()) {
-              XLOG(DBG2) << " Got sys port update from : " << nodeName;
-              newSysPorts = std::make_shared<SystemPortMap>();
-              newSysPorts->fromThrift(
-                  thrift_cow::
-                      deserialize<ThriftMapTypeClass, SysPortMapThriftType>(
-                          fsdb::OperProtocol::BINARY,
-                          *change.state()->contents()));
-            } else if (change.path()->path() == getInterfacesPath()) {
-              XLOG(DBG2) << " Got rif update from : " << nodeName;
-              newRifs = std::make_shared<InterfaceMap>();
-              newRifs->fromThrift(
-                  thrift_cow::
-                      deserialize<ThriftMapTypeClass, InterfaceMapThriftType>(
-                          fsdb::OperProtocol::BINARY,
-                          *change.state()->contents()));
-            } else {
-              throw FbossError(
-                  " Got unexpected state update for : ",
-                  folly::join("/", *change.path()->path()),
-                  " from node: ",
-                  nodeName);
-            }
-          }
-          scheduleUpdate(newSysPorts, newRifs, nodeName, nodeSwitchId);
+        [this, nodeName, nodeSwitchId](fsdb::OperSubDeltaUnit&& operDeltaUnit) {
+          XLOG(DBG2) << " Got sys port/rif update from : " << nodeName;
+          handleFsdbUpdate(std::move(operDeltaUnit), nodeName, nodeSwitchId);
         },
         getServerOptions(node, stateDelta.newState()));
   };
@@ -238,8 +396,10 @@ void DsfSubscriber::stateUpdated(const StateDelta& stateDelta) {
       return;
     }
     XLOG(DBG2) << " Removing DSF subscriptions to : " << node->getName();
-    fsdbPubSubMgr_->removeStatePathSubscription(
+    fsdbPubSubMgr_->removeStateDeltaSubscription(
         {getSystemPortsPath(), getInterfacesPath()}, getLoopbackIp(node));
+    // Resubscribing starts with the full sys port and rif maps again
+    remoteNodes_.wlock()->nodes.erase(node->getSwitchId());
   };
   DeltaFunctions::forEachChanged(
       stateDelta.getDsfNodesDelta(),
@@ -3,8 +3,11 @@
 #pragma once
 
 #include "fboss/agent/StateObserver.h"
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 
+#include <folly/Synchronized.h>
 #include <gtest/gtest.h>
+#include <map>
 #include <memory>
 
 DECLARE_bool(dsf_subscriber_skip_hw_writes);
@@ -34,19 +37,39 @@ class DsfSubscriber : public StateObserver {
   }
 
  private:
+  struct RemoteNode;
+  struct RemoteNodes {
+    std::map<SwitchID, std::unique_ptr<RemoteNode>> nodes;
+    bool updateScheduled{false};
+  };
+
+  // Replace all sys ports and rifs of a node
   void scheduleUpdate(
       const std::shared_ptr<SystemPortMap>& newSysPorts,
       const std::shared_ptr<InterfaceMap>& newRifs,
       const std::string& nodeName,
       SwitchID nodeSwitchId);
+  // Apply changes to sys ports and rifs of a node, published to its FSDB.
+  // Changes from all nodes are coalesced into one state update.
+  void handleFsdbUpdate(
+      fsdb::OperSubDeltaUnit&& operDeltaUnit,
+      const std::string& nodeName,
+      SwitchID nodeSwitchId);
+  std::shared_ptr<SwitchState> updateRemoteState(
+      const std::shared_ptr<SwitchState>& in);
   // Paths
   static std::vector<std::string> getSystemPortsPath();
   static std::vector<std::string> getInterfacesPath();
   SwSwitch* sw_;
   std::unique_ptr<fsdb::FsdbPubSubManager> fsdbPubSubMgr_;
   std::shared_ptr<SwitchState> cachedState_;
+  // Last known sys ports and rifs of remote nodes, and their changes not
+  // yet applied to switch state
+  folly::Synchronized<RemoteNodes> remoteNodes_;
   FRIEND_TEST(DsfSubscriberTest, scheduleUpdate);
+  FRIEND_TEST(DsfSubscriberTest, changesKeptUntilApplied);
   FRIEND_TEST(DsfSubscriberTest, setupNeighbors);
+  FRIEND_TEST(DsfSubscriberTest, remoteNodeDeltasScale);
 };
 
 } // namespace facebook::fboss
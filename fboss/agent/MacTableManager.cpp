@@ -12,23 +12,139 @@
 #include "fboss/agent/L2Entry.h"
 #include "fboss/agent/MacTableUtils.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/state/StateUpdate.h"
 #include "fboss/agent/state/SwitchState.h"
 
+#include <folly/String.h>
+#include <folly/logging/xlog.h>
+
+#include <algorithm>
+
+DEFINE_int32(
+    mac_learning_batch_size,
+    1024,
+    "Maximum number of L2 learning updates applied in a single state update");
+DEFINE_int32(
+    mac_learning_batch_window_ms,
+    0,
+    "Time to wait for more L2 learning updates after the first update of a "
+    "batch before applying it. With 0, a batch takes in updates until the "
+    "update thread gets to it");
+
 namespace facebook::fboss {
 
-MacTableManager::MacTableManager(SwSwitch* sw) : sw_(sw) {}
+MacTableManager::MacTableManager(SwSwitch* sw)
+    : sw_(sw), pendingBatches_(std::make_shared<PendingBatches>()) {}
 
 void MacTableManager::handleL2LearningUpdate(
     L2Entry l2Entry,
     L2EntryUpdateType l2EntryUpdateType) {
-  auto updateMacTableFn =
-      [l2Entry, l2EntryUpdateType](const std::shared_ptr<SwitchState>& state) {
-        return MacTableUtils::updateMacTable(state, l2Entry, l2EntryUpdateType);
-      };
-
-  sw_->updateStateNoCoalescing(
-      folly::to<std::string>("Programming : ", l2Entry.str()),
-      std::move(updateMacTableFn));
+  bool newBatch = false;
+  {
+    auto pendingBatches = pendingBatches_->wlock();
+    auto key = std::make_pair(l2Entry.getVlanID(), l2Entry.getMac());
+    if (pendingBatches->empty() || pendingBatches->back().applied ||
+        pendingBatches->back().updates.size() >=
+            std::max(FLAGS_mac_learning_batch_size, 1)) {
+      newBatch = true;
+    } else {
+      const auto& updateTypes = pendingBatches->back().updateTypes;
+      auto it = updateTypes.find(key);
+      newBatch = it != updateTypes.end() && it->second != l2EntryUpdateType;
+    }
+    if (newBatch) {
+      pendingBatches->emplace_back();
+      pendingBatches->back().queued = std::chrono::steady_clock::now();
+    }
+    auto& batch = pendingBatches->back();
+    batch.updateTypes[key] = l2EntryUpdateType;
+    batch.updates.emplace_back(std::move(l2Entry), l2EntryUpdateType);
+  }
+  if (newBatch) {
+    scheduleBatch();
+  }
+}
+
+/*
+ * Applies the oldest batch not applied yet. The batch stays queued until the
+ * update is committed, so a state update function never changes the queue.
+ */
+class MacTableManager::BatchUpdate : public StateUpdate {
+ public:
+  BatchUpdate(SwSwitch* sw, std::shared_ptr<PendingBatches> pendingBatches)
+      : StateUpdate(
+            "Programming L2 learning updates",
+            static_cast<int>(BehaviorFlags::NON_COALESCING)),
+        sw_(sw),
+        pendingBatches_(std::move(pendingBatches)) {}
+
+  std::shared_ptr<SwitchState> applyUpdate(
+      const std::shared_ptr<SwitchState>& state) override {
+    {
+      auto locked = pendingBatches_->wlock();
+      auto it = std::find_if(
+          locked->begin(), locked->end(), [](const PendingBatch& batch) {
+            return !batch.applied;
+          });
+      if (it == locked->end()) {
+        return nullptr;
+      }
+      // An applied batch is no longer modified, and references to deque
+      // elements stay valid as other batches are added or removed
+      it->applied = true;
+      batch_ = &*it;
+    }
+    sw_->stats()->macLearningBatch(
+        batch_->updates.size(),
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - batch_->queued));
+
+    std::shared_ptr<SwitchState> newState{state};
+    for (const auto& [l2Entry, l2EntryUpdateType] : batch_->updates) {
+      XLOG(DBG2) << "Programming : " << l2Entry.str();
+      newState =
+          MacTableUtils::updateMacTable(newState, l2Entry, l2EntryUpdateType);
+    }
+    return newState;
+  }
+
+  void onError(const std::exception& ex) noexcept override {
+    XLOG(FATAL) << "unexpected error applying state update <" << getName()
+                << ">: " << folly::exceptionStr(ex);
+  }
+
+  void onSuccess() override {
+    if (!batch_) {
+      return;
+    }
+    // Updates are committed in the order they are applied
+    auto locked = pendingBatches_->wlock();
+    CHECK_EQ(&locked->front(), batch_);
+    locked->pop_front();
+  }
+
+ private:
+  SwSwitch* sw_;
+  std::shared_ptr<PendingBatches> pendingBatches_;
+  const PendingBatch* batch_{nullptr};
+};
+
+void MacTableManager::scheduleBatch() {
+  // Every batch schedules one update, which applies the oldest batch not
+  // applied yet. Batches are thus applied in order even if their updates are
+  // not scheduled in order.
+  auto schedule = [sw = sw_, pendingBatches = pendingBatches_]() {
+    sw->updateState(std::make_unique<BatchUpdate>(sw, pendingBatches));
+  };
+  if (FLAGS_mac_learning_batch_window_ms <= 0) {
+    schedule();
+    return;
+  }
+  auto* evb = sw_->getBackgroundEvb();
+  evb->runInEventBaseThread([evb, schedule = std::move(schedule)]() mutable {
+    evb->runAfterDelay(std::move(schedule), FLAGS_mac_learning_batch_window_ms);
+  });
 }
 
 } // namespace facebook::fboss
@@ -10,25 +10,63 @@
 #pragma once
 
 #include "fboss/agent/L2Entry.h"
+#include "fboss/agent/types.h"
+
+#include <folly/MacAddress.h>
+#include <folly/Synchronized.h>
+#include <gflags/gflags.h>
+
+#include <chrono>
+#include <deque>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+DECLARE_int32(mac_learning_batch_size);
+DECLARE_int32(mac_learning_batch_window_ms);
 
 namespace facebook::fboss {
 
 class SwSwitch;
+class SwitchState;
 
 class MacTableManager {
  public:
   explicit MacTableManager(SwSwitch* sw);
 
+  /*
+   * L2 learning updates are applied in batches, each in a single state
+   * update. An update joins the newest batch not yet applied, unless that
+   * batch is full or has an update of the other type (learn vs age) for the
+   * same MAC, in which case it starts a new batch. This keeps every learn and
+   * age of a MAC visible as a separate state delta, in the order received.
+   */
   void handleL2LearningUpdate(
       L2Entry l2Entry,
       L2EntryUpdateType l2EntryUpdateType);
 
  private:
+  struct PendingBatch {
+    std::vector<std::pair<L2Entry, L2EntryUpdateType>> updates;
+    std::map<std::pair<VlanID, folly::MacAddress>, L2EntryUpdateType>
+        updateTypes;
+    std::chrono::steady_clock::time_point queued;
+    // Set once the batch is applied, after which it takes in no more updates
+    bool applied{false};
+  };
+  using PendingBatches = folly::Synchronized<std::deque<PendingBatch>>;
+  class BatchUpdate;
+
+  void scheduleBatch();
+
   // Forbidden copy constructor and assignment operator
   MacTableManager(MacTableManager const&) = delete;
   MacTableManager& operator=(MacTableManager const&) = delete;
 
   SwSwitch* sw_{nullptr};
+  // Shared with scheduled state updates, which may outlive this object
+  std::shared_ptr<PendingBatches> pendingBatches_;
 };
 
 } // namespace facebook::fboss
@@ -16,6 +16,10 @@ class MirrorManager : public StateObserver {
   ~MirrorManager() override;
 
   void stateUpdated(const StateDelta& delta) override;
+  // Only inspects the delta and queues a state update
+  bool notifyConcurrently() const override {
+    return true;
+  }
 
  private:
   SwSwitch* sw_;
@@ -39,6 +39,7 @@ namespace facebook::fboss {
 template <typename NTable>
 class NeighborCache {
   friend class NeighborCacheEntry<NTable>;
+  friend class NeighborCacheImpl<NTable>;
 
  public:
   typedef typename NTable::Entry::AddressType AddressType;
@@ -215,6 +216,11 @@ class NeighborCache {
     return impl_->processEntry(ip);
   }
 
+  void flushExpiredEntries() {
+    std::lock_guard<std::mutex> g(cacheLock_);
+    impl_->flushExpiredEntries();
+  }
+
   // Has the entry corresponding to ip has been hit in hw
   bool isHit(AddressType ip) {
     return sw_->getAndClearNeighborHit(RouterID(0), ip);
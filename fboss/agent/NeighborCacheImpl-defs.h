@@ -194,7 +194,11 @@ void NeighborCacheImpl<NTable>::programPendingEntry(Entry* entry, bool force) {
 }
 
 template <typename NTable>
-NeighborCacheImpl<NTable>::~NeighborCacheImpl() {}
+NeighborCacheImpl<NTable>::~NeighborCacheImpl() {
+  // Caches are only destroyed along with their vlan, so expired entries still
+  // waiting for the batched flush have nothing left to be removed from
+  expiredEntriesFlush_.cancelLoopCallback();
+}
 
 template <typename NTable>
 void NeighborCacheImpl<NTable>::repopulate(std::shared_ptr<NTable> table) {
@@ -301,6 +305,11 @@ NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::setEntryInternal(
     entry->updateState(state);
     return changed ? entry : nullptr;
   } else if (add) {
+    if (expiredEntries_.count(fields.ip)) {
+      // Remove the expired entry from the SwitchState before programming
+      // the new one, so that updates are applied in order
+      flushExpiredEntries();
+    }
     auto to_store = std::make_shared<Entry>(fields, evb_, cache_, state);
     entry = to_store.get();
     setCacheEntry(std::move(to_store));
@@ -331,11 +340,53 @@ void NeighborCacheImpl<NTable>::processEntry(AddressType ip) {
   if (entry) {
     entry->process();
     if (entry->getState() == NeighborEntryState::EXPIRED) {
-      flushEntry(ip);
+      if (FLAGS_batch_neighbor_expiry) {
+        expireEntry(ip);
+      } else {
+        flushEntry(ip);
+      }
     }
   }
 }
 
+template <typename NTable>
+void NeighborCacheImpl<NTable>::expireEntry(AddressType ip) {
+  if (!removeEntry(ip)) {
+    return;
+  }
+  expiredEntries_.insert(ip);
+  if (!expiredEntriesFlush_.isLoopCallbackScheduled()) {
+    evb_->runInLoop(&expiredEntriesFlush_);
+  }
+}
+
+template <typename NTable>
+void NeighborCacheImpl<NTable>::flushExpiredEntries() {
+  if (expiredEntries_.empty()) {
+    return;
+  }
+  std::unordered_set<AddressType> expired;
+  expired.swap(expiredEntries_);
+  XLOG(DBG2) << "Flushing " << expired.size() << " expired neighbor entries "
+             << "for vlan " << vlanID_;
+
+  auto name = folly::to<std::string>(
+      "remove ", expired.size(), " expired neighbor entries");
+  // The update may be applied after this cache is destroyed, so don't
+  // capture this
+  auto updateFn = [vlanID = vlanID_, expired = std::move(expired)](
+                      const std::shared_ptr<SwitchState>& state)
+      -> std::shared_ptr<SwitchState> {
+    std::shared_ptr<SwitchState> newState{state};
+    bool flushed{false};
+    for (const auto& ip : expired) {
+      flushed |= flushEntryFromSwitchState(&newState, vlanID, ip);
+    }
+    return flushed ? newState : nullptr;
+  };
+  sw_->updateState(name, std::move(updateFn));
+}
+
 template <typename NTable>
 NeighborCacheEntry<NTable>* NeighborCacheImpl<NTable>::getCacheEntry(
     AddressType ip) const {
@@ -367,8 +418,12 @@ bool NeighborCacheImpl<NTable>::removeEntry(AddressType ip) {
 template <typename NTable>
 bool NeighborCacheImpl<NTable>::flushEntryFromSwitchState(
     std::shared_ptr<SwitchState>* state,
+    VlanID vlanID,
     AddressType ip) {
-  auto* vlan = (*state)->getVlans()->getVlan(vlanID_).get();
+  auto* vlan = (*state)->getVlans()->getVlanIf(vlanID).get();
+  if (!vlan) {
+    return false;
+  }
   auto* table = vlan->template getNeighborTable<NTable>().get();
   const auto& entry = table->getNodeIf(ip.str());
   if (!entry) {
@@ -401,7 +456,7 @@ void NeighborCacheImpl<NTable>::flushEntry(AddressType ip, bool* flushed) {
   auto updateFn = [this, ip, flushed](const std::shared_ptr<SwitchState>& state)
       -> std::shared_ptr<SwitchState> {
     std::shared_ptr<SwitchState> newState{state};
-    if (flushEntryFromSwitchState(&newState, ip)) {
+    if (flushEntryFromSwitchState(&newState, vlanID_, ip)) {
       if (flushed) {
         *flushed = true;
       }
@@ -18,9 +18,14 @@
 
 #include <folly/IPAddress.h>
 #include <folly/Random.h>
+#include <folly/io/async/EventBase.h>
+#include <gflags/gflags.h>
 #include <list>
 #include <optional>
 #include <string>
+#include <unordered_set>
+
+DECLARE_bool(batch_neighbor_expiry);
 
 namespace facebook::fboss {
 
@@ -136,12 +141,18 @@ class NeighborCacheImpl {
 
   void processEntry(AddressType ip);
 
+  // Remove an expired entry from the cache, and queue its removal from the
+  // SwitchState with the other entries expiring in this loop iteration
+  void expireEntry(AddressType ip);
+  void flushExpiredEntries();
+
   // Pass in a non-null flushed if you care whether an entry
   // was actually flushed from the switch state
   void flushEntry(AddressType ip, bool* flushed = nullptr);
 
-  bool flushEntryFromSwitchState(
+  static bool flushEntryFromSwitchState(
       std::shared_ptr<SwitchState>* state,
+      VlanID vlanID,
       AddressType ip);
 
   Entry* getCacheEntry(AddressType ip) const;
@@ -166,6 +177,23 @@ class NeighborCacheImpl {
 
   // Map of all entries
   std::unordered_map<AddressType, std::shared_ptr<Entry>> entries_;
+
+  class ExpiredEntriesFlush : public folly::EventBase::LoopCallback {
+   public:
+    explicit ExpiredEntriesFlush(NeighborCache<NTable>* cache)
+        : cache_(cache) {}
+
+    void runLoopCallback() noexcept override {
+      cache_->flushExpiredEntries();
+    }
+
+   private:
+    NeighborCache<NTable>* cache_;
+  };
+
+  // Expired entries not yet removed from the SwitchState
+  std::unordered_set<AddressType> expiredEntries_;
+  ExpiredEntriesFlush expiredEntriesFlush_{cache_};
 };
 
 } // namespace facebook::fboss
@@ -43,6 +43,12 @@ DEFINE_bool(
     false,
     "Disable neighbor updater in agent");
 
+DEFINE_bool(
+    batch_neighbor_expiry,
+    true,
+    "Remove neighbor entries expiring together from the switch state in one "
+    "state update, rather than one update per entry");
+
 namespace facebook::fboss {
 
 using facebook::fboss::DeltaFunctions::forEachChanged;
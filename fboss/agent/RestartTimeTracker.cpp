@@ -159,6 +159,13 @@ class RestartTimeTracker {
     return tp;
   }
 
+  void newDuration(const std::string& step, milliseconds duration) {
+    auto counterName =
+        folly::to<std::string>(prefix_, step, ".", kStageCounterSuffix);
+    fb303::fbData->setCounter(counterName, duration.count());
+    XLOG(DBG2) << counterName << " -> " << duration.count() << "ms";
+  }
+
  private:
   std::string savePath(RestartEvent type) {
     return folly::to<std::string>(warmBootDir_, "/", to_string(type));
@@ -226,6 +233,15 @@ void mark(RestartEvent event) {
   }
 }
 
+void markDuration(const std::string& step, milliseconds duration) {
+  auto tracker = impl_.lock();
+  if (*tracker) {
+    // Unlike mark(), also called from hw layers running without an agent
+    // (e.g. hw tests), in which case there is nothing to export to
+    (*tracker)->newDuration(step, duration);
+  }
+}
+
 void stop() {
   auto tracker = impl_.lock();
   (*tracker).reset();
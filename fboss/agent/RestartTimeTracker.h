@@ -9,6 +9,7 @@
  */
 #pragma once
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 
@@ -44,6 +45,9 @@ enum class RestartEvent : uint16_t {
 namespace restart_time {
 void init(const std::string& warmBootDir, bool warmBoot);
 void mark(RestartEvent event);
+// Export the duration of a step within a stage, e.g. reloading one type of
+// hw objects during init, as <prefix>.<step>.stage_duration_ms
+void markDuration(const std::string& step, std::chrono::milliseconds duration);
 void stop();
 }; // namespace restart_time
 
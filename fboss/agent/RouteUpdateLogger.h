@@ -162,6 +162,10 @@ class RouteUpdateLogger : public StateObserver {
   ~RouteUpdateLogger() override;
 
   void stateUpdated(const StateDelta& delta) override;
+  // Only reads the delta and the (thread safe) trackers and loggers
+  bool notifyConcurrently() const override {
+    return true;
+  }
   void startLoggingForPrefix(const RouteUpdateLoggingInstance& req);
   void stopLoggingForPrefix(
       const folly::IPAddress& network,
@@ -0,0 +1,204 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/Utils.h"
+#include "fboss/agent/packet/Ethertype.h"
+#include "fboss/agent/packet/ICMPHdr.h"
+#include "fboss/agent/packet/IPProto.h"
+
+#include <folly/io/Cursor.h>
+#include <folly/logging/xlog.h>
+
+DEFINE_bool(
+    async_rx_dispatch,
+    false,
+    "Handle trapped packets on a dispatch thread, with per class queues "
+    "served in priority order, rather than on the HwSwitch RX thread");
+DEFINE_int32(
+    rx_dispatch_queue_size,
+    1024,
+    "Number of packets queued per class with async_rx_dispatch");
+DEFINE_int32(
+    rx_neighbor_resolution_pps,
+    0,
+    "Rate limit for trapped ARP and NDP packets with async_rx_dispatch, 0 for "
+    "no limit");
+DEFINE_int32(
+    rx_default_class_pps,
+    0,
+    "Rate limit for trapped packets other than control protocols and "
+    "neighbor resolution with async_rx_dispatch, 0 for no limit");
+
+namespace facebook::fboss {
+
+namespace {
+constexpr uint16_t kBgpPort = 179;
+
+bool isBgp(folly::io::Cursor& cursor) {
+  auto srcPort = cursor.readBE<uint16_t>();
+  auto dstPort = cursor.readBE<uint16_t>();
+  return srcPort == kBgpPort || dstPort == kBgpPort;
+}
+
+uint32_t ppsLimit(RxPacketDispatcher::RxClass rxClass) {
+  switch (rxClass) {
+    case RxPacketDispatcher::RxClass::NEIGHBOR_RESOLUTION:
+      return FLAGS_rx_neighbor_resolution_pps;
+    case RxPacketDispatcher::RxClass::DEFAULT:
+      return FLAGS_rx_default_class_pps;
+    default:
+      return 0;
+  }
+}
+} // namespace
+
+RxPacketDispatcher::RxPacketDispatcher(SwSwitch* sw, PacketHandler handler)
+    : sw_(sw), handler_(std::move(handler)) {
+  for (size_t i = 0; i < kNumClasses; ++i) {
+    queues_[i] =
+        std::make_unique<folly::MPMCQueue<std::unique_ptr<RxPacket>>>(
+            FLAGS_rx_dispatch_queue_size);
+    if (auto pps = ppsLimit(static_cast<RxClass>(i))) {
+      rateLimits_[i] = std::make_unique<folly::TokenBucket>(pps, pps);
+    }
+  }
+}
+
+RxPacketDispatcher::~RxPacketDispatcher() {
+  stop();
+}
+
+void RxPacketDispatcher::start() {
+  CHECK(!dispatchThread_);
+  dispatchThread_ = std::make_unique<std::thread>([this] {
+    initThread("fbossRxDispatchThread");
+    dispatchLoop();
+  });
+}
+
+void RxPacketDispatcher::stop() {
+  if (!dispatchThread_) {
+    return;
+  }
+  stopping_ = true;
+  pending_.post();
+  dispatchThread_->join();
+  dispatchThread_.reset();
+}
+
+bool RxPacketDispatcher::enqueue(std::unique_ptr<RxPacket> pkt) {
+  auto rxClass = classify(pkt.get());
+  auto idx = static_cast<size_t>(rxClass);
+  if ((rateLimits_[idx] && !rateLimits_[idx]->consume(1)) ||
+      !queues_[idx]->write(std::move(pkt))) {
+    sw_->stats()->trappedPktClassDropped(rxClassName(rxClass));
+    return false;
+  }
+  pending_.post();
+  return true;
+}
+
+void RxPacketDispatcher::dispatchLoop() {
+  while (true) {
+    pending_.wait();
+    if (stopping_) {
+      return;
+    }
+    // Each post is for one queued packet, so one of the queues has a packet
+    // for us. Take it from the highest priority queue that has one.
+    std::unique_ptr<RxPacket> pkt;
+    for (auto& queue : queues_) {
+      if (queue->read(pkt)) {
+        break;
+      }
+    }
+    if (pkt) {
+      handler_(std::move(pkt));
+    }
+  }
+}
+
+RxPacketDispatcher::RxClass RxPacketDispatcher::classify(
+    const RxPacket* pkt) {
+  try {
+    folly::io::Cursor cursor(pkt->buf());
+    // Skip over destination and source MAC
+    cursor += 12;
+    auto ethertype = cursor.readBE<uint16_t>();
+    if (ethertype == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+      cursor += 2;
+      ethertype = cursor.readBE<uint16_t>();
+    }
+    switch (static_cast<ETHERTYPE>(ethertype)) {
+      case ETHERTYPE::ETHERTYPE_SLOW_PROTOCOLS:
+      case ETHERTYPE::ETHERTYPE_LLDP:
+      case ETHERTYPE::ETHERTYPE_EAPOL:
+        return RxClass::LINK_CONTROL;
+      case ETHERTYPE::ETHERTYPE_ARP:
+        return RxClass::NEIGHBOR_RESOLUTION;
+      case ETHERTYPE::ETHERTYPE_IPV4: {
+        auto headerLength = (cursor.read<uint8_t>() & 0x0f) * 4;
+        cursor += 8;
+        auto proto = static_cast<IP_PROTO>(cursor.read<uint8_t>());
+        cursor += headerLength - 10;
+        if (proto == IP_PROTO::IP_PROTO_TCP && isBgp(cursor)) {
+          return RxClass::ROUTING_CONTROL;
+        }
+        break;
+      }
+      case ETHERTYPE::ETHERTYPE_IPV6: {
+        cursor += 6;
+        auto nextHeader = static_cast<IP_PROTO>(cursor.read<uint8_t>());
+        // Hop limit, source and destination address. Packets with extension
+        // headers fall through to the default class.
+        cursor += 33;
+        if (nextHeader == IP_PROTO::IP_PROTO_TCP && isBgp(cursor)) {
+          return RxClass::ROUTING_CONTROL;
+        }
+        if (nextHeader == IP_PROTO::IP_PROTO_IPV6_ICMP) {
+          auto type = cursor.read<uint8_t>();
+          if (type >= static_cast<uint8_t>(
+                          ICMPv6Type::ICMPV6_TYPE_NDP_ROUTER_SOLICITATION) &&
+              type <= static_cast<uint8_t>(
+                          ICMPv6Type::ICMPV6_TYPE_NDP_REDIRECT_MESSAGE)) {
+            return RxClass::NEIGHBOR_RESOLUTION;
+          }
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  } catch (const std::out_of_range&) {
+    // Truncated packet, handlePacket() counts it
+  }
+  return RxClass::DEFAULT;
+}
+
+folly::StringPiece RxPacketDispatcher::rxClassName(RxClass rxClass) {
+  switch (rxClass) {
+    case RxClass::LINK_CONTROL:
+      return "link_control";
+    case RxClass::ROUTING_CONTROL:
+      return "routing_control";
+    case RxClass::NEIGHBOR_RESOLUTION:
+      return "neighbor_resolution";
+    case RxClass::DEFAULT:
+    case RxClass::NUM_CLASSES:
+      break;
+  }
+  return "default";
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,90 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MPMCQueue.h>
+#include <folly/Range.h>
+#include <folly/TokenBucket.h>
+#include <folly/synchronization/LifoSem.h>
+#include <gflags/gflags.h>
+
+#include <array>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <thread>
+
+DECLARE_bool(async_rx_dispatch);
+DECLARE_int32(rx_dispatch_queue_size);
+DECLARE_int32(rx_neighbor_resolution_pps);
+DECLARE_int32(rx_default_class_pps);
+
+namespace facebook::fboss {
+
+class RxPacket;
+class SwSwitch;
+
+/*
+ * Hands trapped packets off the HwSwitch RX callback thread to a dispatch
+ * thread, so that a burst of one kind of punted packets (e.g. ARP or TTL
+ * expired) does not delay control protocol packets behind it.
+ *
+ * Packets are put in a bounded queue per RxClass. The dispatch thread always
+ * serves the highest priority non-empty queue first. Packets arriving to a
+ * full queue, or above the rate limit of their class, are dropped and
+ * counted in the trapped.<class>.drops counter.
+ */
+class RxPacketDispatcher {
+ public:
+  // In priority order, highest first
+  enum class RxClass : uint8_t {
+    LINK_CONTROL, // LACP, LLDP, EAPOL
+    ROUTING_CONTROL, // BGP
+    NEIGHBOR_RESOLUTION, // ARP, NDP
+    DEFAULT, // everything else
+    NUM_CLASSES,
+  };
+  static constexpr auto kNumClasses = static_cast<size_t>(RxClass::NUM_CLASSES);
+
+  using PacketHandler = std::function<void(std::unique_ptr<RxPacket>)>;
+
+  RxPacketDispatcher(SwSwitch* sw, PacketHandler handler);
+  ~RxPacketDispatcher();
+
+  void start();
+  // Stops the dispatch thread, packets still queued are dropped
+  void stop();
+
+  /*
+   * Queue pkt for the dispatch thread, called on the RX callback thread.
+   * Returns false if the packet was dropped.
+   */
+  bool enqueue(std::unique_ptr<RxPacket> pkt);
+
+  static RxClass classify(const RxPacket* pkt);
+  static folly::StringPiece rxClassName(RxClass rxClass);
+
+ private:
+  void dispatchLoop();
+
+  SwSwitch* sw_;
+  PacketHandler handler_;
+  std::array<std::unique_ptr<folly::MPMCQueue<std::unique_ptr<RxPacket>>>,
+             kNumClasses>
+      queues_;
+  // Null for classes without a rate limit
+  std::array<std::unique_ptr<folly::TokenBucket>, kNumClasses> rateLimits_;
+  // Posted once per queued packet
+  folly::LifoSem pending_;
+  std::atomic<bool> stopping_{false};
+  std::unique_ptr<std::thread> dispatchThread_;
+};
+
+} // namespace facebook::fboss
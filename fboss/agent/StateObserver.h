@@ -13,12 +13,33 @@
 
 #include "fboss/agent/state/StateDelta.h"
 
+#include <string>
+#include <vector>
+
 namespace facebook::fboss {
 
 class StateObserver : public boost::noncopyable {
  public:
   virtual ~StateObserver() {}
   virtual void stateUpdated(const StateDelta& delta) = 0;
+
+  /*
+   * Observers returning true may be notified on a thread pool, concurrently
+   * with other observers, rather than on the update thread. They must not
+   * rely on running in the update thread.
+   */
+  virtual bool notifyConcurrently() const {
+    return false;
+  }
+
+  /*
+   * Names, as registered, of the observers that must be done with a state
+   * delta before this observer is notified of it. Names of observers that
+   * are not registered are ignored.
+   */
+  virtual std::vector<std::string> stateObserverDependencies() const {
+    return {};
+  }
 };
 
 } // namespace facebook::fboss
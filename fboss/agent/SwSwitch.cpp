@@ -50,6 +50,7 @@
 #include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/RouteUpdateLogger.h"
 #include "fboss/agent/RxPacket.h"
+#include "fboss/agent/RxPacketDispatcher.h"
 #include "fboss/agent/StaticL2ForNeighborObserver.h"
 #include "fboss/agent/SwSwitchRouteUpdateWrapper.h"
 #include "fboss/agent/SwitchStats.h"
@@ -84,6 +85,8 @@
 #include <folly/MapUtil.h>
 #include <folly/SocketAddress.h>
 #include <folly/String.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
 #include <folly/system/ThreadName.h>
 #include <glog/logging.h>
@@ -95,6 +98,9 @@
 #include <chrono>
 #include <condition_variable>
 #include <exception>
+#include <functional>
+#include <map>
+#include <set>
 #include <tuple>
 
 using folly::EventBase;
@@ -144,6 +150,27 @@ DEFINE_int32(
     update_phy_info_interval_s,
     10,
     "Update phy info interval in seconds");
+
+DEFINE_bool(
+    pipelined_state_updates,
+    false,
+    "Run state update functions on a separate thread, so that the next "
+    "batch of updates is prepared while the previous one is programmed to HW "
+    "and observers are notified of it on the update thread");
+
+DEFINE_int32(
+    state_update_pipeline_depth,
+    1,
+    "With pipelined_state_updates, the number of prepared batches of state "
+    "updates that may be queued for the update thread, including the one "
+    "being programmed");
+
+DEFINE_int32(
+    state_observer_threads,
+    0,
+    "Number of threads used to notify state observers that allow it "
+    "concurrently. 0, the default, notifies all observers on the update "
+    "thread");
 namespace {
 
 /**
@@ -223,6 +250,17 @@ SwSwitch::SwSwitch(std::unique_ptr<Platform> platform)
   // don't exist already.
   utilCreateDir(platform_->getVolatileStateDir());
   utilCreateDir(platform_->getPersistentStateDir());
+  if (FLAGS_state_observer_threads > 0) {
+    stateObserverExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_state_observer_threads,
+        std::make_shared<folly::NamedThreadFactory>("StateObserver"));
+  }
+  if (FLAGS_async_rx_dispatch) {
+    rxPacketDispatcher_ = std::make_unique<RxPacketDispatcher>(
+        this, [this](std::unique_ptr<RxPacket> pkt) {
+          handlePacketNoThrow(std::move(pkt));
+        });
+  }
 }
 
 SwSwitch::~SwSwitch() {
@@ -243,6 +281,10 @@ void SwSwitch::stop(bool revertToMinAlpmState) {
   // After this we should no longer receive packets or link state changed events
   // while we are destroying ourselves
   hw_->unregisterCallbacks();
+  // Drop trapped packets still queued for handling
+  if (rxPacketDispatcher_) {
+    rxPacketDispatcher_->stop();
+  }
 
   // Stop tunMgr so we don't get any packets to process
   // in software that were sent to the switch ip or were
@@ -816,6 +858,7 @@ void SwSwitch::removeStateObserver(StateObserver* observer) {
   if (!nErased) {
     throw FbossError("State observer remove failed: observer does not exist");
   }
+  stateObserverLevels_ = computeStateObserverLevels();
 }
 
 void SwSwitch::addStateObserver(StateObserver* observer, const string& name) {
@@ -824,6 +867,56 @@ void SwSwitch::addStateObserver(StateObserver* observer, const string& name) {
     throw FbossError("State observer add failed: ", name, " already exists");
   }
   stateObservers_.emplace(observer, name);
+  try {
+    stateObserverLevels_ = computeStateObserverLevels();
+  } catch (const FbossError&) {
+    stateObservers_.erase(observer);
+    throw;
+  }
+}
+
+std::vector<std::vector<StateObserver*>> SwSwitch::computeStateObserverLevels()
+    const {
+  std::map<std::string, StateObserver*> nameToObserver;
+  for (const auto& [observer, name] : stateObservers_) {
+    nameToObserver.emplace(name, observer);
+  }
+  // Level of an observer is 0 without (registered) dependencies, else one
+  // more than the highest level of its dependencies
+  std::map<StateObserver*, int> levels;
+  std::set<StateObserver*> visiting;
+  std::function<int(StateObserver*)> level = [&](StateObserver* observer) {
+    auto it = levels.find(observer);
+    if (it != levels.end()) {
+      return it->second;
+    }
+    if (!visiting.insert(observer).second) {
+      throw FbossError(
+          "State observer ",
+          stateObservers_.at(observer),
+          " has a circular dependency");
+    }
+    auto observerLevel = 0;
+    for (const auto& dependency : observer->stateObserverDependencies()) {
+      auto dit = nameToObserver.find(dependency);
+      if (dit != nameToObserver.end()) {
+        observerLevel = std::max(observerLevel, level(dit->second) + 1);
+      }
+    }
+    visiting.erase(observer);
+    levels.emplace(observer, observerLevel);
+    return observerLevel;
+  };
+
+  std::vector<std::vector<StateObserver*>> observerLevels;
+  for (const auto& observerAndName : stateObservers_) {
+    auto observerLevel = level(observerAndName.first);
+    if (observerLevels.size() <= static_cast<size_t>(observerLevel)) {
+      observerLevels.resize(observerLevel + 1);
+    }
+    observerLevels[observerLevel].push_back(observerAndName.first);
+  }
+  return observerLevels;
 }
 
 void SwSwitch::notifyStateObservers(const StateDelta& delta) {
@@ -832,18 +925,48 @@ void SwSwitch::notifyStateObservers(const StateDelta& delta) {
     // Make sure the SwSwitch is not already being destroyed
     return;
   }
-  for (auto observerName : stateObservers_) {
-    try {
-      auto observer = observerName.first;
-      observer->stateUpdated(delta);
-    } catch (const std::exception& ex) {
-      // TODO: Figure out the best way to handle errors here.
-      XLOG(FATAL) << "error notifying " << observerName.second
-                  << " of update: " << folly::exceptionStr(ex);
+  // Observers that allow it are notified on stateObserverExecutor_, the
+  // others on this thread while those run. All observers of a level are done
+  // before the next level is notified, and all of them before we return, so
+  // that observers never see deltas out of order.
+  std::vector<folly::Future<folly::Unit>> notified;
+  for (const auto& observers : stateObserverLevels_) {
+    notified.clear();
+    for (auto observer : observers) {
+      if (stateObserverExecutor_ && observer->notifyConcurrently()) {
+        notified.push_back(
+            folly::via(stateObserverExecutor_.get(), [this, observer, &delta] {
+              notifyStateObserver(observer, delta);
+            }));
+      }
     }
+    for (auto observer : observers) {
+      if (!stateObserverExecutor_ || !observer->notifyConcurrently()) {
+        notifyStateObserver(observer, delta);
+      }
+    }
+    folly::collectAll(notified.begin(), notified.end()).wait();
   }
 }
 
+void SwSwitch::notifyStateObserver(
+    StateObserver* observer,
+    const StateDelta& delta) {
+  const auto& name = stateObservers_.at(observer);
+  auto start = std::chrono::steady_clock::now();
+  try {
+    observer->stateUpdated(delta);
+  } catch (const std::exception& ex) {
+    // TODO: Figure out the best way to handle errors here.
+    XLOG(FATAL) << "error notifying " << name
+                << " of update: " << folly::exceptionStr(ex);
+  }
+  stats()->stateObserverUpdate(
+      name,
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start));
+}
+
 bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
   if (isExiting()) {
     XLOG(DBG2) << " Skipped queuing update: " << update->getName()
@@ -853,12 +976,16 @@ bool SwSwitch::updateState(unique_ptr<StateUpdate> update) {
   {
     std::unique_lock guard(pendingUpdatesLock_);
     pendingUpdates_.push_back(*update.release());
+    ++numPendingUpdates_;
   }
 
-  // Signal the update thread that updates are pending.
+  // Signal the update thread (or in pipelined mode, the thread preparing
+  // updates for it) that updates are pending.
   // We call runInEventBaseThread() with a static function pointer since this
   // is more efficient than having to allocate a new bound function object.
-  updateEventBase_.runInEventBaseThread(handlePendingUpdatesHelper, this);
+  auto* evb = pipelinedStateUpdates_ ? &stateUpdatePrepareEventBase_
+                                     : &updateEventBase_;
+  evb->runInEventBaseThread(handlePendingUpdatesHelper, this);
   return true;
 }
 
@@ -907,6 +1034,76 @@ void SwSwitch::handlePendingUpdatesHelper(SwSwitch* sw) {
 }
 
 void SwSwitch::handlePendingUpdates() {
+  auto updates = getPendingUpdates();
+  // handlePendingUpdates() is invoked once for each update, but a previous
+  // call might have already processed everything.  If we don't have anything
+  // to do just return early.
+  if (updates.empty()) {
+    return;
+  }
+  // The final drain of updates on exit happens once the update thread is
+  // gone, so always runs both stages here
+  if (!pipelinedStateUpdates_ || isExiting()) {
+    auto oldAppliedState = getState();
+    auto newDesiredState = prepareUpdates(&updates, oldAppliedState);
+    programUpdates(&updates, oldAppliedState, newDesiredState);
+    return;
+  }
+
+  // Pipelined mode: we are on the prepare thread, while the update thread
+  // programs previously prepared updates. Build on the last prepared state,
+  // or on the applied state once nothing is left to program. HW failure
+  // protected updates are the only ones whose programming may fail without
+  // being fatal, so they are only prepared and programmed with nothing else
+  // in flight, and nothing is prepared on top of them until they are done.
+  // That way a failure never leaves prepared states to rebase.
+  auto hwFailureProtected = updates.begin()->hwFailureProtected();
+  // Wait until at most maxInFlight prepared updates are still to be
+  // programmed, and return how many are
+  auto waitForProgramming = [this](int maxInFlight) {
+    std::unique_lock guard(pipelineLock_);
+    pipelineCv_.wait(guard, [this, maxInFlight] {
+      return numUpdatesProgramming_ <= maxInFlight || isExiting();
+    });
+    return numUpdatesProgramming_;
+  };
+  int inFlight;
+  if (hwFailureProtected) {
+    inFlight = waitForProgramming(0);
+  } else {
+    std::unique_lock guard(pipelineLock_);
+    inFlight = numUpdatesProgramming_;
+  }
+  auto oldDesiredState = inFlight ? lastPreparedState_ : getState();
+  auto newDesiredState = prepareUpdates(&updates, oldDesiredState);
+  lastPreparedState_ = newDesiredState;
+
+  auto stallStart = std::chrono::steady_clock::now();
+  waitForProgramming(std::max(FLAGS_state_update_pipeline_depth, 1) - 1);
+  stats()->stateUpdatePipelineStall(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - stallStart));
+  {
+    std::unique_lock guard(pipelineLock_);
+    ++numUpdatesProgramming_;
+  }
+  auto preparedUpdates = std::make_shared<StateUpdateList>();
+  preparedUpdates->splice(preparedUpdates->begin(), updates);
+  updateEventBase_.runInEventBaseThread(
+      [this, preparedUpdates, oldDesiredState, newDesiredState]() {
+        programUpdates(preparedUpdates.get(), oldDesiredState, newDesiredState);
+        {
+          std::unique_lock guard(pipelineLock_);
+          --numUpdatesProgramming_;
+        }
+        pipelineCv_.notify_all();
+      });
+  if (hwFailureProtected) {
+    waitForProgramming(0);
+  }
+}
+
+SwSwitch::StateUpdateList SwSwitch::getPendingUpdates() {
   // Get the list of updates to run.
   //
   // We might pull multiple updates off the list at once if several updates
@@ -914,8 +1111,10 @@ void SwSwitch::handlePendingUpdates() {
   // might also end up finding 0 updates to process if a previous
   // handlePendingUpdates() call processed multiple updates.
   StateUpdateList updates;
+  size_t queueDepth;
   {
     std::unique_lock guard(pendingUpdatesLock_);
+    queueDepth = numPendingUpdates_;
     // When deciding how many elements to pull off the pendingUpdates_
     // list, we pull as many as we can, subject to the following conditions
     // - Non coalescing updates are executed by themselves
@@ -927,6 +1126,7 @@ void SwSwitch::handlePendingUpdates() {
           // First update is non coalescing, splice it onto the updates list
           // and apply transaction by itself
           ++iter;
+          --numPendingUpdates_;
           break;
         } else {
           // Splice all updates upto this non coalescing update, we will
@@ -935,25 +1135,27 @@ void SwSwitch::handlePendingUpdates() {
         }
       }
       ++iter;
+      --numPendingUpdates_;
     }
     updates.splice(
         updates.begin(), pendingUpdates_, pendingUpdates_.begin(), iter);
   }
-
-  // handlePendingUpdates() is invoked once for each update, but a previous
-  // call might have already processed everything.  If we don't have anything
-  // to do just return early.
-  if (updates.empty()) {
-    return;
+  if (!updates.empty()) {
+    stats()->stateUpdateQueueDepth(queueDepth);
   }
+  return updates;
+}
 
+std::shared_ptr<SwitchState> SwSwitch::prepareUpdates(
+    StateUpdateList* updates,
+    const std::shared_ptr<SwitchState>& oldState) {
   // Non coalescing updates should be applied individually
-  bool isNonCoalescing = updates.begin()->isNonCoalescing();
+  bool isNonCoalescing = updates->begin()->isNonCoalescing();
   if (isNonCoalescing) {
-    CHECK_EQ(updates.size(), 1)
+    CHECK_EQ(updates->size(), 1)
         << " Non coalescing updates should be applied individually";
   }
-  if (updates.begin()->hwFailureProtected()) {
+  if (updates->begin()->hwFailureProtected()) {
     CHECK(isNonCoalescing)
         << " Hw Failure protected updates should be non coalescing";
   }
@@ -962,12 +1164,12 @@ void SwSwitch::handlePendingUpdates() {
   // not initialized yet
   DCHECK(isInitialized());
 
+  auto start = std::chrono::steady_clock::now();
   // Call all of the update functions to prepare the new SwitchState
-  auto oldAppliedState = getState();
   // We start with the old state, and apply state updates one at a time.
-  auto newDesiredState = oldAppliedState;
-  auto iter = updates.begin();
-  while (iter != updates.end()) {
+  auto newDesiredState = oldState;
+  auto iter = updates->begin();
+  while (iter != updates->end()) {
     StateUpdate* update = &(*iter);
     ++iter;
 
@@ -994,12 +1196,22 @@ void SwSwitch::handlePendingUpdates() {
       newDesiredState = intermediateState;
     }
   }
+  stats()->stateUpdatePrepare(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start));
+  return newDesiredState;
+}
+
+void SwSwitch::programUpdates(
+    StateUpdateList* updates,
+    const std::shared_ptr<SwitchState>& oldAppliedState,
+    const std::shared_ptr<SwitchState>& newDesiredState) {
   // Start newAppliedState as equal to newDesiredState unless
   // we learn otherwise
   auto newAppliedState = newDesiredState;
   // Now apply the update and notify subscribers
   if (newDesiredState != oldAppliedState) {
-    auto isTransaction = updates.begin()->hwFailureProtected() &&
+    auto isTransaction = updates->begin()->hwFailureProtected() &&
         getHw()->transactionsSupported();
     // There was some change during these state updates
     newAppliedState =
@@ -1023,9 +1235,10 @@ void SwSwitch::handlePendingUpdates() {
          */
         XLOG(DBG2) << " Failed to apply updates to HW since SwSwtich already "
                       "started exit";
-      } else if (updates.size() == 1 && updates.begin()->hwFailureProtected()) {
+      } else if (
+          updates->size() == 1 && updates->begin()->hwFailureProtected()) {
         fb303::fbData->incrementCounter(kHwUpdateFailures);
-        unique_ptr<StateUpdate> update(&updates.front());
+        unique_ptr<StateUpdate> update(&updates->front());
         try {
           throw FbossHwUpdateError(
               newDesiredState,
@@ -1047,9 +1260,9 @@ void SwSwitch::handlePendingUpdates() {
   }
   updatePtpTcCounter();
   // Notify all of the updates of success and delete them.
-  while (!updates.empty()) {
-    unique_ptr<StateUpdate> update(&updates.front());
-    updates.pop_front();
+  while (!updates->empty()) {
+    unique_ptr<StateUpdate> update(&updates->front());
+    updates->pop_front();
     update->onSuccess();
   }
 }
@@ -1076,6 +1289,13 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
     const shared_ptr<SwitchState>& oldState,
     const shared_ptr<SwitchState>& newState,
     bool isTransaction) {
+  // If we are already exiting, abort the update. With pipelined updates,
+  // oldState may then also be a prepared state that was never applied.
+  if (isExiting()) {
+    XLOG(DBG2) << " Agent exiting before all updates could be applied";
+    return oldState;
+  }
+
   // Check that we are starting from what has been already applied
   DCHECK_EQ(oldState, getAppliedState());
 
@@ -1086,12 +1306,6 @@ std::shared_ptr<SwitchState> SwSwitch::applyUpdate(
 
   StateDelta delta(oldState, newState);
 
-  // If we are already exiting, abort the update
-  if (isExiting()) {
-    XLOG(DBG2) << " Agent exiting before all updates could be applied";
-    return oldState;
-  }
-
   std::shared_ptr<SwitchState> newAppliedState;
 
   // Inform the HwSwitch of the change.
@@ -1228,6 +1442,14 @@ void SwSwitch::setPortStatusCounter(PortID port, bool up) {
 }
 
 void SwSwitch::packetReceived(std::unique_ptr<RxPacket> pkt) noexcept {
+  if (rxPacketDispatcher_) {
+    rxPacketDispatcher_->enqueue(std::move(pkt));
+    return;
+  }
+  handlePacketNoThrow(std::move(pkt));
+}
+
+void SwSwitch::handlePacketNoThrow(std::unique_ptr<RxPacket> pkt) noexcept {
   PortID port = pkt->getSrcPort();
   try {
     handlePacket(std::move(pkt));
@@ -1420,6 +1642,12 @@ void SwSwitch::startThreads() {
       [=] { this->threadLoop("fbossBgThread", &backgroundEventBase_); }));
   updateThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossUpdateThread", &updateEventBase_); }));
+  if (pipelinedStateUpdates_) {
+    stateUpdatePrepareThread_.reset(new std::thread([=] {
+      this->threadLoop(
+          "fbossStateUpdatePrepareThread", &stateUpdatePrepareEventBase_);
+    }));
+  }
   packetTxThread_.reset(new std::thread(
       [=] { this->threadLoop("fbossPktTxThread", &packetTxEventBase_); }));
   pcapDistributionThread_.reset(new std::thread([=] {
@@ -1429,6 +1657,9 @@ void SwSwitch::startThreads() {
   neighborCacheThread_.reset(new std::thread([=] {
     this->threadLoop("fbossNeighborCacheThread", &neighborCacheEventBase_);
   }));
+  if (rxPacketDispatcher_) {
+    rxPacketDispatcher_->start();
+  }
 }
 
 void SwSwitch::stopThreads() {
@@ -1438,6 +1669,18 @@ void SwSwitch::stopThreads() {
   //
   // Alternatively, it would be nicer to update EventBase so it can notify
   // callbacks when the event loop is being stopped.
+  // Stop preparing updates before stopping the update thread, so that all
+  // prepared updates get to the update thread and are signalled there
+  if (stateUpdatePrepareThread_) {
+    stateUpdatePrepareEventBase_.runInEventBaseThread(
+        [this] { stateUpdatePrepareEventBase_.terminateLoopSoon(); });
+    {
+      // Wake up the prepare thread if it is waiting on the update thread
+      std::unique_lock guard(pipelineLock_);
+    }
+    pipelineCv_.notify_all();
+    stateUpdatePrepareThread_->join();
+  }
   if (backgroundThread_) {
     backgroundEventBase_.runInEventBaseThread(
         [this] { backgroundEventBase_.terminateLoopSoon(); });
@@ -1811,6 +2054,7 @@ void SwSwitch::applyConfig(
   // We don't need to hold a lock here. updateStateBlocking() does that for us.
   auto routeUpdater = getRouteUpdater();
   auto oldConfig = getConfig();
+  std::shared_ptr<SwitchState> configAppliedState;
   updateStateBlocking(
       reason,
       [&](const shared_ptr<SwitchState>& state) -> shared_ptr<SwitchState> {
@@ -1832,18 +2076,29 @@ void SwSwitch::applyConfig(
           XLOG(WARN) << "Current platform doesn't have QsfpCache. "
                      << "No need to build TransceiverMap";
         }
+        // Only skip sections unchanged since curConfig_ when state is known
+        // to have been built from it, and only those whose part of state was
+        // not modified outside of config since
+        auto prevConfigState = curConfigAppliedState_.exchange(nullptr);
+        auto prevConfig = prevConfigState ? &curConfig_ : nullptr;
         auto newState = rib_ ? applyThriftConfig(
                                    originalState,
                                    &newConfig,
                                    getPlatform(),
                                    &routeUpdater,
-                                   aclNexthopHandler_.get())
+                                   aclNexthopHandler_.get(),
+                                   prevConfig,
+                                   prevConfigState,
+                                   stats())
                              : applyThriftConfig(
                                    originalState,
                                    &newConfig,
                                    getPlatform(),
                                    (RoutingInformationBase*)nullptr,
-                                   aclNexthopHandler_.get());
+                                   aclNexthopHandler_.get(),
+                                   prevConfig,
+                                   prevConfigState,
+                                   stats());
 
         if (newState && !isValidStateUpdate(StateDelta(state, newState))) {
           throw FbossError("Invalid config passed in, skipping");
@@ -1860,12 +2115,15 @@ void SwSwitch::applyConfig(
           // if config is not updated, the new state will return null
           // in such a case return here, to prevent possible crash.
           XLOG(WARNING) << "Applying config did not cause state change";
+          configAppliedState = state;
           return nullptr;
         }
+        configAppliedState = newState;
         return newState;
       });
   // Since we're using blocking state update, once we reach here, the new config
   // should be already applied and programmed into hardware.
+  curConfigAppliedState_ = configAppliedState;
   updateConfigAppliedInfo();
 
   /*
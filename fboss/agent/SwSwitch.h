@@ -28,16 +28,22 @@
 #include <folly/Range.h>
 #include <folly/SpinLock.h>
 #include <folly/ThreadLocal.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/io/async/EventBase.h>
 #include <optional>
 
 #include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <memory>
 #include <mutex>
 #include <thread>
 #include <type_traits>
 
+DECLARE_bool(pipelined_state_updates);
+DECLARE_int32(state_update_pipeline_depth);
+DECLARE_int32(state_observer_threads);
+
 namespace facebook::fboss {
 
 class ArpHandler;
@@ -54,6 +60,7 @@ class PortDescriptor;
 class PortStats;
 class PortUpdateHandler;
 class RxPacket;
+class RxPacketDispatcher;
 class SwitchState;
 class SwitchStats;
 class StateDelta;
@@ -820,10 +827,19 @@ class SwSwitch : public HwSwitch::Callback {
   void setSwitchRunState(SwitchRunState desiredState);
   SwitchStats* createSwitchStats();
   void handlePacket(std::unique_ptr<RxPacket> pkt);
+  void handlePacketNoThrow(std::unique_ptr<RxPacket> pkt) noexcept;
 
   void updatePtpTcCounter();
   static void handlePendingUpdatesHelper(SwSwitch* sw);
   void handlePendingUpdates();
+  StateUpdateList getPendingUpdates();
+  std::shared_ptr<SwitchState> prepareUpdates(
+      StateUpdateList* updates,
+      const std::shared_ptr<SwitchState>& oldState);
+  void programUpdates(
+      StateUpdateList* updates,
+      const std::shared_ptr<SwitchState>& oldAppliedState,
+      const std::shared_ptr<SwitchState>& newDesiredState);
   std::shared_ptr<SwitchState> applyUpdate(
       const std::shared_ptr<SwitchState>& oldState,
       const std::shared_ptr<SwitchState>& newState,
@@ -840,6 +856,7 @@ class SwSwitch : public HwSwitch::Callback {
   bool stateObserverRegistered(StateObserver* observer);
   void addStateObserver(StateObserver* observer, const std::string& name);
   void removeStateObserver(StateObserver* observer);
+  std::vector<std::vector<StateObserver*>> computeStateObserverLevels() const;
 
   /*
    * File where switch state gets dumped on exit
@@ -854,6 +871,7 @@ class SwSwitch : public HwSwitch::Callback {
    * Notifies all the observers that a state update occured.
    */
   void notifyStateObservers(const StateDelta& delta);
+  void notifyStateObserver(StateObserver* observer, const StateDelta& delta);
 
   void logLinkStateEvent(PortID port, bool up);
 
@@ -870,6 +888,10 @@ class SwSwitch : public HwSwitch::Callback {
 
   std::string curConfigStr_;
   cfg::SwitchConfig curConfig_;
+  // State last built from curConfig_. Config sections unchanged since
+  // curConfig_ whose part of state is also unchanged since this state need
+  // not be applied again. Reset while a config is being applied.
+  folly::Synchronized<std::shared_ptr<SwitchState>> curConfigAppliedState_;
 
   // The HwSwitch object.  This object is owned by the Platform.
   HwSwitch* hw_;
@@ -887,6 +909,23 @@ class SwSwitch : public HwSwitch::Callback {
    */
   folly::SpinLock pendingUpdatesLock_;
   StateUpdateList pendingUpdates_;
+  size_t numPendingUpdates_{0};
+
+  /*
+   * With pipelined_state_updates, update functions run on the prepare
+   * thread, which hands the resulting states to the update thread to be
+   * programmed to HW and notified to observers.
+   */
+  const bool pipelinedStateUpdates_{FLAGS_pipelined_state_updates};
+  std::unique_ptr<std::thread> stateUpdatePrepareThread_;
+  folly::EventBase stateUpdatePrepareEventBase_;
+  // Last state handed to the update thread, only accessed by the prepare
+  // thread
+  std::shared_ptr<SwitchState> lastPreparedState_;
+  // Number of prepared batches of updates not yet done on the update thread
+  std::mutex pipelineLock_;
+  std::condition_variable pipelineCv_;
+  int numUpdatesProgramming_{0};
 
   /*
    * The current switch state represented as :  appliedState,
@@ -969,7 +1008,18 @@ class SwSwitch : public HwSwitch::Callback {
    * locking when we access the container during a state update.
    */
   std::map<StateObserver*, std::string> stateObservers_;
+  /*
+   * stateObservers_ grouped so that observers only depend on observers in
+   * earlier groups. Observers in the same group are notified concurrently if
+   * they allow it.
+   */
+  std::vector<std::vector<StateObserver*>> stateObserverLevels_;
+  // Notifies observers concurrently, null if state_observer_threads is 0
+  std::unique_ptr<folly::CPUThreadPoolExecutor> stateObserverExecutor_;
   std::unique_ptr<PacketObservers> pktObservers_;
+  // Handles trapped packets off the RX thread, null if async_rx_dispatch is
+  // not set
+  std::unique_ptr<RxPacketDispatcher> rxPacketDispatcher_;
 
   std::unique_ptr<ArpHandler> arp_;
   std::unique_ptr<IPv4Handler> ipv4_;
@@ -26,9 +26,10 @@ std::shared_ptr<SwitchState> swSwitchFibUpdate(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const facebook::fboss::RibToFibDelta* ribToFibDelta,
     void* cookie) {
   facebook::fboss::ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute, ribToFibDelta);
 
   auto sw = static_cast<facebook::fboss::SwSwitch*>(cookie);
   sw->updateStateWithHwFailureProtection("update fib", std::move(fibUpdater));
@@ -29,7 +29,8 @@ SwitchStats::SwitchStats()
     : SwitchStats(fb303::ThreadCachedServiceData::get()->getThreadStats()) {}
 
 SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
-    : trapPkts_(map, kCounterPrefix + "trapped.pkts", SUM, RATE),
+    : map_(map),
+      trapPkts_(map, kCounterPrefix + "trapped.pkts", SUM, RATE),
       trapPktDrops_(map, kCounterPrefix + "trapped.drops", SUM, RATE),
       trapPktBogus_(map, kCounterPrefix + "trapped.bogus", SUM, RATE),
       trapPktErrors_(map, kCounterPrefix + "trapped.error", SUM, RATE),
@@ -83,6 +84,27 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           SUM,
           RATE),
       updateState_(map, kCounterPrefix + "state_update.us", 50000, 0, 1000000),
+      updateStatePrepare_(
+          map,
+          kCounterPrefix + "state_update_prepare.us",
+          50000,
+          0,
+          1000000),
+      updateStatePipelineStall_(
+          map,
+          kCounterPrefix + "state_update_pipeline_stall.us",
+          50000,
+          0,
+          1000000),
+      updateStateQueueDepth_(
+          map,
+          kCounterPrefix + "state_update_queue_depth",
+          1,
+          0,
+          200,
+          AVG,
+          50,
+          100),
       routeUpdate_(map, kCounterPrefix + "route_update.us", 50, 0, 500),
       bgHeartbeatDelay_(
           map,
@@ -174,6 +196,24 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           AVG,
           50,
           100),
+      macLearningBatchSize_(
+          map,
+          kCounterPrefix + "mac_learning_batch_size",
+          16,
+          0,
+          4096,
+          AVG,
+          50,
+          100),
+      macLearningQueueDelay_(
+          map,
+          kCounterPrefix + "mac_learning_queue_delay.us",
+          1000,
+          0,
+          1000000,
+          AVG,
+          50,
+          100),
       linkStateChange_(map, kCounterPrefix + "link_state.flap", SUM),
       pcapDistFailure_(map, kCounterPrefix + "pcap_dist_failure.error"),
       updateStatsExceptions_(
@@ -239,6 +279,61 @@ SwitchStats::SwitchStats(ThreadLocalStatsMap* map)
           kCounterPrefix + "thread_heartbeat_miss",
           SUM) {}
 
+void SwitchStats::stateObserverUpdate(
+    const std::string& observer,
+    std::chrono::microseconds us) {
+  auto it = stateObserverUpdate_.find(observer);
+  if (it == stateObserverUpdate_.end()) {
+    it = stateObserverUpdate_
+             .emplace(
+                 observer,
+                 std::make_unique<TLHistogram>(
+                     map_,
+                     kCounterPrefix + "state_observer." + observer + ".us",
+                     1000,
+                     0,
+                     1000000))
+             .first;
+  }
+  it->second->addValue(us.count());
+}
+
+void SwitchStats::configSectionApply(
+    const std::string& section,
+    std::chrono::microseconds us) {
+  auto it = configSectionApply_.find(section);
+  if (it == configSectionApply_.end()) {
+    it = configSectionApply_
+             .emplace(
+                 section,
+                 std::make_unique<TLHistogram>(
+                     map_,
+                     kCounterPrefix + "config_apply." + section + ".us",
+                     1000,
+                     0,
+                     1000000))
+             .first;
+  }
+  it->second->addValue(us.count());
+}
+
+void SwitchStats::trappedPktClassDropped(folly::StringPiece rxClass) {
+  auto it = trapPktClassDrops_.find(rxClass);
+  if (it == trapPktClassDrops_.end()) {
+    it = trapPktClassDrops_
+             .emplace(
+                 rxClass.str(),
+                 std::make_unique<TLTimeseries>(
+                     map_,
+                     kCounterPrefix + "trapped." + rxClass.str() + ".drops",
+                     SUM,
+                     RATE))
+             .first;
+  }
+  it->second->addValue(1);
+  trapPktDrops_.addValue(1);
+}
+
 PortStats* FOLLY_NULLABLE SwitchStats::port(PortID portID) {
   auto it = ports_.find(portID);
   if (it != ports_.end()) {
@@ -13,7 +13,9 @@
 #include <boost/noncopyable.hpp>
 #include <fb303/ThreadCachedServiceData.h>
 #include <fb303/detail/QuantileStatWrappers.h>
+#include <folly/container/F14Map.h>
 #include <chrono>
+#include <unordered_map>
 #include "fboss/agent/AggregatePortStats.h"
 #include "fboss/agent/InterfaceStats.h"
 #include "fboss/agent/PortStats.h"
@@ -104,6 +106,8 @@ class SwitchStats : public boost::noncopyable {
     trapPktUnhandled_.addValue(1);
     trapPktDrops_.addValue(1);
   }
+  // Dropped by RxPacketDispatcher, the queue or rate limit of rxClass was full
+  void trappedPktClassDropped(folly::StringPiece rxClass);
   void pktToHost(uint32_t bytes) {
     trapPktToHost_.addValue(1);
     trapPktToHostBytes_.addValue(bytes);
@@ -249,6 +253,26 @@ class SwitchStats : public boost::noncopyable {
     updateState_.addValue(us.count());
   }
 
+  void stateUpdatePrepare(std::chrono::microseconds us) {
+    updateStatePrepare_.addValue(us.count());
+  }
+
+  void stateUpdatePipelineStall(std::chrono::microseconds us) {
+    updateStatePipelineStall_.addValue(us.count());
+  }
+
+  void stateUpdateQueueDepth(int depth) {
+    updateStateQueueDepth_.addValue(depth);
+  }
+
+  void stateObserverUpdate(
+      const std::string& observer,
+      std::chrono::microseconds us);
+
+  void configSectionApply(
+      const std::string& section,
+      std::chrono::microseconds us);
+
   void routeUpdate(std::chrono::microseconds us, uint64_t routes) {
     // As syncFib() could include no routes.
     if (routes == 0) {
@@ -298,6 +322,11 @@ class SwitchStats : public boost::noncopyable {
     neighborCacheEventBacklog_.addValue(value);
   }
 
+  void macLearningBatch(int size, std::chrono::microseconds queueDelay) {
+    macLearningBatchSize_.addValue(size);
+    macLearningQueueDelay_.addValue(queueDelay.count());
+  }
+
   void linkStateChange() {
     linkStateChange_.addValue(1);
   }
@@ -382,6 +411,9 @@ class SwitchStats : public boost::noncopyable {
 
   explicit SwitchStats(ThreadLocalStatsMap* map);
 
+  // Holds the stats created on first use below
+  ThreadLocalStatsMap* map_;
+
   // Total number of trapped packets
   TLTimeseries trapPkts_;
   // Number of trapped packets that were intentionally dropped.
@@ -480,6 +512,44 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram updateState_;
 
+  /**
+   * Histogram for time used to run the functions of a batch of state updates
+   * (in microseconds)
+   */
+  TLHistogram updateStatePrepare_;
+
+  /**
+   * Histogram for time a prepared batch of state updates waits for earlier
+   * ones to be programmed, with pipelined state updates (in microseconds)
+   */
+  TLHistogram updateStatePipelineStall_;
+
+  /**
+   * Number of pending state updates when a batch is pulled off the queue
+   */
+  TLHistogram updateStateQueueDepth_;
+
+  /**
+   * Histograms for time used by each StateObserver to process a state update
+   * (in microseconds), created on first use
+   */
+  std::unordered_map<std::string, std::unique_ptr<TLHistogram>>
+      stateObserverUpdate_;
+
+  /**
+   * Histograms for time used to apply each section of a changed config
+   * (in microseconds), created on first use
+   */
+  std::unordered_map<std::string, std::unique_ptr<TLHistogram>>
+      configSectionApply_;
+
+  /**
+   * Trapped packets dropped by RxPacketDispatcher per packet class, created on
+   * first use
+   */
+  folly::F14FastMap<std::string, std::unique_ptr<TLTimeseries>>
+      trapPktClassDrops_;
+
   /**
    * Histogram for time used for route update (in microsecond)
    */
@@ -527,6 +597,17 @@ class SwitchStats : public boost::noncopyable {
    */
   TLHistogram neighborCacheEventBacklog_;
 
+  /**
+   * Number of L2 learning updates applied in a single state update
+   */
+  TLHistogram macLearningBatchSize_;
+
+  /**
+   * Time from an L2 learning update being queued to its batch being applied
+   * (in microseconds)
+   */
+  TLHistogram macLearningQueueDelay_;
+
   /**
    * Link state up/down change count
    */
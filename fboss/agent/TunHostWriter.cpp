@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/TunHostWriter.h"
+
+#include "fboss/agent/RxPacket.h"
+#include "fboss/agent/SysError.h"
+
+#include <fb303/ServiceData.h>
+#include <folly/logging/xlog.h>
+
+#include <unistd.h>
+#include <algorithm>
+
+namespace facebook::fboss {
+
+TunHostWriter::TunHostWriter(
+    folly::EventBase* evb,
+    int fd,
+    const std::string& counterPrefix,
+    size_t queueSize)
+    : folly::EventHandler(evb, folly::NetworkSocket::fromFd(fd)),
+      evb_(evb),
+      fd_(fd),
+      depthCounter_(counterPrefix + ".host_queue_depth"),
+      dropsCounter_(counterPrefix + ".host_queue_drops"),
+      queue_(std::max<size_t>(queueSize, 1)) {
+  DCHECK(evb) << "NULL pointer to EventBase";
+}
+
+TunHostWriter::~TunHostWriter() {
+  DCHECK(!flushScheduled_ || evb_->isInEventBaseThread());
+}
+
+bool TunHostWriter::enqueue(std::unique_ptr<RxPacket> pkt) {
+  if (!queue_.write(std::move(pkt))) {
+    fb303::fbData->incrementCounter(dropsCounter_);
+    return false;
+  }
+  scheduleFlush();
+  return true;
+}
+
+void TunHostWriter::scheduleFlush() {
+  if (flushScheduled_.exchange(true)) {
+    // The pending flush will write this packet too
+    return;
+  }
+  evb_->runInEventBaseThread([this, alive = std::weak_ptr<bool>(alive_)]() {
+    if (alive.lock()) {
+      flush();
+    }
+  });
+}
+
+size_t TunHostWriter::flush() {
+  DCHECK(evb_->isInEventBaseThread());
+  // Packets queued from now on schedule another flush. Those already queued
+  // are no more than the queue capacity, so they are all written below.
+  flushScheduled_ = false;
+  if (isHandlerRegistered()) {
+    // A posted flush got here before the fd was reported writable
+    unregisterHandler();
+  }
+  fb303::fbData->setCounter(depthCounter_, queueDepth());
+
+  size_t written = 0;
+  std::unique_ptr<RxPacket> pkt = std::move(blockedPkt_);
+  const auto maxPackets = queue_.capacity() + (pkt ? 1 : 0);
+  for (size_t i = 0; i < maxPackets && (pkt || queue_.read(pkt)); ++i) {
+    const auto buf = pkt->buf();
+    int ret = 0;
+    do {
+      ret = write(fd_, buf->data(), buf->length());
+    } while (ret == -1 && errno == EINTR);
+    if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      // The host isn't keeping up. Keep this packet and the queued ones
+      // until the fd is writable, rather than failing each of them.
+      XLOG(DBG4) << "Host queue full on fd " << fd_ << ", " << queueDepth()
+                 << " packets left queued";
+      blockedPkt_ = std::move(pkt);
+      flushScheduled_ = true;
+      registerHandler(folly::EventHandler::WRITE);
+      break;
+    }
+    if (ret < 0) {
+      sysLogError(ret, "Failed to send packet to host on fd ", fd_);
+      fb303::fbData->incrementCounter(dropsCounter_);
+    } else if (ret < buf->length()) {
+      XLOG(ERR) << "Failed to send full packet to host on fd " << fd_ << ". "
+                << ret << " bytes sent instead of " << buf->length();
+      fb303::fbData->incrementCounter(dropsCounter_);
+    } else {
+      ++written;
+    }
+    pkt.reset();
+  }
+  XLOG(DBG4) << "Sent " << written << " packets to host on fd " << fd_;
+  return written;
+}
+
+void TunHostWriter::handlerReady(uint16_t /*events*/) noexcept {
+  flush();
+}
+
+size_t TunHostWriter::queueDepth() const {
+  // size() can be transiently negative while readers wait on an empty queue
+  return std::max<ssize_t>(queue_.size(), 0);
+}
+
+} // namespace facebook::fboss
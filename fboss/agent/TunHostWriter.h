@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <folly/MPMCQueue.h>
+#include <folly/io/async/EventBase.h>
+#include <folly/io/async/EventHandler.h>
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace facebook::fboss {
+
+class RxPacket;
+
+/*
+ * Writes packets punted to the host to a tun interface fd in batches.
+ *
+ * Packets are queued from any thread and written on the thread serving evb,
+ * so the RX threads handing packets to the host don't make a write syscall
+ * per packet. A burst of packets is written from a single event base
+ * callback. Packets arriving to a full queue are dropped.
+ *
+ * When the fd can't take more packets (EAGAIN), the batch stops there and
+ * the remaining packets stay queued until the fd is writable again.
+ *
+ * evb is shared with the owner of the fd (TunManager's event base, which
+ * also runs netlink syncs), so a long sync delays host writes and may cause
+ * drops once the queue fills up. In exchange, the writer lives and dies on
+ * the same thread as its tun interface, with no extra thread per switch.
+ *
+ * The queue depth seen by each batch and the number of dropped packets are
+ * exported in the <counterPrefix>.host_queue_depth and
+ * <counterPrefix>.host_queue_drops counters.
+ *
+ * Must be destroyed on the thread serving evb, batches still to be written
+ * are then dropped.
+ */
+class TunHostWriter : private folly::EventHandler {
+ public:
+  TunHostWriter(
+      folly::EventBase* evb,
+      int fd,
+      const std::string& counterPrefix,
+      size_t queueSize);
+  ~TunHostWriter();
+
+  /*
+   * Queue the L3 packet in pkt->buf() to be written to the fd. Can be called
+   * from any thread. Returns false if the packet was dropped.
+   */
+  bool enqueue(std::unique_ptr<RxPacket> pkt);
+
+  /*
+   * Write up to one queue worth of packets to the fd, called on the thread
+   * serving evb. Returns the number of packets written.
+   */
+  size_t flush();
+
+  // The fd is writable again after a flush stopped on EAGAIN
+  void handlerReady(uint16_t events) noexcept override;
+
+  size_t queueDepth() const;
+
+ private:
+  // no copy or assign
+  TunHostWriter(const TunHostWriter&) = delete;
+  TunHostWriter& operator=(const TunHostWriter&) = delete;
+
+  void scheduleFlush();
+
+  folly::EventBase* evb_;
+  const int fd_;
+  const std::string depthCounter_;
+  const std::string dropsCounter_;
+  folly::MPMCQueue<std::unique_ptr<RxPacket>> queue_;
+  // Packet the last flush stopped at on EAGAIN, written first by the next one
+  std::unique_ptr<RxPacket> blockedPkt_;
+  // Whether a flush is posted to evb_, or waits for the fd to be writable,
+  // and is yet to run
+  std::atomic<bool> flushScheduled_{false};
+  // Posted flushes check it to not run once the writer is destroyed
+  std::shared_ptr<bool> alive_{std::make_shared<bool>(true)};
+};
+
+} // namespace facebook::fboss
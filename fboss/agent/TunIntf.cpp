@@ -28,19 +28,33 @@ extern "C" {
 #include "fboss/agent/NlError.h"
 #include "fboss/agent/RxPacket.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/SysError.h"
+#include "fboss/agent/TunHostWriter.h"
 #include "fboss/agent/TxPacket.h"
 #include "fboss/agent/packet/EthHdr.h"
 
+DEFINE_bool(
+    tun_intf_batch_io,
+    false,
+    "Queue packets sent to host on tun interfaces and write them in batches "
+    "on the tun event base thread, instead of writing each one on the thread "
+    "sending it");
+DEFINE_int32(
+    tun_intf_host_queue_size,
+    1024,
+    "Number of packets queued per tun interface with tun_intf_batch_io");
+DEFINE_int32(
+    tun_intf_read_batch_size,
+    16,
+    "Max packets read from host on a tun interface per event");
+
 namespace facebook::fboss {
 
 namespace {
 
 const std::string kTunDev = "/dev/net/tun";
 
-// Max packets to be processed which are received from host
-const int kMaxSentOneTime = 16;
-
 // Definition of `iplink_req` as it is not well defined in any header files
 struct iplink_req {
   struct nlmsghdr n;
@@ -81,6 +95,13 @@ TunIntf::TunIntf(
   SCOPE_FAIL {
     closeFD();
   };
+  if (FLAGS_tun_intf_batch_io) {
+    hostWriter_ = std::make_unique<TunHostWriter>(
+        evb,
+        fd_,
+        SwitchStats::kCounterPrefix + name_,
+        FLAGS_tun_intf_host_queue_size);
+  }
 
   // XXX: Disabling mode on existing interface so that we end up removing
   // automatically allocated v6 link local address on next release. from
@@ -114,6 +135,13 @@ TunIntf::TunIntf(
   SCOPE_FAIL {
     closeFD();
   };
+  if (FLAGS_tun_intf_batch_io) {
+    hostWriter_ = std::make_unique<TunHostWriter>(
+        evb,
+        fd_,
+        SwitchStats::kCounterPrefix + name_,
+        FLAGS_tun_intf_host_queue_size);
+  }
 
   // Make the Tun interface persistent, so that the network sessions from the
   // application (i.e. BGP)  will not be reset if controller restarts
@@ -159,6 +187,8 @@ TunIntf::TunIntf(
 
 TunIntf::~TunIntf() {
   stop();
+  // Drop packets still queued to host before closing their fd
+  hostWriter_.reset();
 
   // We must have a valid fd to TunIntf
   CHECK_NE(fd_, -1);
@@ -251,6 +281,8 @@ void TunIntf::addAddress(const folly::IPAddress& addr, uint8_t mask) {
 
 void TunIntf::setMtu(int mtu) {
   mtu_ = mtu;
+  // Allocated for the previous MTU
+  spareTxPkt_.reset();
   auto sock = socket(PF_INET, SOCK_DGRAM, 0);
   sysCheckError(sock, "Failed to open socket");
   SCOPE_EXIT {
@@ -323,9 +355,10 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
   uint64_t bytes = 0;
   bool fdFail = false;
   try {
-    while (sent + dropped < kMaxSentOneTime) {
-      std::unique_ptr<TxPacket> pkt;
-      pkt = sw_->allocateL3TxPacket(mtu_);
+    while (sent + dropped < FLAGS_tun_intf_read_batch_size) {
+      std::unique_ptr<TxPacket> pkt = spareTxPkt_
+          ? std::move(spareTxPkt_)
+          : sw_->allocateL3TxPacket(mtu_);
       auto buf = pkt->buf();
       int ret = 0;
       do {
@@ -336,6 +369,9 @@ void TunIntf::handlerReady(uint16_t /*events*/) noexcept {
           sysLogError(ret, "Failed to read on ", fd_);
           // Cannot continue read on this fd
           fdFail = true;
+        } else if (hostWriter_) {
+          // Nothing read into it, keep it for the next read
+          spareTxPkt_ = std::move(pkt);
         }
         break;
       } else if (ret == 0) {
@@ -388,6 +424,10 @@ bool TunIntf::sendPacketToHost(std::unique_ptr<RxPacket> pkt) {
   // skip L2 header
   buf->trimStart(l2Len);
 
+  if (hostWriter_) {
+    return hostWriter_->enqueue(std::move(pkt));
+  }
+
   int ret = 0;
   do {
     ret = write(fd_, buf->data(), buf->length());
@@ -11,14 +11,21 @@
 
 #include <folly/io/async/EventBase.h>
 #include <folly/io/async/EventHandler.h>
+#include <gflags/gflags.h>
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/StateUtils.h"
 #include "fboss/agent/types.h"
 
+DECLARE_bool(tun_intf_batch_io);
+DECLARE_int32(tun_intf_host_queue_size);
+DECLARE_int32(tun_intf_read_batch_size);
+
 namespace facebook::fboss {
 
 class SwSwitch;
 class RxPacket;
+class TunHostWriter;
+class TxPacket;
 
 class TunIntf : private folly::EventHandler {
  public:
@@ -87,7 +94,9 @@ class TunIntf : private folly::EventHandler {
   /**
    * Send a packet to the interface on host.
    * Unlike other methods, which are called on thread that serves the evb,
-   * this function can be called from any thread.
+   * this function can be called from any thread. With tun_intf_batch_io the
+   * packet is queued and written to the host on the thread that serves the
+   * evb.
    *
    * @return true The packet is sent to host
    *         false The packet is dropped due to errors
@@ -163,6 +172,16 @@ class TunIntf : private folly::EventHandler {
    */
   int fd_{-1};
   int mtu_{-1};
+
+  // Writes packets to host in batches, set with tun_intf_batch_io only
+  std::unique_ptr<TunHostWriter> hostWriter_;
+
+  /**
+   * With tun_intf_batch_io, packet allocated for a read from host which found
+   * nothing to read, to be used by the next read instead of allocating
+   * another one.
+   */
+  std::unique_ptr<TxPacket> spareTxPkt_;
 };
 
 } // namespace facebook::fboss
@@ -27,13 +27,17 @@ extern "C" {
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/SysError.h"
 #include "fboss/agent/TunIntf.h"
+#include "fboss/agent/state/DeltaFunctions.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/InterfaceMap.h"
 #include "fboss/agent/state/Port.h"
 #include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
 
 #include <boost/container/flat_set.hpp>
 
+#include <shared_mutex>
+
 namespace {
 const int kDefaultMtu = 1500;
 }
@@ -83,15 +87,62 @@ void TunManager::stateUpdated(const StateDelta& delta) {
   // not have to worry about waiting to listen to updates until the
   // SwSwitch is in the configured state. t4155406 should also help
   // with that.
+  //
+  // Only updates that change interfaces or their statuses are synced, and
+  // updates arriving while a sync is pending are folded into it.
+  if (!isSyncNeeded(delta)) {
+    return;
+  }
+  bool syncPending = pendingSyncState_.withWLock([&](auto& pendingState) {
+    bool pending = pendingState != nullptr;
+    pendingState = delta.newState();
+    return pending;
+  });
+  if (!syncPending) {
+    evb_->runInEventBaseThread([this]() { this->syncPendingState(); });
+  }
+}
 
-  auto state = delta.newState();
-  evb_->runInEventBaseThread([this, state]() { this->sync(state); });
+bool TunManager::isSyncNeeded(const StateDelta& delta) {
+  const auto& oldState = delta.oldState();
+  const auto& newState = delta.newState();
+  if (oldState->getInterfaces() != newState->getInterfaces() ||
+      oldState->getPorts() != newState->getPorts()) {
+    return true;
+  }
+  // Neighbor tables are part of vlans, only look at the vlan to interface
+  // mapping
+  bool vlanIntfsChanged = false;
+  auto changed = [&](const std::shared_ptr<Vlan>& oldVlan,
+                     const std::shared_ptr<Vlan>& newVlan) {
+    if (oldVlan->getInterfaceID() == newVlan->getInterfaceID()) {
+      return LoopAction::CONTINUE;
+    }
+    vlanIntfsChanged = true;
+    return LoopAction::BREAK;
+  };
+  auto addedOrRemoved = [&](const std::shared_ptr<Vlan>& /* vlan */) {
+    vlanIntfsChanged = true;
+    return LoopAction::BREAK;
+  };
+  DeltaFunctions::forEachChanged(
+      delta.getVlansDelta(), changed, addedOrRemoved, addedOrRemoved);
+  return vlanIntfsChanged;
+}
+
+void TunManager::syncPendingState() {
+  std::shared_ptr<SwitchState> state;
+  pendingSyncState_.withWLock(
+      [&](auto& pendingState) { std::swap(state, pendingState); });
+  if (state) {
+    sync(state);
+  }
 }
 
 bool TunManager::sendPacketToHost(
     InterfaceID dstIfID,
     std::unique_ptr<RxPacket> pkt) {
-  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_lock lock(intfsMutex_);
   auto iter = intfs_.find(dstIfID);
   if (iter == intfs_.end()) {
     // the Interface ID has been deleted, make a log, and skip the pkt
@@ -103,30 +154,24 @@ bool TunManager::sendPacketToHost(
 
 void TunManager::addExistingIntf(const std::string& ifName, int ifIndex) {
   InterfaceID ifID = util::getIDFromTunIntfName(ifName);
-  auto ret = intfs_.emplace(ifID, nullptr);
-  if (!ret.second) {
+  if (intfs_.find(ifID) != intfs_.end()) {
     throw FbossError("Duplicate interface ", ifName);
   }
 
-  SCOPE_FAIL {
-    intfs_.erase(ret.first);
-  };
-  ret.first->second.reset(
-      new TunIntf(sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID)));
+  auto intf = std::make_unique<TunIntf>(
+      sw_, evb_, ifID, ifIndex, getInterfaceMtu(ifID));
+  std::unique_lock lock(intfsMutex_);
+  intfs_.emplace(ifID, std::move(intf));
 }
 
 void TunManager::addNewIntf(
     InterfaceID ifID,
     bool isUp,
     const Interface::Addresses& addrs) {
-  auto ret = intfs_.emplace(ifID, nullptr);
-  if (!ret.second) {
+  if (intfs_.find(ifID) != intfs_.end()) {
     throw FbossError("Duplicate interface for interface ", ifID);
   }
 
-  SCOPE_FAIL {
-    intfs_.erase(ret.first);
-  };
   auto intf = std::make_unique<TunIntf>(
       sw_, evb_, ifID, isUp, addrs, getInterfaceMtu(ifID));
 
@@ -148,7 +193,8 @@ void TunManager::addNewIntf(
   }
 
   // Store it in local map on success
-  ret.first->second = std::move(intf);
+  std::unique_lock lock(intfsMutex_);
+  intfs_.emplace(ifID, std::move(intf));
 }
 
 void TunManager::removeIntf(InterfaceID ifID) {
@@ -167,7 +213,14 @@ void TunManager::removeIntf(InterfaceID ifID) {
   // Remove the route table and associated rule
   removeRouteTable(ifID, intf->getIfIndex());
   intf->setDelete();
-  intfs_.erase(iter);
+  // Destroy the interface outside of intfsMutex_, once packets can no
+  // longer be sent to it
+  std::unique_ptr<TunIntf> removed;
+  {
+    std::unique_lock lock(intfsMutex_);
+    removed = std::move(intf);
+    intfs_.erase(iter);
+  }
 }
 
 void TunManager::addProbedAddr(
@@ -613,7 +666,13 @@ void TunManager::doProbe(std::lock_guard<std::mutex>& /* lock */) {
 
   CHECK(!probeDone_); // Callers must check for probeDone before calling
   stop(); // stop all interfaces
-  intfs_.clear(); // clear all interface info
+  // clear all interface info
+  boost::container::flat_map<InterfaceID, std::unique_ptr<TunIntf>> oldIntfs;
+  {
+    std::unique_lock lock(intfsMutex_);
+    intfs_.swap(oldIntfs);
+  }
+  oldIntfs.clear();
 
   // get links
   struct nl_cache* cache;
@@ -9,6 +9,8 @@
  */
 #pragma once
 
+#include <folly/SharedMutex.h>
+#include <folly/Synchronized.h>
 #include <folly/io/async/EventBase.h>
 #include "fboss/agent/StateObserver.h"
 #include "fboss/agent/state/Interface.h"
@@ -40,6 +42,13 @@ class TunManager : public StateObserver {
    */
   void stateUpdated(const StateDelta& delta) override;
 
+  /**
+   * Whether a state update changes anything TunManager syncs to the host:
+   * interfaces and their addresses, or ports and vlans that interface
+   * statuses are derived from. Route and neighbor updates don't.
+   */
+  static bool isSyncNeeded(const StateDelta& delta);
+
   /**
    * Send a packet to host.
    * This function can be called from any thread.
@@ -92,6 +101,12 @@ class TunManager : public StateObserver {
   void stop() const;
   void start() const;
 
+  /**
+   * Sync the latest state posted by stateUpdated(). Called on the thread
+   * that serves evb_.
+   */
+  void syncPendingState();
+
   /**
    * Add a TUN interface. It can happen two ways
    * 1. During probe process when we discover existing Tun interface on linux
@@ -227,12 +242,22 @@ class TunManager : public StateObserver {
   nl_sock* sock_{nullptr};
 
   /**
-   * The mutex used to protect `intfs_` which can be used by
-   * sync() could manipulate intfs_. Called on the thread that serves evb_.
-   * sendPacketToHost() uses intfs_, it can be called from any thread.
+   * The mutex used to serialize sync() and probe(), which manipulate
+   * intfs_ and the host. Called on the thread that serves evb_.
+   * sendPacketToHost() uses intfs_, it can be called from any thread, so
+   * entries are only added to or removed from intfs_ while also holding
+   * intfsMutex_ exclusively. sendPacketToHost() only takes intfsMutex_
+   * shared and so never waits on netlink calls made by sync().
    */
   boost::container::flat_map<InterfaceID, std::unique_ptr<TunIntf>> intfs_;
   std::mutex mutex_;
+  folly::SharedMutex intfsMutex_;
+
+  /**
+   * Latest state posted by stateUpdated() and not yet synced. A burst of
+   * updates is coalesced into a single sync of the last state.
+   */
+  folly::Synchronized<std::shared_ptr<SwitchState>> pendingSyncState_;
 
   // Whether the manager has registered itself to listen for state updates
   // from sw_
@@ -54,6 +54,8 @@ void HwBasePortFb303Stats::reinitStats(std::optional<std::string> oldPortName) {
                 queueIdAndName.second))
           : std::nullopt;
       portCounters_.reinitStat(newStatName, oldStatName);
+      queueStatCounters_[queueIdAndName.first][statKey] =
+          portCounters_.getCounterIf(newStatName);
     }
   }
   if (macsecStatsInited_) {
@@ -83,10 +85,12 @@ void HwBasePortFb303Stats::reinitStat(
     folly::StringPiece statKey,
     const std::string& portName,
     std::optional<std::string> oldPortName) {
+  auto newStatName = statName(statKey, portName);
   portCounters_.reinitStat(
-      statName(statKey, portName),
+      newStatName,
       oldPortName ? std::optional<std::string>(statName(statKey, *oldPortName))
                   : std::nullopt);
+  portStatCounters_[statKey] = portCounters_.getCounterIf(newStatName);
 }
 
 /*
@@ -96,11 +100,15 @@ void HwBasePortFb303Stats::reinitStat(
     folly::StringPiece statKey,
     int queueId,
     std::optional<std::string> oldQueueName) {
+  auto newStatName =
+      statName(statKey, portName_, queueId, queueId2Name_[queueId]);
   portCounters_.reinitStat(
-      statName(statKey, portName_, queueId, queueId2Name_[queueId]),
+      newStatName,
       oldQueueName ? std::optional<std::string>(
                          statName(statKey, portName_, queueId, *oldQueueName))
                    : std::nullopt);
+  queueStatCounters_[queueId][statKey] =
+      portCounters_.getCounterIf(newStatName);
 }
 
 void HwBasePortFb303Stats::queueChanged(
@@ -123,6 +131,7 @@ void HwBasePortFb303Stats::queueRemoved(int queueId) {
         statName(statKey, portName_, queueId, queueId2Name_[queueId]));
   }
   queueId2Name_.erase(queueId);
+  queueStatCounters_.erase(queueId);
 }
 
 void HwBasePortFb303Stats::updateStat(
@@ -130,14 +139,19 @@ void HwBasePortFb303Stats::updateStat(
     folly::StringPiece statKey,
     int queueId,
     int64_t val) {
-  portCounters_.updateStat(
-      now, statName(statKey, portName_, queueId, queueId2Name_[queueId]), val);
+  auto qitr = queueStatCounters_.find(queueId);
+  CHECK(qitr != queueStatCounters_.end());
+  auto citr = qitr->second.find(statKey);
+  CHECK(citr != qitr->second.end() && citr->second);
+  citr->second->updateValue(now, val);
 }
 
 void HwBasePortFb303Stats::updateStat(
     const std::chrono::seconds& now,
     folly::StringPiece statKey,
     int64_t val) {
-  portCounters_.updateStat(now, statName(statKey, portName_), val);
+  auto citr = portStatCounters_.find(statKey);
+  CHECK(citr != portStatCounters_.end() && citr->second);
+  citr->second->updateValue(now, val);
 }
 } // namespace facebook::fboss
@@ -112,9 +112,17 @@ class HwBasePortFb303Stats {
       int queueId,
       std::optional<std::string> oldQueueName);
 
+  using StatKey2Counter =
+      folly::F14FastMap<folly::StringPiece, stats::MonotonicCounter*>;
+
   std::string portName_;
   HwFb303Stats portCounters_;
   QueueId2Name queueId2Name_;
+  // Counters resolved whenever a stat is (re)initialized, so that updates
+  // look them up by stat key rather than by building and hashing full stat
+  // names
+  StatKey2Counter portStatCounters_;
+  folly::F14FastMap<int, StatKey2Counter> queueStatCounters_;
   bool macsecStatsInited_{false};
 };
 
@@ -36,14 +36,18 @@ class HwFb303Stats {
       int64_t val);
   void removeStat(const std::string& statName);
 
- private:
   /*
-   * Update queue stat
+   * Counter for statName, if any. The pointer stays valid until the stat is
+   * removed or renamed (by reinitStat), so callers updating a stat every
+   * stats interval can resolve it once instead of looking it up by name on
+   * each update.
    */
   stats::MonotonicCounter* getCounterIf(const std::string& statName);
   const stats::MonotonicCounter* getCounterIf(
       const std::string& statName) const;
 
-  folly::F14FastMap<std::string, stats::MonotonicCounter> counters_;
+ private:
+  // Node map, so that counters do not move as other stats come and go
+  folly::F14NodeMap<std::string, stats::MonotonicCounter> counters_;
 };
 } // namespace facebook::fboss
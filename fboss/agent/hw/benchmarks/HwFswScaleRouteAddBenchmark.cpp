@@ -12,9 +12,21 @@
 
 #include "fboss/agent/test/RouteScaleGenerators.h"
 
+#include <gflags/gflags.h>
+
 namespace facebook::fboss {
 
 ROUTE_ADD_BENCHMARK(
     HwFswScaleRouteAddBenchmark,
     utility::FSWRouteScaleGenerator);
+
+/*
+ * Same route scale with route creates and removes batched into bulk SAI
+ * calls. Set by name since the flag only exists in SAI builds.
+ */
+BENCHMARK(HwFswScaleRouteAddBulkBenchmark) {
+  gflags::FlagSaver flagSaver;
+  gflags::SetCommandLineOption("bulk_route_programming_size", "4096");
+  routeAddDelBenchmarker<utility::FSWRouteScaleGenerator>(true);
+}
 } // namespace facebook::fboss
@@ -23,8 +23,9 @@
 
 namespace facebook::fboss {
 
-BENCHMARK(RibResolutionBenchmark) {
+void ribResolutionBenchmark(bool incremental) {
   folly::BenchmarkSuspender suspender;
+  FLAGS_rib_incremental_resolution = incremental;
   std::unique_ptr<AgentEnsemble> ensemble{};
 
   AgentEnsembleSwitchConfigFn initialConfigFn =
@@ -61,4 +62,12 @@ BENCHMARK(RibResolutionBenchmark) {
   suspender.rehire();
 }
 
+BENCHMARK(RibResolutionBenchmark) {
+  ribResolutionBenchmark(true);
+}
+
+BENCHMARK(RibResolutionFullResolutionBenchmark) {
+  ribResolutionBenchmark(false);
+}
+
 } // namespace facebook::fboss
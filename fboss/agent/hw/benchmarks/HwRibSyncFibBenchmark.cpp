@@ -23,8 +23,14 @@
 
 namespace facebook::fboss {
 
-BENCHMARK(RibSyncFibBenchmark) {
+/*
+ * Sync FIB with the same routes that were programmed. With
+ * incremental resolution and FIB updates the FIB is patched from the
+ * set of re-resolved routes, otherwise it is rebuilt from the whole RIB.
+ */
+void ribSyncFibBenchmark(bool incremental) {
   folly::BenchmarkSuspender suspender;
+  FLAGS_rib_incremental_resolution = incremental;
   AgentEnsembleSwitchConfigFn initialConfigFn =
       [](HwSwitch* hwSwitch, const std::vector<PortID>& ports) {
         auto config = utility::onePortPerInterfaceConfig(hwSwitch, ports);
@@ -51,7 +57,6 @@ BENCHMARK(RibSyncFibBenchmark) {
       "resolution only",
       ribToSwitchStateUpdate,
       static_cast<void*>(&switchState));
-  switchState = ensemble->getSw()->getState();
   suspender.dismiss();
   // Sync fib with the same routes
   rib->update(
@@ -66,4 +71,71 @@ BENCHMARK(RibSyncFibBenchmark) {
       static_cast<void*>(&switchState));
   suspender.rehire();
 }
+
+/*
+ * Add kNumDeltaRoutes routes to a FIB already holding the rest of the
+ * 50K route scale.
+ */
+void ribSmallDeltaFibBenchmark(bool incremental) {
+  constexpr auto kNumDeltaRoutes = 10;
+  folly::BenchmarkSuspender suspender;
+  FLAGS_rib_incremental_resolution = incremental;
+  AgentEnsembleSwitchConfigFn initialConfigFn =
+      [](HwSwitch* hwSwitch, const std::vector<PortID>& ports) {
+        auto config = utility::onePortPerInterfaceConfig(hwSwitch, ports);
+        return config;
+      };
+
+  auto ensemble = createAgentEnsemble(initialConfigFn);
+  auto state = ensemble->getSw()->getState();
+  utility::THAlpmRouteScaleGenerator gen(state, 50000);
+  const auto& routeChunks = gen.getThriftRoutes();
+  CHECK_EQ(1, routeChunks.size());
+  CHECK_GT(routeChunks[0].size(), kNumDeltaRoutes);
+  std::vector<UnicastRoute> deltaRoutes(
+      routeChunks[0].begin(), routeChunks[0].begin() + kNumDeltaRoutes);
+  std::vector<UnicastRoute> baseRoutes(
+      routeChunks[0].begin() + kNumDeltaRoutes, routeChunks[0].end());
+  auto rib = RoutingInformationBase::fromFollyDynamic(
+      ensemble->getSw()->getRib()->toFollyDynamic(), nullptr, nullptr);
+  auto switchState = ensemble->getSw()->getState();
+  rib->update(
+      RouterID(0),
+      ClientID::BGPD,
+      AdminDistance::EBGP,
+      baseRoutes,
+      {},
+      false,
+      "base routes",
+      ribToSwitchStateUpdate,
+      static_cast<void*>(&switchState));
+  suspender.dismiss();
+  rib->update(
+      RouterID(0),
+      ClientID::BGPD,
+      AdminDistance::EBGP,
+      deltaRoutes,
+      {},
+      false,
+      "delta routes",
+      ribToSwitchStateUpdate,
+      static_cast<void*>(&switchState));
+  suspender.rehire();
+}
+
+BENCHMARK(RibSyncFibBenchmark) {
+  ribSyncFibBenchmark(true);
+}
+
+BENCHMARK(RibSyncFibFullRebuildBenchmark) {
+  ribSyncFibBenchmark(false);
+}
+
+BENCHMARK(RibSmallDeltaFibBenchmark) {
+  ribSmallDeltaFibBenchmark(true);
+}
+
+BENCHMARK(RibSmallDeltaFibFullRebuildBenchmark) {
+  ribSmallDeltaFibBenchmark(false);
+}
 } // namespace facebook::fboss
@@ -8,7 +8,9 @@
  *
  */
 
+#include "fboss/agent/PacketObserver.h"
 #include "fboss/agent/Platform.h"
+#include "fboss/agent/RxPacket.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwTestCoppUtils.h"
 #include "fboss/agent/hw/test/HwTestPacketUtils.h"
@@ -25,8 +27,12 @@
 #include <folly/IPAddress.h>
 #include <folly/dynamic.h>
 #include <folly/init/Init.h>
+#include <folly/io/Cursor.h>
 #include <folly/json.h>
+#include <folly/synchronization/Baton.h>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <thread>
 
@@ -34,6 +40,57 @@ namespace facebook::fboss {
 
 const std::string kDstIp = "2620:0:1cfe:face:b00c::4";
 
+namespace {
+/*
+ * Signals the first trapped LLDP packet after each expectLldp(), used to
+ * measure how long a control protocol packet takes to get through the RX path
+ * while it is flooded with other trapped packets
+ */
+class LldpRxObserver : public PacketObserverIf {
+ public:
+  // Call before sending the probe. Late or duplicate LLDP packets received
+  // while no probe is expected are ignored, so the baton is posted at most
+  // once per reset.
+  void expectLldp() {
+    lldpReceived_.reset();
+    expectingLldp_.store(true);
+  }
+
+  bool waitForLldp(std::chrono::milliseconds timeout) {
+    if (lldpReceived_.try_wait_for(timeout)) {
+      return true;
+    }
+    if (expectingLldp_.exchange(false)) {
+      return false;
+    }
+    // The probe came in as the wait timed out, and is being posted
+    lldpReceived_.wait();
+    return true;
+  }
+
+ private:
+  void packetReceived(const RxPacket* pkt) noexcept override {
+    folly::io::Cursor cursor(pkt->buf());
+    if (cursor.totalLength() < 18) {
+      return;
+    }
+    cursor += 12;
+    auto ethertype = cursor.readBE<uint16_t>();
+    if (ethertype == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_VLAN)) {
+      cursor += 2;
+      ethertype = cursor.readBE<uint16_t>();
+    }
+    if (ethertype == static_cast<uint16_t>(ETHERTYPE::ETHERTYPE_LLDP) &&
+        expectingLldp_.exchange(false)) {
+      lldpReceived_.post();
+    }
+  }
+
+  std::atomic<bool> expectingLldp_{false};
+  folly::Baton<> lldpReceived_;
+};
+} // namespace
+
 BENCHMARK(RxSlowPathBenchmark) {
   constexpr int kEcmpWidth = 1;
   AgentEnsembleSwitchConfigFn initialConfig =
@@ -105,15 +162,59 @@ BENCHMARK(RxSlowPathBenchmark) {
                           durationMillseconds.count()) *
       1000;
 
+  // Measure LLDP latency through the RX path while the flood is going on.
+  // Packets are sent out of the looped back port one at a time.
+  constexpr auto kLldpProbes = 100;
+  constexpr auto kLldpTimeout = std::chrono::milliseconds(1000);
+  const auto kLldpMac = folly::MacAddress{"01:80:c2:00:00:0e"};
+  LldpRxObserver lldpObserver;
+  ensemble->getSw()->getPacketObservers()->registerPacketObserver(
+      &lldpObserver, "LldpRxObserver");
+  std::chrono::duration<double, std::micro> lldpLatencyTotal{0};
+  std::chrono::duration<double, std::micro> lldpLatencyMax{0};
+  int lldpReceived = 0;
+  for (auto i = 0; i < kLldpProbes; ++i) {
+    auto lldpPacket = utility::makeEthTxPacket(
+        hwSwitch,
+        VlanID(*config.vlanPorts()[0].vlanID()),
+        kSrcMac,
+        kLldpMac,
+        ETHERTYPE::ETHERTYPE_LLDP,
+        std::vector<uint8_t>(64, 0xff));
+    lldpObserver.expectLldp();
+    auto sent = std::chrono::steady_clock::now();
+    hwSwitch->sendPacketOutOfPortSync(
+        std::move(lldpPacket), ensemble->masterLogicalPortIds()[0]);
+    if (!lldpObserver.waitForLldp(kLldpTimeout)) {
+      continue;
+    }
+    std::chrono::duration<double, std::micro> latency =
+        std::chrono::steady_clock::now() - sent;
+    lldpLatencyTotal += latency;
+    lldpLatencyMax = std::max(lldpLatencyMax, latency);
+    ++lldpReceived;
+  }
+  ensemble->getSw()->getPacketObservers()->unregisterPacketObserver(
+      &lldpObserver, "LldpRxObserver");
+  uint32_t lldpLatencyAvgUs =
+      lldpReceived ? lldpLatencyTotal.count() / lldpReceived : 0;
+  uint32_t lldpLatencyMaxUs = lldpLatencyMax.count();
+
   if (FLAGS_json) {
     folly::dynamic cpuRxRateJson = folly::dynamic::object;
     cpuRxRateJson["cpu_rx_pps"] = pps;
     cpuRxRateJson["cpu_rx_bytes_per_sec"] = bytesPerSec;
+    cpuRxRateJson["lldp_rx_latency_avg_us"] = lldpLatencyAvgUs;
+    cpuRxRateJson["lldp_rx_latency_max_us"] = lldpLatencyMaxUs;
+    cpuRxRateJson["lldp_rx_lost"] = kLldpProbes - lldpReceived;
     std::cout << toPrettyJson(cpuRxRateJson) << std::endl;
   } else {
     XLOG(DBG2) << " Pkts before: " << pktsBefore << " Pkts after: " << pktsAfter
                << " interval ms: " << durationMillseconds.count()
-               << " pps: " << pps << " bytes per sec: " << bytesPerSec;
+               << " pps: " << pps << " bytes per sec: " << bytesPerSec
+               << " LLDP latency avg us: " << lldpLatencyAvgUs
+               << " max us: " << lldpLatencyMaxUs
+               << " lost: " << kLldpProbes - lldpReceived;
   }
 }
 } // namespace facebook::fboss
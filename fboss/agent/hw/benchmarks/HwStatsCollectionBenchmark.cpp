@@ -10,6 +10,7 @@
 
 #include "fboss/agent/Platform.h"
 #include "fboss/agent/SwitchStats.h"
+#include "fboss/agent/Utils.h"
 #include "fboss/agent/hw/test/ConfigFactory.h"
 #include "fboss/agent/hw/test/HwSwitchEnsemble.h"
 #include "fboss/agent/hw/test/HwSwitchEnsembleFactory.h"
@@ -18,8 +19,13 @@
 
 #include <folly/Benchmark.h>
 #include <folly/IPAddress.h>
+#include <folly/json.h>
 #include <folly/logging/xlog.h>
 
+#include <atomic>
+#include <iostream>
+#include <thread>
+
 namespace facebook::fboss {
 
 RouteNextHopSet makeNextHops(std::vector<std::string> ipsAsStrings) {
@@ -91,4 +97,65 @@ BENCHMARK(HwStatsCollection) {
   suspender.rehire();
 }
 
+/*
+ * Program routes in chunks while another thread collects stats in a loop,
+ * as the stats thread does in the agent, and benchmark the route
+ * programming. Also reports the worst case latency of programming a chunk,
+ * which is what stats collection holding the switch lock shows up in.
+ */
+BENCHMARK(HwRouteProgrammingWithStatsCollection) {
+  folly::BenchmarkSuspender suspender;
+  std::unique_ptr<AgentEnsemble> ensemble{};
+  int numPortsToCollectStats = 48;
+  constexpr auto kNumRouteChunks = 40;
+  constexpr auto kRoutesPerChunk = 256;
+
+  AgentEnsembleSwitchConfigFn initialConfigFn =
+      [numPortsToCollectStats](
+          HwSwitch* hwSwitch, const std::vector<PortID>& ports) {
+        auto portsNew = ports;
+        portsNew.resize(std::min((int)ports.size(), numPortsToCollectStats));
+        return utility::onePortPerInterfaceConfig(
+            hwSwitch, portsNew, cfg::PortLoopbackMode::MAC);
+      };
+  ensemble = createAgentEnsemble(initialConfigFn);
+  auto hwSwitch = ensemble->getHw();
+
+  std::atomic<bool> done{false};
+  std::thread statsThread([hwSwitch, &done]() {
+    SwitchStats dummy;
+    while (!done) {
+      hwSwitch->updateStats(&dummy);
+    }
+  });
+
+  auto updater = ensemble->getSw()->getRouteUpdater();
+  double worstCaseChunkMsecs = 0;
+  suspender.dismiss();
+  for (auto chunk = 0; chunk < kNumRouteChunks; ++chunk) {
+    StopWatch chunkTimer(std::nullopt, FLAGS_json);
+    for (auto i = 0; i < kRoutesPerChunk; ++i) {
+      folly::CIDRNetwork nw{
+          folly::IPAddress(folly::sformat("2401:db00:{:x}:{:x}::", chunk, i)),
+          64};
+      UnicastRoute route = util::toUnicastRoute(
+          nw, RouteNextHopEntry(makeNextHops({"1::"}), AdminDistance::EBGP));
+      updater.addRoute(RouterID(0), ClientID::BGPD, route);
+    }
+    updater.program();
+    worstCaseChunkMsecs =
+        std::max(worstCaseChunkMsecs, chunkTimer.msecsElapsed().count());
+  }
+  suspender.rehire();
+  done = true;
+  statsThread.join();
+  if (FLAGS_json) {
+    folly::dynamic time = folly::dynamic::object;
+    time["worst_case_route_chunk_msecs"] = worstCaseChunkMsecs;
+    std::cout << toPrettyJson(time) << std::endl;
+  } else {
+    XLOG(DBG2) << "worst_case_route_chunk_msecs : " << worstCaseChunkMsecs;
+  }
+}
+
 } // namespace facebook::fboss
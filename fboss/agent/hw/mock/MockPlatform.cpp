@@ -44,10 +44,13 @@ const folly::IPAddressV6& MockPlatform::getMockLinkLocalIp6() {
 
 MockPlatform::MockPlatform(
     std::unique_ptr<PlatformProductInfo> productInfo,
-    std::unique_ptr<MockHwSwitch> hw)
+    std::unique_ptr<MockHwSwitch> hw,
+    std::unique_ptr<PlatformMapping> platformMapping)
     : Platform(
           std::move(productInfo),
-          std::make_unique<Wedge100PlatformMapping>(),
+          platformMapping ? std::move(platformMapping)
+                          : std::unique_ptr<PlatformMapping>(
+                                std::make_unique<Wedge100PlatformMapping>()),
           getMockLocalMac()),
       tmpDir_("fboss_mock_state"),
       hw_(std::move(hw)) {
@@ -69,6 +72,12 @@ MockPlatform::MockPlatform()
           nullptr,
           make_unique<::testing::NiceMock<MockHwSwitch>>(this)) {}
 
+MockPlatform::MockPlatform(std::unique_ptr<PlatformMapping> platformMapping)
+    : MockPlatform(
+          nullptr,
+          make_unique<::testing::NiceMock<MockHwSwitch>>(this),
+          std::move(platformMapping)) {}
+
 MockPlatform::~MockPlatform() {}
 
 void MockPlatform::setupAsic(
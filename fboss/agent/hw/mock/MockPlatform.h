@@ -34,9 +34,12 @@ class HwSwitchWarmBootHelper;
 class MockPlatform : public Platform {
  public:
   MockPlatform();
+  // Uses platformMapping instead of the Wedge100 platform mapping
+  explicit MockPlatform(std::unique_ptr<PlatformMapping> platformMapping);
   MockPlatform(
       std::unique_ptr<PlatformProductInfo> productInfo,
-      std::unique_ptr<MockHwSwitch> hw);
+      std::unique_ptr<MockHwSwitch> hw,
+      std::unique_ptr<PlatformMapping> platformMapping = nullptr);
   ~MockPlatform() override;
 
   HwSwitch* getHwSwitch() const override;
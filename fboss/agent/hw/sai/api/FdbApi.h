@@ -132,6 +132,47 @@ class FdbApi : public SaiApi<FdbApi> {
     return api_->set_fdb_entry_attribute(fdbEntry.entry(), attr);
   }
 
+  sai_status_t _bulkCreate(
+      const SaiFdbTraits::FdbEntry* fdbEntries,
+      size_t objectCount,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_fdb_entry_t> rawEntries(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      rawEntries[idx] = *fdbEntries[idx].entry();
+    }
+    return api_->create_fdb_entries(
+        objectCount,
+        rawEntries.data(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+  sai_status_t _bulkRemove(
+      const SaiFdbTraits::FdbEntry* fdbEntries,
+      size_t objectCount,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_fdb_entry_t> rawEntries(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      rawEntries[idx] = *fdbEntries[idx].entry();
+    }
+    return api_->remove_fdb_entries(
+        objectCount,
+        rawEntries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+
   sai_fdb_api_t* api_;
   friend class SaiApi<FdbApi>;
 };
@@ -149,6 +149,47 @@ class NeighborApi : public SaiApi<NeighborApi> {
     return api_->set_neighbor_entry_attribute(neighborEntry.entry(), attr);
   }
 
+  sai_status_t _bulkCreate(
+      const SaiNeighborTraits::NeighborEntry* neighborEntries,
+      size_t objectCount,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_neighbor_entry_t> rawEntries(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      rawEntries[idx] = *neighborEntries[idx].entry();
+    }
+    return api_->create_neighbor_entries(
+        objectCount,
+        rawEntries.data(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+  sai_status_t _bulkRemove(
+      const SaiNeighborTraits::NeighborEntry* neighborEntries,
+      size_t objectCount,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_neighbor_entry_t> rawEntries(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      rawEntries[idx] = *neighborEntries[idx].entry();
+    }
+    return api_->remove_neighbor_entries(
+        objectCount,
+        rawEntries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+
   sai_neighbor_api_t* api_;
   friend class SaiApi<NeighborApi>;
 };
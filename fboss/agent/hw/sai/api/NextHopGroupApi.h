@@ -19,6 +19,7 @@
 
 #include <set>
 #include <tuple>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -156,6 +157,49 @@ class NextHopGroupApi : public SaiApi<NextHopGroupApi> {
     return SAI_STATUS_NOT_SUPPORTED;
 #endif
   }
+  sai_status_t _bulkCreate(
+      NextHopGroupMemberSaiId* ids,
+      sai_object_id_t switch_id,
+      size_t objectCount,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_object_id_t> rawIds(objectCount);
+    auto status = api_->create_next_hop_group_members(
+        switch_id,
+        objectCount,
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        rawIds.data(),
+        retStatus);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      ids[idx] = NextHopGroupMemberSaiId(rawIds[idx]);
+    }
+    return status;
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+  sai_status_t _bulkRemove(
+      const NextHopGroupMemberSaiId* ids,
+      size_t objectCount,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_object_id_t> rawIds(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      rawIds[idx] = ids[idx];
+    }
+    return api_->remove_next_hop_group_members(
+        objectCount,
+        rawIds.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
 
   sai_next_hop_group_api_t* api_;
   friend class SaiApi<NextHopGroupApi>;
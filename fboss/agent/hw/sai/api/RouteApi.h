@@ -21,6 +21,7 @@
 #include <folly/logging/xlog.h>
 
 #include <iterator>
+#include <vector>
 
 extern "C" {
 #include <sai.h>
@@ -143,6 +144,47 @@ class RouteApi : public SaiApi<RouteApi> {
     return api_->set_route_entry_attribute(routeEntry.entry(), attr);
   }
 
+  sai_status_t _bulkCreate(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      size_t objectCount,
+      const uint32_t* attrCounts,
+      const sai_attribute_t** attrLists,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_route_entry_t> rawEntries(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      rawEntries[idx] = *routeEntries[idx].entry();
+    }
+    return api_->create_route_entries(
+        objectCount,
+        rawEntries.data(),
+        attrCounts,
+        attrLists,
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+  sai_status_t _bulkRemove(
+      const SaiRouteTraits::RouteEntry* routeEntries,
+      size_t objectCount,
+      sai_status_t* retStatus) const {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+    std::vector<sai_route_entry_t> rawEntries(objectCount);
+    for (auto idx = 0; idx < objectCount; idx++) {
+      rawEntries[idx] = *routeEntries[idx].entry();
+    }
+    return api_->remove_route_entries(
+        objectCount,
+        rawEntries.data(),
+        SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR,
+        retStatus);
+#else
+    return SAI_STATUS_NOT_SUPPORTED;
+#endif
+  }
+
   sai_route_api_t* api_;
   friend class SaiApi<RouteApi>;
 };
@@ -27,6 +27,7 @@
 #include <mutex>
 #include <stdexcept>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <fmt/format.h>
@@ -376,6 +377,188 @@ class SaiApi {
     return bulkSetAttributesUnlocked(adapterKeys, attributes);
   }
 
+  /*
+   * Bulk counterparts of create and remove, programming many objects of the
+   * same type with a single call into the adapter. As with create, there is
+   * one implementation for objects whose AdapterKey is a SAI object id,
+   * which returns the adapter keys, and one for entry structs.
+   *
+   * Adapters stop at the first object that fails, having programmed the
+   * ones before it. Bulk create of object ids removes those again before
+   * throwing, as the caller never gets their keys. Bulk create of entry
+   * structs and bulk remove instead report which objects were programmed in
+   * done, if given, before throwing, so that callers can account for them.
+   */
+
+  // sai_object_id_t case
+  template <typename SaiObjectTraits>
+  std::enable_if_t<
+      AdapterKeyIsObjectId<SaiObjectTraits>::value,
+      std::vector<typename SaiObjectTraits::AdapterKey>>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes,
+      sai_object_id_t switch_id) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    std::vector<typename SaiObjectTraits::AdapterKey> keys(
+        createAttributes.size());
+    if (createAttributes.empty()) {
+      return keys;
+    }
+    if (UNLIKELY(failHwWrites() || skipHwWrites())) {
+      // As with create, we can't manufacture adapter keys out of thin air
+      XLOG(
+          FATAL,
+          "Attempting bulk create SAI objects while hw writes are blocked");
+    }
+    std::vector<std::vector<sai_attribute_t>> saiAttributeTs;
+    saiAttributeTs.reserve(createAttributes.size());
+    for (const auto& attributes : createAttributes) {
+      saiAttributeTs.push_back(saiAttrs(attributes));
+    }
+    auto [attrCounts, attrLists] = bulkAttrLists(saiAttributeTs);
+    std::vector<sai_status_t> retStatus(keys.size(), SAI_STATUS_FAILURE);
+    auto g{SaiApiLock::getInstance()->lock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkCreate(
+          keys.data(),
+          switch_id,
+          keys.size(),
+          attrCounts.data(),
+          attrLists.data(),
+          retStatus.data());
+    }
+    if (!bulkSucceeded(status, retStatus)) {
+      for (auto idx = 0; idx < keys.size(); idx++) {
+        if (retStatus[idx] != SAI_STATUS_SUCCESS) {
+          continue;
+        }
+        auto removeStatus = impl()._remove(keys[idx]);
+        if (removeStatus != SAI_STATUS_SUCCESS) {
+          saiLogError(
+              removeStatus,
+              apiType(),
+              fmt::format(
+                  "Failed to remove sai object {} of failed bulk create",
+                  keys[idx]));
+        }
+      }
+    }
+    saiApiCheckError(
+        status, apiType(), fmt::format("Failed to bulk create sai entities"));
+    for (auto idx = 0; idx < keys.size(); idx++) {
+      saiApiCheckError(
+          retStatus[idx],
+          apiType(),
+          fmt::format(
+              "Failed to create sai entity: {}", createAttributes[idx]));
+      XLOGF(
+          DBG5,
+          "bulk created SAI object: {}: {}",
+          keys[idx],
+          createAttributes[idx]);
+    }
+    return keys;
+  }
+
+  // entry struct case
+  template <typename SaiObjectTraits>
+  std::enable_if_t<AdapterKeyIsEntryStruct<SaiObjectTraits>::value, void>
+  bulkCreate(
+      const std::vector<typename SaiObjectTraits::AdapterKey>& entries,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          createAttributes,
+      std::vector<bool>* done = nullptr) const {
+    static_assert(
+        std::is_same_v<typename SaiObjectTraits::SaiApiT, ApiT>,
+        "invalid traits for the api");
+    CHECK_EQ(entries.size(), createAttributes.size());
+    if (done) {
+      done->assign(entries.size(), skipHwWrites());
+    }
+    if (UNLIKELY(skipHwWrites()) || entries.empty()) {
+      return;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOG(
+          FATAL,
+          "Attempting bulk create SAI objects while hw writes are blocked");
+    }
+    std::vector<std::vector<sai_attribute_t>> saiAttributeTs;
+    saiAttributeTs.reserve(createAttributes.size());
+    for (const auto& attributes : createAttributes) {
+      saiAttributeTs.push_back(saiAttrs(attributes));
+    }
+    auto [attrCounts, attrLists] = bulkAttrLists(saiAttributeTs);
+    std::vector<sai_status_t> retStatus(entries.size(), SAI_STATUS_FAILURE);
+    auto g{SaiApiLock::getInstance()->lock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkCreate(
+          entries.data(),
+          entries.size(),
+          attrCounts.data(),
+          attrLists.data(),
+          retStatus.data());
+    }
+    setBulkDone(retStatus, done);
+    saiApiCheckError(
+        status, apiType(), fmt::format("Failed to bulk create sai entities"));
+    for (auto idx = 0; idx < entries.size(); idx++) {
+      saiApiCheckError(
+          retStatus[idx],
+          apiType(),
+          fmt::format(
+              "Failed to create sai entity: {}: {}",
+              entries[idx],
+              createAttributes[idx]));
+      XLOGF(
+          DBG5,
+          "bulk created SAI object: {}: {}",
+          entries[idx],
+          createAttributes[idx]);
+    }
+  }
+
+  template <typename AdapterKeyT>
+  void bulkRemove(
+      const std::vector<AdapterKeyT>& keys,
+      std::vector<bool>* done = nullptr) const {
+    if (done) {
+      done->assign(keys.size(), skipHwWrites());
+    }
+    if (UNLIKELY(skipHwWrites()) || keys.empty()) {
+      return;
+    }
+    if (UNLIKELY(failHwWrites())) {
+      XLOG(
+          FATAL,
+          "Attempting bulk remove SAI objects while hw writes are blocked");
+    }
+    std::vector<sai_status_t> retStatus(keys.size(), SAI_STATUS_FAILURE);
+    auto g{SaiApiLock::getInstance()->lock()};
+    sai_status_t status;
+    {
+      TIME_CALL;
+      status = impl()._bulkRemove(keys.data(), keys.size(), retStatus.data());
+    }
+    setBulkDone(retStatus, done);
+    saiApiCheckError(
+        status, apiType(), fmt::format("Failed to bulk remove sai objects"));
+    for (auto idx = 0; idx < keys.size(); idx++) {
+      saiApiCheckError(
+          retStatus[idx],
+          apiType(),
+          fmt::format("Failed to remove sai object : {}", keys[idx]));
+      XLOGF(DBG5, "bulk removed SAI object: {}", keys[idx]);
+    }
+  }
+
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStats(
       const typename SaiObjectTraits::AdapterKey& key,
@@ -446,6 +629,39 @@ class SaiApi {
   bool skipHwWrites() const {
     return getHwWriteBehavior() == HwWriteBehavior::SKIP;
   }
+  static bool bulkSucceeded(
+      sai_status_t status,
+      const std::vector<sai_status_t>& retStatus) {
+    return status == SAI_STATUS_SUCCESS &&
+        std::all_of(retStatus.begin(), retStatus.end(), [](auto objStatus) {
+             return objStatus == SAI_STATUS_SUCCESS;
+           });
+  }
+  // Which objects a bulk call programmed
+  static void setBulkDone(
+      const std::vector<sai_status_t>& retStatus,
+      std::vector<bool>* done) {
+    if (!done) {
+      return;
+    }
+    for (auto idx = 0; idx < retStatus.size(); idx++) {
+      (*done)[idx] = retStatus[idx] == SAI_STATUS_SUCCESS;
+    }
+  }
+  // Attribute count and attribute list of each object, as taken by bulk calls
+  static std::pair<std::vector<uint32_t>, std::vector<const sai_attribute_t*>>
+  bulkAttrLists(
+      const std::vector<std::vector<sai_attribute_t>>& saiAttributeTs) {
+    std::vector<uint32_t> attrCounts;
+    std::vector<const sai_attribute_t*> attrLists;
+    attrCounts.reserve(saiAttributeTs.size());
+    attrLists.reserve(saiAttributeTs.size());
+    for (const auto& attrs : saiAttributeTs) {
+      attrCounts.push_back(attrs.size());
+      attrLists.push_back(attrs.data());
+    }
+    return std::make_pair(std::move(attrCounts), std::move(attrLists));
+  }
   template <typename SaiObjectTraits>
   std::vector<uint64_t> getStatsImpl(
       const typename SaiObjectTraits::AdapterKey& key,
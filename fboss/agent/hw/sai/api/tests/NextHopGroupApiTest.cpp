@@ -207,6 +207,60 @@ TEST_F(NextHopGroupApiTest, bulkSetNextHopGroupMemberAttributes) {
 #endif
 }
 
+TEST_F(NextHopGroupApiTest, bulkCreateRemoveNextHopGroupMembers) {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  auto groupId = createNextHopGroup(SAI_NEXT_HOP_GROUP_TYPE_ECMP);
+  checkNextHopGroup(groupId);
+
+  std::vector<SaiNextHopGroupMemberTraits::CreateAttributes> createAttributes;
+  for (auto idx = 0; idx < 3; idx++) {
+    sai_object_id_t nextHopId = 42 + idx;
+    sai_uint32_t nextHopWeight = idx + 1;
+    createAttributes.push_back({groupId, nextHopId, nextHopWeight});
+  }
+  auto memberAdapterKeys =
+      nextHopGroupApi->bulkCreate<SaiNextHopGroupMemberTraits>(
+          createAttributes, 0);
+  EXPECT_EQ(memberAdapterKeys.size(), createAttributes.size());
+  for (auto idx = 0; idx < memberAdapterKeys.size(); idx++) {
+    checkNextHopGroupMember(groupId, memberAdapterKeys[idx], idx + 1);
+  }
+  EXPECT_EQ(
+      nextHopGroupApi
+          ->getAttribute(
+              groupId, SaiNextHopGroupTraits::Attributes::NextHopMemberList())
+          .size(),
+      3);
+
+  nextHopGroupApi->bulkRemove(memberAdapterKeys);
+  EXPECT_EQ(
+      nextHopGroupApi
+          ->getAttribute(
+              groupId, SaiNextHopGroupTraits::Attributes::NextHopMemberList())
+          .size(),
+      0);
+#endif
+}
+
+TEST_F(NextHopGroupApiTest, bulkRemoveNextHopGroupMembersStopsOnError) {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  auto groupId = createNextHopGroup(SAI_NEXT_HOP_GROUP_TYPE_ECMP);
+  auto member0 = createNextHopGroupMember(groupId, 42, 1);
+  auto member1 = createNextHopGroupMember(groupId, 43, 1);
+  // The second member does not exist, so the third is not removed
+  std::vector<NextHopGroupMemberSaiId> memberAdapterKeys{
+      member0, NextHopGroupMemberSaiId(12345), member1};
+  std::vector<bool> done;
+  EXPECT_THROW(
+      nextHopGroupApi->bulkRemove(memberAdapterKeys, &done), SaiApiError);
+  EXPECT_EQ(done, std::vector<bool>({true, false, false}));
+  EXPECT_EQ(
+      nextHopGroupApi->getAttribute(
+          groupId, SaiNextHopGroupTraits::Attributes::NextHopMemberList()),
+      std::vector<sai_object_id_t>{static_cast<sai_object_id_t>(member1)});
+#endif
+}
+
 TEST_F(NextHopGroupApiTest, formatNextHopGroupAttributes) {
   SaiNextHopGroupTraits::Attributes::Type t{SAI_NEXT_HOP_GROUP_TYPE_ECMP};
   EXPECT_EQ("Type: 0", fmt::format("{}", t));
@@ -203,6 +203,55 @@ sai_status_t set_next_hop_group_members_attribute_fn(
   return SAI_STATUS_SUCCESS;
 }
 
+sai_status_t create_next_hop_group_members_fn(
+    sai_object_id_t switch_id,
+    uint32_t object_count,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_object_id_t* object_id,
+    sai_status_t* object_statuses) {
+  auto status = SAI_STATUS_SUCCESS;
+  for (int i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NON_EXECUTED;
+      continue;
+    }
+    object_statuses[i] = create_next_hop_group_member_fn(
+        &object_id[i], switch_id, attr_count[i], attr_list[i]);
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+
+sai_status_t remove_next_hop_group_members_fn(
+    uint32_t object_count,
+    const sai_object_id_t* object_id,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto status = SAI_STATUS_SUCCESS;
+  for (int i = 0; i < object_count; ++i) {
+    if (status != SAI_STATUS_SUCCESS &&
+        mode == SAI_BULK_OP_ERROR_MODE_STOP_ON_ERROR) {
+      object_statuses[i] = SAI_STATUS_NON_EXECUTED;
+      continue;
+    }
+    try {
+      object_statuses[i] = remove_next_hop_group_member_fn(object_id[i]);
+    } catch (...) {
+      // Unknown member
+      object_statuses[i] = SAI_STATUS_ITEM_NOT_FOUND;
+    }
+    if (object_statuses[i] != SAI_STATUS_SUCCESS) {
+      status = SAI_STATUS_FAILURE;
+    }
+  }
+  return status;
+}
+
 namespace facebook::fboss {
 
 static sai_next_hop_group_api_t _next_hop_group_api;
@@ -226,6 +275,10 @@ void populate_next_hop_group_api(
 #if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
   _next_hop_group_api.set_next_hop_group_members_attribute =
       &set_next_hop_group_members_attribute_fn;
+  _next_hop_group_api.create_next_hop_group_members =
+      &create_next_hop_group_members_fn;
+  _next_hop_group_api.remove_next_hop_group_members =
+      &remove_next_hop_group_members_fn;
 #endif
   *next_hop_group_api = &_next_hop_group_api;
 }
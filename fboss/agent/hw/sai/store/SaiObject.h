@@ -18,6 +18,7 @@
 
 #include "fboss/agent/hw/sai/store/SaiObjectEventPublisher.h"
 
+#include <exception>
 #include <variant>
 
 class SaiStoreTest;
@@ -242,6 +243,17 @@ class SaiObject {
     live_ = true;
   }
 
+  // Take over an object already created in the adapter by a bulk create
+  SaiObject(
+      const typename SaiObjectTraits::AdapterKey& adapterKey,
+      const typename SaiObjectTraits::AdapterHostKey& adapterHostKey,
+      const typename SaiObjectTraits::CreateAttributes& attributes)
+      : adapterKey_(adapterKey),
+        adapterHostKey_(adapterHostKey),
+        attributes_(attributes) {
+    live_ = true;
+  }
+
   bool live() const {
     return live_;
   }
@@ -400,6 +412,52 @@ class SaiObject {
     api.bulkSetAttributes(adapterKeys, attributes);
   }
 
+  /*
+   * Remove the given objects from the adapter with a single bulk call, rather
+   * than one call each as they are destroyed. Objects which would not be
+   * removed from the adapter on destruction, or which ignore missing in HW
+   * errors on remove, are left to be removed on destruction as usual. The
+   * others are no longer live afterwards, except those the adapter failed to
+   * remove when the bulk remove throws.
+   */
+  template <typename ObjectT>
+  static void bulkRemove(const std::vector<std::shared_ptr<ObjectT>>& objects) {
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    std::vector<SaiObject*> removed;
+    for (const auto& object : objects) {
+      if (!object->live_ || object->isOwnedByAdapter() ||
+          object->skipRemove_ || object->ignoreMissingInHwOnDelete_) {
+        continue;
+      }
+      if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+        object->notifyBeforeDestroy();
+      }
+      adapterKeys.push_back(object->adapterKey_);
+      removed.push_back(object.get());
+    }
+    // On a partial failure, objects removed ahead of the failing one are
+    // still released before rethrowing, so they aren't removed again
+    std::vector<bool> done(removed.size(), true);
+    std::exception_ptr removeError;
+    if constexpr (not IsSaiObjectOwnedByAdapter<SaiObjectTraits>::value) {
+      auto& api = SaiApiTable::getInstance()
+                      ->getApi<typename SaiObjectTraits::SaiApiT>();
+      try {
+        api.bulkRemove(adapterKeys, &done);
+      } catch (const std::exception&) {
+        removeError = std::current_exception();
+      }
+    }
+    for (auto idx = 0; idx < removed.size(); ++idx) {
+      if (done[idx]) {
+        removed[idx]->release();
+      }
+    }
+    if (removeError) {
+      std::rethrow_exception(removeError);
+    }
+  }
+
  protected:
   template <typename AttrT>
   void checkAndSetAttribute(AttrT&& newAttr, bool skipHwWrite) {
@@ -63,6 +63,16 @@ class SaiObjectWithCounters : public SaiObject<SaiObjectTraits> {
     fillInStats(counterIds.data(), counters);
   }
 
+  // Fill in counters the caller read from the adapter itself, e.g. without
+  // holding the locks protecting this object
+  template <typename T = SaiObjectTraits>
+  void setStats(
+      const std::vector<sai_stat_id_t>& counterIds,
+      const std::vector<uint64_t>& counters) {
+    static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
+    fillInStats(counterIds.data(), counters);
+  }
+
   template <typename T = SaiObjectTraits>
   const StatsMap getStats() const {
     static_assert(SaiObjectHasStats<T>::value, "invalid traits for the api");
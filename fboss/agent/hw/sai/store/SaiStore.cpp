@@ -10,6 +10,17 @@
 
 #include "fboss/agent/hw/sai/store/SaiStore.h"
 
+#include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+
+DEFINE_int32(
+    sai_store_reload_threads,
+    1,
+    "Number of threads used to reload the SaiStore object types from the "
+    "adapter during init. 1 reloads them one at a time.");
+
 namespace facebook::fboss {
 
 SaiStore::SaiStore() {}
@@ -27,8 +38,20 @@ void SaiStore::setSwitchId(sai_object_id_t switchId) {
 void SaiStore::reload(
     const folly::dynamic* adapterKeysJson,
     const folly::dynamic* adapterKeys2AdapterHostKeyJson) {
+  // Each SaiObjectStore only reads objects of its own type from the adapter
+  // and fills its own maps, so the object types are reloaded concurrently.
+  // Whether the SAI calls themselves overlap is up to SaiApiLock.
+  std::unique_ptr<folly::CPUThreadPoolExecutor> executor;
+  if (FLAGS_sai_store_reload_threads > 1) {
+    executor = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_sai_store_reload_threads,
+        std::make_shared<folly::NamedThreadFactory>("saiStoreReload"));
+  }
+  folly::Synchronized<std::map<std::string, std::chrono::milliseconds>>
+      durations;
+  std::vector<folly::Future<folly::Unit>> reloaded;
   tupleForEach(
-      [adapterKeysJson, adapterKeys2AdapterHostKeyJson](auto& store) {
+      [&](auto& store) {
         const folly::dynamic* adapterKeys = adapterKeysJson
             ? adapterKeysJson->get_ptr(store.objectTypeName())
             : nullptr;
@@ -36,9 +59,25 @@ void SaiStore::reload(
             ? adapterKeys2AdapterHostKeyJson->get_ptr(store.objectTypeName())
             : nullptr;
 
-        store.reload(adapterKeys, adapterHostKeys);
+        reloaded.push_back(folly::via(
+            executor ? executor.get() : &folly::InlineExecutor::instance(),
+            [&store, &durations, adapterKeys, adapterHostKeys] {
+              auto begin = std::chrono::steady_clock::now();
+              store.reload(adapterKeys, adapterHostKeys);
+              auto duration =
+                  std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - begin);
+              // Several stores (e.g. router interface types) share an
+              // object type
+              (*durations.wlock())[store.objectTypeName().str()] += duration;
+            }));
       },
       stores_);
+  for (auto& result : folly::collectAll(std::move(reloaded)).get()) {
+    // Rethrow the first failure, if any
+    result.value();
+  }
+  reloadDurations_ = std::move(*durations.wlock());
 }
 
 void SaiStore::release() {
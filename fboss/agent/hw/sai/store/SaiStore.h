@@ -25,7 +25,11 @@
 #include "fboss/lib/RefMap.h"
 
 #include <folly/dynamic.h>
+#include <gflags/gflags.h>
 
+#include <chrono>
+#include <exception>
+#include <map>
 #include <memory>
 #include <optional>
 #include <sstream>
@@ -35,6 +39,8 @@ extern "C" {
 #include <sai.h>
 }
 
+DECLARE_int32(sai_store_reload_threads);
+
 namespace facebook::fboss {
 
 inline constexpr auto kAdapterKey2AdapterHostKey = "adapterKey2AdapterHostKey";
@@ -278,6 +284,114 @@ class SaiObjectStore {
     }
   }
 
+  /*
+   * Bulk counterpart of setObject for objects keyed by entry structs (routes,
+   * neighbors, fdb entries): objects already in the store are programmed as
+   * by setObject, and the rest are created with a single bulk create.
+   * adapterHostKeys must be unique.
+   */
+  std::vector<std::shared_ptr<ObjectType>> bulkSetObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes,
+      bool notify = true) {
+    std::vector<std::shared_ptr<ObjectType>> objects;
+    bulkSetObjects(adapterHostKeys, attributes, objects, notify);
+    return objects;
+  }
+
+  /*
+   * As above, setting objects[i] to the object of adapterHostKeys[i]. If the
+   * bulk create fails part way, objects has the objects it did create, and
+   * null for the others, when the error is rethrown. Those objects are
+   * removed from HW again once the caller drops them.
+   */
+  void bulkSetObjects(
+      const std::vector<typename SaiObjectTraits::AdapterHostKey>&
+          adapterHostKeys,
+      const std::vector<typename SaiObjectTraits::CreateAttributes>&
+          attributes,
+      std::vector<std::shared_ptr<ObjectType>>& objects,
+      bool notify = true) {
+    static_assert(
+        AdapterKeyIsEntryStruct<SaiObjectTraits>::value,
+        "bulk set only supported for objects keyed by entry structs");
+    if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+      static_assert(
+          !IsPublisherKeyCustomType<SaiObjectTraits>::value,
+          "method not available for objects with publisher attributes of custom types");
+    }
+    CHECK_EQ(adapterHostKeys.size(), attributes.size());
+    objects.assign(adapterHostKeys.size(), nullptr);
+    std::vector<size_t> toCreate;
+    std::vector<typename SaiObjectTraits::AdapterKey> adapterKeys;
+    std::vector<typename SaiObjectTraits::CreateAttributes> createAttributes;
+    for (auto idx = 0; idx < adapterHostKeys.size(); ++idx) {
+      if (objects_.ref(adapterHostKeys[idx])) {
+        objects[idx] = setObject(adapterHostKeys[idx], attributes[idx], notify);
+        continue;
+      }
+      XLOGF(
+          DBG5,
+          "SaiStore bulk creating {} object {}",
+          objectTypeName(),
+          adapterHostKeys[idx]);
+      toCreate.push_back(idx);
+      adapterKeys.push_back(adapterHostKeys[idx]);
+      createAttributes.push_back(attributes[idx]);
+    }
+    // On a partial failure, objects created ahead of the failing one are
+    // still added to the store and returned before rethrowing, to stay in
+    // sync with HW
+    std::vector<bool> created;
+    std::exception_ptr createError;
+    try {
+      SaiApiTable::getInstance()
+          ->getApi<typename SaiObjectTraits::SaiApiT>()
+          .template bulkCreate<SaiObjectTraits>(
+              adapterKeys, createAttributes, &created);
+    } catch (const std::exception&) {
+      createError = std::current_exception();
+    }
+    for (auto i = 0; i < toCreate.size(); ++i) {
+      if (!created[i]) {
+        continue;
+      }
+      auto idx = toCreate[i];
+      const auto& adapterHostKey = adapterHostKeys[idx];
+      auto ins = objects_.refOrInsert(
+          adapterHostKey,
+          ObjectType(adapterHostKey, adapterHostKey, attributes[idx]),
+          true /*force*/);
+      auto object = ins.first;
+      if (notify) {
+        if constexpr (IsObjectPublisher<SaiObjectTraits>::value) {
+          object->notifyAfterCreate(object);
+        }
+      }
+      XLOGF(DBG5, "SaiStore bulk created object {}", *object);
+      objects[idx] = object;
+    }
+    if (createError) {
+      std::rethrow_exception(createError);
+    }
+  }
+
+  /*
+   * Remove objects from the adapter with a single bulk call ahead of their
+   * destruction, see SaiObject::bulkRemove.
+   */
+  void bulkRemoveObjects(
+      const std::vector<std::shared_ptr<ObjectType>>& objects) {
+    XLOGF(
+        DBG5,
+        "SaiStore bulk removing {} {} objects",
+        objects.size(),
+        objectTypeName());
+    ObjectType::bulkRemove(objects);
+  }
+
   std::shared_ptr<ObjectType> get(
       const typename SaiObjectTraits::AdapterHostKey& adapterHostKey) {
     XLOGF(DBG5, "SaiStore get object {}", adapterHostKey);
@@ -534,11 +648,22 @@ class SaiStore {
 
   /*
    * Reload the SaiStore from the current SAI state via SAI api calls.
+   * Object stores are independent of each other and are reloaded on up to
+   * sai_store_reload_threads threads.
    */
   void reload(
       const folly::dynamic* adapterKeys = nullptr,
       const folly::dynamic* adapterKeys2AdapterHostKey = nullptr);
 
+  /*
+   * Time taken by the last reload() for each object type, keyed by object
+   * type name
+   */
+  const std::map<std::string, std::chrono::milliseconds>& reloadDurations()
+      const {
+    return reloadDurations_;
+  }
+
   /*
    *
    */
@@ -568,6 +693,7 @@ class SaiStore {
 
  private:
   sai_object_id_t switchId_{};
+  std::map<std::string, std::chrono::milliseconds> reloadDurations_;
   std::tuple<
       SaiObjectStore<SaiAclTableGroupTraits>,
       SaiObjectStore<SaiAclTableGroupMemberTraits>,
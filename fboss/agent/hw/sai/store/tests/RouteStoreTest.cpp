@@ -52,6 +52,34 @@ TEST_F(SaiStoreTest, loadRoute) {
   EXPECT_EQ(GET_OPT_ATTR(Route, Metadata, got->attributes()), 41);
 }
 
+TEST_F(SaiStoreTest, loadRoutesConcurrently) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_sai_store_reload_threads = 4;
+  auto& routeApi = saiApiTable->routeApi();
+  SaiRouteTraits::RouteEntry r1(0, 0, {folly::IPAddress{"10.10.10.0"}, 24});
+  SaiRouteTraits::RouteEntry r2(0, 0, {folly::IPAddress{"10.10.11.0"}, 24});
+  for (const auto& r : {r1, r2}) {
+    routeApi.create<SaiRouteTraits>(
+        r,
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+        { SAI_PACKET_ACTION_FORWARD, 5, 42, std::nullopt }
+#else
+        { SAI_PACKET_ACTION_FORWARD, 5, 42 }
+#endif
+    );
+  }
+
+  saiStore->setSwitchId(0);
+  saiStore->reload();
+  auto& store = saiStore->get<SaiRouteTraits>();
+  EXPECT_EQ(store.get(r1)->adapterKey(), r1);
+  EXPECT_EQ(GET_OPT_ATTR(Route, NextHopId, store.get(r2)->attributes()), 5);
+  EXPECT_EQ(
+      saiStore->reloadDurations().count(
+          SaiObjectStore<SaiRouteTraits>::objectTypeName().str()),
+      1);
+}
+
 TEST_F(SaiStoreTest, routeLoadCtor) {
   auto& routeApi = saiApiTable->routeApi();
   folly::IPAddress ip4{"10.10.10.1"};
@@ -131,6 +159,45 @@ TEST_F(SaiStoreTest, routeSetToPunt) {
   */
 }
 
+TEST_F(SaiStoreTest, bulkSetAndRemoveRoutes) {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  saiStore->setSwitchId(0);
+  saiStore->reload();
+  auto& store = saiStore->get<SaiRouteTraits>();
+  auto numRoutes = fs->routeManager.map().size();
+  SaiRouteTraits::RouteEntry r1(0, 0, {folly::IPAddress{"10.10.10.0"}, 24});
+  SaiRouteTraits::RouteEntry r2(0, 0, {folly::IPAddress{"10.10.11.0"}, 24});
+  SaiRouteTraits::CreateAttributes c1{
+      SAI_PACKET_ACTION_FORWARD, 5, 42, std::nullopt};
+  SaiRouteTraits::CreateAttributes c2{
+      SAI_PACKET_ACTION_FORWARD, 6, 43, std::nullopt};
+  auto existing = store.setObject(r1, c1);
+
+  // r1 is already in the store and gets updated, r2 is bulk created
+  SaiRouteTraits::CreateAttributes c1New{
+      SAI_PACKET_ACTION_FORWARD, 7, 42, std::nullopt};
+  auto objs = store.bulkSetObjects({r1, r2}, {c1New, c2});
+  ASSERT_EQ(objs.size(), 2);
+  EXPECT_EQ(objs[0], existing);
+  EXPECT_EQ(objs[0]->attributes(), c1New);
+  EXPECT_EQ(objs[1]->attributes(), c2);
+  EXPECT_EQ(store.get(r2), objs[1]);
+  auto& routeApi = saiApiTable->routeApi();
+  EXPECT_EQ(
+      routeApi.getAttribute(r1, SaiRouteTraits::Attributes::NextHopId{}), 7);
+  EXPECT_EQ(
+      routeApi.getAttribute(r2, SaiRouteTraits::Attributes::NextHopId{}), 6);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 2);
+
+  store.bulkRemoveObjects(objs);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+  // Destroying bulk removed objects doesn't remove them again
+  existing.reset();
+  objs.clear();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+#endif
+}
+
 TEST_F(SaiStoreTest, formatTest) {
   folly::IPAddress ip4{"10.10.10.1"};
   folly::CIDRNetwork dest(ip4, 24);
@@ -235,3 +302,49 @@ TEST_F(SaiStoreTest, toStrV6Route) {
 
   verifyToStr<SaiRouteTraits>();
 }
+
+TEST_F(SaiStoreTest, bulkSetRoutesPartialFailure) {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  saiStore->setSwitchId(0);
+  saiStore->reload();
+  auto& store = saiStore->get<SaiRouteTraits>();
+  auto& routeApi = saiApiTable->routeApi();
+  auto numRoutes = fs->routeManager.map().size();
+  SaiRouteTraits::RouteEntry r1(0, 0, {folly::IPAddress{"10.10.10.0"}, 24});
+  SaiRouteTraits::RouteEntry r2(0, 0, {folly::IPAddress{"10.10.11.0"}, 24});
+  SaiRouteTraits::RouteEntry r3(0, 0, {folly::IPAddress{"10.10.12.0"}, 24});
+  SaiRouteTraits::CreateAttributes c{
+      SAI_PACKET_ACTION_FORWARD, 5, 42, std::nullopt};
+  // r2 exists in HW but not in the store, so creating it fails
+  routeApi.create<SaiRouteTraits>(r2, c);
+
+  std::vector<SaiRouteTraits::RouteEntry> entries{r1, r2, r3};
+  std::vector<SaiRouteTraits::CreateAttributes> attributes(3, c);
+  std::vector<std::shared_ptr<SaiObject<SaiRouteTraits>>> objs;
+  EXPECT_THROW(store.bulkSetObjects(entries, attributes, objs), SaiApiError);
+  // r1 was created ahead of the failure and is in the store, r3 was not
+  // created at all
+  ASSERT_EQ(objs.size(), 3);
+  auto obj1 = objs[0];
+  ASSERT_NE(obj1, nullptr);
+  EXPECT_EQ(store.get(r1), obj1);
+  EXPECT_EQ(obj1->attributes(), c);
+  EXPECT_EQ(objs[1], nullptr);
+  EXPECT_EQ(objs[2], nullptr);
+  EXPECT_EQ(store.get(r2), nullptr);
+  EXPECT_EQ(store.get(r3), nullptr);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 2);
+
+  // Bulk remove stops at r2, gone from HW already, but r1 is released
+  routeApi.remove(r2);
+  auto obj2 = store.setObject(r2, c);
+  routeApi.remove(r2);
+  objs = {obj1, obj2};
+  EXPECT_THROW(store.bulkRemoveObjects(objs), SaiApiError);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+  objs.clear();
+  obj1.reset();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+  obj2->release();
+#endif
+}
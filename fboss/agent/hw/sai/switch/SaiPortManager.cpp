@@ -1169,7 +1169,41 @@ std::optional<FabricEndpoint> SaiPortManager::getFabricReachabilityForPort(
   return endpoint;
 }
 
-void SaiPortManager::updateStats(PortID portId, bool updateWatermarks) {
+std::optional<SaiPortManager::PortCounters> SaiPortManager::prepareStats(
+    PortID portId) {
+  auto handlesItr = handles_.find(portId);
+  if (handlesItr == handles_.end() ||
+      getPortType(portId) == cfg::PortType::RECYCLE_PORT ||
+      portStats_.find(portId) == portStats_.end()) {
+    return std::nullopt;
+  }
+  PortCounters portCounters;
+  portCounters.adapterKey = handlesItr->second->port->adapterKey();
+  portCounters.counterIds = supportedStats(portId);
+  if (fecStatsSupported(portId)) {
+    portCounters.fecCounterIds = {
+        SAI_PORT_STAT_IF_IN_FEC_CORRECTABLE_FRAMES,
+        SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES};
+  }
+  return portCounters;
+}
+
+void SaiPortManager::readStats(PortCounters& portCounters) {
+  auto& portApi = SaiApiTable::getInstance()->portApi();
+  portCounters.counters = portApi.getStats<SaiPortTraits>(
+      portCounters.adapterKey, portCounters.counterIds, SAI_STATS_MODE_READ);
+  if (!portCounters.fecCounterIds.empty()) {
+    portCounters.fecCounters = portApi.getStats<SaiPortTraits>(
+        portCounters.adapterKey,
+        portCounters.fecCounterIds,
+        SAI_STATS_MODE_READ_AND_CLEAR);
+  }
+}
+
+void SaiPortManager::updateStats(
+    PortID portId,
+    bool updateWatermarks,
+    const PortCounters* portCounters) {
   auto handlesItr = handles_.find(portId);
   if (handlesItr == handles_.end()) {
     return;
@@ -1199,12 +1233,38 @@ void SaiPortManager::updateStats(PortID portId, bool updateWatermarks) {
   setUninitializedStatsToZero(*curPortStats.inPause_());
 
   curPortStats.timestamp_() = now.count();
-  handle->port->updateStats(supportedStats(portId), SAI_STATS_MODE_READ);
-  if (fecStatsSupported(portId)) {
-    handle->port->updateStats(
-        {SAI_PORT_STAT_IF_IN_FEC_CORRECTABLE_FRAMES,
-         SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES},
-        SAI_STATS_MODE_READ_AND_CLEAR);
+  if (portCounters && portCounters->adapterKey == handle->port->adapterKey() &&
+      portCounters->counters.size() == portCounters->counterIds.size()) {
+    handle->port->setStats(portCounters->counterIds, portCounters->counters);
+    // The FEC counters hold what was cleared by the last read, so they have
+    // to be overwritten even if this read failed, or they are counted twice.
+    // A failed read is not expected to have cleared anything, the next read
+    // gets those errors.
+    handle->port->setStats(
+        portCounters->fecCounterIds,
+        portCounters->fecCounters.size() == portCounters->fecCounterIds.size()
+            ? portCounters->fecCounters
+            : std::vector<uint64_t>(portCounters->fecCounterIds.size(), 0));
+  } else {
+    handle->port->updateStats(supportedStats(portId), SAI_STATS_MODE_READ);
+    if (fecStatsSupported(portId)) {
+      std::vector<sai_stat_id_t> fecCounterIds{
+          SAI_PORT_STAT_IF_IN_FEC_CORRECTABLE_FRAMES,
+          SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES};
+      handle->port->updateStats(fecCounterIds, SAI_STATS_MODE_READ_AND_CLEAR);
+      // FEC counters are clear on read, so counters read ahead of time but
+      // not used already cleared what they read. Count it too.
+      if (portCounters && portCounters->fecCounterIds == fecCounterIds &&
+          portCounters->fecCounters.size() == fecCounterIds.size()) {
+        auto stats = handle->port->getStats();
+        std::vector<uint64_t> fecCounters;
+        for (size_t i = 0; i < fecCounterIds.size(); ++i) {
+          fecCounters.push_back(
+              stats[fecCounterIds[i]] + portCounters->fecCounters[i]);
+        }
+        handle->port->setStats(fecCounterIds, fecCounters);
+      }
+    }
   }
   const auto& counters = handle->port->getStats();
   fillHwPortStats(counters, managerTable_->debugCounterManager(), curPortStats);
@@ -27,6 +27,8 @@
 #include "folly/container/F14Map.h"
 #include "folly/container/F14Set.h"
 
+#include <optional>
+
 DECLARE_bool(sai_configure_six_tap);
 
 namespace facebook::fboss {
@@ -170,7 +172,32 @@ class SaiPortManager {
       PortSaiId portSaiId,
       cfg::SwitchType switchType) const;
 
-  void updateStats(PortID portID, bool updateWatermarks = false);
+  /*
+   * Port counters read from the adapter outside of the switch lock: the
+   * adapter key and counter ids are taken by prepareStats() under the
+   * lock, readStats() then reads the counters without touching any manager
+   * state and updateStats() applies them, again under the lock.
+   */
+  struct PortCounters {
+    PortSaiId adapterKey;
+    std::vector<sai_stat_id_t> counterIds;
+    std::vector<sai_stat_id_t> fecCounterIds;
+    std::vector<uint64_t> counters;
+    std::vector<uint64_t> fecCounters;
+  };
+  std::optional<PortCounters> prepareStats(PortID portID);
+  static void readStats(PortCounters& portCounters);
+
+  /*
+   * Counters in portCounters are used when they were read for the port's
+   * current adapter key, otherwise they are read here. The clear on read FEC
+   * counters in portCounters are counted either way, and count as zero if
+   * reading them failed.
+   */
+  void updateStats(
+      PortID portID,
+      bool updateWatermarks = false,
+      const PortCounters* portCounters = nullptr);
 
   void clearStats(PortID portID);
 
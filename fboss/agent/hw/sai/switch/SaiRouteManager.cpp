@@ -29,6 +29,12 @@ DEFINE_bool(
     false,
     "Disable valid route check when creating or changing routes in SAI switches");
 
+DEFINE_int32(
+    bulk_route_programming_size,
+    0,
+    "Maximum number of routes created or removed with a single bulk SAI call. "
+    "0 programs each route with its own call");
+
 namespace facebook::fboss {
 
 sai_object_id_t SaiRouteHandle::nextHopAdapterKey() const {
@@ -284,6 +290,22 @@ void SaiRouteManager::addOrUpdateRoute(
     XLOG(DBG3) << "Route action DROP: " << newRoute->str();
   }
   auto& store = saiStore_->get<SaiRouteTraits>();
+  if (FLAGS_bulk_route_programming_size > 0 && !store.get(entry)) {
+    // New route, create it along with other new routes. A route still
+    // waiting to be created is updated in place.
+    pendingRouteCreates_.insert_or_assign(
+        entry,
+        PendingRouteCreate{
+            routeHandle,
+            attributes.value(),
+            std::move(nextHopHandle),
+            std::move(counterHandle)});
+    if (pendingRouteCreates_.size() >=
+        static_cast<size_t>(FLAGS_bulk_route_programming_size)) {
+      programPendingRoutes();
+    }
+    return;
+  }
   auto route = store.setObject(entry, attributes.value());
   routeHandle->route = route;
   routeHandle->nexthopHandle_ = nextHopHandle;
@@ -340,11 +362,79 @@ void SaiRouteManager::removeRoute(
     RouterID routerId) {
   XLOG(DBG3) << "Remove route: " << swRoute->str();
   SaiRouteTraits::RouteEntry entry = routeEntryFromSwRoute(routerId, swRoute);
-  size_t count = handles_.erase(entry);
-  if (!count) {
+  auto itr = handles_.find(entry);
+  if (itr == handles_.end()) {
     throw FbossError(
         "Failed to remove non-existent route to ", swRoute->prefix().str());
   }
+  // Never create a route removed before it was programmed
+  pendingRouteCreates_.erase(entry);
+  if (FLAGS_bulk_route_programming_size > 0) {
+    pendingRouteRemoves_.push_back(std::move(itr->second));
+    handles_.erase(itr);
+    if (pendingRouteRemoves_.size() >=
+        static_cast<size_t>(FLAGS_bulk_route_programming_size)) {
+      programPendingRoutes();
+    }
+    return;
+  }
+  handles_.erase(itr);
+}
+
+void SaiRouteManager::programPendingRoutes() {
+  auto& store = saiStore_->get<SaiRouteTraits>();
+  if (!pendingRouteRemoves_.empty()) {
+    auto routeRemoves = std::move(pendingRouteRemoves_);
+    pendingRouteRemoves_.clear();
+    std::vector<std::shared_ptr<SaiRoute>> routes;
+    routes.reserve(routeRemoves.size());
+    for (const auto& routeHandle : routeRemoves) {
+      // A route object still referenced elsewhere is left to its last owner
+      if (routeHandle->route && routeHandle->route.use_count() == 1) {
+        routes.push_back(routeHandle->route);
+      }
+    }
+    XLOG(DBG3) << "Bulk remove " << routes.size() << " routes";
+    store.bulkRemoveObjects(routes);
+  }
+  if (!pendingRouteCreates_.empty()) {
+    auto routeCreates = std::move(pendingRouteCreates_);
+    pendingRouteCreates_.clear();
+    std::vector<SaiRouteTraits::RouteEntry> entries;
+    std::vector<SaiRouteTraits::CreateAttributes> attributes;
+    entries.reserve(routeCreates.size());
+    attributes.reserve(routeCreates.size());
+    for (const auto& [entry, routeCreate] : routeCreates) {
+      entries.push_back(entry);
+      attributes.push_back(routeCreate.attributes);
+    }
+    XLOG(DBG3) << "Bulk create " << entries.size() << " routes";
+    std::vector<std::shared_ptr<SaiRoute>> routes;
+    std::exception_ptr createError;
+    try {
+      store.bulkSetObjects(entries, attributes, routes);
+    } catch (const std::exception&) {
+      // Hand routes created ahead of the failing one to their handles below
+      // and keep the rest pending
+      createError = std::current_exception();
+    }
+    size_t i = 0;
+    for (auto& [entry, routeCreate] : routeCreates) {
+      auto& route = routes[i++];
+      if (!route) {
+        pendingRouteCreates_.emplace(entry, std::move(routeCreate));
+        continue;
+      }
+      routeCreate.routeHandle->route = route;
+      routeCreate.routeHandle->nexthopHandle_ =
+          std::move(routeCreate.nextHopHandle);
+      routeCreate.routeHandle->counterHandle_ =
+          std::move(routeCreate.counterHandle);
+    }
+    if (createError) {
+      std::rethrow_exception(createError);
+    }
+  }
 }
 
 SaiRouteHandle* SaiRouteManager::getRouteHandle(
@@ -370,6 +460,8 @@ SaiRouteHandle* SaiRouteManager::getRouteHandleImpl(
 }
 
 void SaiRouteManager::clear() {
+  pendingRouteCreates_.clear();
+  pendingRouteRemoves_.clear();
   handles_.clear();
 }
 
@@ -22,8 +22,10 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 DECLARE_bool(disable_valid_route_check);
+DECLARE_int32(bulk_route_programming_size);
 
 namespace facebook::fboss {
 
@@ -119,6 +121,13 @@ class SaiRouteManager {
   const SaiRouteHandle* getRouteHandle(
       const SaiRouteTraits::RouteEntry& entry) const;
 
+  /*
+   * With bulk_route_programming_size set, routes added or removed are not
+   * programmed right away, but queued and programmed with bulk SAI calls once
+   * that many are queued, or when this is called at the end of a FIB delta.
+   */
+  void programPendingRoutes();
+
   void clear();
 
   std::shared_ptr<SaiObject<SaiRouteTraits>> getRouteObject(
@@ -152,11 +161,26 @@ class SaiRouteManager {
       const std::shared_ptr<Route<AddrT>>& oldRoute,
       std::optional<SaiRouteTraits::Attributes::CounterID>& counterID);
 
+  // A new route waiting to be created, along with what its handle will hold
+  struct PendingRouteCreate {
+    SaiRouteHandle* routeHandle;
+    SaiRouteTraits::CreateAttributes attributes;
+    SaiRouteHandle::NextHopHandle nextHopHandle;
+    std::shared_ptr<SaiCounterHandle> counterHandle;
+  };
+
   SaiStore* saiStore_;
   SaiManagerTable* managerTable_;
   const SaiPlatform* platform_;
   folly::F14FastMap<SaiRouteTraits::RouteEntry, std::unique_ptr<SaiRouteHandle>>
       handles_;
+  // Keyed by route entry, so that a route updated or removed before it is
+  // created is queued at most once
+  folly::F14FastMap<SaiRouteTraits::RouteEntry, PendingRouteCreate>
+      pendingRouteCreates_;
+  // Handles of removed routes, kept until the routes are removed from HW so
+  // that next hops and counters are released only after the routes
+  std::vector<std::unique_ptr<SaiRouteHandle>> pendingRouteRemoves_;
 };
 
 } // namespace facebook::fboss
@@ -12,6 +12,7 @@
 #include "fboss/agent/Constants.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/LockPolicy.h"
+#include "fboss/agent/RestartTimeTracker.h"
 #include "fboss/agent/Utils.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/HwPortFb303Stats.h"
@@ -103,6 +104,13 @@ DEFINE_bool(
     false,
     "Fail if any warm boot handles are left unclaimed.");
 
+DEFINE_int32(
+    port_stats_read_threads,
+    0,
+    "Number of threads reading port counters from the adapter without "
+    "holding the switch lock during stats collection. 0 reads them under the "
+    "lock, one port at a time.");
+
 DECLARE_bool(enable_acl_table_group);
 
 DEFINE_bool(
@@ -672,6 +680,10 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
       &SaiRouterInterfaceManager::addRemoteRouterInterface,
       &SaiRouterInterfaceManager::removeRemoteRouterInterface);
 
+  // Neighbors are programmed one at a time, unlike routes: creating a
+  // neighbor notifies the next hops subscribed to it, and routes in this
+  // delta may only be programmed once those next hops exist.
+  //
   // For VOQ switches, neighbor tables live on port based
   // RIFs
   auto processNeighborDeltaForIntfs = [this,
@@ -732,6 +744,8 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
         &SaiRouteManager::addRoute<folly::IPAddressV4>,
         &SaiRouteManager::removeRoute<folly::IPAddressV4>,
         rid);
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().programPendingRoutes();
   };
 
   auto processV6RoutesDelta = [this, &lockPolicy](
@@ -744,6 +758,8 @@ std::shared_ptr<SwitchState> SaiSwitch::stateChangedImpl(
         &SaiRouteManager::addRoute<folly::IPAddressV6>,
         &SaiRouteManager::removeRoute<folly::IPAddressV6>,
         rid);
+    [[maybe_unused]] const auto& lock = lockPolicy.lock();
+    managerTable_->routeManager().programPendingRoutes();
   };
 
   for (const auto& routeDelta : delta.getFibsDelta()) {
@@ -1843,7 +1859,16 @@ void SaiSwitch::initStoreAndManagersLocked(
     const folly::dynamic* adapterKeys,
     const folly::dynamic* adapterKeys2AdapterHostKeys) {
   saiStore_->setSwitchId(switchId_);
+  auto reloadBegin = std::chrono::steady_clock::now();
   saiStore_->reload(adapterKeys, adapterKeys2AdapterHostKeys);
+  restart_time::markDuration(
+      "sai_store_reload",
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - reloadBegin));
+  for (const auto& [objectType, duration] : saiStore_->reloadDurations()) {
+    restart_time::markDuration(
+        folly::to<std::string>("sai_store_reload.", objectType), duration);
+  }
   managerTable_->createSaiTableManagers(
       saiStore_.get(), platform_, concurrentIndices_.get());
   /*
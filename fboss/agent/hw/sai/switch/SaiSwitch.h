@@ -20,6 +20,7 @@
 #include "fboss/agent/platforms/sai/SaiPlatform.h"
 #include "folly/MacAddress.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/io/async/EventBase.h>
 #include "fboss/agent/hw/switch_asics/HwAsic.h"
 
@@ -28,6 +29,7 @@
 #include <thread>
 
 DECLARE_int32(update_watermark_stats_interval_s);
+DECLARE_int32(port_stats_read_threads);
 DECLARE_bool(force_recreate_acl_tables);
 
 namespace facebook::fboss {
@@ -506,6 +508,9 @@ class SaiSwitch : public HwSwitch {
   std::atomic<SwitchRunState> runState_{SwitchRunState::UNINITIALIZED};
 
   int64_t watermarkStatsUpdateTime_{0};
+  // Reads port counters outside of saiSwitchMutex_, created on first use if
+  // port_stats_read_threads > 1
+  std::unique_ptr<folly::CPUThreadPoolExecutor> portStatsReadExecutor_;
   cfg::AsicType asicType_;
   cfg::SwitchType switchType_{cfg::SwitchType::NPU};
 
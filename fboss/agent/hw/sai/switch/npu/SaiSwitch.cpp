@@ -21,6 +21,10 @@
 #include "fboss/agent/hw/sai/switch/SaiPortManager.h"
 #include "fboss/agent/hw/sai/switch/SaiSystemPortManager.h"
 
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
+#include <folly/logging/xlog.h>
+
 namespace facebook::fboss {
 void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
   auto now =
@@ -31,12 +35,56 @@ void SaiSwitch::updateStatsImpl(SwitchStats* /* switchStats */) {
     watermarkStatsUpdateTime_ = now;
   }
 
+  // Port counters are read without holding saiSwitchMutex_ so that stats
+  // collection does not hold off state programming for the duration of the
+  // reads. Only adapter keys and counter ids are taken under the lock.
+  std::map<PortID, SaiPortManager::PortCounters> portCounters;
+  if (FLAGS_port_stats_read_threads > 0) {
+    {
+      std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      for (const auto& portIdAndSaiId : concurrentIndices_->portIds) {
+        auto counters =
+            managerTable_->portManager().prepareStats(portIdAndSaiId.second);
+        if (counters) {
+          portCounters.emplace(portIdAndSaiId.second, std::move(*counters));
+        }
+      }
+    }
+    if (FLAGS_port_stats_read_threads > 1 && !portStatsReadExecutor_) {
+      portStatsReadExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+          FLAGS_port_stats_read_threads,
+          std::make_shared<folly::NamedThreadFactory>("portStatsRead"));
+    }
+    std::vector<folly::Future<folly::Unit>> read;
+    read.reserve(portCounters.size());
+    for (auto& portIdAndCounters : portCounters) {
+      read.push_back(folly::via(
+          FLAGS_port_stats_read_threads > 1
+              ? static_cast<folly::Executor*>(portStatsReadExecutor_.get())
+              : &folly::InlineExecutor::instance(),
+          [&counters = portIdAndCounters.second] {
+            SaiPortManager::readStats(counters);
+          }));
+    }
+    for (auto& result : folly::collectAll(std::move(read)).get()) {
+      if (result.hasException()) {
+        // Port may have gone away since its adapter key was taken, its
+        // counters are read again (if it still exists) under the lock
+        XLOG(DBG2) << "Failed to read port counters: "
+                   << result.exception().what();
+      }
+    }
+  }
+
   auto portsIter = concurrentIndices_->portIds.begin();
   while (portsIter != concurrentIndices_->portIds.end()) {
     {
       std::lock_guard<std::mutex> locked(saiSwitchMutex_);
+      auto counters = portCounters.find(portsIter->second);
       managerTable_->portManager().updateStats(
-          portsIter->second, updateWatermarks);
+          portsIter->second,
+          updateWatermarks,
+          counters != portCounters.end() ? &counters->second : nullptr);
       auto endpointOpt =
           managerTable_->portManager().getFabricReachabilityForPort(
               portsIter->second);
@@ -7,12 +7,19 @@
  *  of patent rights can be found in the PATENTS file in the same directory.
  *
  */
+#include "fboss/agent/AclPriorityAllocator.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableGroupManager.h"
 #include "fboss/agent/hw/sai/switch/SaiAclTableManager.h"
 #include "fboss/agent/hw/sai/switch/SaiSwitch.h"
 #include "fboss/agent/hw/sai/switch/tests/ManagerTestBase.h"
+#include "fboss/agent/state/AclMap.h"
+#include "fboss/agent/state/AclTable.h"
+#include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/types.h"
 
+#include <algorithm>
+#include <limits>
+#include <set>
 #include <string>
 
 using namespace facebook::fboss;
@@ -46,6 +53,76 @@ class AclTableManagerTest : public ManagerTestBase {
   cfg::AclActionType kActionType() {
     return cfg::AclActionType::DENY;
   }
+
+  // Acls named in order of precedence, with priorities allocated keeping
+  // those of programmed acls, as ThriftConfigApplier does
+  std::shared_ptr<AclMap> makeAcls(
+      const std::vector<std::string>& aclNames,
+      int priorityGap) {
+    std::vector<std::optional<int>> existingPriorities;
+    for (const auto& aclName : aclNames) {
+      auto origAcl = programmedState->getAcls()->getEntryIf(aclName);
+      existingPriorities.push_back(
+          origAcl ? std::make_optional(origAcl->getPriority())
+                  : std::nullopt);
+    }
+    auto priorities = AclPriorityAllocator(
+                          AclTable::kDataplaneAclMaxPriority,
+                          std::numeric_limits<int>::max(),
+                          priorityGap)
+                          .allocate(existingPriorities);
+    auto acls = std::make_shared<AclMap>();
+    for (size_t i = 0; i < aclNames.size(); ++i) {
+      auto acl = std::make_shared<AclEntry>(priorities[i], aclNames[i]);
+      acl->setDscp(kDscp());
+      acl->setActionType(kActionType());
+      acls->addEntry(acl);
+    }
+    return acls;
+  }
+
+  std::set<sai_object_id_t> aclEntryIds() const {
+    std::set<sai_object_id_t> ids;
+    for (const auto& idAndEntry : fs->aclEntryManager.map()) {
+      ids.insert(idAndEntry.first);
+    }
+    return ids;
+  }
+
+  // Number of acl entries created and removed in SAI to program acls
+  std::pair<int, int> programAcls(const std::shared_ptr<AclMap>& acls) {
+    auto idsBefore = aclEntryIds();
+    auto newState = programmedState->clone();
+    newState->resetAcls(acls);
+    applyNewState(newState);
+    auto idsAfter = aclEntryIds();
+    std::vector<sai_object_id_t> created;
+    std::set_difference(
+        idsAfter.begin(),
+        idsAfter.end(),
+        idsBefore.begin(),
+        idsBefore.end(),
+        std::back_inserter(created));
+    std::vector<sai_object_id_t> removed;
+    std::set_difference(
+        idsBefore.begin(),
+        idsBefore.end(),
+        idsAfter.begin(),
+        idsAfter.end(),
+        std::back_inserter(removed));
+    return std::make_pair(created.size(), removed.size());
+  }
+
+  // Entries created and removed inserting an acl ahead of numAcls others
+  std::pair<int, int> insertAclAtHead(int numAcls, int priorityGap) {
+    std::vector<std::string> aclNames;
+    for (auto i = 0; i < numAcls; ++i) {
+      aclNames.push_back("acl" + std::to_string(i));
+    }
+    programAcls(makeAcls(aclNames, priorityGap));
+    aclNames.insert(aclNames.begin(), "head");
+    return programAcls(makeAcls(aclNames, priorityGap));
+  }
 };
 
 TEST_F(AclTableManagerTest, addAclTable) {
@@ -235,6 +312,16 @@ TEST_F(AclTableManagerTest, checkNonExistentAclEntry) {
   EXPECT_FALSE(aclEntryHandle);
 }
 
+TEST_F(AclTableManagerTest, insertAclAtHeadDensePriorities) {
+  // Every acl after the inserted one moves down a priority
+  EXPECT_EQ(insertAclAtHead(100, 1), std::make_pair(101, 100));
+}
+
+TEST_F(AclTableManagerTest, insertAclAtHeadSparsePriorities) {
+  // The inserted acl takes a free priority, no other acl is reprogrammed
+  EXPECT_EQ(insertAclAtHead(100, 16), std::make_pair(1, 0));
+}
+
 TEST_F(AclTableManagerTest, aclMirroring) {
   std::string mirrorId = "mirror1";
   auto mirror = std::make_shared<Mirror>(
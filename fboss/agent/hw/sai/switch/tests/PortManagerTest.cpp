@@ -362,6 +362,33 @@ TEST_F(PortManagerTest, updateStats) {
   }
 }
 
+TEST_F(PortManagerTest, updateStatsFailedFecRead) {
+  std::shared_ptr<Port> swPort = makePort(p0);
+  auto& portManager = saiManagerTable->portManager();
+  portManager.addPort(swPort);
+  std::vector<sai_stat_id_t> fecCounterIds{
+      SAI_PORT_STAT_IF_IN_FEC_CORRECTABLE_FRAMES,
+      SAI_PORT_STAT_IF_IN_FEC_NOT_CORRECTABLE_FRAMES};
+  // Errors cleared by the last FEC read
+  portManager.getPortHandle(swPort->getID())
+      ->port->setStats(fecCounterIds, {5, 3});
+  portManager.updateStats(swPort->getID());
+  auto portStats = portManager.getPortStats()[swPort->getID()];
+  EXPECT_EQ(*portStats.fecCorrectableErrors(), 5);
+  EXPECT_EQ(*portStats.fecUncorrectableErrors(), 3);
+
+  auto portCounters = portManager.prepareStats(swPort->getID());
+  ASSERT_TRUE(portCounters.has_value());
+  SaiPortManager::readStats(*portCounters);
+  // Reading the FEC counters failed
+  portCounters->fecCounterIds = fecCounterIds;
+  portCounters->fecCounters.clear();
+  portManager.updateStats(swPort->getID(), false, &*portCounters);
+  portStats = portManager.getPortStats()[swPort->getID()];
+  EXPECT_EQ(*portStats.fecCorrectableErrors(), 5);
+  EXPECT_EQ(*portStats.fecUncorrectableErrors(), 3);
+}
+
 TEST_F(PortManagerTest, portDisableStopsCounterExport) {
   std::shared_ptr<Port> swPort = makePort(p0);
   CHECK(swPort->isEnabled());
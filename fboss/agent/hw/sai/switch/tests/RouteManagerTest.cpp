@@ -386,3 +386,69 @@ TEST_F(ToMeRouteTest, toMeRoutesSlash32) {
   r->setConnected();
   saiManagerTable->routeManager().addRoute<folly::IPAddressV4>(r, RouterID(0));
 }
+
+TEST_F(RouteManagerTest, bulkAddRemoveRoutes) {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  gflags::FlagSaver flagSaver;
+  FLAGS_bulk_route_programming_size = 16;
+  auto& routeManager = saiManagerTable->routeManager();
+  auto numRoutes = fs->routeManager.map().size();
+  auto numNextHopGroups = fs->nextHopGroupManager.map().size();
+  tr2.nextHopInterfaces = tr1.nextHopInterfaces;
+  auto r1 = makeRoute(tr1);
+  auto r2 = makeRoute(tr2);
+  auto entry1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto entry2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+
+  // Routes are queued until programmed, next hop groups are not
+  EXPECT_FALSE(routeManager.getRouteHandle(entry1)->route);
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+  EXPECT_EQ(fs->nextHopGroupManager.map().size(), numNextHopGroups + 1);
+  routeManager.programPendingRoutes();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 2);
+  for (const auto& entry : {entry1, entry2}) {
+    auto routeHandle = routeManager.getRouteHandle(entry);
+    ASSERT_TRUE(routeHandle->route);
+    EXPECT_EQ(
+        saiApiTable->routeApi().getAttribute(
+            entry, SaiRouteTraits::Attributes::NextHopId{}),
+        routeHandle->nextHopAdapterKey());
+  }
+
+  routeManager.removeRoute(r1, RouterID(0));
+  routeManager.removeRoute(r2, RouterID(0));
+  EXPECT_FALSE(routeManager.getRouteHandle(entry1));
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 2);
+  routeManager.programPendingRoutes();
+  // Next hop group is released once no route points to it
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes);
+  EXPECT_EQ(fs->nextHopGroupManager.map().size(), numNextHopGroups);
+#endif
+}
+
+TEST_F(RouteManagerTest, bulkChangeRemovePendingRoutes) {
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  gflags::FlagSaver flagSaver;
+  FLAGS_bulk_route_programming_size = 16;
+  auto& routeManager = saiManagerTable->routeManager();
+  auto numRoutes = fs->routeManager.map().size();
+  auto r1 = makeRoute(tr1);
+  auto r2 = makeRoute(tr2);
+  auto entry1 = routeManager.routeEntryFromSwRoute(RouterID(0), r1);
+  auto entry2 = routeManager.routeEntryFromSwRoute(RouterID(0), r2);
+  routeManager.addRoute<folly::IPAddressV4>(r1, RouterID(0));
+  routeManager.addRoute<folly::IPAddressV4>(r2, RouterID(0));
+
+  // A route changed before it is created is created once, and a route
+  // removed before it is created is not created at all
+  routeManager.changeRoute<folly::IPAddressV4>(
+      r1, makeRoute(tr1), RouterID(0));
+  routeManager.removeRoute(r2, RouterID(0));
+  routeManager.programPendingRoutes();
+  EXPECT_EQ(fs->routeManager.map().size(), numRoutes + 1);
+  ASSERT_TRUE(routeManager.getRouteHandle(entry1)->route);
+  EXPECT_FALSE(routeManager.getRouteHandle(entry2));
+#endif
+}
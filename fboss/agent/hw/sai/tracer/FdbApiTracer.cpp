@@ -66,6 +66,47 @@ sai_status_t wrap_get_fdb_entry_attribute(
       fdb_entry, attr_count, attr_list);
 }
 
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+sai_status_t wrap_create_fdb_entries(
+    uint32_t object_count,
+    const sai_fdb_entry_t* fdb_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto rv = SaiTracer::getInstance()->fdbApi_->create_fdb_entries(
+      object_count, fdb_entry, attr_count, attr_list, mode, object_statuses);
+
+  // Bulk calls are logged as the single calls they executed
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (object_statuses[i] == SAI_STATUS_NON_EXECUTED) {
+      continue;
+    }
+    SaiTracer::getInstance()->logFdbEntryCreateFn(
+        &fdb_entry[i], attr_count[i], attr_list[i], object_statuses[i]);
+  }
+  return rv;
+}
+
+sai_status_t wrap_remove_fdb_entries(
+    uint32_t object_count,
+    const sai_fdb_entry_t* fdb_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto rv = SaiTracer::getInstance()->fdbApi_->remove_fdb_entries(
+      object_count, fdb_entry, mode, object_statuses);
+
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (object_statuses[i] == SAI_STATUS_NON_EXECUTED) {
+      continue;
+    }
+    SaiTracer::getInstance()->logFdbEntryRemoveFn(
+        &fdb_entry[i], object_statuses[i]);
+  }
+  return rv;
+}
+#endif
+
 sai_fdb_api_t* wrappedFdbApi() {
   static sai_fdb_api_t fdbWrappers;
 
@@ -73,6 +114,10 @@ sai_fdb_api_t* wrappedFdbApi() {
   fdbWrappers.remove_fdb_entry = &wrap_remove_fdb_entry;
   fdbWrappers.set_fdb_entry_attribute = &wrap_set_fdb_entry_attribute;
   fdbWrappers.get_fdb_entry_attribute = &wrap_get_fdb_entry_attribute;
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  fdbWrappers.create_fdb_entries = &wrap_create_fdb_entries;
+  fdbWrappers.remove_fdb_entries = &wrap_remove_fdb_entries;
+#endif
 
   return &fdbWrappers;
 }
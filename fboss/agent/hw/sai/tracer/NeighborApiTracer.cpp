@@ -75,6 +75,52 @@ sai_status_t wrap_remove_all_neighbor_entries(sai_object_id_t switch_id) {
       switch_id);
 }
 
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+sai_status_t wrap_create_neighbor_entries(
+    uint32_t object_count,
+    const sai_neighbor_entry_t* neighbor_entry,
+    const uint32_t* attr_count,
+    const sai_attribute_t** attr_list,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto rv = SaiTracer::getInstance()->neighborApi_->create_neighbor_entries(
+      object_count,
+      neighbor_entry,
+      attr_count,
+      attr_list,
+      mode,
+      object_statuses);
+
+  // Bulk calls are logged as the single calls they executed
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (object_statuses[i] == SAI_STATUS_NON_EXECUTED) {
+      continue;
+    }
+    SaiTracer::getInstance()->logNeighborEntryCreateFn(
+        &neighbor_entry[i], attr_count[i], attr_list[i], object_statuses[i]);
+  }
+  return rv;
+}
+
+sai_status_t wrap_remove_neighbor_entries(
+    uint32_t object_count,
+    const sai_neighbor_entry_t* neighbor_entry,
+    sai_bulk_op_error_mode_t mode,
+    sai_status_t* object_statuses) {
+  auto rv = SaiTracer::getInstance()->neighborApi_->remove_neighbor_entries(
+      object_count, neighbor_entry, mode, object_statuses);
+
+  for (uint32_t i = 0; i < object_count; ++i) {
+    if (object_statuses[i] == SAI_STATUS_NON_EXECUTED) {
+      continue;
+    }
+    SaiTracer::getInstance()->logNeighborEntryRemoveFn(
+        &neighbor_entry[i], object_statuses[i]);
+  }
+  return rv;
+}
+#endif
+
 sai_neighbor_api_t* wrappedNeighborApi() {
   static sai_neighbor_api_t neighborWrappers;
 
@@ -86,6 +132,10 @@ sai_neighbor_api_t* wrappedNeighborApi() {
       &wrap_get_neighbor_entry_attribute;
   neighborWrappers.remove_all_neighbor_entries =
       &wrap_remove_all_neighbor_entries;
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
+  neighborWrappers.create_neighbor_entries = &wrap_create_neighbor_entries;
+  neighborWrappers.remove_neighbor_entries = &wrap_remove_neighbor_entries;
+#endif
 
   return &neighborWrappers;
 }
@@ -62,6 +62,14 @@ WRAP_BULK_SET_ATTR_FUNC(
     next_hop_group_member,
     SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
     nextHopGroup);
+WRAP_BULK_CREATE_FUNC(
+    next_hop_group_member,
+    SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+    nextHopGroup);
+WRAP_BULK_REMOVE_FUNC(
+    next_hop_group_member,
+    SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER,
+    nextHopGroup);
 #endif
 WRAP_GET_ATTR_FUNC(
     next_hop_group_member,
@@ -86,6 +94,10 @@ sai_next_hop_group_api_t* wrappedNextHopGroupApi() {
 #if SAI_API_VERSION >= SAI_VERSION(1, 10, 0)
   nextHopGroupWrappers.set_next_hop_group_members_attribute =
       &wrap_set_next_hop_group_members_attribute;
+  nextHopGroupWrappers.create_next_hop_group_members =
+      &wrap_create_next_hop_group_members;
+  nextHopGroupWrappers.remove_next_hop_group_members =
+      &wrap_remove_next_hop_group_members;
 #endif
   nextHopGroupWrappers.get_next_hop_group_member_attribute =
       &wrap_get_next_hop_group_member_attribute;
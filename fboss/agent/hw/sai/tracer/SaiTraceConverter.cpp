@@ -0,0 +1,360 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/hw/sai/tracer/SaiTraceConverter.h"
+
+#include <cstring>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/PortApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SwitchApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/TamApiTracer.h"
+
+DECLARE_int32(default_list_size);
+DECLARE_int32(default_list_count);
+DECLARE_string(sai_replayer_sdk_log_level);
+
+namespace facebook::fboss {
+
+namespace {
+// Size of the record at the start of data, 0 if data does not hold all of it
+size_t recordSize(folly::ByteRange data) {
+  uint32_t size;
+  constexpr auto kHeaderSize = sizeof(size) + sizeof(SaiTraceRecordType) +
+      sizeof(std::chrono::system_clock::time_point);
+  if (data.size() < sizeof(size)) {
+    return 0;
+  }
+  std::memcpy(&size, data.data(), sizeof(size));
+  return size >= kHeaderSize && size <= data.size() ? size : 0;
+}
+
+template <typename Fn>
+void forEachRecord(folly::ByteRange session, Fn fn) {
+  while (auto size = recordSize(session)) {
+    SaiTraceRecordReader record(session.subpiece(0, size));
+    session.advance(size);
+    if (!fn(record)) {
+      return;
+    }
+  }
+}
+} // namespace
+
+std::vector<folly::ByteRange> SaiTraceConverter::findSessions(
+    folly::ByteRange log) {
+  std::vector<folly::ByteRange> sessions;
+  auto magic = folly::ByteRange(kSaiTraceMagic);
+  while (true) {
+    auto pos = log.find(magic);
+    if (pos == folly::ByteRange::npos) {
+      return sessions;
+    }
+    log.advance(pos + magic.size());
+    // The session ends after its SESSION_END record, or with the last whole
+    // record if the traced process did not exit cleanly. Text in between
+    // sessions, such as the boot header, is skipped.
+    auto session = log;
+    while (auto size = recordSize(log)) {
+      SaiTraceRecordReader record(log.subpiece(0, size));
+      log.advance(size);
+      if (record.type() == SaiTraceRecordType::SESSION_END) {
+        break;
+      }
+    }
+    sessions.push_back(session.subpiece(0, session.size() - log.size()));
+  }
+}
+
+void SaiTraceConverter::setFlags(folly::ByteRange session) {
+  auto size = recordSize(session);
+  if (!size) {
+    throw FbossError("Empty sai trace session");
+  }
+  SaiTraceRecordReader record(session.subpiece(0, size));
+  if (record.type() != SaiTraceRecordType::SESSION_START) {
+    throw FbossError("Sai trace session does not start with its flags");
+  }
+  FLAGS_enable_packet_log = record.read<bool>();
+  FLAGS_enable_elapsed_time_log = record.read<bool>();
+  FLAGS_enable_get_attr_log = record.read<bool>();
+  FLAGS_default_list_size = record.read<int32_t>();
+  FLAGS_default_list_count = record.read<int32_t>();
+  FLAGS_sai_replayer_sdk_log_level = record.readString();
+}
+
+SaiTraceConverter::SaiTraceConverter(std::shared_ptr<SaiTracer> tracer)
+    : tracer_(std::move(tracer)) {
+  // Register the extension attributes, as querying the APIs does in the
+  // traced process
+  wrappedPortApi();
+  wrappedSwitchApi();
+  wrappedTamApi();
+}
+
+bool SaiTraceConverter::convert(folly::ByteRange session) {
+  bool complete = false;
+  forEachRecord(session, [&](SaiTraceRecordReader& record) {
+    if (record.type() == SaiTraceRecordType::SESSION_END) {
+      complete = true;
+      return false;
+    }
+    tracer_->replayTime_ = record.time();
+    convertRecord(record);
+    return true;
+  });
+  tracer_->replayTime_.reset();
+  return complete;
+}
+
+void SaiTraceConverter::convertRecord(SaiTraceRecordReader& record) {
+  switch (record.type()) {
+    case SaiTraceRecordType::SESSION_START:
+    case SaiTraceRecordType::SESSION_END:
+      break;
+    case SaiTraceRecordType::API_INITIALIZE: {
+      auto size = record.read<int>();
+      std::vector<std::string> variables;
+      std::vector<std::string> values;
+      for (int i = 0; i < size; ++i) {
+        variables.push_back(record.readString());
+        values.push_back(record.readString());
+      }
+      std::vector<const char*> variablePtrs;
+      std::vector<const char*> valuePtrs;
+      for (int i = 0; i < size; ++i) {
+        variablePtrs.push_back(variables[i].c_str());
+        valuePtrs.push_back(values[i].c_str());
+      }
+      tracer_->logApiInitialize(variablePtrs.data(), valuePtrs.data(), size);
+      break;
+    }
+    case SaiTraceRecordType::API_UNINITIALIZE:
+      tracer_->logApiUninitialize();
+      break;
+    case SaiTraceRecordType::API_QUERY: {
+      auto apiId = record.read<sai_api_t>();
+      tracer_->logApiQuery(apiId, record.readString());
+      break;
+    }
+    case SaiTraceRecordType::GET_OBJECT_KEY: {
+      auto objectType = record.read<sai_object_type_t>();
+      auto objectCount = record.read<uint32_t>();
+      auto hasObjectList = record.read<uint8_t>();
+      std::vector<sai_object_key_t> objectList(objectCount);
+      if (hasObjectList) {
+        for (auto& object : objectList) {
+          object.key.object_id = record.read<sai_object_id_t>();
+        }
+      }
+      tracer_->logGetObjectKeyFn(
+          objectType, objectCount, hasObjectList ? objectList.data() : nullptr);
+      break;
+    }
+    case SaiTraceRecordType::SWITCH_CREATE: {
+      auto attrs = record.readAttributes();
+      sai_object_id_t switchId{SAI_NULL_OBJECT_ID};
+      tracer_->logSwitchCreateFn(&switchId, attrs.size(), attrs.data());
+      break;
+    }
+    case SaiTraceRecordType::ROUTE_ENTRY_CREATE: {
+      auto entry = record.read<sai_route_entry_t>();
+      auto attrs = record.readAttributes();
+      tracer_->logRouteEntryCreateFn(&entry, attrs.size(), attrs.data());
+      break;
+    }
+    case SaiTraceRecordType::NEIGHBOR_ENTRY_CREATE: {
+      auto entry = record.read<sai_neighbor_entry_t>();
+      auto attrs = record.readAttributes();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logNeighborEntryCreateFn(
+          &entry, attrs.size(), attrs.data(), rv);
+      break;
+    }
+    case SaiTraceRecordType::FDB_ENTRY_CREATE: {
+      auto entry = record.read<sai_fdb_entry_t>();
+      auto attrs = record.readAttributes();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logFdbEntryCreateFn(&entry, attrs.size(), attrs.data(), rv);
+      break;
+    }
+    case SaiTraceRecordType::INSEG_ENTRY_CREATE: {
+      auto entry = record.read<sai_inseg_entry_t>();
+      auto attrs = record.readAttributes();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logInsegEntryCreateFn(&entry, attrs.size(), attrs.data(), rv);
+      break;
+    }
+    case SaiTraceRecordType::CREATE: {
+      auto fnName = record.readString();
+      auto switchId = record.read<sai_object_id_t>();
+      auto objectType = record.read<sai_object_type_t>();
+      auto attrs = record.readAttributes();
+      // Only known after the call, from the POST_INVOCATION record
+      sai_object_id_t objectId{SAI_NULL_OBJECT_ID};
+      createdVarName_ = tracer_->logCreateFn(
+          fnName, &objectId, switchId, attrs.size(), attrs.data(), objectType);
+      break;
+    }
+    case SaiTraceRecordType::ROUTE_ENTRY_REMOVE: {
+      auto entry = record.read<sai_route_entry_t>();
+      tracer_->logRouteEntryRemoveFn(&entry);
+      break;
+    }
+    case SaiTraceRecordType::NEIGHBOR_ENTRY_REMOVE: {
+      auto entry = record.read<sai_neighbor_entry_t>();
+      tracer_->logNeighborEntryRemoveFn(&entry, record.read<sai_status_t>());
+      break;
+    }
+    case SaiTraceRecordType::FDB_ENTRY_REMOVE: {
+      auto entry = record.read<sai_fdb_entry_t>();
+      tracer_->logFdbEntryRemoveFn(&entry, record.read<sai_status_t>());
+      break;
+    }
+    case SaiTraceRecordType::INSEG_ENTRY_REMOVE: {
+      auto entry = record.read<sai_inseg_entry_t>();
+      tracer_->logInsegEntryRemoveFn(&entry, record.read<sai_status_t>());
+      break;
+    }
+    case SaiTraceRecordType::REMOVE: {
+      auto fnName = record.readString();
+      auto objectId = record.read<sai_object_id_t>();
+      tracer_->logRemoveFn(
+          fnName, objectId, record.read<sai_object_type_t>());
+      break;
+    }
+    case SaiTraceRecordType::ROUTE_ENTRY_SET_ATTR: {
+      auto entry = record.read<sai_route_entry_t>();
+      auto attrs = record.readAttributes();
+      tracer_->logRouteEntrySetAttrFn(&entry, attrs.data());
+      break;
+    }
+    case SaiTraceRecordType::NEIGHBOR_ENTRY_SET_ATTR: {
+      auto entry = record.read<sai_neighbor_entry_t>();
+      auto attrs = record.readAttributes();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logNeighborEntrySetAttrFn(&entry, attrs.data(), rv);
+      break;
+    }
+    case SaiTraceRecordType::FDB_ENTRY_SET_ATTR: {
+      auto entry = record.read<sai_fdb_entry_t>();
+      auto attrs = record.readAttributes();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logFdbEntrySetAttrFn(&entry, attrs.data(), rv);
+      break;
+    }
+    case SaiTraceRecordType::INSEG_ENTRY_SET_ATTR: {
+      auto entry = record.read<sai_inseg_entry_t>();
+      auto attrs = record.readAttributes();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logInsegEntrySetAttrFn(&entry, attrs.data(), rv);
+      break;
+    }
+    case SaiTraceRecordType::GET_ATTR: {
+      auto fnName = record.readString();
+      auto objectId = record.read<sai_object_id_t>();
+      auto objectType = record.read<sai_object_type_t>();
+      auto attrs = record.readAttributes();
+      tracer_->logGetAttrFn(
+          fnName, objectId, attrs.size(), attrs.data(), objectType);
+      break;
+    }
+    case SaiTraceRecordType::SET_ATTR: {
+      auto fnName = record.readString();
+      auto objectId = record.read<sai_object_id_t>();
+      auto objectType = record.read<sai_object_type_t>();
+      auto attrs = record.readAttributes();
+      tracer_->logSetAttrFn(fnName, objectId, attrs.data(), objectType);
+      break;
+    }
+    case SaiTraceRecordType::BULK_SET_ATTR: {
+      auto fnName = record.readString();
+      auto objectIds = record.readArray<sai_object_id_t>();
+      auto attrs = record.readAttributes();
+      auto mode = record.read<sai_bulk_op_error_mode_t>();
+      auto objectStatuses = record.readArray<sai_status_t>();
+      auto objectType = record.read<sai_object_type_t>();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logBulkSetAttrFn(
+          fnName,
+          objectIds.size(),
+          objectIds.data(),
+          attrs.data(),
+          mode,
+          objectStatuses.data(),
+          objectType,
+          rv);
+      break;
+    }
+    case SaiTraceRecordType::SEND_HOSTIF_PACKET: {
+      auto hostifId = record.read<sai_object_id_t>();
+      auto buffer = record.readArray<uint8_t>();
+      auto attrs = record.readAttributes();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logSendHostifPacketFn(
+          hostifId,
+          buffer.size(),
+          buffer.data(),
+          attrs.size(),
+          attrs.data(),
+          rv);
+      break;
+    }
+    case SaiTraceRecordType::GET_STATS: {
+      auto fnName = record.readString();
+      auto objectId = record.read<sai_object_id_t>();
+      auto counterIds = record.readArray<sai_stat_id_t>();
+      auto counters = record.readArray<uint64_t>();
+      auto objectType = record.read<sai_object_type_t>();
+      auto rv = record.read<sai_status_t>();
+      auto mode = record.read<int>();
+      tracer_->logGetStatsFn(
+          fnName,
+          objectId,
+          counterIds.size(),
+          counterIds.data(),
+          counters.data(),
+          objectType,
+          rv,
+          mode);
+      break;
+    }
+    case SaiTraceRecordType::CLEAR_STATS: {
+      auto fnName = record.readString();
+      auto objectId = record.read<sai_object_id_t>();
+      auto counterIds = record.readArray<sai_stat_id_t>();
+      auto objectType = record.read<sai_object_type_t>();
+      auto rv = record.read<sai_status_t>();
+      tracer_->logClearStatsFn(
+          fnName,
+          objectId,
+          counterIds.size(),
+          counterIds.data(),
+          objectType,
+          rv);
+      break;
+    }
+    case SaiTraceRecordType::POST_INVOCATION: {
+      auto rv = record.read<sai_status_t>();
+      auto objectId = record.read<sai_object_id_t>();
+      auto begin = record.read<std::chrono::system_clock::time_point>();
+      auto isCreate = record.read<bool>();
+      tracer_->logPostInvocation(
+          rv,
+          objectId,
+          begin,
+          isCreate ? std::make_optional(createdVarName_)
+                   : std::optional<std::string>());
+      break;
+    }
+  }
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <folly/Range.h>
+
+#include "fboss/agent/hw/sai/tracer/SaiTraceRecord.h"
+
+namespace facebook::fboss {
+
+class SaiTracer;
+
+/*
+ * Generates the replayable C code of a binary replayer log, by calling the
+ * SaiTracer log functions of the text logger with the arguments of each
+ * record. The tracer must be created with --enable_replayer and without
+ * --enable_binary_replayer_log.
+ */
+class SaiTraceConverter {
+ public:
+  // Binary sessions in a replayer log, one per run of the traced process
+  static std::vector<folly::ByteRange> findSessions(folly::ByteRange log);
+
+  // Sets the tracer flags the session was recorded with. Must be called
+  // before the SaiTracer is created, as it writes the globals.
+  static void setFlags(folly::ByteRange session);
+
+  explicit SaiTraceConverter(std::shared_ptr<SaiTracer> tracer);
+
+  // Returns false if the session is cut short, e.g. by a crash
+  bool convert(folly::ByteRange session);
+
+ private:
+  void convertRecord(SaiTraceRecordReader& record);
+
+  std::shared_ptr<SaiTracer> tracer_;
+  // Variable of the last create call, assigned its object id by the
+  // POST_INVOCATION record that follows
+  std::string createdVarName_;
+};
+
+} // namespace facebook::fboss
@@ -0,0 +1,361 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <cstddef>
+#include <cstring>
+#include <unordered_map>
+
+#include "fboss/agent/FbossError.h"
+#include "fboss/agent/hw/sai/tracer/AclApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/BridgeApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/BufferApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/CounterApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/DebugCounterApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/FdbApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/HashApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/HostifApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/LagApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/MacsecApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/MirrorApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/MplsApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/NeighborApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/NextHopApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/NextHopGroupApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/PortApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/QosMapApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/QueueApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/RouteApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/RouterInterfaceApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SaiTraceRecord.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SamplePacketApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SchedulerApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SwitchApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/SystemPortApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/TamApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/TunnelApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/VirtualRouterApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/VlanApiTracer.h"
+#include "fboss/agent/hw/sai/tracer/WredApiTracer.h"
+
+namespace facebook::fboss {
+
+namespace {
+
+// Which sai_*_list_t member of sai_attribute_value_t an attribute uses
+enum class ListKind : uint8_t {
+  NONE,
+  S8,
+  U32,
+  S32,
+  OBJECT_ID,
+  QOS_MAP,
+  ACL_ACTION_OBJECT_ID,
+  SYSTEM_PORT_CONFIG,
+  PORT_LANE_LATCH_STATUS,
+};
+
+// All sai_*_list_t share this layout
+struct SaiList {
+  uint32_t count;
+  void* list;
+};
+static_assert(sizeof(SaiList) == sizeof(sai_object_list_t));
+static_assert(
+    offsetof(SaiList, list) == offsetof(sai_object_list_t, list) &&
+    offsetof(SaiList, list) == offsetof(sai_qos_map_list_t, list));
+
+struct ListLayout {
+  // Offset of the list in sai_attribute_value_t
+  size_t offset;
+  size_t elemSize;
+};
+
+ListLayout listLayout(ListKind kind) {
+  switch (kind) {
+    case ListKind::S8:
+      return {offsetof(sai_attribute_value_t, s8list), sizeof(sai_int8_t)};
+    case ListKind::U32:
+      return {offsetof(sai_attribute_value_t, u32list), sizeof(sai_uint32_t)};
+    case ListKind::S32:
+      return {offsetof(sai_attribute_value_t, s32list), sizeof(sai_int32_t)};
+    case ListKind::OBJECT_ID:
+      return {
+          offsetof(sai_attribute_value_t, objlist), sizeof(sai_object_id_t)};
+    case ListKind::QOS_MAP:
+      return {offsetof(sai_attribute_value_t, qosmap), sizeof(sai_qos_map_t)};
+    case ListKind::ACL_ACTION_OBJECT_ID:
+      return {
+          offsetof(sai_attribute_value_t, aclaction.parameter.objlist),
+          sizeof(sai_object_id_t)};
+    case ListKind::SYSTEM_PORT_CONFIG:
+      return {
+          offsetof(sai_attribute_value_t, sysportconfiglist),
+          sizeof(sai_system_port_config_t)};
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 3) || defined(TAJO_SDK_VERSION_1_42_8)
+    case ListKind::PORT_LANE_LATCH_STATUS:
+      return {
+          offsetof(sai_attribute_value_t, portlanelatchstatuslist),
+          sizeof(sai_port_lane_latch_status_t)};
+#endif
+    default:
+      break;
+  }
+  throw FbossError("Unknown list kind ", static_cast<int>(kind));
+}
+
+ListKind listKind(sai_object_type_t object_type, sai_attr_id_t attr_id) {
+  // Same types as SaiTracer::listFuncMap_
+  static const std::unordered_map<std::size_t, ListKind> kListKinds {
+    {TYPE_INDEX(std::vector<sai_object_id_t>), ListKind::OBJECT_ID},
+        {TYPE_INDEX(std::vector<sai_uint32_t>), ListKind::U32},
+        {TYPE_INDEX(std::vector<sai_int32_t>), ListKind::S32},
+        {TYPE_INDEX(std::vector<sai_qos_map_t>), ListKind::QOS_MAP},
+        {TYPE_INDEX(AclEntryActionSaiObjectIdList),
+         ListKind::ACL_ACTION_OBJECT_ID},
+        {TYPE_INDEX(std::vector<sai_system_port_config_t>),
+         ListKind::SYSTEM_PORT_CONFIG},
+#if SAI_API_VERSION >= SAI_VERSION(1, 10, 3) || defined(TAJO_SDK_VERSION_1_42_8)
+        {TYPE_INDEX(std::vector<sai_port_lane_latch_status_t>),
+         ListKind::PORT_LANE_LATCH_STATUS},
+#endif
+  };
+  auto type = saiAttributeType(object_type, attr_id);
+  if (!type) {
+    // Attributes SET_SAI_STRING_ATTRIBUTES serializes as s8list
+    return attr_id == SAI_SWITCH_ATTR_SWITCH_HARDWARE_INFO ||
+            attr_id == SAI_SWITCH_ATTR_FIRMWARE_PATH_NAME
+        ? ListKind::S8
+        : ListKind::NONE;
+  }
+  auto iter = kListKinds.find(type);
+  return iter == kListKinds.end() ? ListKind::NONE : iter->second;
+}
+
+std::string& recordBuffer() {
+  static thread_local std::string buf;
+  return buf;
+}
+
+} // namespace
+
+std::size_t saiAttributeType(
+    sai_object_type_t object_type,
+    sai_attr_id_t attr_id) {
+  switch (object_type) {
+    case SAI_OBJECT_TYPE_ACL_COUNTER:
+      return getAclCounterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_ENTRY:
+      return getAclEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_TABLE:
+      return getAclTableAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_TABLE_GROUP:
+      return getAclTableGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ACL_TABLE_GROUP_MEMBER:
+      return getAclTableGroupMemberAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_BRIDGE:
+      return getBridgeAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_BRIDGE_PORT:
+      return getBridgePortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_BUFFER_POOL:
+      return getBufferPoolAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_BUFFER_PROFILE:
+      return getBufferProfileAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_COUNTER:
+      return getCounterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_DEBUG_COUNTER:
+      return getDebugCounterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_FDB_ENTRY:
+      return getFdbEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HASH:
+      return getHashAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HOSTIF_PACKET:
+      return getHostifPacketAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HOSTIF_TRAP:
+      return getHostifTrapAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_HOSTIF_TRAP_GROUP:
+      return getHostifTrapGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_INSEG_ENTRY:
+      return getInsegEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_INGRESS_PRIORITY_GROUP:
+      return getIngressPriorityGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_LAG:
+      return getLagAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_LAG_MEMBER:
+      return getLagMemberAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC:
+      return getMacsecAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_PORT:
+      return getMacsecPortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_FLOW:
+      return getMacsecFlowAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_SA:
+      return getMacsecSAAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MACSEC_SC:
+      return getMacsecSCAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_MIRROR_SESSION:
+      return getMirrorSessionAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEIGHBOR_ENTRY:
+      return getNeighborEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEXT_HOP:
+      return getNextHopAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEXT_HOP_GROUP:
+      return getNextHopGroupAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_NEXT_HOP_GROUP_MEMBER:
+      return getNextHopGroupMemberAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_PORT:
+      return getPortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_PORT_SERDES:
+      return getPortSerdesAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_PORT_CONNECTOR:
+      return getPortConnectorAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_QOS_MAP:
+      return getQosMapAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_QUEUE:
+      return getQueueAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ROUTE_ENTRY:
+      return getRouteEntryAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_ROUTER_INTERFACE:
+      return getRouterInterfaceAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SAMPLEPACKET:
+      return getSamplePacketAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SCHEDULER:
+      return getSchedulerAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SWITCH:
+      return getSwitchAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_SYSTEM_PORT:
+      return getSystemPortAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM:
+      return getTamAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM_EVENT:
+      return getTamEventAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM_EVENT_ACTION:
+      return getTamEventActionAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TAM_REPORT:
+      return getTamReportAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TUNNEL:
+      return getTunnelAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_TUNNEL_TERM_TABLE_ENTRY:
+      return getTunnelTermAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_VIRTUAL_ROUTER:
+      return getVirtualRouterAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_VLAN:
+      return getVlanAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_VLAN_MEMBER:
+      return getVlanMemberAttributeType(attr_id);
+    case SAI_OBJECT_TYPE_WRED:
+      return getWredAttributeType(attr_id);
+    default:
+      return 0;
+  }
+}
+
+SaiTraceRecordWriter::SaiTraceRecordWriter(SaiTraceRecordType type)
+    : buf_(recordBuffer()) {
+  buf_.clear();
+  // Size is filled in by finish()
+  write<uint32_t>(0);
+  write(type);
+  write(std::chrono::system_clock::now());
+}
+
+void SaiTraceRecordWriter::append(const void* data, size_t size) {
+  if (size) {
+    buf_.append(static_cast<const char*>(data), size);
+  }
+}
+
+SaiTraceRecordWriter& SaiTraceRecordWriter::writeString(
+    folly::StringPiece str) {
+  return writeArray(str.data(), str.size());
+}
+
+SaiTraceRecordWriter& SaiTraceRecordWriter::writeAttributes(
+    const sai_attribute_t* attr_list,
+    uint32_t attr_count,
+    sai_object_type_t object_type) {
+  write(attr_count);
+  for (uint32_t i = 0; i < attr_count; ++i) {
+    auto kind = listKind(object_type, attr_list[i].id);
+    write(attr_list[i].id);
+    write(attr_list[i].value);
+    write(kind);
+    if (kind == ListKind::NONE) {
+      continue;
+    }
+    auto layout = listLayout(kind);
+    SaiList list;
+    std::memcpy(
+        &list,
+        reinterpret_cast<const uint8_t*>(&attr_list[i].value) + layout.offset,
+        sizeof(list));
+    write<uint8_t>(list.list != nullptr);
+    if (list.list) {
+      append(list.list, layout.elemSize * list.count);
+    }
+  }
+  return *this;
+}
+
+folly::ByteRange SaiTraceRecordWriter::finish() {
+  uint32_t size = buf_.size();
+  std::memcpy(buf_.data(), &size, sizeof(size));
+  return folly::ByteRange(folly::StringPiece(buf_));
+}
+
+SaiTraceRecordReader::SaiTraceRecordReader(folly::ByteRange record)
+    : data_(record) {
+  read<uint32_t>();
+  type_ = read<SaiTraceRecordType>();
+  time_ = read<std::chrono::system_clock::time_point>();
+}
+
+void SaiTraceRecordReader::take(void* data, size_t size) {
+  if (size > data_.size()) {
+    throw FbossError(
+        "Truncated sai trace record of type ", static_cast<int>(type_));
+  }
+  if (size) {
+    std::memcpy(data, data_.data(), size);
+    data_.advance(size);
+  }
+}
+
+std::string SaiTraceRecordReader::readString() {
+  auto chars = readArray<char>();
+  return std::string(chars.begin(), chars.end());
+}
+
+std::vector<sai_attribute_t> SaiTraceRecordReader::readAttributes() {
+  std::vector<sai_attribute_t> attrs(read<uint32_t>());
+  for (auto& attr : attrs) {
+    attr.id = read<sai_attr_id_t>();
+    attr.value = read<sai_attribute_value_t>();
+    auto kind = read<ListKind>();
+    if (kind == ListKind::NONE) {
+      continue;
+    }
+    auto layout = listLayout(kind);
+    auto listPtr = reinterpret_cast<uint8_t*>(&attr.value) + layout.offset;
+    SaiList list;
+    std::memcpy(&list, listPtr, sizeof(list));
+    list.list = nullptr;
+    if (read<uint8_t>()) {
+      // Keep a non null list for empty lists, as the original call had
+      size_t size = layout.elemSize * list.count;
+      auto& storage = lists_.emplace_back(std::max<size_t>(size, 1));
+      take(storage.data(), size);
+      list.list = storage.data();
+    }
+    std::memcpy(listPtr, &list, sizeof(list));
+  }
+  return attrs;
+}
+
+} // namespace facebook::fboss
@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <folly/Range.h>
+
+extern "C" {
+#include <sai.h>
+}
+
+namespace facebook::fboss {
+
+/*
+ * With --enable_binary_replayer_log, SaiTracer does not generate C code on
+ * the SAI call path. Each log call instead appends one record holding its
+ * arguments to the replayer log, with attribute values copied as raw
+ * sai_attribute_value_t bytes plus the elements of list attributes.
+ * sai_trace_converter later passes the records back through SaiTracer to
+ * write the same replayable C file the text logger would have written.
+ *
+ * A binary session in the log starts with kSaiTraceMagic, followed by
+ * records made of
+ *   uint32_t size (of the whole record, including the size itself)
+ *   SaiTraceRecordType type
+ *   std::chrono::system_clock::time_point when the record was written
+ *   arguments of the log call
+ * and ends with a SESSION_END record.
+ */
+constexpr folly::StringPiece kSaiTraceMagic{"// Sai Tracer binary log\n"};
+
+enum class SaiTraceRecordType : uint8_t {
+  SESSION_START,
+  SESSION_END,
+  API_INITIALIZE,
+  API_UNINITIALIZE,
+  API_QUERY,
+  GET_OBJECT_KEY,
+  SWITCH_CREATE,
+  ROUTE_ENTRY_CREATE,
+  NEIGHBOR_ENTRY_CREATE,
+  FDB_ENTRY_CREATE,
+  INSEG_ENTRY_CREATE,
+  CREATE,
+  ROUTE_ENTRY_REMOVE,
+  NEIGHBOR_ENTRY_REMOVE,
+  FDB_ENTRY_REMOVE,
+  INSEG_ENTRY_REMOVE,
+  REMOVE,
+  ROUTE_ENTRY_SET_ATTR,
+  NEIGHBOR_ENTRY_SET_ATTR,
+  FDB_ENTRY_SET_ATTR,
+  INSEG_ENTRY_SET_ATTR,
+  GET_ATTR,
+  SET_ATTR,
+  BULK_SET_ATTR,
+  SEND_HOSTIF_PACKET,
+  GET_STATS,
+  CLEAR_STATS,
+  POST_INVOCATION,
+};
+
+// TYPE_INDEX of the attribute value type, 0 if the tracer does not know it
+std::size_t saiAttributeType(
+    sai_object_type_t object_type,
+    sai_attr_id_t attr_id);
+
+/*
+ * Builds one record in a per thread buffer, so that writing a record does
+ * not allocate once the buffer has grown to fit the largest record.
+ */
+class SaiTraceRecordWriter {
+ public:
+  explicit SaiTraceRecordWriter(SaiTraceRecordType type);
+
+  template <typename T>
+  SaiTraceRecordWriter& write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    append(&value, sizeof(T));
+    return *this;
+  }
+
+  SaiTraceRecordWriter& writeString(folly::StringPiece str);
+
+  // Count followed by the values. values may be null if count is 0.
+  template <typename T>
+  SaiTraceRecordWriter& writeArray(const T* values, uint32_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    write(count);
+    append(values, sizeof(T) * count);
+    return *this;
+  }
+
+  SaiTraceRecordWriter& writeAttributes(
+      const sai_attribute_t* attr_list,
+      uint32_t attr_count,
+      sai_object_type_t object_type);
+
+  // The finished record, valid until the next writer on this thread
+  folly::ByteRange finish();
+
+ private:
+  void append(const void* data, size_t size);
+
+  std::string& buf_;
+};
+
+class SaiTraceRecordReader {
+ public:
+  // record must hold a whole record, starting with its size
+  explicit SaiTraceRecordReader(folly::ByteRange record);
+
+  SaiTraceRecordType type() const {
+    return type_;
+  }
+
+  std::chrono::system_clock::time_point time() const {
+    return time_;
+  }
+
+  template <typename T>
+  T read() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    T value;
+    take(&value, sizeof(T));
+    return value;
+  }
+
+  std::string readString();
+
+  template <typename T>
+  std::vector<T> readArray() {
+    static_assert(std::is_trivially_copyable_v<T>);
+    std::vector<T> values(read<uint32_t>());
+    take(values.data(), sizeof(T) * values.size());
+    return values;
+  }
+
+  // List attributes point into storage owned by the reader
+  std::vector<sai_attribute_t> readAttributes();
+
+ private:
+  void take(void* data, size_t size);
+
+  folly::ByteRange data_;
+  SaiTraceRecordType type_;
+  std::chrono::system_clock::time_point time_;
+  std::vector<std::vector<uint8_t>> lists_;
+};
+
+} // namespace facebook::fboss
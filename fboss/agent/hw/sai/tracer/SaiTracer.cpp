@@ -79,6 +79,13 @@ DEFINE_bool(
     "Flag to indicate whether to log the get API calls. "
     "At runtime, it should be disabled to reduce logging overhead.");
 
+DEFINE_bool(
+    enable_binary_replayer_log,
+    false,
+    "Write SAI calls to the replayer log as binary records rather than C "
+    "code, to keep code generation off the SAI call path. Convert the log "
+    "with sai_trace_converter.");
+
 DEFINE_string(
     sai_log,
     "/var/facebook/logs/fboss/sdk/sai_replayer.log",
@@ -390,45 +397,8 @@ sai_status_t __wrap_sai_get_object_key(
     return rv;
   }
 
-  vector<string> getObjectKeyLines = {
-      to<string>("expected_object_count=", *object_count),
-      to<string>(
-          "sai_get_object_count(switch_0, (_sai_object_type_t)",
-          object_type,
-          ", &object_count)"),
-      "object_list.resize(object_count)",
-      to<string>(
-          "sai_get_object_key(switch_0, (_sai_object_type_t)",
-          object_type,
-          ", &object_count, object_list.data())"),
-      to<string>(
-          "if (object_count < expected_object_count) { printf(\"[WARNING] current switch reloaded %u ",
-          facebook::fboss::saiObjectTypeToString(object_type),
-          " objects, expected %u\\n\", expected_object_count, object_count); }"),
-  };
-
-  vector<string> declarationLines;
-  if (object_list != nullptr) {
-    declarationLines.reserve(*object_count);
-    for (int i = 0; i < *object_count; ++i) {
-      sai_object_key_t object = object_list[i];
-      string declaration =
-          std::get<0>(SaiTracer::getInstance()->declareVariable(
-              &object.key.object_id, object_type));
-      declarationLines.push_back(to<string>(
-          declaration,
-          "=assignObject(object_list.data(), object_count, ",
-          i,
-          ", ",
-          object.key.object_id,
-          ")"));
-    }
-  }
-
-  vector<string> lines;
-  lines.insert(lines.end(), getObjectKeyLines.begin(), getObjectKeyLines.end());
-  lines.insert(lines.end(), declarationLines.begin(), declarationLines.end());
-  SaiTracer::getInstance()->writeToFile(lines);
+  SaiTracer::getInstance()->logGetObjectKeyFn(
+      object_type, *object_count, object_list);
   return rv;
 }
 
@@ -448,6 +418,21 @@ SaiTracer::SaiTracer() {
         FLAGS_sai_log, FLAGS_log_timeout, AsyncLogger::SAI_REPLAYER);
 
     asyncLogger_->startFlushThread();
+
+    if (FLAGS_enable_binary_replayer_log) {
+      // sai_trace_converter generates the C code with the same flags
+      asyncLogger_->appendLog(kSaiTraceMagic.data(), kSaiTraceMagic.size());
+      SaiTraceRecordWriter record(SaiTraceRecordType::SESSION_START);
+      record.write(FLAGS_enable_packet_log)
+          .write(FLAGS_enable_elapsed_time_log)
+          .write(FLAGS_enable_get_attr_log)
+          .write(FLAGS_default_list_size)
+          .write(FLAGS_default_list_count)
+          .writeString(FLAGS_sai_replayer_sdk_log_level);
+      writeRecord(record);
+      return;
+    }
+
     asyncLogger_->appendLog(cpp_header_, strlen(cpp_header_));
 
     setupGlobals();
@@ -457,7 +442,12 @@ SaiTracer::SaiTracer() {
 
 SaiTracer::~SaiTracer() {
   if (FLAGS_enable_replayer) {
-    writeFooter();
+    if (FLAGS_enable_binary_replayer_log) {
+      SaiTraceRecordWriter record(SaiTraceRecordType::SESSION_END);
+      writeRecord(record);
+    } else {
+      writeFooter();
+    }
     asyncLogger_->forceFlush();
     asyncLogger_->stopFlushThread();
   }
@@ -487,6 +477,16 @@ void SaiTracer::logApiInitialize(
     const char** variables,
     const char** values,
     int size) {
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::API_INITIALIZE);
+    record.write(size);
+    for (int i = 0; i < size; ++i) {
+      record.writeString(variables[i]).writeString(values[i]);
+    }
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines;
 
   for (int i = 0; i < size; ++i) {
@@ -515,6 +515,12 @@ void SaiTracer::logApiInitialize(
 }
 
 void SaiTracer::logApiUninitialize(void) {
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::API_UNINITIALIZE);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{"sai_api_uninitialize()"};
   writeToFile(lines);
 }
@@ -527,6 +533,13 @@ void SaiTracer::logApiQuery(sai_api_t api_id, const std::string& api_var) {
 
   init_api_.emplace(api_id, api_var);
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::API_QUERY);
+    record.write(api_id).writeString(api_var);
+    writeRecord(record);
+    return;
+  }
+
   writeToFile(
       {to<string>("sai_", api_var, "_t* ", api_var),
        to<string>(
@@ -543,6 +556,67 @@ void SaiTracer::logApiQuery(sai_api_t api_id, const std::string& api_var) {
            " API.\")")});
 }
 
+void SaiTracer::logGetObjectKeyFn(
+    sai_object_type_t object_type,
+    uint32_t object_count,
+    const sai_object_key_t* object_list) {
+  if (!FLAGS_enable_replayer) {
+    return;
+  }
+
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::GET_OBJECT_KEY);
+    record.write(object_type).write(object_count).write<uint8_t>(
+        object_list != nullptr);
+    if (object_list) {
+      for (int i = 0; i < object_count; ++i) {
+        record.write(object_list[i].key.object_id);
+      }
+    }
+    writeRecord(record);
+    return;
+  }
+
+  vector<string> getObjectKeyLines = {
+      to<string>("expected_object_count=", object_count),
+      to<string>(
+          "sai_get_object_count(switch_0, (_sai_object_type_t)",
+          object_type,
+          ", &object_count)"),
+      "object_list.resize(object_count)",
+      to<string>(
+          "sai_get_object_key(switch_0, (_sai_object_type_t)",
+          object_type,
+          ", &object_count, object_list.data())"),
+      to<string>(
+          "if (object_count < expected_object_count) { printf(\"[WARNING] current switch reloaded %u ",
+          saiObjectTypeToString(object_type),
+          " objects, expected %u\\n\", expected_object_count, object_count); }"),
+  };
+
+  vector<string> declarationLines;
+  if (object_list != nullptr) {
+    declarationLines.reserve(object_count);
+    for (int i = 0; i < object_count; ++i) {
+      sai_object_key_t object = object_list[i];
+      string declaration =
+          std::get<0>(declareVariable(&object.key.object_id, object_type));
+      declarationLines.push_back(to<string>(
+          declaration,
+          "=assignObject(object_list.data(), object_count, ",
+          i,
+          ", ",
+          object.key.object_id,
+          ")"));
+    }
+  }
+
+  vector<string> lines;
+  lines.insert(lines.end(), getObjectKeyLines.begin(), getObjectKeyLines.end());
+  lines.insert(lines.end(), declarationLines.begin(), declarationLines.end());
+  writeToFile(lines);
+}
+
 void SaiTracer::logSwitchCreateFn(
     sai_object_id_t* switch_id,
     uint32_t attr_count,
@@ -551,6 +625,13 @@ void SaiTracer::logSwitchCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::SWITCH_CREATE);
+    record.writeAttributes(attr_list, attr_count, SAI_OBJECT_TYPE_SWITCH);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_SWITCH);
@@ -586,6 +667,14 @@ void SaiTracer::logRouteEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ROUTE_ENTRY_CREATE);
+    record.write(*route_entry)
+        .writeAttributes(attr_list, attr_count, SAI_OBJECT_TYPE_ROUTE_ENTRY);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_ROUTE_ENTRY);
@@ -616,6 +705,15 @@ void SaiTracer::logNeighborEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::NEIGHBOR_ENTRY_CREATE);
+    record.write(*neighbor_entry)
+        .writeAttributes(attr_list, attr_count, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
@@ -652,6 +750,15 @@ void SaiTracer::logFdbEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::FDB_ENTRY_CREATE);
+    record.write(*fdb_entry)
+        .writeAttributes(attr_list, attr_count, SAI_OBJECT_TYPE_FDB_ENTRY)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_FDB_ENTRY);
@@ -688,6 +795,15 @@ void SaiTracer::logInsegEntryCreateFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::INSEG_ENTRY_CREATE);
+    record.write(*inseg_entry)
+        .writeAttributes(attr_list, attr_count, SAI_OBJECT_TYPE_INSEG_ENTRY)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   // First fill in attribute list
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_INSEG_ENTRY);
@@ -726,6 +842,17 @@ std::string SaiTracer::logCreateFn(
     return "";
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::CREATE);
+    record.writeString(fn_name)
+        .write(switch_id)
+        .write(object_type)
+        .writeAttributes(attr_list, attr_count, object_type);
+    writeRecord(record);
+    // The converter names the variable
+    return "";
+  }
+
   // First fill in attribute list
   vector<string> lines = setAttrList(attr_list, attr_count, object_type);
 
@@ -748,6 +875,13 @@ void SaiTracer::logRouteEntryRemoveFn(const sai_route_entry_t* route_entry) {
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ROUTE_ENTRY_REMOVE);
+    record.write(*route_entry);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setRouteEntry(route_entry, lines);
 
@@ -769,6 +903,13 @@ void SaiTracer::logNeighborEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::NEIGHBOR_ENTRY_REMOVE);
+    record.write(*neighbor_entry).write(rv);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setNeighborEntry(neighbor_entry, lines);
 
@@ -796,6 +937,13 @@ void SaiTracer::logFdbEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::FDB_ENTRY_REMOVE);
+    record.write(*fdb_entry).write(rv);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setFdbEntry(fdb_entry, lines);
 
@@ -823,6 +971,13 @@ void SaiTracer::logInsegEntryRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::INSEG_ENTRY_REMOVE);
+    record.write(*inseg_entry).write(rv);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
   setInsegEntry(inseg_entry, lines);
 
@@ -851,6 +1006,13 @@ void SaiTracer::logRemoveFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::REMOVE);
+    record.writeString(fn_name).write(remove_object_id).write(object_type);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines{};
 
   // Make the remove call
@@ -876,6 +1038,14 @@ void SaiTracer::logRouteEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::ROUTE_ENTRY_SET_ATTR);
+    record.write(*route_entry)
+        .writeAttributes(attr, 1, SAI_OBJECT_TYPE_ROUTE_ENTRY);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_ROUTE_ENTRY);
 
@@ -901,6 +1071,15 @@ void SaiTracer::logNeighborEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::NEIGHBOR_ENTRY_SET_ATTR);
+    record.write(*neighbor_entry)
+        .writeAttributes(attr, 1, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_NEIGHBOR_ENTRY);
 
@@ -932,6 +1111,15 @@ void SaiTracer::logFdbEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::FDB_ENTRY_SET_ATTR);
+    record.write(*fdb_entry)
+        .writeAttributes(attr, 1, SAI_OBJECT_TYPE_FDB_ENTRY)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_FDB_ENTRY);
 
@@ -963,6 +1151,15 @@ void SaiTracer::logInsegEntrySetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::INSEG_ENTRY_SET_ATTR);
+    record.write(*inseg_entry)
+        .writeAttributes(attr, 1, SAI_OBJECT_TYPE_INSEG_ENTRY)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, SAI_OBJECT_TYPE_INSEG_ENTRY);
 
@@ -996,6 +1193,16 @@ void SaiTracer::logGetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::GET_ATTR);
+    record.writeString(fn_name)
+        .write(get_object_id)
+        .write(object_type)
+        .writeAttributes(attr, attr_count, object_type);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines = setAttrList(attr, attr_count, object_type);
   lines.push_back(
       to<string>("memset(get_attribute,0,ATTR_SIZE*", maxAttrCount_, ")"));
@@ -1024,6 +1231,16 @@ void SaiTracer::logSetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::SET_ATTR);
+    record.writeString(fn_name)
+        .write(set_object_id)
+        .write(object_type)
+        .writeAttributes(attr, 1, object_type);
+    writeRecord(record);
+    return;
+  }
+
   // Setup one attribute
   vector<string> lines = setAttrList(attr, 1, object_type);
 
@@ -1053,6 +1270,19 @@ void SaiTracer::logBulkSetAttrFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::BULK_SET_ATTR);
+    record.writeString(fn_name)
+        .writeArray(object_id, object_count)
+        .writeAttributes(attr_list, object_count, object_type)
+        .write(mode)
+        .writeArray(object_statuses, object_count)
+        .write(object_type)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   // Setup attributes
   vector<string> lines = setAttrList(attr_list, object_count, object_type);
 
@@ -1101,6 +1331,16 @@ void SaiTracer::logSendHostifPacketFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::SEND_HOSTIF_PACKET);
+    record.write(hostif_id)
+        .writeArray(buffer, buffer_size)
+        .writeAttributes(attr_list, attr_count, SAI_OBJECT_TYPE_HOSTIF_PACKET)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines =
       setAttrList(attr_list, attr_count, SAI_OBJECT_TYPE_HOSTIF_PACKET);
 
@@ -1156,6 +1396,19 @@ void SaiTracer::logGetStatsFn(
   if (!FLAGS_enable_replayer || !FLAGS_enable_get_attr_log) {
     return;
   }
+
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::GET_STATS);
+    record.writeString(fn_name)
+        .write(object_id)
+        .writeArray(counter_ids, number_of_counters)
+        .writeArray(counters, number_of_counters)
+        .write(object_type)
+        .write(rv)
+        .write(mode);
+    writeRecord(record);
+    return;
+  }
   vector<string> lines = {
       to<string>("memset(counter_list,0,4*", maxAttrCount_, ")"),
       to<string>("memset(counter_vals,0,8*", maxAttrCount_, ")")};
@@ -1198,6 +1451,17 @@ void SaiTracer::logClearStatsFn(
     return;
   }
 
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::CLEAR_STATS);
+    record.writeString(fn_name)
+        .write(object_id)
+        .writeArray(counter_ids, number_of_counters)
+        .write(object_type)
+        .write(rv);
+    writeRecord(record);
+    return;
+  }
+
   vector<string> lines = {
       to<string>("memset(counter_list,0,4*", maxAttrCount_, ")")};
   for (int i = 0; i < number_of_counters; ++i) {
@@ -1572,7 +1836,7 @@ string SaiTracer::logTimeAndRv(
     sai_status_t rv,
     sai_object_id_t object_id,
     std::chrono::system_clock::time_point begin) {
-  auto now = std::chrono::system_clock::now();
+  auto now = replayTime_ ? *replayTime_ : std::chrono::system_clock::now();
   auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
                     now.time_since_epoch()) %
       1000;
@@ -1649,6 +1913,13 @@ void SaiTracer::logPostInvocation(
     sai_object_id_t object_id,
     std::chrono::system_clock::time_point begin,
     std::optional<std::string> varName) {
+  if (FLAGS_enable_binary_replayer_log) {
+    SaiTraceRecordWriter record(SaiTraceRecordType::POST_INVOCATION);
+    record.write(rv).write(object_id).write(begin).write(varName.has_value());
+    writeRecord(record);
+    return;
+  }
+
   // In the case of create fn, objectID is known after invocation.
   // Therefore, add it to the variable mapping here.
   if (varName) {
@@ -1717,6 +1988,12 @@ void SaiTracer::writeFooter() {
   asyncLogger_->appendLog(footer.c_str(), footer.size());
 }
 
+void SaiTracer::writeRecord(SaiTraceRecordWriter& record) {
+  auto bytes = record.finish();
+  asyncLogger_->appendLog(
+      reinterpret_cast<const char*>(bytes.data()), bytes.size());
+}
+
 void SaiTracer::initVarCounts() {
   varCounts_.emplace(SAI_OBJECT_TYPE_ACL_COUNTER, 0);
   varCounts_.emplace(SAI_OBJECT_TYPE_ACL_ENTRY, 0);
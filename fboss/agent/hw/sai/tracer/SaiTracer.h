@@ -11,12 +11,14 @@
 
 #include <map>
 #include <memory>
+#include <optional>
 #include <tuple>
 #include <typeindex>
 
 #include "fboss/agent/AsyncLogger.h"
 #include "fboss/agent/hw/sai/api/SaiVersion.h"
 #include "fboss/agent/hw/sai/api/Traits.h"
+#include "fboss/agent/hw/sai/tracer/SaiTraceRecord.h"
 #include "fboss/agent/hw/sai/tracer/Utils.h"
 
 #include <folly/File.h>
@@ -33,6 +35,7 @@ DECLARE_bool(enable_replayer);
 DECLARE_bool(enable_packet_log);
 DECLARE_bool(enable_elapsed_time_log);
 DECLARE_bool(enable_get_attr_log);
+DECLARE_bool(enable_binary_replayer_log);
 
 using PrimitiveFunction = std::string (*)(const sai_attribute_t*, int);
 using AttributeFunction =
@@ -62,6 +65,11 @@ class SaiTracer {
 
   void logApiQuery(sai_api_t api_id, const std::string& api_var);
 
+  void logGetObjectKeyFn(
+      sai_object_type_t object_type,
+      uint32_t object_count,
+      const sai_object_key_t* object_list);
+
   void logSwitchCreateFn(
       sai_object_id_t* switch_id,
       uint32_t attr_count,
@@ -282,6 +290,9 @@ class SaiTracer {
   };
 
  private:
+  // Rebuilds the C code from binary records
+  friend class SaiTraceConverter;
+
   // Helper methods for variables and attribute list
   std::vector<std::string> setAttrList(
       const sai_attribute_t* attr_list,
@@ -327,10 +338,14 @@ class SaiTracer {
 
   void writeFooter();
 
+  void writeRecord(SaiTraceRecordWriter& record);
+
   uint32_t maxAttrCount_;
   uint32_t maxListCount_;
   uint32_t numCalls_;
   std::unique_ptr<AsyncLogger> asyncLogger_;
+  // Time of the record being converted, used instead of the current time
+  std::optional<std::chrono::system_clock::time_point> replayTime_;
 
   // Variables mappings in generated C code
   // varCounts map from object type to the current counter
@@ -519,11 +534,12 @@ class SaiTracer {
       "void run_trace() {\n";
 };
 
-#define SET_ATTRIBUTE_FUNC_DECLARATION(obj_type) \
-  void set##obj_type##Attributes(                \
-      const sai_attribute_t* attr_list,          \
-      uint32_t attr_count,                       \
-      std::vector<std::string>& attrLines);
+#define SET_ATTRIBUTE_FUNC_DECLARATION(obj_type)                 \
+  void set##obj_type##Attributes(                                \
+      const sai_attribute_t* attr_list,                          \
+      uint32_t attr_count,                                       \
+      std::vector<std::string>& attrLines);                      \
+  std::size_t get##obj_type##AttributeType(sai_attr_id_t attr_id);
 
 #define WRAP_CREATE_FUNC(obj_type, sai_obj_type, api_type)                 \
   sai_status_t wrap_create_##obj_type(                                     \
@@ -627,6 +643,67 @@ class SaiTracer {
     return rv;                                                                 \
   }
 
+#define WRAP_BULK_CREATE_FUNC(obj_type, sai_obj_type, api_type)               \
+  sai_status_t wrap_create_##obj_type##s(                                     \
+      sai_object_id_t switch_id,                                              \
+      uint32_t object_count,                                                  \
+      const uint32_t* attr_count,                                             \
+      const sai_attribute_t** attr_list,                                      \
+      sai_bulk_op_error_mode_t mode,                                          \
+      sai_object_id_t* object_id,                                             \
+      sai_status_t* object_statuses) {                                        \
+    auto begin = FLAGS_enable_elapsed_time_log                                \
+        ? std::chrono::system_clock::now()                                    \
+        : std::chrono::system_clock::time_point::min();                       \
+    auto rv = SaiTracer::getInstance()->api_type##Api_->create_##obj_type##s( \
+        switch_id,                                                            \
+        object_count,                                                         \
+        attr_count,                                                           \
+        attr_list,                                                            \
+        mode,                                                                 \
+        object_id,                                                            \
+        object_statuses);                                                     \
+    /* Bulk calls are logged as the single calls they executed */             \
+    for (uint32_t i = 0; i < object_count; ++i) {                             \
+      if (object_statuses[i] == SAI_STATUS_NON_EXECUTED) {                    \
+        continue;                                                             \
+      }                                                                       \
+      auto varName = SaiTracer::getInstance()->logCreateFn(                   \
+          "create_" #obj_type,                                                \
+          &object_id[i],                                                      \
+          switch_id,                                                          \
+          attr_count[i],                                                      \
+          attr_list[i],                                                       \
+          sai_obj_type);                                                      \
+      SaiTracer::getInstance()->logPostInvocation(                            \
+          object_statuses[i], object_id[i], begin, varName);                  \
+    }                                                                         \
+    return rv;                                                                \
+  }
+
+#define WRAP_BULK_REMOVE_FUNC(obj_type, sai_obj_type, api_type)               \
+  sai_status_t wrap_remove_##obj_type##s(                                     \
+      uint32_t object_count,                                                  \
+      const sai_object_id_t* object_id,                                       \
+      sai_bulk_op_error_mode_t mode,                                          \
+      sai_status_t* object_statuses) {                                        \
+    auto begin = FLAGS_enable_elapsed_time_log                                \
+        ? std::chrono::system_clock::now()                                    \
+        : std::chrono::system_clock::time_point::min();                       \
+    auto rv = SaiTracer::getInstance()->api_type##Api_->remove_##obj_type##s( \
+        object_count, object_id, mode, object_statuses);                      \
+    for (uint32_t i = 0; i < object_count; ++i) {                             \
+      if (object_statuses[i] == SAI_STATUS_NON_EXECUTED) {                    \
+        continue;                                                             \
+      }                                                                       \
+      SaiTracer::getInstance()->logRemoveFn(                                  \
+          "remove_" #obj_type, object_id[i], sai_obj_type);                   \
+      SaiTracer::getInstance()->logPostInvocation(                            \
+          object_statuses[i], object_id[i], begin);                           \
+    }                                                                         \
+    return rv;                                                                \
+  }
+
 #define WRAP_GET_STATS_FUNC(obj_type, sai_obj_type, api_type)             \
   sai_status_t wrap_get_##obj_type##_stats(                               \
       sai_object_id_t obj_type##_id,                                      \
@@ -713,6 +790,12 @@ class SaiTracer {
   }
 
 #define SET_SAI_REGULAR_ATTRIBUTES(obj_type)                                 \
+  /* TYPE_INDEX of the attribute, 0 if it is not in the map */               \
+  std::size_t get##obj_type##AttributeType(sai_attr_id_t attr_id) {          \
+    auto iter = _##obj_type##Map.find(attr_id);                              \
+    return iter == _##obj_type##Map.end() ? 0 : iter->second.second;         \
+  }                                                                          \
+                                                                             \
   void set##obj_type##Attributes(                                            \
       const sai_attribute_t* attr_list,                                      \
       uint32_t attr_count,                                                   \
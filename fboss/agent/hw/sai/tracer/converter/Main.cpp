@@ -0,0 +1,71 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiTraceConverter.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+
+DEFINE_string(
+    binary_log,
+    "",
+    "Replayer log written with --enable_binary_replayer_log. The C code is "
+    "written to --sai_log.");
+DEFINE_int32(
+    session,
+    -1,
+    "Session of the binary log to convert, counting from 0, as the log holds "
+    "one session per run of the traced process. Defaults to the last one.");
+
+DECLARE_string(sai_log);
+
+using namespace facebook::fboss;
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  if (FLAGS_binary_log.empty() || FLAGS_binary_log == FLAGS_sai_log) {
+    XLOG(FATAL) << "--binary_log must be set and differ from --sai_log";
+  }
+  std::string log;
+  if (!folly::readFile(FLAGS_binary_log.c_str(), log)) {
+    XLOG(FATAL) << "Failed to read " << FLAGS_binary_log;
+  }
+  auto sessions = SaiTraceConverter::findSessions(
+      folly::ByteRange(folly::StringPiece(log)));
+  if (sessions.empty()) {
+    XLOG(FATAL) << "No binary session in " << FLAGS_binary_log;
+  }
+  auto session = FLAGS_session < 0 ? sessions.size() - 1 : FLAGS_session;
+  if (session >= sessions.size()) {
+    XLOG(FATAL) << "Session " << session << " requested, " << FLAGS_binary_log
+                << " has " << sessions.size();
+  }
+
+  FLAGS_enable_replayer = true;
+  FLAGS_enable_binary_replayer_log = false;
+  SaiTraceConverter::setFlags(sessions[session]);
+
+  bool complete =
+      SaiTraceConverter(SaiTracer::getInstance()).convert(sessions[session]);
+  // The tracer writes the footer and flushes the C code when destroyed
+  folly::SingletonVault::singleton()->destroyInstances();
+
+  if (!complete) {
+    XLOG(WARN) << "Session " << session
+               << " ends early, the traced process did not exit cleanly";
+  }
+  XLOG(INFO) << "Wrote session " << session << " of " << sessions.size()
+             << " to " << FLAGS_sai_log;
+  return 0;
+}
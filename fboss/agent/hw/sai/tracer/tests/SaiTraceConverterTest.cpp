@@ -0,0 +1,162 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/hw/sai/tracer/SaiTraceConverter.h"
+#include "fboss/agent/hw/sai/tracer/SaiTracer.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Singleton.h>
+#include <folly/experimental/TestUtil.h>
+#include <gtest/gtest.h>
+
+#include <arpa/inet.h>
+#include <array>
+#include <regex>
+
+DECLARE_string(sai_log);
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr sai_object_id_t kSwitchId = 0x21000000000000;
+constexpr sai_object_id_t kPortId = 0x1000000000001;
+constexpr sai_object_id_t kVirtualRouterId = 0x3000000000000;
+
+// Log calls as the SAI API wrappers make them
+void traceSaiCalls(SaiTracer& tracer) {
+  auto begin = std::chrono::system_clock::time_point::min();
+  tracer.logApiQuery(SAI_API_PORT, "port_api");
+  tracer.logApiQuery(SAI_API_ROUTE, "route_api");
+
+  // Scalar and list attributes
+  std::array<uint32_t, 4> lanes{0, 1, 2, 3};
+  std::array<sai_attribute_t, 3> portAttrs{};
+  portAttrs[0].id = SAI_PORT_ATTR_HW_LANE_LIST;
+  portAttrs[0].value.u32list.count = lanes.size();
+  portAttrs[0].value.u32list.list = lanes.data();
+  portAttrs[1].id = SAI_PORT_ATTR_SPEED;
+  portAttrs[1].value.u32 = 100000;
+  portAttrs[2].id = SAI_PORT_ATTR_ADMIN_STATE;
+  portAttrs[2].value.booldata = true;
+  sai_object_id_t portId = kPortId;
+  auto varName = tracer.logCreateFn(
+      "create_port",
+      &portId,
+      kSwitchId,
+      portAttrs.size(),
+      portAttrs.data(),
+      SAI_OBJECT_TYPE_PORT);
+  tracer.logPostInvocation(SAI_STATUS_SUCCESS, portId, begin, varName);
+
+  sai_attribute_t mtu{};
+  mtu.id = SAI_PORT_ATTR_MTU;
+  mtu.value.u32 = 9412;
+  tracer.logSetAttrFn("set_port_attribute", portId, &mtu, SAI_OBJECT_TYPE_PORT);
+  tracer.logPostInvocation(SAI_STATUS_SUCCESS, portId, begin);
+
+  // Entry keyed objects, and a failed call
+  sai_route_entry_t route{};
+  route.switch_id = kSwitchId;
+  route.vr_id = kVirtualRouterId;
+  route.destination.addr_family = SAI_IP_ADDR_FAMILY_IPV4;
+  route.destination.addr.ip4 = htonl(0x0a000000);
+  route.destination.mask.ip4 = htonl(0xff000000);
+  sai_attribute_t packetAction{};
+  packetAction.id = SAI_ROUTE_ENTRY_ATTR_PACKET_ACTION;
+  packetAction.value.s32 = SAI_PACKET_ACTION_DROP;
+  tracer.logRouteEntryCreateFn(&route, 1, &packetAction);
+  tracer.logPostInvocation(SAI_STATUS_SUCCESS, SAI_NULL_OBJECT_ID, begin);
+  tracer.logRouteEntryCreateFn(&route, 1, &packetAction);
+  tracer.logPostInvocation(
+      SAI_STATUS_ITEM_ALREADY_EXISTS, SAI_NULL_OBJECT_ID, begin);
+  tracer.logRouteEntryRemoveFn(&route);
+  tracer.logPostInvocation(SAI_STATUS_SUCCESS, SAI_NULL_OBJECT_ID, begin);
+
+  tracer.logRemoveFn("remove_port", portId, SAI_OBJECT_TYPE_PORT);
+  tracer.logPostInvocation(SAI_STATUS_SUCCESS, portId, begin);
+}
+
+class SaiTraceConverterTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    FLAGS_enable_replayer = true;
+  }
+
+  void TearDown() override {
+    folly::SingletonVault::singleton()->destroyInstances();
+    folly::SingletonVault::singleton()->reenableInstances();
+  }
+
+ protected:
+  // Runs fn with a new tracer logging to file, and returns the log
+  template <typename Fn>
+  std::string withTracer(const std::string& file, bool binary, Fn fn) {
+    FLAGS_sai_log = (tmpDir_.path() / file).string();
+    FLAGS_enable_binary_replayer_log = binary;
+    // The API tracers format attributes through the singleton instance
+    fn(*SaiTracer::getInstance());
+    // The tracer writes the footer and flushes the log when destroyed
+    folly::SingletonVault::singleton()->destroyInstances();
+    folly::SingletonVault::singleton()->reenableInstances();
+    std::string log;
+    EXPECT_TRUE(folly::readFile(FLAGS_sai_log.c_str(), log));
+    return log;
+  }
+
+  // Replays happen at a different time than the calls
+  static std::string stripTimestamps(const std::string& log) {
+    static const std::regex kTimestamp(
+        R"(\d{4}-\d{2}-\d{2} \d{2}:\d{2}:\d{2}(\.\d{3})?)");
+    return std::regex_replace(log, kTimestamp, "<time>");
+  }
+
+  gflags::FlagSaver flagSaver_;
+  folly::test::TemporaryDirectory tmpDir_;
+};
+} // namespace
+
+TEST_F(SaiTraceConverterTest, binaryLogConvertsToTextLog) {
+  auto binaryLog = withTracer(
+      "binary.log", true, [](SaiTracer& tracer) { traceSaiCalls(tracer); });
+  auto sessions = SaiTraceConverter::findSessions(
+      folly::ByteRange(folly::StringPiece(binaryLog)));
+  ASSERT_EQ(sessions.size(), 1);
+
+  SaiTraceConverter::setFlags(sessions[0]);
+  bool complete{false};
+  auto convertedLog =
+      withTracer("converted.log", false, [&](SaiTracer& /* tracer */) {
+        complete = SaiTraceConverter(SaiTracer::getInstance())
+                       .convert(sessions[0]);
+      });
+  EXPECT_TRUE(complete);
+
+  auto textLog = withTracer(
+      "text.log", false, [](SaiTracer& tracer) { traceSaiCalls(tracer); });
+  EXPECT_FALSE(textLog.empty());
+  EXPECT_EQ(stripTimestamps(convertedLog), stripTimestamps(textLog));
+}
+
+TEST_F(SaiTraceConverterTest, truncatedSession) {
+  auto binaryLog = withTracer(
+      "binary.log", true, [](SaiTracer& tracer) { traceSaiCalls(tracer); });
+  // Cut the session short in its last record, as a crash would
+  binaryLog.resize(binaryLog.size() - 1);
+  auto sessions = SaiTraceConverter::findSessions(
+      folly::ByteRange(folly::StringPiece(binaryLog)));
+  ASSERT_EQ(sessions.size(), 1);
+
+  bool complete{true};
+  withTracer("converted.log", false, [&](SaiTracer& /* tracer */) {
+    complete =
+        SaiTraceConverter(SaiTracer::getInstance()).convert(sessions[0]);
+  });
+  EXPECT_FALSE(complete);
+}
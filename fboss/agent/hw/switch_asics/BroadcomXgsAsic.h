@@ -14,5 +14,10 @@ class BroadcomXgsAsic : public BroadcomAsic {
   using BroadcomAsic::BroadcomAsic;
   std::set<cfg::StreamType> getQueueStreamTypes(
       cfg::PortType portType) const override;
+  // The ACL priority range is much larger than the number of ACLs, spread
+  // them out so inserting an ACL rarely moves its neighbours
+  int getDefaultAclPriorityGap() const override {
+    return 16;
+  }
 };
 } // namespace facebook::fboss
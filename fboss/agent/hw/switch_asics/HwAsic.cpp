@@ -26,11 +26,26 @@
 
 DEFINE_int32(acl_gid, -1, "Content aware processor group ID for ACLs");
 DEFINE_int32(teFlow_gid, -1, "Exact Match group ID for TeFlows");
+DEFINE_int32(
+    acl_priority_gap,
+    -1,
+    "Gap between priorities of newly allocated ACLs, overriding the ASIC "
+    "default");
 
 namespace {
 constexpr auto kDefaultACLGroupID = 128;
 constexpr auto kDefaultTeFlowGroupID = 1;
 constexpr auto kDefaultDropEgressID = 100000;
+/*
+ * Not derived from the SAI ACL entry priority range, which is only known
+ * once the switch is initialized. This only bounds the window ACL priorities
+ * may be spread over: the priorities in use grow with the number of dataplane
+ * ACLs times the priority gap, so ASICs packing ACLs densely use no more of
+ * their range than they did before gaps were introduced. Priorities the HW
+ * can't take are still rejected when programmed (swPriorityToSaiPriority).
+ * Native BCM maps priorities up to 1M, well above this.
+ */
+constexpr auto kDefaultMaxDataplaneAclPriorities = 64 * 1024;
 } // namespace
 
 namespace facebook::fboss {
@@ -115,6 +130,18 @@ int HwAsic::getDefaultTeFlowGroupID() const {
   }
 }
 
+int HwAsic::getMaxDataplaneAclPriorities() const {
+  return kDefaultMaxDataplaneAclPriorities;
+}
+
+int HwAsic::getAclPriorityGap() const {
+  if (FLAGS_acl_priority_gap > 0) {
+    return FLAGS_acl_priority_gap;
+  } else {
+    return getDefaultAclPriorityGap();
+  }
+}
+
 /*
  * station entry id for vlan interface
  */
@@ -210,6 +210,25 @@ class HwAsic {
    */
   virtual int getDefaultTeFlowGroupID() const;
 
+  /*
+   * Number of priorities available to dataplane ACLs, which SwitchState
+   * numbers from AclTable::kDataplaneAclMaxPriority up. This is a fixed
+   * software cap on the allocation window, not queried from the ASIC.
+   */
+  virtual int getMaxDataplaneAclPriorities() const;
+
+  /*
+   * Gap between the priorities of newly allocated ACLs, leaving room to
+   * insert ACLs later without changing the priorities of their neighbours.
+   * 1 packs ACLs densely, for ASICs without priority range to spare, such as
+   * TAJO which only leaves half of its range to dataplane ACLs. Can be
+   * overridden with --acl_priority_gap.
+   */
+  int getAclPriorityGap() const;
+  virtual int getDefaultAclPriorityGap() const {
+    return 1;
+  }
+
   /*
    * station entry id for vlan interface
    */
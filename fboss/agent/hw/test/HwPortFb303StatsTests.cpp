@@ -318,6 +318,20 @@ TEST(HwPortFb303Stats, UpdateStats) {
   verifyUpdatedStats(portStats);
 }
 
+TEST(HwPortFb303Stats, UpdateStatsAfterRename) {
+  HwPortFb303Stats portStats(kPortName, kQueue2Name);
+  // Counters are resolved on every (re)init, updates must go to the
+  // counters of the current names
+  portStats.portNameChanged("fab1/1/1");
+  portStats.queueChanged(1, "platinum");
+  portStats.portNameChanged(kPortName);
+  portStats.queueChanged(1, "gold");
+  portStats.queueRemoved(2);
+  portStats.queueChanged(2, "silver");
+  updateStats(portStats);
+  verifyUpdatedStats(portStats);
+}
+
 TEST(HwPortFb303StatsTest, PortName) {
   constexpr auto kNewPortName = "eth1/2/1";
   HwPortFb303Stats stats(kPortName, kQueue2Name);
@@ -23,6 +23,7 @@ void hwSwitchFibUpdate(
     const facebook::fboss::IPv4NetworkToRouteMap& v4NetworkToRoute,
     const facebook::fboss::IPv6NetworkToRouteMap& v6NetworkToRoute,
     const facebook::fboss::LabelToRouteMap& labelToRoute,
+    const facebook::fboss::RibToFibDelta* ribToFibDelta,
     void* cookie);
 
 class HwSwitchEnsembleRouteUpdateWrapper : public RouteUpdateWrapper {
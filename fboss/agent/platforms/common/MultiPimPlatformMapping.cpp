@@ -21,58 +21,74 @@ namespace fboss {
 MultiPimPlatformMapping::MultiPimPlatformMapping(
     const std::string& jsonPlatformMappingStr)
     : PlatformMapping(jsonPlatformMappingStr) {
-  for (auto& port : platformPorts_) {
-    int portPimID = getPimID(port.second);
+  initPims();
+}
 
-    if (pims_.find(portPimID) == pims_.end()) {
-      pims_[portPimID] = std::make_unique<PlatformMapping>();
-    }
+MultiPimPlatformMapping::MultiPimPlatformMapping(
+    folly::ByteRange compactPlatformMapping)
+    : PlatformMapping(compactPlatformMapping) {
+  initPims();
+}
 
-    pims_[portPimID]->setPlatformPort(port.first, port.second);
+void MultiPimPlatformMapping::initPims() {
+  for (const auto& [portID, pimID] : getPlatformPortPimIDs()) {
+    pimPorts_[pimID].push_back(portID);
+  }
+}
 
-    const auto& portChips = utility::getDataPlanePhyChips(port.second, chips_);
+std::unique_ptr<PlatformMapping>& MultiPimPlatformMapping::getOrCreatePim(
+    uint8_t pimID) {
+  if (auto itPim = pims_.find(pimID); itPim != pims_.end()) {
+    return itPim->second;
+  }
+  auto itPimPorts = pimPorts_.find(pimID);
+  if (itPimPorts == pimPorts_.end()) {
+    throw FbossError("Invalid pim id:", static_cast<int>(pimID));
+  }
+
+  auto pim = std::make_unique<PlatformMapping>();
+  for (auto portID : itPimPorts->second) {
+    const auto& port = *getPlatformPortIf(portID);
+    pim->setPlatformPort(portID, port);
+
+    const auto& portChips = utility::getDataPlanePhyChips(port, chips_);
     for (auto itChip : portChips) {
-      pims_[portPimID]->setChip(itChip.first, itChip.second);
+      pim->setChip(itChip.first, itChip.second);
     }
 
-    for (auto& portProfile : *port.second.supportedProfiles()) {
+    for (auto& portProfile : *port.supportedProfiles()) {
       if (auto platformProfile =
               getPortProfileConfig(PlatformPortProfileConfigMatcher(
-                  portProfile.first, PimID(portPimID)))) {
+                  portProfile.first, PimID(pimID)))) {
         cfg::PlatformPortProfileConfigEntry configEntry;
         cfg::PlatformPortConfigFactor factor;
         factor.profileID() = portProfile.first;
-        factor.pimIDs() = {portPimID};
+        factor.pimIDs() = {pimID};
         configEntry.profile() = platformProfile.value();
         configEntry.factor() = factor;
-        pims_[portPimID]->mergePlatformSupportedProfile(configEntry);
+        pim->mergePlatformSupportedProfile(configEntry);
       } else {
         throw FbossError(
             "Port:",
-            *port.second.mapping()->name(),
+            *port.mapping()->name(),
             " uses unsupported platform profile:",
             apache::thrift::util::enumNameSafe(portProfile.first));
       }
     }
 
-    auto portConfigOverrides = getPortConfigOverrides(port.first);
-    pims_[portPimID]->mergePortConfigOverrides(port.first, portConfigOverrides);
+    auto portConfigOverrides = getPortConfigOverrides(portID);
+    pim->mergePortConfigOverrides(portID, portConfigOverrides);
   }
+  return pims_[pimID] = std::move(pim);
 }
 
 PlatformMapping* MultiPimPlatformMapping::getPimPlatformMapping(uint8_t pimID) {
-  if (auto itPim = pims_.find(pimID); itPim != pims_.end()) {
-    return itPim->second.get();
-  }
-  throw FbossError("Invalid pim id:", static_cast<int>(pimID));
+  return getOrCreatePim(pimID).get();
 }
 
 std::unique_ptr<PlatformMapping>
 MultiPimPlatformMapping::getPimPlatformMappingUniquePtr(uint8_t pimID) {
-  if (auto itPim = pims_.find(pimID); itPim != pims_.end()) {
-    return std::move(itPim->second);
-  }
-  throw FbossError("Invalid pim id:", static_cast<int>(pimID));
+  return std::move(getOrCreatePim(pimID));
 }
 } // namespace fboss
 } // namespace facebook
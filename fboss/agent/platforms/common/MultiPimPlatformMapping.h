@@ -14,9 +14,18 @@
 namespace facebook {
 namespace fboss {
 
+/*
+ * The mapping of each pim is only built on first use, from the ports of that
+ * pim.
+ */
 class MultiPimPlatformMapping : public PlatformMapping {
  public:
   explicit MultiPimPlatformMapping(const std::string& jsonPlatformMappingStr);
+  /*
+   * Mapping built into the binary as its compact encoding (see
+   * PlatformMapping::toCompact()). Ports are decoded on first access.
+   */
+  explicit MultiPimPlatformMapping(folly::ByteRange compactPlatformMapping);
 
   PlatformMapping* getPimPlatformMapping(uint8_t pimID);
 
@@ -27,6 +36,12 @@ class MultiPimPlatformMapping : public PlatformMapping {
   std::map<uint8_t, std::unique_ptr<PlatformMapping>> pims_;
 
  private:
+  void initPims();
+  std::unique_ptr<PlatformMapping>& getOrCreatePim(uint8_t pimID);
+
+  // Ports of each pim, to build its mapping from
+  std::map<uint8_t, std::vector<int32_t>> pimPorts_;
+
   // Forbidden copy constructor and assignment operator
   MultiPimPlatformMapping(MultiPimPlatformMapping const&) = delete;
   MultiPimPlatformMapping& operator=(MultiPimPlatformMapping const&) = delete;
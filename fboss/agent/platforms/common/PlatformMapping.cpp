@@ -10,16 +10,30 @@
 
 #include "fboss/agent/platforms/common/PlatformMapping.h"
 
+#include <folly/io/Cursor.h>
 #include <folly/logging/xlog.h>
 #include <re2/re2.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <tuple>
 
 #include "fboss/agent/FbossError.h"
 
 namespace {
 constexpr auto kFbossPortNameRegex = "eth(\\d+)/(\\d+)/(\\d+)";
 const re2::RE2 portNameRegex(kFbossPortNameRegex);
+
+// Compact platform mappings are laid out as (integers are little endian):
+//   u32 magic, u32 version
+//   u32 length, mapping without its ports
+//   u32 number of ports
+//   i32 port id, i32 pim id, u32 offset, u32 length: for each port, in port
+//     id order. The pim id is kNoPimID for port names without one.
+//   ports, each at its offset from the end of the port index
+constexpr uint32_t kCompactMappingMagic = 0x4d504246; // "FBPM"
+constexpr uint32_t kCompactMappingVersion = 2;
+constexpr size_t kCompactPortIndexEntrySize = 4 * sizeof(uint32_t);
+constexpr int32_t kNoPimID = -1;
 } // namespace
 
 namespace facebook {
@@ -152,6 +166,10 @@ PlatformMapping::PlatformMapping(const cfg::PlatformMapping& mapping) {
   init(mapping);
 }
 
+PlatformMapping::PlatformMapping(folly::ByteRange compactPlatformMapping) {
+  initCompact(compactPlatformMapping);
+}
+
 void PlatformMapping::init(const cfg::PlatformMapping& mapping) {
   platformPorts_ = std::move(*mapping.ports());
   platformSupportedProfiles_ = std::move(*mapping.platformSupportedProfiles());
@@ -163,9 +181,146 @@ void PlatformMapping::init(const cfg::PlatformMapping& mapping) {
   }
 }
 
+void PlatformMapping::initCompact(folly::ByteRange compactPlatformMapping) {
+  folly::IOBuf buf(folly::IOBuf::WRAP_BUFFER, compactPlatformMapping);
+  folly::io::Cursor cursor(&buf);
+  if (cursor.readLE<uint32_t>() != kCompactMappingMagic) {
+    throw FbossError("Not a compact platform mapping");
+  }
+  if (auto version = cursor.readLE<uint32_t>();
+      version != kCompactMappingVersion) {
+    throw FbossError("Unsupported compact platform mapping version ", version);
+  }
+  auto mappingLength = cursor.readLE<uint32_t>();
+  init(apache::thrift::CompactSerializer::deserialize<cfg::PlatformMapping>(
+      compactPlatformMapping.subpiece(
+          cursor.getCurrentPosition(), mappingLength)));
+  cursor.skip(mappingLength);
+
+  auto numPorts = cursor.readLE<uint32_t>();
+  auto portsStart =
+      cursor.getCurrentPosition() + numPorts * kCompactPortIndexEntrySize;
+  for (uint32_t i = 0; i < numPorts; ++i) {
+    auto portID = cursor.readLE<int32_t>();
+    auto pimID = cursor.readLE<int32_t>();
+    auto offset = cursor.readLE<uint32_t>();
+    auto length = cursor.readLE<uint32_t>();
+    encodedPlatformPorts_.emplace(
+        portID,
+        EncodedPlatformPort{
+            pimID,
+            compactPlatformMapping.subpiece(portsStart + offset, length)});
+  }
+  hasEncodedPlatformPorts_ = !encodedPlatformPorts_.empty();
+}
+
+std::string PlatformMapping::toCompact() const {
+  auto mapping = toThrift();
+  std::vector<std::tuple<int32_t, int32_t, std::string>> ports;
+  for (const auto& [portID, port] : *mapping.ports()) {
+    int pimID = 0;
+    if (!re2::RE2::FullMatch(
+            port.get_mapping().get_name(), portNameRegex, &pimID)) {
+      pimID = kNoPimID;
+    }
+    ports.emplace_back(
+        portID,
+        pimID,
+        apache::thrift::CompactSerializer::serialize<std::string>(port));
+  }
+  mapping.ports()->clear();
+  auto encodedMapping =
+      apache::thrift::CompactSerializer::serialize<std::string>(mapping);
+
+  folly::IOBufQueue queue;
+  folly::io::QueueAppender appender(&queue, 4096);
+  appender.writeLE<uint32_t>(kCompactMappingMagic);
+  appender.writeLE<uint32_t>(kCompactMappingVersion);
+  appender.writeLE<uint32_t>(encodedMapping.size());
+  appender.push(
+      reinterpret_cast<const uint8_t*>(encodedMapping.data()),
+      encodedMapping.size());
+  appender.writeLE<uint32_t>(ports.size());
+  uint32_t offset = 0;
+  for (const auto& [portID, pimID, encodedPort] : ports) {
+    appender.writeLE<int32_t>(portID);
+    appender.writeLE<int32_t>(pimID);
+    appender.writeLE<uint32_t>(offset);
+    appender.writeLE<uint32_t>(encodedPort.size());
+    offset += encodedPort.size();
+  }
+  for (const auto& [portID, pimID, encodedPort] : ports) {
+    appender.push(
+        reinterpret_cast<const uint8_t*>(encodedPort.data()),
+        encodedPort.size());
+  }
+  return queue.move()->moveToFbString().toStdString();
+}
+
+void PlatformMapping::decodeAllPlatformPorts() const {
+  if (!hasEncodedPlatformPorts_.load(std::memory_order_acquire)) {
+    return;
+  }
+  std::lock_guard<std::mutex> g(encodedPlatformPortsLock_);
+  for (const auto& [portID, encodedPort] : encodedPlatformPorts_) {
+    platformPorts_.emplace(
+        portID,
+        apache::thrift::CompactSerializer::deserialize<cfg::PlatformPortEntry>(
+            encodedPort.encoded));
+  }
+  encodedPlatformPorts_.clear();
+  hasEncodedPlatformPorts_.store(false, std::memory_order_release);
+}
+
+const cfg::PlatformPortEntry* PlatformMapping::getPlatformPortIf(
+    int32_t portID) const {
+  // Once all ports are decoded, platformPorts_ no longer changes
+  std::unique_lock<std::mutex> g(encodedPlatformPortsLock_, std::defer_lock);
+  if (hasEncodedPlatformPorts_.load(std::memory_order_acquire)) {
+    g.lock();
+  }
+  if (auto itPort = platformPorts_.find(portID);
+      itPort != platformPorts_.end()) {
+    return &itPort->second;
+  }
+  auto itEncodedPort = encodedPlatformPorts_.find(portID);
+  if (itEncodedPort == encodedPlatformPorts_.end()) {
+    return nullptr;
+  }
+  auto itPort =
+      platformPorts_
+          .emplace(
+              portID,
+              apache::thrift::CompactSerializer::deserialize<
+                  cfg::PlatformPortEntry>(itEncodedPort->second.encoded))
+          .first;
+  encodedPlatformPorts_.erase(itEncodedPort);
+  if (encodedPlatformPorts_.empty()) {
+    hasEncodedPlatformPorts_.store(false, std::memory_order_release);
+  }
+  return &itPort->second;
+}
+
+std::map<int32_t, int> PlatformMapping::getPlatformPortPimIDs() const {
+  std::map<int32_t, int> portPimIDs;
+  for (const auto& [portID, platformPort] : platformPorts_) {
+    portPimIDs.emplace(portID, getPimID(platformPort));
+  }
+  for (const auto& [portID, encodedPort] : encodedPlatformPorts_) {
+    if (encodedPort.pimID == kNoPimID) {
+      // Throws, with the name of the port
+      getPimID(
+          apache::thrift::CompactSerializer::deserialize<
+              cfg::PlatformPortEntry>(encodedPort.encoded));
+    }
+    portPimIDs.emplace(portID, encodedPort.pimID);
+  }
+  return portPimIDs;
+}
+
 cfg::PlatformMapping PlatformMapping::toThrift() const {
   cfg::PlatformMapping newMapping;
-  newMapping.ports() = this->platformPorts_;
+  newMapping.ports() = getPlatformPorts();
   newMapping.platformSupportedProfiles() = this->platformSupportedProfiles_;
   for (auto nameChipPair : this->chips_) {
     newMapping.chips()->push_back(nameChipPair.second);
@@ -175,7 +330,7 @@ cfg::PlatformMapping PlatformMapping::toThrift() const {
 }
 
 void PlatformMapping::merge(PlatformMapping* mapping) {
-  for (auto port : mapping->platformPorts_) {
+  for (auto port : mapping->getPlatformPorts()) {
     platformPorts_.emplace(port.first, std::move(port.second));
     mergePortConfigOverrides(
         port.first, mapping->getPortConfigOverrides(port.first));
@@ -237,11 +392,11 @@ void PlatformMapping::mergePlatformSupportedProfile(
 }
 
 int PlatformMapping::getPimID(PortID portID) const {
-  auto itPlatformPort = platformPorts_.find(portID);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = getPlatformPortIf(portID);
+  if (!platformPort) {
     throw FbossError("Unrecoganized port:", portID);
   }
-  return getPimID(itPlatformPort->second);
+  return getPimID(*platformPort);
 }
 
 int PlatformMapping::getPimID(
@@ -261,23 +416,22 @@ int PlatformMapping::getPimID(
 
 const phy::DataPlanePhyChip& PlatformMapping::getPortIphyChip(
     PortID portID) const {
-  auto itPlatformPort = platformPorts_.find(portID);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = getPlatformPortIf(portID);
+  if (!platformPort) {
     throw FbossError("Unrecoganized port:", portID);
   }
-  const auto& coreName =
-      itPlatformPort->second.mapping()->pins()[0].a()->get_chip();
+  const auto& coreName = platformPort->mapping()->pins()[0].a()->get_chip();
   return chips_.at(coreName);
 }
 
 cfg::PortSpeed PlatformMapping::getPortMaxSpeed(PortID portID) const {
-  auto itPlatformPort = platformPorts_.find(portID);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = getPlatformPortIf(portID);
+  if (!platformPort) {
     throw FbossError("Unrecoganized port:", portID);
   }
 
   cfg::PortSpeed maxSpeed{cfg::PortSpeed::DEFAULT};
-  for (auto profile : *itPlatformPort->second.supportedProfiles()) {
+  for (auto profile : *platformPort->supportedProfiles()) {
     if (auto profileConfig = getPortProfileConfig(
             PlatformPortProfileConfigMatcher(profile.first, portID))) {
       if (static_cast<int>(maxSpeed) <
@@ -555,7 +709,7 @@ void PlatformMapping::mergePortConfigOverrides(
 }
 
 const PortID PlatformMapping::getPortID(const std::string& portName) const {
-  for (const auto& platPortEntry : platformPorts_) {
+  for (const auto& platPortEntry : getPlatformPorts()) {
     if (*platPortEntry.second.mapping()->name() == portName) {
       return PortID(*platPortEntry.second.mapping()->id());
     }
@@ -566,12 +720,12 @@ const PortID PlatformMapping::getPortID(const std::string& portName) const {
 const cfg::PlatformPortConfig& PlatformMapping::getPlatformPortConfig(
     PortID id,
     cfg::PortProfileID profileID) const {
-  auto itPlatformPort = platformPorts_.find(id);
-  if (itPlatformPort == platformPorts_.end()) {
+  auto platformPort = getPlatformPortIf(id);
+  if (!platformPort) {
     throw FbossError("No PlatformPortEntry found for port ", id);
   }
 
-  auto& supportedProfiles = *itPlatformPort->second.supportedProfiles();
+  auto& supportedProfiles = *platformPort->supportedProfiles();
   auto platformPortConfig = supportedProfiles.find(profileID);
   if (platformPortConfig == supportedProfiles.end()) {
     throw FbossError(
@@ -586,15 +740,14 @@ const cfg::PlatformPortConfig& PlatformMapping::getPlatformPortConfig(
 std::map<phy::DataPlanePhyChip, std::vector<phy::PinConfig>>
 PlatformMapping::getCorePinMapping(const std::vector<cfg::Port>& ports) const {
   std::map<phy::DataPlanePhyChip, std::vector<phy::PinConfig>> corePinMapping;
-  const auto& platformPorts = getPlatformPorts();
   for (auto& port : ports) {
     auto portID = port.get_logicalID();
-    if (platformPorts.find(portID) == platformPorts.end()) {
+    auto platformPortEntry = getPlatformPortIf(portID);
+    if (!platformPortEntry) {
       throw FbossError("Could not find platform port with id ", portID);
     }
-    auto& platformPortEntry = platformPorts.at(portID);
     auto profileID = port.get_profileID();
-    if (portID != platformPortEntry.mapping()->get_controllingPort()) {
+    if (portID != platformPortEntry->mapping()->get_controllingPort()) {
       continue;
     }
     const auto& chip = getPortIphyChip(PortID(portID));
@@ -14,6 +14,10 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/qsfp_service/if/gen-cpp2/transceiver_types.h"
 
+#include <folly/Range.h>
+#include <atomic>
+#include <mutex>
+
 namespace facebook {
 namespace fboss {
 
@@ -72,11 +76,24 @@ class PlatformMapping {
   PlatformMapping() {}
   explicit PlatformMapping(const std::string& jsonPlatformMappingStr);
   explicit PlatformMapping(const cfg::PlatformMapping& mapping);
+  /*
+   * Build from the output of toCompact(). Platform ports are only decoded on
+   * first access, so compactPlatformMapping must outlive this mapping, e.g.
+   * by being embedded in the binary.
+   */
+  explicit PlatformMapping(folly::ByteRange compactPlatformMapping);
   virtual ~PlatformMapping() = default;
 
   cfg::PlatformMapping toThrift() const;
 
+  /*
+   * Compact protocol encoding of the mapping, with each platform port
+   * encoded separately and indexed by port id and pim id
+   */
+  std::string toCompact() const;
+
   const std::map<int32_t, cfg::PlatformPortEntry>& getPlatformPorts() const {
+    decodeAllPlatformPorts();
     return platformPorts_;
   }
 
@@ -146,7 +163,8 @@ class PlatformMapping {
   getCorePinMapping(const std::vector<cfg::Port>& ports) const;
 
  protected:
-  std::map<int32_t, cfg::PlatformPortEntry> platformPorts_;
+  // Ports decoded from a compact mapping are added on first access
+  mutable std::map<int32_t, cfg::PlatformPortEntry> platformPorts_;
   std::vector<cfg::PlatformPortProfileConfigEntry> platformSupportedProfiles_;
   std::map<std::string, phy::DataPlanePhyChip> chips_;
   std::vector<cfg::PlatformPortConfigOverride> portConfigOverrides_;
@@ -155,8 +173,34 @@ class PlatformMapping {
       PortID id,
       cfg::PortProfileID profileID) const;
 
- private:
   void init(const cfg::PlatformMapping& mapping);
+  void initCompact(folly::ByteRange compactPlatformMapping);
+
+  /*
+   * Returns nullptr for unknown ports. Only decodes the requested port of a
+   * compact mapping.
+   */
+  const cfg::PlatformPortEntry* getPlatformPortIf(int32_t portID) const;
+
+  /*
+   * Pim id of every port, without decoding the ports of a compact mapping.
+   * Only meant for use while building the mapping, not concurrently with
+   * port lookups.
+   */
+  std::map<int32_t, int> getPlatformPortPimIDs() const;
+
+ private:
+  void decodeAllPlatformPorts() const;
+
+  struct EncodedPlatformPort {
+    int32_t pimID;
+    folly::ByteRange encoded;
+  };
+  // Encoded ports of a compact mapping, not decoded yet
+  mutable std::map<int32_t, EncodedPlatformPort> encodedPlatformPorts_;
+  mutable std::atomic<bool> hasEncodedPlatformPorts_{false};
+  mutable std::mutex encodedPlatformPortsLock_;
+
   // Forbidden copy constructor and assignment operator
   PlatformMapping(PlatformMapping const&) = delete;
   PlatformMapping& operator=(PlatformMapping const&) = delete;
@@ -0,0 +1,110 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+/*
+ * Build step generating the compact encoding of a platform mapping. Reads the
+ * JSON raw string literal out of a platform mapping source file, and writes a
+ * source file defining <class>::compactPlatformMapping() to return its
+ * PlatformMapping::toCompact() encoding. The JSON itself is not built into
+ * binaries using the compact encoding.
+ */
+
+#include "fboss/agent/platforms/common/PlatformMapping.h"
+
+#include <folly/FileUtil.h>
+#include <folly/Format.h>
+#include <folly/init/Init.h>
+#include <folly/logging/xlog.h>
+#include <gflags/gflags.h>
+#include <cstring>
+
+DEFINE_string(source, "", "Platform mapping source file with the JSON mapping");
+DEFINE_string(header, "", "Header declaring the platform mapping class");
+DEFINE_string(class_name, "", "Platform mapping class name");
+DEFINE_string(output, "", "Generated source file");
+
+namespace {
+constexpr auto kJsonStart = "R\"(";
+constexpr auto kJsonEnd = ")\"";
+constexpr auto kBytesPerLine = 12;
+
+std::string extractJson(const std::string& source) {
+  auto start = source.find(kJsonStart);
+  if (start == std::string::npos) {
+    throw std::runtime_error(
+        folly::to<std::string>("No JSON mapping in ", FLAGS_source));
+  }
+  start += strlen(kJsonStart);
+  auto end = source.find(kJsonEnd, start);
+  if (end == std::string::npos) {
+    throw std::runtime_error(
+        folly::to<std::string>("Unterminated JSON mapping in ", FLAGS_source));
+  }
+  return source.substr(start, end - start);
+}
+
+std::string generateSource(const std::string& compactMapping) {
+  std::string out = folly::sformat(
+      "// THIS FILE IS AUTOGENERATED DO NOT MODIFY\n"
+      "// GENERATED BY: platform_mapping_compiler from {}\n\n"
+      "#include \"{}\"\n\n"
+      "namespace {{\n"
+      "const uint8_t kCompactPlatformMapping[] = {{",
+      FLAGS_source,
+      FLAGS_header);
+  for (size_t i = 0; i < compactMapping.size(); ++i) {
+    out += i % kBytesPerLine ? " " : "\n    ";
+    out += folly::sformat(
+        "0x{:02x},", static_cast<unsigned>(uint8_t(compactMapping[i])));
+  }
+  out += folly::sformat(
+      "\n}};\n"
+      "}} // namespace\n\n"
+      "namespace facebook::fboss {{\n"
+      "folly::ByteRange {}::compactPlatformMapping() {{\n"
+      "  return folly::ByteRange(\n"
+      "      kCompactPlatformMapping, sizeof(kCompactPlatformMapping));\n"
+      "}}\n"
+      "}} // namespace facebook::fboss\n",
+      FLAGS_class_name);
+  return out;
+}
+} // namespace
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  if (FLAGS_source.empty() || FLAGS_header.empty() ||
+      FLAGS_class_name.empty() || FLAGS_output.empty()) {
+    XLOG(ERR) << "--source, --header, --class_name and --output are required";
+    return 1;
+  }
+
+  std::string source;
+  if (!folly::readFile(FLAGS_source.c_str(), source)) {
+    XLOG(ERR) << "Failed to read " << FLAGS_source;
+    return 1;
+  }
+  facebook::fboss::PlatformMapping mapping(extractJson(source));
+  auto compactMapping = mapping.toCompact();
+  // The JSON is left out of the binary, make sure nothing is lost on the way
+  facebook::fboss::PlatformMapping decodedMapping(
+      folly::ByteRange(folly::StringPiece(compactMapping)));
+  if (decodedMapping.toThrift() != mapping.toThrift()) {
+    XLOG(ERR) << "Compact encoding of " << FLAGS_source
+              << " does not decode to the JSON mapping";
+    return 1;
+  }
+  if (!folly::writeFile(
+          generateSource(compactMapping), FLAGS_output.c_str())) {
+    XLOG(ERR) << "Failed to write " << FLAGS_output;
+    return 1;
+  }
+  return 0;
+}
@@ -11,6 +11,9 @@
 #include "fboss/agent/platforms/common/fuji/Fuji16QPimPlatformMapping.h"
 #include <folly/logging/xlog.h>
 
+// Source of the compact encoding generated at build time
+// (ADD_COMPACT_PLATFORM_MAPPING), which is built into the binary instead
+#ifndef FBOSS_COMPACT_PLATFORM_MAPPING
 namespace {
 constexpr auto kJsonPlatformMappingStr = R"(
 {
@@ -97773,11 +97776,16 @@ constexpr auto kJsonPlatformMappingStr = R"(
 }
 )";
 } // namespace
+#endif
 
 namespace facebook {
 namespace fboss {
 Fuji16QPimPlatformMapping::Fuji16QPimPlatformMapping()
+#ifdef FBOSS_COMPACT_PLATFORM_MAPPING
+    : MultiPimPlatformMapping(compactPlatformMapping()) {}
+#else
     : MultiPimPlatformMapping(kJsonPlatformMappingStr) {}
+#endif
 
 Fuji16QPimPlatformMapping::Fuji16QPimPlatformMapping(
     const std::string& platformMappingStr)
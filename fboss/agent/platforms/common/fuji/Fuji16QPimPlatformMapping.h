@@ -19,6 +19,9 @@ class Fuji16QPimPlatformMapping : public MultiPimPlatformMapping {
   explicit Fuji16QPimPlatformMapping();
   explicit Fuji16QPimPlatformMapping(const std::string& platformMappingStr);
 
+  // Compact encoding of the JSON mapping, generated at build time
+  static folly::ByteRange compactPlatformMapping();
+
  private:
   // Forbidden copy constructor and assignment operator
   Fuji16QPimPlatformMapping(Fuji16QPimPlatformMapping const&) = delete;
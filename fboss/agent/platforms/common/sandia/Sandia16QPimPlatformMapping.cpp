@@ -10,6 +10,9 @@
 
 #include "fboss/agent/platforms/common/sandia/Sandia16QPimPlatformMapping.h"
 
+// Source of the compact encoding generated at build time
+// (ADD_COMPACT_PLATFORM_MAPPING), which is built into the binary instead
+#ifndef FBOSS_COMPACT_PLATFORM_MAPPING
 namespace {
 constexpr auto kJsonPlatformMappingStr = R"(
 {
@@ -70590,11 +70593,16 @@ constexpr auto kJsonPlatformMappingStr = R"(
 }
 )";
 } // namespace
+#endif
 
 namespace facebook {
 namespace fboss {
 Sandia16QPimPlatformMapping::Sandia16QPimPlatformMapping()
+#ifdef FBOSS_COMPACT_PLATFORM_MAPPING
+    : MultiPimPlatformMapping(compactPlatformMapping()) {}
+#else
     : MultiPimPlatformMapping(kJsonPlatformMappingStr) {}
+#endif
 
 Sandia16QPimPlatformMapping::Sandia16QPimPlatformMapping(
     const std::string& platformMappingStr)
@@ -19,6 +19,9 @@ class Sandia16QPimPlatformMapping : public MultiPimPlatformMapping {
   Sandia16QPimPlatformMapping();
   explicit Sandia16QPimPlatformMapping(const std::string& platformMappingStr);
 
+  // Compact encoding of the JSON mapping, generated at build time
+  static folly::ByteRange compactPlatformMapping();
+
  private:
   // Forbidden copy constructor and assignment operator
   Sandia16QPimPlatformMapping(Sandia16QPimPlatformMapping const&) = delete;
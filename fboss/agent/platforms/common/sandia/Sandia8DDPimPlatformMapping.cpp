@@ -11,6 +11,9 @@
 
 #include "fboss/agent/platforms/common/sandia/Sandia8DDPimPlatformMapping.h"
 
+// Source of the compact encoding generated at build time
+// (ADD_COMPACT_PLATFORM_MAPPING), which is built into the binary instead
+#ifndef FBOSS_COMPACT_PLATFORM_MAPPING
 namespace {
 constexpr auto kJsonPlatformMappingStr = R"(
 {
@@ -75135,11 +75138,16 @@ constexpr auto kJsonPlatformMappingStr = R"(
 }
 )";
 } // namespace
+#endif
 
 namespace facebook {
 namespace fboss {
 Sandia8DDPimPlatformMapping::Sandia8DDPimPlatformMapping()
+#ifdef FBOSS_COMPACT_PLATFORM_MAPPING
+    : MultiPimPlatformMapping(compactPlatformMapping()) {}
+#else
     : MultiPimPlatformMapping(kJsonPlatformMappingStr) {}
+#endif
 
 Sandia8DDPimPlatformMapping::Sandia8DDPimPlatformMapping(
     const std::string& platformMappingStr)
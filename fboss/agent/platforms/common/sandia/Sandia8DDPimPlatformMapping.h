@@ -19,6 +19,9 @@ class Sandia8DDPimPlatformMapping : public MultiPimPlatformMapping {
   Sandia8DDPimPlatformMapping();
   explicit Sandia8DDPimPlatformMapping(const std::string& platformMappingStr);
 
+  // Compact encoding of the JSON mapping, generated at build time
+  static folly::ByteRange compactPlatformMapping();
+
  private:
   // Forbidden copy constructor and assignment operator
   Sandia8DDPimPlatformMapping(Sandia8DDPimPlatformMapping const&) = delete;
@@ -19,6 +19,9 @@ class Yamp16QPimPlatformMapping : public MultiPimPlatformMapping {
   Yamp16QPimPlatformMapping();
   explicit Yamp16QPimPlatformMapping(const std::string& platformMappingStr);
 
+  // Compact encoding of the JSON mapping, generated at build time
+  static folly::ByteRange compactPlatformMapping();
+
  private:
   // Forbidden copy constructor and assignment operator
   Yamp16QPimPlatformMapping(Yamp16QPimPlatformMapping const&) = delete;
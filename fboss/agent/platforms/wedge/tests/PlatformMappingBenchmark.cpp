@@ -0,0 +1,201 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/platforms/common/fuji/Fuji16QPimPlatformMapping.h"
+#include "fboss/agent/platforms/common/sandia/Sandia8DDPimPlatformMapping.h"
+#include "fboss/agent/platforms/common/yamp/Yamp16QPimPlatformMapping.h"
+
+#include <folly/Benchmark.h>
+#include <folly/FileUtil.h>
+#include <folly/String.h>
+#include <folly/init/Init.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <unistd.h>
+#include <iostream>
+
+/*
+ * Startup cost of the largest platform mappings, built from their JSON or
+ * from their compact encoding. Parse time is benchmarked, resident memory is
+ * measured in a fresh process per mapping with --resident_memory. The JSON is
+ * not built into the binary, it is serialized from the decoded mapping.
+ */
+DEFINE_string(
+    resident_memory,
+    "",
+    "Only print how much resident memory building a mapping takes: "
+    "<yamp|fuji|sandia>_<json|compact|pim|port>");
+
+using namespace facebook::fboss;
+
+namespace {
+template <typename MultiPimMappingT>
+const std::string& jsonMapping() {
+  static const std::string json =
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+          PlatformMapping(MultiPimMappingT::compactPlatformMapping())
+              .toThrift());
+  return json;
+}
+
+// Decodes every port
+template <typename MultiPimMappingT>
+std::unique_ptr<PlatformMapping> buildMapping(bool compact) {
+  auto mapping = compact
+      ? std::make_unique<MultiPimMappingT>()
+      : std::make_unique<MultiPimMappingT>(jsonMapping<MultiPimMappingT>());
+  folly::doNotOptimizeAway(mapping->getPlatformPorts().size());
+  return mapping;
+}
+
+// Only decodes the ports of the pim looked up
+template <typename MultiPimMappingT>
+std::unique_ptr<PlatformMapping> buildOnePimMapping() {
+  auto mapping = std::make_unique<MultiPimMappingT>();
+  folly::doNotOptimizeAway(mapping->getPimPlatformMapping(2));
+  return mapping;
+}
+
+// Only decodes the port looked up
+template <typename MultiPimMappingT>
+std::unique_ptr<PlatformMapping> buildOnePortMapping() {
+  auto mapping = std::make_unique<MultiPimMappingT>();
+  folly::doNotOptimizeAway(mapping->getPortMaxSpeed(PortID(1)));
+  return mapping;
+}
+
+template <typename MultiPimMappingT>
+std::function<std::unique_ptr<PlatformMapping>()> mappingBuilder(
+    const std::string& encoding) {
+  if (encoding == "pim") {
+    return buildOnePimMapping<MultiPimMappingT>;
+  }
+  if (encoding == "port") {
+    return buildOnePortMapping<MultiPimMappingT>;
+  }
+  if (encoding == "json") {
+    // Not counted as resident memory of the mapping
+    jsonMapping<MultiPimMappingT>();
+  }
+  return [compact = encoding == "compact"]() {
+    return buildMapping<MultiPimMappingT>(compact);
+  };
+}
+
+size_t residentBytes() {
+  std::string statm;
+  folly::readFile("/proc/self/statm", statm);
+  std::vector<folly::StringPiece> fields;
+  folly::split(' ', statm, fields);
+  return folly::to<size_t>(fields.at(1)) * sysconf(_SC_PAGESIZE);
+}
+
+int printResidentMemory(const std::string& mappingName) {
+  std::vector<std::string> platformAndEncoding;
+  folly::split('_', mappingName, platformAndEncoding);
+  if (platformAndEncoding.size() != 2) {
+    std::cerr << "Unknown mapping " << mappingName << std::endl;
+    return 1;
+  }
+  const auto& platform = platformAndEncoding[0];
+  const auto& encoding = platformAndEncoding[1];
+  std::function<std::unique_ptr<PlatformMapping>()> build;
+  if (platform == "yamp") {
+    build = mappingBuilder<Yamp16QPimPlatformMapping>(encoding);
+  } else if (platform == "fuji") {
+    build = mappingBuilder<Fuji16QPimPlatformMapping>(encoding);
+  } else if (platform == "sandia") {
+    build = mappingBuilder<Sandia8DDPimPlatformMapping>(encoding);
+  } else {
+    std::cerr << "Unknown platform " << platform << std::endl;
+    return 1;
+  }
+  auto before = residentBytes();
+  auto mapping = build();
+  std::cout << mappingName << ": " << (residentBytes() - before) / 1024
+            << " KiB resident" << std::endl;
+  return 0;
+}
+} // namespace
+
+BENCHMARK(Yamp16QPimJson, iters) {
+  BENCHMARK_SUSPEND {
+    jsonMapping<Yamp16QPimPlatformMapping>();
+  }
+  for (unsigned i = 0; i < iters; ++i) {
+    buildMapping<Yamp16QPimPlatformMapping>(false);
+  }
+}
+
+BENCHMARK_RELATIVE(Yamp16QPimCompact) {
+  buildMapping<Yamp16QPimPlatformMapping>(true);
+}
+
+BENCHMARK_RELATIVE(Yamp16QPimCompactOnePim) {
+  buildOnePimMapping<Yamp16QPimPlatformMapping>();
+}
+
+BENCHMARK_RELATIVE(Yamp16QPimCompactOnePort) {
+  buildOnePortMapping<Yamp16QPimPlatformMapping>();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(Fuji16QPimJson, iters) {
+  BENCHMARK_SUSPEND {
+    jsonMapping<Fuji16QPimPlatformMapping>();
+  }
+  for (unsigned i = 0; i < iters; ++i) {
+    buildMapping<Fuji16QPimPlatformMapping>(false);
+  }
+}
+
+BENCHMARK_RELATIVE(Fuji16QPimCompact) {
+  buildMapping<Fuji16QPimPlatformMapping>(true);
+}
+
+BENCHMARK_RELATIVE(Fuji16QPimCompactOnePim) {
+  buildOnePimMapping<Fuji16QPimPlatformMapping>();
+}
+
+BENCHMARK_RELATIVE(Fuji16QPimCompactOnePort) {
+  buildOnePortMapping<Fuji16QPimPlatformMapping>();
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(Sandia8DDPimJson, iters) {
+  BENCHMARK_SUSPEND {
+    jsonMapping<Sandia8DDPimPlatformMapping>();
+  }
+  for (unsigned i = 0; i < iters; ++i) {
+    buildMapping<Sandia8DDPimPlatformMapping>(false);
+  }
+}
+
+BENCHMARK_RELATIVE(Sandia8DDPimCompact) {
+  buildMapping<Sandia8DDPimPlatformMapping>(true);
+}
+
+BENCHMARK_RELATIVE(Sandia8DDPimCompactOnePim) {
+  buildOnePimMapping<Sandia8DDPimPlatformMapping>();
+}
+
+BENCHMARK_RELATIVE(Sandia8DDPimCompactOnePort) {
+  buildOnePortMapping<Sandia8DDPimPlatformMapping>();
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  if (!FLAGS_resident_memory.empty()) {
+    return printResidentMemory(FLAGS_resident_memory);
+  }
+  folly::runBenchmarks();
+  return 0;
+}
@@ -16,6 +16,8 @@
 #include "fboss/agent/platforms/common/galaxy/GalaxyFCPlatformMapping.h"
 #include "fboss/agent/platforms/common/galaxy/GalaxyLCPlatformMapping.h"
 #include "fboss/agent/platforms/common/minipack/Minipack16QPimPlatformMapping.h"
+#include "fboss/agent/platforms/common/sandia/Sandia16QPimPlatformMapping.h"
+#include "fboss/agent/platforms/common/sandia/Sandia8DDPimPlatformMapping.h"
 #include "fboss/agent/platforms/common/wedge100/Wedge100PlatformMapping.h"
 #include "fboss/agent/platforms/common/wedge40/Wedge40PlatformMapping.h"
 #include "fboss/agent/platforms/common/wedge400/Wedge400PlatformMapping.h"
@@ -25,12 +27,61 @@
 #include "fboss/lib/phy/gen-cpp2/phy_types.h"
 #include "fboss/lib/platforms/PlatformMode.h"
 
+#include <gflags/gflags.h>
 #include <gtest/gtest.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
 #include <optional>
 
 namespace facebook::fboss::test {
 
+namespace {
+class LazyPlatformMapping : public PlatformMapping {
+ public:
+  using PlatformMapping::PlatformMapping;
+
+  size_t numDecodedPlatformPorts() const {
+    return platformPorts_.size();
+  }
+};
+
+template <typename MultiPimMappingT>
+void verifyCompactPlatformMapping() {
+  // JSON of the mapping, decoded in full
+  PlatformMapping fullMapping(MultiPimMappingT::compactPlatformMapping());
+  MultiPimMappingT jsonMapping(
+      apache::thrift::SimpleJSONSerializer::serialize<std::string>(
+          fullMapping.toThrift()));
+  const auto& jsonPorts = jsonMapping.getPlatformPorts();
+
+  // Lookups of single ports only decode those ports
+  LazyPlatformMapping lazyMapping(MultiPimMappingT::compactPlatformMapping());
+  EXPECT_EQ(lazyMapping.numDecodedPlatformPorts(), 0);
+  size_t numLookedUp = 0;
+  for (auto portID : {jsonPorts.begin()->first, jsonPorts.rbegin()->first}) {
+    EXPECT_EQ(
+        jsonMapping.getPortMaxSpeed(PortID(portID)),
+        lazyMapping.getPortMaxSpeed(PortID(portID)));
+    EXPECT_EQ(
+        jsonMapping.getPortIphyChip(PortID(portID)),
+        lazyMapping.getPortIphyChip(PortID(portID)));
+    EXPECT_EQ(lazyMapping.numDecodedPlatformPorts(), ++numLookedUp);
+  }
+  EXPECT_EQ(jsonPorts, lazyMapping.getPlatformPorts());
+  EXPECT_EQ(lazyMapping.numDecodedPlatformPorts(), jsonPorts.size());
+
+  // Pim mappings are built on first use, from the pim ids of the port index
+  MultiPimMappingT compactMapping;
+  for (uint8_t pimID = 2; pimID < 10; pimID++) {
+    EXPECT_EQ(
+        jsonMapping.getPimPlatformMapping(pimID)->toThrift(),
+        compactMapping.getPimPlatformMapping(pimID)->toThrift());
+  }
+  EXPECT_THROW(compactMapping.getPimPlatformMapping(10), FbossError);
+  EXPECT_EQ(jsonMapping.toThrift(), compactMapping.toThrift());
+}
+} // namespace
+
 cfg::PlatformPortProfileConfigEntry createPlatformPortProfileConfigEntry(
     cfg::PortProfileID profileID,
     std::set<int> pimIDs,
@@ -1306,4 +1357,11 @@ TEST_F(PlatformMappingTest, VerifyYampXphyLinePolaritySwap) {
   verifyXphyLinePolaritySwapByProfile(
       mapping.get(), mapping->getPlatformPorts(), expectedPolaritySwap);
 }
+
+TEST_F(PlatformMappingTest, VerifyCompactPlatformMappings) {
+  verifyCompactPlatformMapping<Yamp16QPimPlatformMapping>();
+  verifyCompactPlatformMapping<Fuji16QPimPlatformMapping>();
+  verifyCompactPlatformMapping<Sandia16QPimPlatformMapping>();
+  verifyCompactPlatformMapping<Sandia8DDPimPlatformMapping>();
+}
 } // namespace facebook::fboss::test
@@ -24,6 +24,7 @@
 
 namespace facebook::fboss {
 
+class RibResolutionIndex;
 class RibRouteUpdater;
 
 // I considered templatizing this class by Iterator but decided against it
@@ -60,7 +61,8 @@ class ConfigApplier {
       folly::Range<StaticIp2MplsRouteIterator> staticIp2MplsRouteRange,
       folly::Range<StaticMplsRouteWithNextHopsIterator> staticMplsRouteRange,
       folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsDropRouteRange,
-      folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsCpuRouteRange);
+      folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsCpuRouteRange,
+      RibResolutionIndex* resolutionIndex = nullptr);
 
   void apply();
 
@@ -77,6 +79,7 @@ class ConfigApplier {
   folly::Range<StaticMplsRouteWithNextHopsIterator> staticMplsRouteRange_;
   folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsDropRouteRange_;
   folly::Range<StaticMplsRouteNoNextHopsIterator> staticMplsCpuRouteRange_;
+  RibResolutionIndex* resolutionIndex_;
 };
 
 } // namespace facebook::fboss
@@ -20,9 +20,10 @@ std::shared_ptr<facebook::fboss::SwitchState> ribToSwitchStateUpdate(
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const RibToFibDelta* ribToFibDelta,
     void* cookie) {
   ForwardingInformationBaseUpdater fibUpdater(
-      vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute);
+      vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute, ribToFibDelta);
 
   auto switchState =
       static_cast<std::shared_ptr<facebook::fboss::SwitchState>*>(cookie);
@@ -36,6 +37,7 @@ std::shared_ptr<facebook::fboss::SwitchState> noopFibUpdate(
     const IPv4NetworkToRouteMap& /*v4NetworkToRoute*/,
     const IPv6NetworkToRouteMap& /*v6NetworkToRoute*/,
     const LabelToRouteMap& /*labelToRoute*/,
+    const RibToFibDelta* /*ribToFibDelta*/,
     void* /*cookie*/) {
   return nullptr;
 }
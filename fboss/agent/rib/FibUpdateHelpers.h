@@ -17,12 +17,14 @@
 namespace facebook::fboss {
 
 class SwitchState;
+struct RibToFibDelta;
 
 std::shared_ptr<SwitchState> ribToSwitchStateUpdate(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const RibToFibDelta* ribToFibDelta,
     void* cookie);
 
 std::shared_ptr<SwitchState> noopFibUpdate(
@@ -30,5 +32,6 @@ std::shared_ptr<SwitchState> noopFibUpdate(
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const RibToFibDelta* ribToFibDelta,
     void* cookie);
 } // namespace facebook::fboss
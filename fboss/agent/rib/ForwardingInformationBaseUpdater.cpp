@@ -21,6 +21,7 @@
 #include <folly/logging/xlog.h>
 
 #include <algorithm>
+#include <variant>
 
 namespace facebook::fboss {
 
@@ -28,11 +29,13 @@ ForwardingInformationBaseUpdater::ForwardingInformationBaseUpdater(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
-    const LabelToRouteMap& labelToRoute)
+    const LabelToRouteMap& labelToRoute,
+    const RibToFibDelta* ribToFibDelta)
     : vrf_(vrf),
       v4NetworkToRoute_(v4NetworkToRoute),
       v6NetworkToRoute_(v6NetworkToRoute),
-      labelToRoute_(labelToRoute) {}
+      labelToRoute_(labelToRoute),
+      ribToFibDelta_(ribToFibDelta) {}
 
 std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
     const std::shared_ptr<SwitchState>& state) {
@@ -53,11 +56,15 @@ std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
     previousFibContainer = nextState->getFibs()->getFibContainerIf(vrf_);
   }
   CHECK(previousFibContainer);
-  auto newFibV4 =
-      createUpdatedFib(v4NetworkToRoute_, previousFibContainer->getFibV4());
+  auto newFibV4 = updateFib(
+      v4NetworkToRoute_,
+      previousFibContainer->getFibV4(),
+      ribToFibDelta_ ? ribToFibDelta_->syncedFibV4 : nullptr);
 
-  auto newFibV6 =
-      createUpdatedFib(v6NetworkToRoute_, previousFibContainer->getFibV6());
+  auto newFibV6 = updateFib(
+      v6NetworkToRoute_,
+      previousFibContainer->getFibV6(),
+      ribToFibDelta_ ? ribToFibDelta_->syncedFibV6 : nullptr);
 
   auto newLabelFib = createUpdatedLabelFib(
       labelToRoute_, state->getLabelForwardingInformationBase());
@@ -82,6 +89,76 @@ std::shared_ptr<SwitchState> ForwardingInformationBaseUpdater::operator()(
   return nextState;
 }
 
+template <typename AddressT>
+std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+ForwardingInformationBaseUpdater::updateFib(
+    const facebook::fboss::NetworkToRouteMap<AddressT>& rib,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fib,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        syncedFib) {
+  // The delta is only meaningful relative to the FIB the RIB last synced
+  // to. If some other state update replaced the FIB (e.g. a HW rollback),
+  // fall back to rebuilding it from the whole RIB.
+  if (ribToFibDelta_ && ribToFibDelta_->changedRoutes && syncedFib &&
+      syncedFib == fib) {
+    return createUpdatedFibFromDelta(rib, fib);
+  }
+  return createUpdatedFib(rib, fib);
+}
+
+template <typename AddressT>
+std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+ForwardingInformationBaseUpdater::createUpdatedFibFromDelta(
+    const facebook::fboss::NetworkToRouteMap<AddressT>& rib,
+    const std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>&
+        fib) {
+  std::shared_ptr<facebook::fboss::ForwardingInformationBase<AddressT>>
+      updatedFib;
+  auto writableFib = [&updatedFib, &fib]() {
+    if (!updatedFib) {
+      updatedFib = fib->clone();
+    }
+    return updatedFib.get();
+  };
+  for (const auto& routeKey : *ribToFibDelta_->changedRoutes) {
+    auto cidr = std::get_if<folly::CIDRNetwork>(&routeKey);
+    if (!cidr ||
+        cidr->first.isV4() != std::is_same_v<AddressT, folly::IPAddressV4>) {
+      continue;
+    }
+    AddressT network;
+    if constexpr (std::is_same_v<AddressT, folly::IPAddressV4>) {
+      network = cidr->first.asV4();
+    } else {
+      network = cidr->first.asV6();
+    }
+    facebook::fboss::RoutePrefix<AddressT> fibPrefix{network, cidr->second};
+    auto ritr = rib.exactMatch(fibPrefix.network(), fibPrefix.mask());
+    std::shared_ptr<facebook::fboss::Route<AddressT>> ribRoute;
+    if (ritr != rib.end() && ritr->value()->isResolved()) {
+      // The recursive resolution algorithm considers a next-hop TO_CPU or
+      // DROP to be resolved.
+      ribRoute = ritr->value();
+    }
+    auto fibRoute = fib->exactMatch(fibPrefix);
+    if (!ribRoute) {
+      if (fibRoute) {
+        // Route was deleted or became unresolved
+        writableFib()->removeNode(fibRoute);
+      }
+      continue;
+    }
+    CHECK(ribRoute->isPublished());
+    if (!fibRoute) {
+      writableFib()->addNode(ribRoute);
+    } else if (fibRoute != ribRoute && !fibRoute->isSame(ribRoute.get())) {
+      writableFib()->updateNode(ribRoute);
+    }
+  }
+  return updatedFib;
+}
+
 template <typename AddressT>
 std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
 ForwardingInformationBaseUpdater::createUpdatedFib(
@@ -101,11 +178,10 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
       continue;
     }
 
-    // TODO(samank): optimize to linear time intersection algorithm
-    facebook::fboss::RoutePrefix<AddressT> fibPrefix{
+    facebook::fboss::RoutePrefixKey<AddressT> fibPrefix{
         ribRoute->prefix().network(), ribRoute->prefix().mask()};
     std::shared_ptr<facebook::fboss::Route<AddressT>> fibRoute =
-        fib->getNodeIf(fibPrefix.str());
+        fib->getNodeIf(fibPrefix);
     if (fibRoute) {
       if (fibRoute == ribRoute || fibRoute->isSame(ribRoute.get())) {
         // Pointer or contents are same, reuse existing route
@@ -119,7 +195,7 @@ ForwardingInformationBaseUpdater::createUpdatedFib(
       updated = true;
     }
     CHECK(fibRoute->isPublished());
-    updatedFib.emplace_hint(updatedFib.cend(), fibPrefix.str(), fibRoute);
+    updatedFib.emplace_hint(updatedFib.cend(), fibPrefix, fibRoute);
   }
   // Check for deleted routes. Routes that were in the previous FIB
   // and have now been removed
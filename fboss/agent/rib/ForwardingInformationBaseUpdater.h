@@ -21,6 +21,7 @@
 namespace facebook::fboss {
 
 class SwitchState;
+struct RibToFibDelta;
 
 class ForwardingInformationBaseUpdater {
  public:
@@ -28,7 +29,8 @@ class ForwardingInformationBaseUpdater {
       RouterID vrf,
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
-      const LabelToRouteMap& labelToRoute);
+      const LabelToRouteMap& labelToRoute,
+      const RibToFibDelta* ribToFibDelta = nullptr);
 
   std::shared_ptr<SwitchState> operator()(
       const std::shared_ptr<SwitchState>& state);
@@ -43,6 +45,24 @@ class ForwardingInformationBaseUpdater {
       const facebook::fboss::NetworkToRouteMap<AddressT>& rib,
       const std::shared_ptr<
           facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
+  /*
+   * Same as createUpdatedFib, but only looks at the RIB routes in
+   * ribToFibDelta_, fib must be the FIB the delta is relative to.
+   */
+  template <typename AddressT>
+  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  createUpdatedFibFromDelta(
+      const facebook::fboss::NetworkToRouteMap<AddressT>& rib,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& fib);
+  template <typename AddressT>
+  std::shared_ptr<typename facebook::fboss::ForwardingInformationBase<AddressT>>
+  updateFib(
+      const facebook::fboss::NetworkToRouteMap<AddressT>& rib,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& fib,
+      const std::shared_ptr<
+          facebook::fboss::ForwardingInformationBase<AddressT>>& syncedFib);
   std::shared_ptr<facebook::fboss::LabelForwardingInformationBase>
   createUpdatedLabelFib(
       const facebook::fboss::NetworkToRouteMap<LabelID>& rib,
@@ -52,6 +72,7 @@ class ForwardingInformationBaseUpdater {
   const IPv4NetworkToRouteMap& v4NetworkToRoute_;
   const IPv6NetworkToRouteMap& v6NetworkToRoute_;
   const LabelToRouteMap& labelToRoute_;
+  const RibToFibDelta* ribToFibDelta_;
 };
 
 } // namespace facebook::fboss
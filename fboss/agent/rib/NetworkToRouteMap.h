@@ -133,7 +133,11 @@ class NetworkToRouteMap
       if (!filter(route)) {
         continue;
       }
-      obj.emplace(route->getID(), route->toThrift());
+      if constexpr (std::is_same_v<LabelID, AddressT>) {
+        obj.emplace(route->getID(), route->toThrift());
+      } else {
+        obj.emplace(route->str(), route->toThrift());
+      }
     }
     return obj;
   }
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/agent/rib/RibResolutionIndex.h"
+
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss {
+
+void RibResolutionIndex::invalidate() {
+  nhopSetToRoutes_.clear();
+  routeToNhopSet_.clear();
+  v4NhopToNhopSets_.clear();
+  v6NhopToNhopSets_.clear();
+  unsyncedRoutes_.reset();
+  valid_ = false;
+}
+
+void RibResolutionIndex::setNextHops(
+    const RouteKey& route,
+    const RouteNextHopSet& nhops) {
+  auto ritr = routeToNhopSet_.find(route);
+  if (ritr != routeToNhopSet_.end()) {
+    if (*ritr->second == nhops) {
+      return;
+    }
+    removeRoute(route);
+  }
+  if (nhops.empty()) {
+    return;
+  }
+  auto [sitr, inserted] = nhopSetToRoutes_.try_emplace(nhops);
+  sitr->second.insert(route);
+  if (inserted) {
+    indexNextHops(&sitr->first);
+  }
+  routeToNhopSet_.emplace(route, &sitr->first);
+}
+
+void RibResolutionIndex::removeRoute(const RouteKey& route) {
+  auto ritr = routeToNhopSet_.find(route);
+  if (ritr == routeToNhopSet_.end()) {
+    return;
+  }
+  auto sitr = nhopSetToRoutes_.find(*ritr->second);
+  CHECK(sitr != nhopSetToRoutes_.end());
+  routeToNhopSet_.erase(ritr);
+  sitr->second.erase(route);
+  if (sitr->second.empty()) {
+    unindexNextHops(&sitr->first);
+    nhopSetToRoutes_.erase(sitr);
+  }
+}
+
+void RibResolutionIndex::indexNextHops(const RouteNextHopSet* nhopSet) {
+  for (const auto& nhop : *nhopSet) {
+    const auto& addr = nhop.addr();
+    if (addr.isV4()) {
+      v4NhopToNhopSets_[addr.asV4()].insert(nhopSet);
+    } else {
+      v6NhopToNhopSets_[addr.asV6()].insert(nhopSet);
+    }
+  }
+}
+
+void RibResolutionIndex::unindexNextHops(const RouteNextHopSet* nhopSet) {
+  auto unindex = [nhopSet](auto& nhopToNhopSets, const auto& addr) {
+    auto it = nhopToNhopSets.find(addr);
+    if (it == nhopToNhopSets.end()) {
+      return;
+    }
+    it->second.erase(nhopSet);
+    if (it->second.empty()) {
+      nhopToNhopSets.erase(it);
+    }
+  };
+  for (const auto& nhop : *nhopSet) {
+    const auto& addr = nhop.addr();
+    if (addr.isV4()) {
+      unindex(v4NhopToNhopSets_, addr.asV4());
+    } else {
+      unindex(v6NhopToNhopSets_, addr.asV6());
+    }
+  }
+}
+
+} // namespace facebook::fboss
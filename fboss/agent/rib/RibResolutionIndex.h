@@ -0,0 +1,138 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include "fboss/agent/state/RouteNextHopEntry.h"
+#include "fboss/agent/types.h"
+
+#include <folly/IPAddress.h>
+
+#include <map>
+#include <optional>
+#include <set>
+#include <variant>
+
+namespace facebook::fboss {
+
+/*
+ * RibResolutionIndex records, for every route in a VRF, the (unresolved)
+ * next hop set that its best entry was last resolved with, and for every
+ * next hop address the next hop sets that contain it. Given a prefix whose
+ * routing state changed, this lets RibRouteUpdater find every route whose
+ * recursive resolution could have looked up that prefix, so that only those
+ * routes are re-resolved instead of the whole table.
+ *
+ * Next hops are indexed via the next hop set rather than per route, since a
+ * large table typically has a few hundred distinct ECMP sets shared by
+ * hundreds of thousands of routes.
+ *
+ * The index is only meaningful if every resolution since it was built went
+ * through a RibRouteUpdater that maintained it. Anything else that rewrites
+ * the route tables must invalidate() it; the next update then falls back to
+ * a full resolution, which also rebuilds the index.
+ */
+class RibResolutionIndex {
+ public:
+  using RouteKey = std::variant<folly::CIDRNetwork, LabelID>;
+
+  bool isValid() const {
+    return valid_;
+  }
+  void setValid() {
+    valid_ = true;
+  }
+  void invalidate();
+
+  /*
+   * Record that route was resolved using nhops. An empty set (DROP, TO_CPU)
+   * removes any previously recorded dependency.
+   */
+  void setNextHops(const RouteKey& route, const RouteNextHopSet& nhops);
+  void removeRoute(const RouteKey& route);
+
+  /*
+   * Invoke fn for every route with a next hop within prefix
+   */
+  template <typename Fn>
+  void forEachDependent(const folly::CIDRNetwork& prefix, const Fn& fn) const {
+    if (prefix.first.isV4()) {
+      forEachDependentImpl(
+          v4NhopToNhopSets_, prefix.first.asV4(), prefix.second, fn);
+    } else {
+      forEachDependentImpl(
+          v6NhopToNhopSets_, prefix.first.asV6(), prefix.second, fn);
+    }
+  }
+
+  /*
+   * Routes that were (re-)resolved, added or deleted since fibSynced() was
+   * last called. nullopt after a full resolution, when any route may have
+   * changed.
+   */
+  const std::optional<std::set<RouteKey>>& unsyncedRoutes() const {
+    return unsyncedRoutes_;
+  }
+  void routesUpdated(const std::set<RouteKey>& routes) {
+    if (unsyncedRoutes_) {
+      unsyncedRoutes_->insert(routes.begin(), routes.end());
+    }
+  }
+  void routeUpdated(const RouteKey& route) {
+    if (unsyncedRoutes_) {
+      unsyncedRoutes_->insert(route);
+    }
+  }
+  void fibSynced() {
+    unsyncedRoutes_.emplace();
+  }
+
+  size_t numRoutes() const {
+    return routeToNhopSet_.size();
+  }
+  size_t numNextHopSets() const {
+    return nhopSetToRoutes_.size();
+  }
+
+ private:
+  using NextHopSets = std::set<const RouteNextHopSet*>;
+  template <typename AddressT>
+  using NextHopToNextHopSets = std::map<AddressT, NextHopSets>;
+
+  template <typename AddressT, typename Fn>
+  void forEachDependentImpl(
+      const NextHopToNextHopSets<AddressT>& nhopToNhopSets,
+      const AddressT& network,
+      uint8_t mask,
+      const Fn& fn) const {
+    // Addresses within a subnet are contiguous in the ordered map
+    for (auto it = nhopToNhopSets.lower_bound(network);
+         it != nhopToNhopSets.end() && it->first.inSubnet(network, mask);
+         ++it) {
+      for (const auto* nhopSet : it->second) {
+        for (const auto& route : nhopSetToRoutes_.at(*nhopSet)) {
+          fn(route);
+        }
+      }
+    }
+  }
+
+  void indexNextHops(const RouteNextHopSet* nhopSet);
+  void unindexNextHops(const RouteNextHopSet* nhopSet);
+
+  std::map<RouteNextHopSet, std::set<RouteKey>> nhopSetToRoutes_;
+  std::map<RouteKey, const RouteNextHopSet*> routeToNhopSet_;
+  NextHopToNextHopSets<folly::IPAddressV4> v4NhopToNhopSets_;
+  NextHopToNextHopSets<folly::IPAddressV6> v6NhopToNhopSets_;
+  std::optional<std::set<RouteKey>> unsyncedRoutes_;
+  bool valid_{false};
+};
+
+} // namespace facebook::fboss
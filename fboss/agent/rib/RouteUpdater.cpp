@@ -15,6 +15,7 @@
 #include <boost/container/flat_map.hpp>
 #include <boost/container/flat_set.hpp>
 #include <boost/integer/common_factor.hpp>
+#include <folly/ScopeGuard.h>
 #include <folly/logging/xlog.h>
 
 #include "fboss/agent/FbossError.h"
@@ -42,6 +43,26 @@ static const RoutePrefixV6 kIPv6LinkLocalPrefix{
     64};
 static const auto kInterfaceRouteClientId = ClientID::INTERFACE_ROUTE;
 
+namespace {
+template <typename AddressT>
+RibResolutionIndex::RouteKey routeKey(
+    const typename Route<AddressT>::Prefix& prefix) {
+  if constexpr (std::is_same_v<LabelID, AddressT>) {
+    return prefix.label();
+  } else {
+    return folly::CIDRNetwork(prefix.network(), prefix.mask());
+  }
+}
+
+// Admin distance is left out, it only selects the best client entry and does
+// not change how the route is programmed
+bool sameForwarding(const RouteNextHopEntry& a, const RouteNextHopEntry& b) {
+  return a.getAction() == b.getAction() &&
+      a.getNextHopSet() == b.getNextHopSet() &&
+      a.getCounterID() == b.getCounterID() && a.getClassID() == b.getClassID();
+}
+} // namespace
+
 RibRouteUpdater::RibRouteUpdater(
     IPv4NetworkToRouteMap* v4Routes,
     IPv6NetworkToRouteMap* v6Routes)
@@ -53,6 +74,16 @@ RibRouteUpdater::RibRouteUpdater(
     LabelToRouteMap* mplsRoutes)
     : v4Routes_(v4Routes), v6Routes_(v6Routes), mplsRoutes_(mplsRoutes) {}
 
+RibRouteUpdater::RibRouteUpdater(
+    IPv4NetworkToRouteMap* v4Routes,
+    IPv6NetworkToRouteMap* v6Routes,
+    LabelToRouteMap* mplsRoutes,
+    RibResolutionIndex* resolutionIndex)
+    : v4Routes_(v4Routes),
+      v6Routes_(v6Routes),
+      mplsRoutes_(mplsRoutes),
+      resolutionIndex_(resolutionIndex) {}
+
 void RibRouteUpdater::update(
     const std::map<ClientID, std::vector<RouteEntry>>& toAdd,
     const std::map<ClientID, std::vector<folly::CIDRNetwork>>& toDel,
@@ -130,10 +161,12 @@ void RibRouteUpdater::addOrReplaceRouteImpl(
     if (!existingRouteForClient || !(*existingRouteForClient == entry)) {
       route = writableRoute<AddressT>(it);
       route->update(clientID, entry);
+      routeChanged(routeKey<AddressT>(prefix));
     }
     return;
   }
 
+  routeChanged(routeKey<AddressT>(prefix));
   routes->insert(
       prefix, std::make_shared<Route<AddressT>>(prefix, clientID, entry));
 }
@@ -159,6 +192,7 @@ void RibRouteUpdater::addOrReplaceRoute(
   XLOG(DBG3) << "Add mpls route for label " << label << " nh " << entry.str();
   auto iter = mplsRoutes_->find(label);
   if (iter == mplsRoutes_->end()) {
+    routeChanged(label);
     mplsRoutes_->emplace(std::make_pair(
         label,
         std::make_shared<Route<LabelID>>(
@@ -169,6 +203,7 @@ void RibRouteUpdater::addOrReplaceRoute(
     if (!existingRouteForClient || !(*existingRouteForClient == entry)) {
       route = writableRoute<LabelID>(route);
       route->update(clientID, entry);
+      routeChanged(label);
     }
   }
 }
@@ -190,6 +225,7 @@ void RibRouteUpdater::delRouteImpl(
   if (!clientNhopEntry) {
     return;
   }
+  routeChanged(routeKey<AddressT>(prefix));
   if (route->numClientEntries() == 1) {
     // If this client's the only entry, simply erase
     XLOG(DBG3) << "Deleting route: " << route->str();
@@ -231,6 +267,7 @@ void RibRouteUpdater::delRoute(const LabelID& label, const ClientID clientID) {
   if (!clientNhopEntry) {
     return;
   }
+  routeChanged(label);
   if (route->numClientEntries() == 1) {
     // If this client's the only entry, simply erase
     XLOG(DBG3) << "Deleting route: " << route->str();
@@ -256,6 +293,7 @@ void RibRouteUpdater::removeAllRoutesFromClientImpl(
     if (!nhopEntry) {
       continue;
     }
+    routeChanged(routeKey<AddressT>(route->prefix()));
     if (route->numClientEntries() == 1) {
       // This client's is the only entry avoid unnecessary cloning
       // we are going to prune the route anyways
@@ -572,6 +610,12 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
   const auto action = bestEntry->getAction();
   const auto counterID = bestEntry->getCounterID();
   const auto classID = bestEntry->getClassID();
+  if (resolutionIndex_) {
+    // DROP and TO_CPU entries have no next hops, so this also clears any
+    // dependencies recorded by a previous resolution
+    resolutionIndex_->setNextHops(
+        routeKey<AddressT>(route->prefix()), bestEntry->getNextHopSet());
+  }
   if (action == RouteForwardAction::DROP) {
     hasDrop = true;
   } else if (action == RouteForwardAction::TO_CPU) {
@@ -651,10 +695,10 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
   std::shared_ptr<Route<AddressT>> updatedRoute;
   auto updateRoute = [this, clientId, &updatedRoute, classID, &route](
                          typename NetworkToRouteMap<AddressT>::Iterator ritr,
-                         std::optional<RouteNextHopEntry> nhop) {
+                         const std::shared_ptr<RouteNextHopEntry>& nhop) {
     updatedRoute = writableRoute<AddressT>(ritr);
     if (nhop) {
-      updatedRoute->setResolved(*nhop);
+      updatedRoute->setResolved(nhop);
       if (clientId == kInterfaceRouteClientId &&
           !nhop->getNextHopSet().empty()) {
         updatedRoute->setConnected();
@@ -667,41 +711,34 @@ std::shared_ptr<Route<AddressT>> RibRouteUpdater::resolveOne(
     XLOG(DBG3) << (updatedRoute->isResolved() ? "Resolved" : "Cannot resolve")
                << " route " << updatedRoute->str();
   };
+  std::shared_ptr<RouteNextHopEntry> nhop;
   if (fwd && !fwd->empty()) {
-    if (route->getForwardInfo().getNextHopSet() != *fwd ||
-        route->getForwardInfo().getCounterID() != counterID ||
-        route->getForwardInfo().getClassID() != classID) {
-      updateRoute(
-          ritr,
-          std::make_optional<RouteNextHopEntry>(
-              *fwd, bestEntry->getAdminDistance(), counterID, classID));
-    }
+    nhop = RouteNextHopEntry::intern(
+        *fwd, bestEntry->getAdminDistance(), counterID, classID);
   } else if (hasToCpu) {
-    if (!route->isToCPU() ||
-        route->getForwardInfo().getCounterID() != counterID ||
-        route->getForwardInfo().getClassID() != classID) {
-      updateRoute(
-          ritr,
-          std::make_optional<RouteNextHopEntry>(
-              RouteForwardAction::TO_CPU,
-              AdminDistance::MAX_ADMIN_DISTANCE,
-              counterID,
-              classID));
-    }
+    nhop = RouteNextHopEntry::intern(
+        RouteForwardAction::TO_CPU,
+        AdminDistance::MAX_ADMIN_DISTANCE,
+        counterID,
+        classID);
   } else if (hasDrop) {
-    if (!route->isDrop() ||
-        route->getForwardInfo().getCounterID() != counterID ||
-        route->getForwardInfo().getClassID() != classID) {
-      updateRoute(
-          ritr,
-          std::make_optional<RouteNextHopEntry>(
-              RouteForwardAction::DROP,
-              AdminDistance::MAX_ADMIN_DISTANCE,
-              counterID,
-              classID));
-    }
+    nhop = RouteNextHopEntry::intern(
+        RouteForwardAction::DROP,
+        AdminDistance::MAX_ADMIN_DISTANCE,
+        counterID,
+        classID);
+  }
+  if (!nhop) {
+    updateRoute(ritr, nullptr);
+  } else if (!route->isResolved()) {
+    updateRoute(ritr, nhop);
   } else {
-    updateRoute(ritr, std::nullopt);
+    // Forwarding info is interned, so unchanged forwarding info is usually
+    // the very same entry
+    const auto& fwdInfo = route->getForwardInfo();
+    if (&fwdInfo != nhop.get() && !sameForwarding(fwdInfo, *nhop)) {
+      updateRoute(ritr, nhop);
+    }
   }
   if (!updatedRoute) {
     route->publish();
@@ -739,13 +776,100 @@ void RibRouteUpdater::resolve(NetworkToRouteMap<AddressT>* routes) {
   }
 }
 
+template <typename AddressT>
+void RibRouteUpdater::resolve(
+    std::vector<typename NetworkToRouteMap<AddressT>::Iterator>& toResolve) {
+  for (auto ritr : toResolve) {
+    if (needResolve(value<AddressT>(ritr))) {
+      resolveOne<AddressT>(ritr);
+    }
+  }
+}
+
 template <typename AddressT>
 bool RibRouteUpdater::needResolve(
     const std::shared_ptr<Route<AddressT>>& route) const {
   return needsResolution_.find(route.get()) != needsResolution_.end();
 }
 
+void RibRouteUpdater::resolveAffected() {
+  // Start with the routes this update touched. Any route with a next hop
+  // covered by one of those prefixes may now resolve differently, and so may
+  // any route with a next hop covered by *that* route, and so on.
+  std::set<RibResolutionIndex::RouteKey> affected;
+  std::vector<folly::CIDRNetwork> toVisit;
+  auto addAffected = [&affected,
+                      &toVisit](const RibResolutionIndex::RouteKey& key) {
+    if (affected.insert(key).second) {
+      if (auto prefix = std::get_if<folly::CIDRNetwork>(&key)) {
+        toVisit.push_back(*prefix);
+      }
+    }
+  };
+  std::for_each(changedRoutes_.begin(), changedRoutes_.end(), addAffected);
+  while (!toVisit.empty()) {
+    auto prefix = toVisit.back();
+    toVisit.pop_back();
+    resolutionIndex_->forEachDependent(prefix, addAffected);
+  }
+
+  std::vector<IPv4NetworkToRouteMap::Iterator> v4ToResolve;
+  std::vector<IPv6NetworkToRouteMap::Iterator> v6ToResolve;
+  std::vector<LabelToRouteMap::Iterator> mplsToResolve;
+  auto markForResolution = [this](auto it, auto* toResolve) {
+    needsResolution_.insert(value(*it).get());
+    toResolve->push_back(it);
+  };
+  for (const auto& key : affected) {
+    if (auto prefix = std::get_if<folly::CIDRNetwork>(&key)) {
+      if (prefix->first.isV4()) {
+        auto it = v4Routes_->exactMatch(prefix->first.asV4(), prefix->second);
+        if (it != v4Routes_->end()) {
+          markForResolution(it, &v4ToResolve);
+          continue;
+        }
+      } else {
+        auto it = v6Routes_->exactMatch(prefix->first.asV6(), prefix->second);
+        if (it != v6Routes_->end()) {
+          markForResolution(it, &v6ToResolve);
+          continue;
+        }
+      }
+    } else if (mplsRoutes_) {
+      auto it = mplsRoutes_->find(std::get<LabelID>(key));
+      if (it != mplsRoutes_->end()) {
+        markForResolution(it, &mplsToResolve);
+        continue;
+      }
+    }
+    // Route was deleted
+    resolutionIndex_->removeRoute(key);
+  }
+  resolutionIndex_->routesUpdated(affected);
+
+  resolve<IPAddressV4>(v4ToResolve);
+  resolve<IPAddressV6>(v6ToResolve);
+  resolve<LabelID>(mplsToResolve);
+}
+
 void RibRouteUpdater::updateDone() {
+  SCOPE_EXIT {
+    needsResolution_.clear();
+    unresolvedToResolvedNhops_.clear();
+    changedRoutes_.clear();
+  };
+  if (resolutionIndex_) {
+    SCOPE_FAIL {
+      // Partially applied resolution, rebuild the index on next update
+      resolutionIndex_->invalidate();
+    };
+    if (resolutionIndex_->isValid()) {
+      resolveAffected();
+      return;
+    }
+    // Full resolution below will rebuild the index from scratch
+    resolutionIndex_->invalidate();
+  }
   // Record all routes as needing resolution
   auto markForResolution = [this](const auto& routes) {
     std::for_each(routes->begin(), routes->end(), [this](auto& route) {
@@ -757,14 +881,13 @@ void RibRouteUpdater::updateDone() {
   if (mplsRoutes_) {
     markForResolution(mplsRoutes_);
   }
-  SCOPE_EXIT {
-    needsResolution_.clear();
-    unresolvedToResolvedNhops_.clear();
-  };
   resolve(v4Routes_);
   resolve(v6Routes_);
   if (mplsRoutes_) {
     resolve(mplsRoutes_);
   }
+  if (resolutionIndex_) {
+    resolutionIndex_->setValid();
+  }
 }
 } // namespace facebook::fboss
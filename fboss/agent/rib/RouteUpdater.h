@@ -13,6 +13,7 @@
 #include "fboss/agent/types.h"
 
 #include "fboss/agent/rib/NetworkToRouteMap.h"
+#include "fboss/agent/rib/RibResolutionIndex.h"
 
 #include <folly/IPAddress.h>
 
@@ -41,6 +42,11 @@ namespace facebook::fboss {
  *    only IP nexthops will be in the final ECMP group.
  * 5. If and only if TO_CPU is the only nexthop (directly or indirectly) of
  *    a route, TO_CPU action will be only path in the resolved ECMP group.
+ *
+ * When constructed with a RibResolutionIndex, resolve() is incremental: only
+ * the routes touched by this update, and the routes whose next hops fall
+ * within a touched (or transitively re-resolved) prefix, are re-resolved.
+ * If the index is not valid, all routes are resolved and the index rebuilt.
  */
 class RibRouteUpdater {
  public:
@@ -53,6 +59,12 @@ class RibRouteUpdater {
       IPv6NetworkToRouteMap* v6Routes,
       LabelToRouteMap* mplsRoutes);
 
+  RibRouteUpdater(
+      IPv4NetworkToRouteMap* v4Routes,
+      IPv6NetworkToRouteMap* v6Routes,
+      LabelToRouteMap* mplsRoutes,
+      RibResolutionIndex* resolutionIndex);
+
   struct RouteEntry {
     folly::CIDRNetwork prefix;
     RouteNextHopEntry nhopEntry;
@@ -117,6 +129,12 @@ class RibRouteUpdater {
       ClientID clientID,
       const RouteNextHopEntry& entry);
   void updateDone();
+  void resolveAffected();
+  void routeChanged(const RibResolutionIndex::RouteKey& key) {
+    if (resolutionIndex_) {
+      changedRoutes_.insert(key);
+    }
+  }
 
   void
   delRoute(const folly::IPAddress& network, uint8_t mask, ClientID clientID);
@@ -145,6 +163,9 @@ class RibRouteUpdater {
 
   template <typename AddressT>
   void resolve(NetworkToRouteMap<AddressT>* routes);
+  template <typename AddressT>
+  void resolve(
+      std::vector<typename NetworkToRouteMap<AddressT>::Iterator>& toResolve);
 
   template <typename AddressT>
   std::shared_ptr<Route<AddressT>> resolveOne(
@@ -176,6 +197,12 @@ class RibRouteUpdater {
   IPv4NetworkToRouteMap* v4Routes_{nullptr};
   IPv6NetworkToRouteMap* v6Routes_{nullptr};
   LabelToRouteMap* mplsRoutes_{nullptr};
+  RibResolutionIndex* resolutionIndex_{nullptr};
+  /*
+   * Routes added, deleted or modified by this update. Only tracked when
+   * resolving incrementally.
+   */
+  std::set<RibResolutionIndex::RouteKey> changedRoutes_;
   std::unordered_set<void*> needsResolution_;
   /*
    * Cache for next hop to FWD informatio. For our use case
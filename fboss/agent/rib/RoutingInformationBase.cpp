@@ -31,8 +31,22 @@
 #include <utility>
 
 #include <folly/ScopeGuard.h>
+#include <folly/executors/InlineExecutor.h>
+#include <folly/futures/Future.h>
 #include <folly/logging/xlog.h>
 
+DEFINE_bool(
+    rib_incremental_resolution,
+    true,
+    "Only re-resolve the RIB routes affected by an update, rather than the "
+    "whole route table");
+
+DEFINE_int32(
+    rib_reconfigure_threads,
+    1,
+    "Number of threads used to apply config to the route tables of different "
+    "VRFs concurrently. 1, the default, applies config one VRF at a time");
+
 namespace facebook::fboss {
 
 namespace {
@@ -172,7 +186,8 @@ void RibRouteTables::reconfigure(
     const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToNull,
     const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToCpu,
     FibUpdateFunction updateFibCallback,
-    void* cookie) {
+    void* cookie,
+    folly::Executor* executor) {
   // Config application is accomplished in the following sequence of steps:
   // 1. Update the VRFs held in RoutingInformationBase's
   // SynchronizedRouteTables data-structure
@@ -188,14 +203,12 @@ void RibRouteTables::reconfigure(
   // 4. Re-resolve routes
   //
   // 5. Update FIB
-  //
-  // Steps 2-5 take place in ConfigApplier.
 
   std::vector<RouterID> existingVrfs = getVrfList();
 
-  auto configureRoutesForVrf = [&](RouterID vrf,
-                                   const PrefixToInterfaceIDAndIP&
-                                       interfaceRoutes) {
+  auto applyConfig = [&](RouterID vrf,
+                         const PrefixToInterfaceIDAndIP& interfaceRoutes,
+                         RouteTable& routeTable) {
     // A ConfigApplier object should be independent of the VRF whose
     // routes it is processing. However, because interface and static
     // routes for _all_ VRFs are passed to ConfigApplier, the vrf
@@ -204,57 +217,123 @@ void RibRouteTables::reconfigure(
 
     // ConfigApplier can be made independent of the VRF whose routes it
     // is processing by the use of boost::filter_iterator.
-    updateRib(vrf, [&](auto& routeTable) {
-      ConfigApplier configApplier(
-          vrf,
-          &(routeTable.v4NetworkToRoute),
-          &(routeTable.v6NetworkToRoute),
-          &(routeTable.labelToRoute),
-          folly::range(interfaceRoutes.cbegin(), interfaceRoutes.cend()),
-          folly::range(staticRoutesToCpu.cbegin(), staticRoutesToCpu.cend()),
-          folly::range(staticRoutesToNull.cbegin(), staticRoutesToNull.cend()),
-          folly::range(
-              staticRoutesWithNextHops.cbegin(),
-              staticRoutesWithNextHops.cend()),
-          folly::range(
-              staticIp2MplsRoutes.cbegin(), staticIp2MplsRoutes.cend()),
-          folly::range(
-              staticMplsRoutesWithNextHops.cbegin(),
-              staticMplsRoutesWithNextHops.cend()),
-          folly::range(
-              staticMplsRoutesToNull.cbegin(), staticMplsRoutesToNull.cend()),
-          folly::range(
-              staticMplsRoutesToCpu.cbegin(), staticMplsRoutesToCpu.cend()));
-      // Apply config
-      configApplier.apply();
-    });
-    updateFib(vrf, updateFibCallback, cookie);
+    ConfigApplier configApplier(
+        vrf,
+        &(routeTable.v4NetworkToRoute),
+        &(routeTable.v6NetworkToRoute),
+        &(routeTable.labelToRoute),
+        folly::range(interfaceRoutes.cbegin(), interfaceRoutes.cend()),
+        folly::range(staticRoutesToCpu.cbegin(), staticRoutesToCpu.cend()),
+        folly::range(staticRoutesToNull.cbegin(), staticRoutesToNull.cend()),
+        folly::range(
+            staticRoutesWithNextHops.cbegin(), staticRoutesWithNextHops.cend()),
+        folly::range(staticIp2MplsRoutes.cbegin(), staticIp2MplsRoutes.cend()),
+        folly::range(
+            staticMplsRoutesWithNextHops.cbegin(),
+            staticMplsRoutesWithNextHops.cend()),
+        folly::range(
+            staticMplsRoutesToNull.cbegin(), staticMplsRoutesToNull.cend()),
+        folly::range(
+            staticMplsRoutesToCpu.cbegin(), staticMplsRoutesToCpu.cend()),
+        routeTable.resolutionIndexIfEnabled());
+    // Apply config
+    configApplier.apply();
   };
-  // Because of this sequential loop over each VRF, config application scales
-  // linearly with the number of VRFs. If FBOSS is run in a multi-VRF routing
-  // architecture in the future, this slow-down can be avoided by
-  // parallelizing this loop. Converting this loop to use task-level
-  // parallelism should be straightfoward because it has been written to avoid
-  // dependencies across different iterations of the loop.
+  // Config application (steps 2-4) only touches the RouteTable of the VRF
+  // being configured, so it runs for all VRFs concurrently on executor. FIB
+  // updates (step 5) stay serial: fibUpdateCallback is supplied by the
+  // caller and threads a single SwitchState through cookie, with each call
+  // building on the state left by the previous VRF. They are made in VRF
+  // order, which makes the resulting state independent of the order in
+  // which config application finished.
+  using VrfAndInterfaceRoutes =
+      std::pair<RouterID, const PrefixToInterfaceIDAndIP*>;
+  auto configureRoutesForVrfs =
+      [&](const std::vector<VrfAndInterfaceRoutes>& vrfsAndInterfaceRoutes) {
+        std::vector<folly::Try<folly::Unit>> results;
+        std::exception_ptr firstError;
+        {
+          auto lockedRouteTables = synchronizedRouteTables_.wlock();
+          std::vector<RouteTable*> routeTables;
+          routeTables.reserve(vrfsAndInterfaceRoutes.size());
+          for (const auto& vrfAndInterfaceRoutes : vrfsAndInterfaceRoutes) {
+            auto it = lockedRouteTables->find(vrfAndInterfaceRoutes.first);
+            if (it == lockedRouteTables->end()) {
+              throw FbossError(
+                  "VRF ", vrfAndInterfaceRoutes.first, " not configured");
+            }
+            routeTables.push_back(&it->second);
+          }
+          // Only the (distinct) RouteTables are accessed concurrently, never
+          // the map holding them
+          std::vector<folly::Future<folly::Unit>> applied;
+          applied.reserve(vrfsAndInterfaceRoutes.size());
+          for (size_t i = 0; i < vrfsAndInterfaceRoutes.size(); ++i) {
+            applied.push_back(folly::via(
+                executor ? executor : &folly::InlineExecutor::instance(),
+                [&applyConfig,
+                 vrfAndInterfaceRoutes = vrfsAndInterfaceRoutes[i],
+                 routeTable = routeTables[i]] {
+                  applyConfig(
+                      vrfAndInterfaceRoutes.first,
+                      *vrfAndInterfaceRoutes.second,
+                      *routeTable);
+                }));
+          }
+          results = folly::collectAll(std::move(applied)).get();
+          for (size_t i = 0; i < results.size(); ++i) {
+            if (results[i].hasException()) {
+              XLOG(ERR) << "Failed to apply config to VRF "
+                        << vrfsAndInterfaceRoutes[i].first << ": "
+                        << results[i].exception().what();
+              if (!firstError) {
+                firstError = results[i].exception().to_exception_ptr();
+              }
+            }
+          }
+        }
+        // A failure in one VRF doesn't keep the FIBs of the others behind
+        // their RIBs. The first failure is rethrown once all are synced.
+        for (size_t i = 0; i < vrfsAndInterfaceRoutes.size(); ++i) {
+          if (results[i].hasException()) {
+            continue;
+          }
+          try {
+            updateFib(
+                vrfsAndInterfaceRoutes[i].first, updateFibCallback, cookie);
+          } catch (const std::exception& ex) {
+            XLOG(ERR) << "Failed to update FIB of VRF "
+                      << vrfsAndInterfaceRoutes[i].first << ": " << ex.what();
+            if (!firstError) {
+              firstError = std::current_exception();
+            }
+          }
+        }
+        if (firstError) {
+          std::rethrow_exception(firstError);
+        }
+      };
+  // First handle the VRFs for which no interface routes exist
+  const PrefixToInterfaceIDAndIP noInterfaceRoutes;
+  std::vector<VrfAndInterfaceRoutes> vrfsAndInterfaceRoutes;
   for (auto vrf : existingVrfs) {
-    // First handle the VRFs for which no interface routes exist
-    if (configRouterIDToInterfaceRoutes.find(vrf) !=
+    if (configRouterIDToInterfaceRoutes.find(vrf) ==
         configRouterIDToInterfaceRoutes.end()) {
-      continue;
+      vrfsAndInterfaceRoutes.emplace_back(vrf, &noInterfaceRoutes);
     }
-    configureRoutesForVrf(
-        vrf, {} /* No interface routes*/
-    );
   }
+  configureRoutesForVrfs(vrfsAndInterfaceRoutes);
   {
     auto lockedRouteTables = synchronizedRouteTables_.wlock();
     *lockedRouteTables = constructRouteTables(
         lockedRouteTables, configRouterIDToInterfaceRoutes);
   }
-  for (auto& vrf : getVrfList()) {
-    const auto& interfaceRoutes = configRouterIDToInterfaceRoutes.at(vrf);
-    configureRoutesForVrf(vrf, interfaceRoutes);
+  vrfsAndInterfaceRoutes.clear();
+  for (auto vrf : getVrfList()) {
+    vrfsAndInterfaceRoutes.emplace_back(
+        vrf, &configRouterIDToInterfaceRoutes.at(vrf));
   }
+  configureRoutesForVrfs(vrfsAndInterfaceRoutes);
 }
 
 template <typename RouteType, typename RouteIdType>
@@ -272,7 +351,8 @@ void RibRouteTables::update(
     RibRouteUpdater updater(
         &(routeTable.v4NetworkToRoute),
         &(routeTable.v6NetworkToRoute),
-        &(routeTable.labelToRoute));
+        &(routeTable.labelToRoute),
+        routeTable.resolutionIndexIfEnabled());
     updater.update(clientID, toAddRoutes, toDelPrefixes, resetClientsRoutes);
   });
   updateFib(routerID, fibUpdateCallback, cookie);
@@ -282,14 +362,24 @@ void RibRouteTables::updateFib(
     RouterID vrf,
     const FibUpdateFunction& fibUpdateCallback,
     void* cookie) {
+  std::shared_ptr<SwitchState> newState;
   try {
     auto lockedRouteTables = synchronizedRouteTables_.rlock();
     auto& routeTable = lockedRouteTables->find(vrf)->second;
-    fibUpdateCallback(
+    RibToFibDelta ribToFibDelta;
+    const auto& resolutionIndex = routeTable.resolutionIndex;
+    if (FLAGS_rib_incremental_resolution && resolutionIndex.isValid() &&
+        resolutionIndex.unsyncedRoutes()) {
+      ribToFibDelta.syncedFibV4 = routeTable.syncedFibV4;
+      ribToFibDelta.syncedFibV6 = routeTable.syncedFibV6;
+      ribToFibDelta.changedRoutes = &(*resolutionIndex.unsyncedRoutes());
+    }
+    newState = fibUpdateCallback(
         vrf,
         routeTable.v4NetworkToRoute,
         routeTable.v6NetworkToRoute,
         routeTable.labelToRoute,
+        &ribToFibDelta,
         cookie);
   } catch (const FbossHwUpdateError& hwUpdateError) {
     {
@@ -299,6 +389,11 @@ void RibRouteTables::updateFib(
       auto fib = hwUpdateError.appliedState->getFibs()->getFibContainer(vrf);
       auto lockedRouteTables = synchronizedRouteTables_.wlock();
       auto& routeTable = lockedRouteTables->find(vrf)->second;
+      // Resolution state now comes from the FIB, not from the updates
+      // recorded in the index
+      routeTable.resolutionIndex.invalidate();
+      routeTable.syncedFibV4.reset();
+      routeTable.syncedFibV6.reset();
       reconstructRibFromFib<
           folly::IPAddressV4,
           ForwardingInformationBase<folly::IPAddressV4>>(
@@ -316,6 +411,13 @@ void RibRouteTables::updateFib(
     }
     throw;
   }
+  auto lockedRouteTables = synchronizedRouteTables_.wlock();
+  auto& routeTable = lockedRouteTables->find(vrf)->second;
+  auto fibContainer =
+      newState ? newState->getFibs()->getFibContainerIf(vrf) : nullptr;
+  routeTable.syncedFibV4 = fibContainer ? fibContainer->getFibV4() : nullptr;
+  routeTable.syncedFibV6 = fibContainer ? fibContainer->getFibV6() : nullptr;
+  routeTable.resolutionIndex.fibSynced();
 }
 
 void RibRouteTables::ensureVrf(RouterID rid) {
@@ -327,7 +429,8 @@ void RibRouteTables::ensureVrf(RouterID rid) {
 
 std::vector<RouterID> RibRouteTables::getVrfList() const {
   auto lockedRouteTables = synchronizedRouteTables_.rlock();
-  std::vector<RouterID> res(lockedRouteTables->size());
+  std::vector<RouterID> res;
+  res.reserve(lockedRouteTables->size());
   for (const auto& entry : *lockedRouteTables) {
     res.push_back(entry.first);
   }
@@ -342,11 +445,14 @@ void RibRouteTables::setClassID(
     void* cookie) {
   updateRib(rid, [&](auto& routeTable) {
     // Update rib
-    auto updateRoute = [&classId](auto& rib, auto ip, uint8_t mask) {
+    auto updateRoute = [&classId, &routeTable](
+                           auto& rib, auto ip, uint8_t mask) {
       auto ritr = rib.exactMatch(ip, mask);
       if (ritr == rib.end() || ritr->value()->getClassID() == classId) {
         return;
       }
+      routeTable.resolutionIndex.routeUpdated(
+          folly::CIDRNetwork(folly::IPAddress(ip), mask));
       ritr->value() = ritr->value()->clone();
       ritr->value()->updateClassID(classId);
       ritr->value()->publish();
@@ -410,6 +516,11 @@ RibRouteTables::RouterIDToRouteTable RibRouteTables::constructRouteTables(
 }
 
 RoutingInformationBase::RoutingInformationBase() {
+  if (FLAGS_rib_reconfigure_threads > 1) {
+    reconfigureExecutor_ = std::make_unique<folly::CPUThreadPoolExecutor>(
+        FLAGS_rib_reconfigure_threads,
+        std::make_shared<folly::NamedThreadFactory>("ribReconfigure"));
+  }
   ribUpdateThread_ = std::make_unique<std::thread>([this] {
     initThread("ribUpdateThread");
     ribUpdateEventBase_.loopForever();
@@ -460,7 +571,8 @@ void RoutingInformationBase::reconfigure(
         staticMplsRoutesToNull,
         staticMplsRoutesToCpu,
         updateFibCallback,
-        cookie);
+        cookie,
+        reconfigureExecutor_.get());
   };
   ribUpdateEventBase_.runInEventBaseThreadAndWait(updateFn);
 }
@@ -821,6 +933,7 @@ void RibRouteTables::importFibs(
   for (const auto& iter : std::as_const(*fibs)) {
     const auto& fib = iter.second;
     auto& routeTables = (*lockedRouteTables)[fib->getID()];
+    routeTables.resolutionIndex.invalidate();
     importRoutes(fib->getFibV6(), &routeTables.v6NetworkToRoute);
     importRoutes(fib->getFibV4(), &routeTables.v4NetworkToRoute);
     auto mplsTable = &routeTables.labelToRoute;
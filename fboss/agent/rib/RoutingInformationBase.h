@@ -13,10 +13,12 @@
 #include "fboss/agent/if/gen-cpp2/FbossCtrl.h"
 #include "fboss/agent/rib/NetworkToRouteMap.h"
 #include "fboss/agent/rib/RouteUpdater.h"
+#include "fboss/agent/state/ForwardingInformationBase.h"
 #include "fboss/agent/state/LabelForwardingInformationBase.h"
 #include "fboss/agent/types.h"
 
 #include <folly/Synchronized.h>
+#include <folly/executors/CPUThreadPoolExecutor.h>
 
 #include <functional>
 #include <memory>
@@ -24,16 +26,32 @@
 #include <vector>
 
 DECLARE_bool(mpls_rib);
+DECLARE_bool(rib_incremental_resolution);
+DECLARE_int32(rib_reconfigure_threads);
 
 namespace facebook::fboss {
 class SwitchState;
 class ForwardingInformationBaseMap;
 
+/*
+ * Routes of a VRF that may differ between the RIB and the FIBs the RIB was
+ * last synced to. When the FIBs in the state being updated are exactly
+ * syncedFibV4/syncedFibV6, ForwardingInformationBaseUpdater only needs to
+ * patch changedRoutes into them. A null changedRoutes means any route may
+ * have changed and the FIBs must be rebuilt from the whole RIB.
+ */
+struct RibToFibDelta {
+  std::shared_ptr<ForwardingInformationBaseV4> syncedFibV4;
+  std::shared_ptr<ForwardingInformationBaseV6> syncedFibV6;
+  const std::set<RibResolutionIndex::RouteKey>* changedRoutes{nullptr};
+};
+
 using FibUpdateFunction = std::function<std::shared_ptr<SwitchState>(
     RouterID vrf,
     const IPv4NetworkToRouteMap& v4NetworkToRoute,
     const IPv6NetworkToRouteMap& v6NetworkToRoute,
     const LabelToRouteMap& labelToRoute,
+    const RibToFibDelta* ribToFibDelta,
     void* cookie)>;
 
 /*
@@ -76,6 +94,11 @@ class RibRouteTables {
   using RouterIDAndNetworkToInterfaceRoutes =
       boost::container::flat_map<RouterID, PrefixToInterfaceIDAndIP>;
 
+  /*
+   * Config is applied to the route tables of different VRFs concurrently on
+   * executor (inline if null). FIBs are then updated one VRF at a time, in
+   * VRF order.
+   */
   void reconfigure(
       const RouterIDAndNetworkToInterfaceRoutes&
           configRouterIDToInterfaceRoutes,
@@ -88,7 +111,8 @@ class RibRouteTables {
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToNull,
       const std::vector<cfg::StaticMplsRouteNoNextHops>& staticMplsRoutesToCpu,
       FibUpdateFunction fibUpdateCallback,
-      void* cookie);
+      void* cookie,
+      folly::Executor* executor = nullptr);
   folly::dynamic toFollyDynamic() const;
   folly::dynamic unresolvedRoutesFollyDynamic() const;
   /*
@@ -129,6 +153,25 @@ class RibRouteTables {
     IPv4NetworkToRouteMap v4NetworkToRoute;
     IPv6NetworkToRouteMap v6NetworkToRoute;
     LabelToRouteMap labelToRoute;
+    /*
+     * Not part of the RIB state proper, only used to restrict route
+     * resolution to the routes affected by an update.
+     */
+    RibResolutionIndex resolutionIndex;
+    /*
+     * FIBs produced by the last successful FIB update for this VRF
+     */
+    std::shared_ptr<ForwardingInformationBaseV4> syncedFibV4;
+    std::shared_ptr<ForwardingInformationBaseV6> syncedFibV6;
+
+    RibResolutionIndex* resolutionIndexIfEnabled() {
+      if (!FLAGS_rib_incremental_resolution) {
+        // Updates made without the index leave it stale
+        resolutionIndex.invalidate();
+        return nullptr;
+      }
+      return &resolutionIndex;
+    }
 
     bool operator==(const RouteTable& other) const {
       return v4NetworkToRoute == other.v4NetworkToRoute &&
@@ -160,11 +203,11 @@ class RibRouteTables {
   void updateRib(RouterID vrf, const RibUpdateFn& updateRib);
 
   /*
-   * Currently, route updates to separate VRFs are made to be sequential. In the
-   * event FBOSS has to operate in a routing architecture with numerous VRFs,
-   * we can avoid a slow down by a factor of number of VRFs by parallelizing
-   * route updates across VRFs. This can be accomplished simply by associating
-   * the mutex implicit in folly::Synchronized with an individual RouteTable.
+   * Currently, route updates to separate VRFs are made to be sequential.
+   * Only reconfigure() applies config to the RouteTables of all VRFs
+   * concurrently, while holding the lock on the whole map. Parallelizing
+   * other route updates across VRFs can be accomplished by associating the
+   * mutex implicit in folly::Synchronized with an individual RouteTable.
    */
   using RouterIDToRouteTable = boost::container::flat_map<RouterID, RouteTable>;
   using SynchronizedRouteTables = folly::Synchronized<RouterIDToRouteTable>;
@@ -365,6 +408,8 @@ class RoutingInformationBase {
 
   std::unique_ptr<std::thread> ribUpdateThread_;
   folly::EventBase ribUpdateEventBase_;
+  // Applies config to VRFs concurrently, null if rib_reconfigure_threads <= 1
+  std::unique_ptr<folly::CPUThreadPoolExecutor> reconfigureExecutor_;
   RibRouteTables ribTables_;
 };
 
@@ -8,9 +8,11 @@
  *
  */
 
+#include "fboss/agent/FbossError.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
 
+#include "fboss/agent/rib/FibUpdateHelpers.h"
 #include "fboss/agent/rib/RoutingInformationBase.h"
 #include "fboss/agent/state/ForwardingInformationBase.h"
 #include "fboss/agent/state/ForwardingInformationBaseContainer.h"
@@ -341,3 +343,84 @@ TEST(ConfigApplication, MultiVrfColdBoot) {
   fibContainer = fibMap->getFibContainer(RouterID(1));
   EXPECT_NE(nullptr, fibContainer);
 }
+
+TEST(ConfigApplication, MultiVrfVrfList) {
+  RoutingInformationBase rib;
+  RoutingInformationBase::RouterIDAndNetworkToInterfaceRoutes interfaceRoutes;
+  interfaceRoutes[RouterID(1)];
+  interfaceRoutes[RouterID(2)];
+
+  rib.reconfigure(
+      interfaceRoutes,
+      {} /* staticRoutesWithNextHops */,
+      {} /* staticRoutesToNull */,
+      {} /* staticRoutesToCpu */,
+      {} /* staticIp2MplsRoutes */,
+      {} /* staticMplsRoutesWithNextHops */,
+      {} /* staticMplsRoutesToNull */,
+      {} /* staticMplsRoutesToCpu */,
+      noopFibUpdate,
+      nullptr);
+  // Only the configured VRFs, each listed once
+  EXPECT_EQ(
+      rib.getVrfList(), std::vector<RouterID>({RouterID(1), RouterID(2)}));
+}
+
+TEST(ConfigApplication, MultiVrfParallelMatchesSequential) {
+  gflags::FlagSaver flagSaver;
+  auto emptyState = std::make_shared<SwitchState>();
+  auto platform = createMockPlatform();
+  auto config = dualVrfConfig();
+
+  auto applyConfig = [&](int threads) {
+    FLAGS_rib_reconfigure_threads = threads;
+    RoutingInformationBase rib;
+    auto state =
+        publishAndApplyConfig(emptyState, &config, platform.get(), &rib);
+    EXPECT_NE(nullptr, state);
+    return state;
+  };
+  auto sequentialState = applyConfig(1);
+  auto parallelState = applyConfig(4);
+
+  EXPECT_EQ(
+      sequentialState->getFibs()->toThrift(),
+      parallelState->getFibs()->toThrift());
+}
+
+TEST(ConfigApplication, FibUpdateFailureInOneVrf) {
+  RoutingInformationBase rib;
+  RoutingInformationBase::RouterIDAndNetworkToInterfaceRoutes interfaceRoutes;
+  interfaceRoutes[RouterID(0)];
+  interfaceRoutes[RouterID(1)];
+
+  std::vector<RouterID> updatedVrfs;
+  auto updateFib = [&updatedVrfs](
+                       RouterID vrf,
+                       const auto& /* v4NetworkToRoute */,
+                       const auto& /* v6NetworkToRoute */,
+                       const auto& /* labelToRoute */,
+                       const auto* /* ribToFibDelta */,
+                       void* /* cookie */) -> std::shared_ptr<SwitchState> {
+    updatedVrfs.push_back(vrf);
+    if (vrf == RouterID(0)) {
+      throw FbossError("FIB update failed");
+    }
+    return nullptr;
+  };
+  EXPECT_THROW(
+      rib.reconfigure(
+          interfaceRoutes,
+          {} /* staticRoutesWithNextHops */,
+          {} /* staticRoutesToNull */,
+          {} /* staticRoutesToCpu */,
+          {} /* staticIp2MplsRoutes */,
+          {} /* staticMplsRoutesWithNextHops */,
+          {} /* staticMplsRoutesToNull */,
+          {} /* staticMplsRoutesToCpu */,
+          updateFib,
+          nullptr),
+      FbossError);
+  // The failure in VRF 0 doesn't keep VRF 1 from being synced
+  EXPECT_EQ(updatedVrfs, std::vector<RouterID>({RouterID(0), RouterID(1)}));
+}
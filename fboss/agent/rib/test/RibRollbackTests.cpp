@@ -49,6 +49,7 @@ class FailSomeUpdates {
       const IPv4NetworkToRouteMap& v4NetworkToRoute,
       const IPv6NetworkToRouteMap& v6NetworkToRoute,
       const LabelToRouteMap& labelToRoute,
+      const RibToFibDelta* ribToFibDelta,
       void* cookie) {
     if (toFail_.find(++cnt_) != toFail_.end()) {
       auto curSwitchStatePtr =
@@ -60,11 +61,17 @@ class FailSomeUpdates {
           v4NetworkToRoute,
           v6NetworkToRoute,
           labelToRoute,
+          ribToFibDelta,
           static_cast<void*>(&desiredState));
       throw FbossHwUpdateError(desiredState, *curSwitchStatePtr);
     }
     return ribToSwitchStateUpdate(
-        vrf, v4NetworkToRoute, v6NetworkToRoute, labelToRoute, cookie);
+        vrf,
+        v4NetworkToRoute,
+        v6NetworkToRoute,
+        labelToRoute,
+        ribToFibDelta,
+        cookie);
   }
 
  private:
@@ -198,4 +198,140 @@ TEST(Route, serializeRouteTable) {
   EXPECT_MPLS_ROUTES_MATCH(origMplsRoutes, &newMplsRoutes);
 }
 
+TEST(Route, incrementalResolutionMatchesFullResolution) {
+  IPv4NetworkToRouteMap fullV4Routes;
+  IPv6NetworkToRouteMap fullV6Routes;
+  LabelToRouteMap fullMplsRoutes;
+  IPv4NetworkToRouteMap incV4Routes;
+  IPv6NetworkToRouteMap incV6Routes;
+  LabelToRouteMap incMplsRoutes;
+  RibResolutionIndex index;
+
+  auto update = [&](ClientID client,
+                    const std::vector<RibRouteUpdater::RouteEntry>& toAdd,
+                    const std::vector<folly::CIDRNetwork>& toDel) {
+    RibRouteUpdater full(&fullV4Routes, &fullV6Routes, &fullMplsRoutes);
+    full.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+        client, toAdd, toDel, false);
+    RibRouteUpdater incremental(
+        &incV4Routes, &incV6Routes, &incMplsRoutes, &index);
+    incremental.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+        client, toAdd, toDel, false);
+    EXPECT_TRUE(index.isValid());
+    EXPECT_ROUTES_MATCH(&fullV4Routes, &incV4Routes);
+    EXPECT_ROUTES_MATCH(&fullV6Routes, &incV6Routes);
+  };
+  auto interfaceRoute = [](const std::string& network,
+                           const std::string& intfAddr,
+                           InterfaceID intf) {
+    ResolvedNextHop nhop(IPAddress(intfAddr), intf, UCMP_DEFAULT_WEIGHT);
+    return RibRouteUpdater::RouteEntry(
+        IPAddress::createNetwork(network),
+        RouteNextHopEntry(
+            static_cast<NextHop>(nhop), AdminDistance::DIRECTLY_CONNECTED));
+  };
+  auto route = [](const std::string& network,
+                  std::vector<std::string> nhops) {
+    return RibRouteUpdater::RouteEntry(
+        IPAddress::createNetwork(network),
+        RouteNextHopEntry(makeNextHops(std::move(nhops)), kDistance));
+  };
+  auto isResolved = [&incV4Routes](const std::string& network) {
+    auto prefix = IPAddress::createNetwork(network);
+    auto it = incV4Routes.exactMatch(prefix.first.asV4(), prefix.second);
+    return it != incV4Routes.end() && it->value()->isResolved();
+  };
+
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {interfaceRoute("1.1.1.0/24", "1.1.1.1", InterfaceID(1)),
+       interfaceRoute("2.2.2.0/24", "2.2.2.1", InterfaceID(2)),
+       interfaceRoute("1001::/64", "1001::1", InterfaceID(1))},
+      {});
+  // Directly, recursively and unresolvable routes
+  update(
+      kClientA,
+      {route("10.0.0.0/24", {"1.1.1.10"}),
+       route("20.0.0.0/24", {"10.0.0.5"}),
+       route("30.0.0.0/24", {"20.0.0.7", "2.2.2.10"}),
+       route("40.0.0.0/24", {"99.0.0.1"}),
+       route("2001::/64", {"1001::10"})},
+      {});
+  EXPECT_TRUE(isResolved("30.0.0.0/24"));
+  EXPECT_FALSE(isResolved("40.0.0.0/24"));
+  // Covering route for a previously unresolvable next hop
+  update(kClientB, {route("99.0.0.0/8", {"2.2.2.10"})}, {});
+  EXPECT_TRUE(isResolved("40.0.0.0/24"));
+  // More specific route changes resolution two levels up
+  update(kClientB, {route("10.0.0.0/28", {"2.2.2.20"})}, {});
+  // Change next hops of a route others resolve through
+  update(kClientB, {route("10.0.0.0/28", {"1.1.1.20", "2.2.2.20"})}, {});
+  update(kClientB, {}, {IPAddress::createNetwork("10.0.0.0/28")});
+  // Take away the interface route everything resolves through
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {},
+      {IPAddress::createNetwork("1.1.1.0/24"),
+       IPAddress::createNetwork("1001::/64")});
+  EXPECT_FALSE(isResolved("10.0.0.0/24"));
+  EXPECT_FALSE(isResolved("20.0.0.0/24"));
+  EXPECT_TRUE(isResolved("30.0.0.0/24"));
+  update(kClientB, {}, {IPAddress::createNetwork("99.0.0.0/8")});
+  EXPECT_FALSE(isResolved("40.0.0.0/24"));
+
+  // Invalidated index falls back to full resolution and is rebuilt
+  index.invalidate();
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {interfaceRoute("1.1.1.0/24", "1.1.1.1", InterfaceID(1))},
+      {});
+  EXPECT_TRUE(isResolved("20.0.0.0/24"));
+  EXPECT_GT(index.numRoutes(), 0);
+}
+
+TEST(Route, resolvedRoutesShareForwardInfo) {
+  IPv4NetworkToRouteMap v4Routes;
+  IPv6NetworkToRouteMap v6Routes;
+  LabelToRouteMap mplsRoutes;
+  auto update = [&](ClientID client,
+                    const std::vector<RibRouteUpdater::RouteEntry>& toAdd) {
+    RibRouteUpdater updater(&v4Routes, &v6Routes, &mplsRoutes);
+    updater.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+        client, toAdd, {}, false);
+  };
+  auto getRoute = [&v4Routes](const std::string& network) {
+    auto prefix = IPAddress::createNetwork(network);
+    auto it = v4Routes.exactMatch(prefix.first.asV4(), prefix.second);
+    CHECK(it != v4Routes.end());
+    return it->value();
+  };
+
+  ResolvedNextHop intfNhop(
+      IPAddress("1.1.1.1"), InterfaceID(1), UCMP_DEFAULT_WEIGHT);
+  update(
+      ClientID::INTERFACE_ROUTE,
+      {RibRouteUpdater::RouteEntry(
+          IPAddress::createNetwork("1.1.1.0/24"),
+          RouteNextHopEntry(
+              static_cast<NextHop>(intfNhop),
+              AdminDistance::DIRECTLY_CONNECTED))});
+  std::vector<RibRouteUpdater::RouteEntry> routes;
+  for (const auto& network : {"10.0.0.0/24", "20.0.0.0/24", "30.0.0.0/24"}) {
+    routes.emplace_back(
+        IPAddress::createNetwork(network),
+        RouteNextHopEntry(makeNextHops({"1.1.1.10", "1.1.1.20"}), kDistance));
+  }
+  update(kClientA, routes);
+
+  auto route10 = getRoute("10.0.0.0/24");
+  EXPECT_TRUE(route10->isResolved());
+  for (const auto& network : {"20.0.0.0/24", "30.0.0.0/24"}) {
+    EXPECT_EQ(&getRoute(network)->getForwardInfo(), &route10->getForwardInfo());
+  }
+
+  // Unchanged forwarding info is retained on re-resolution
+  update(kClientA, {});
+  EXPECT_EQ(getRoute("10.0.0.0/24"), route10);
+}
+
 } // namespace facebook::fboss
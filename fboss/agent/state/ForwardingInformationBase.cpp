@@ -19,7 +19,8 @@ template <typename AddressT>
 std::shared_ptr<Route<AddressT>>
 ForwardingInformationBase<AddressT>::exactMatch(
     const RoutePrefix<AddressT>& prefix) const {
-  return ForwardingInformationBase::Base::getNodeIf(prefix.str());
+  return ForwardingInformationBase::Base::getNodeIf(
+      RoutePrefixKey<AddressT>(prefix));
 }
 
 template <typename AddressT>
@@ -35,12 +35,20 @@ using ForwardingInformationBaseType = std::map<std::string, state::RouteFields>;
 template <typename AddrT>
 class ForwardingInformationBase;
 
+// FIBs are large and modified by every route update, share unmodified
+// routes between a FIB and its clones. Routes are keyed by binary prefix in
+// memory and by prefix string in thrift.
 template <typename AddrT>
-using ForwardingInformationBaseTraits = ThriftMapNodeTraits<
-    ForwardingInformationBase<AddrT>,
-    ForwardingInformationBaseClass,
-    ForwardingInformationBaseType,
-    Route<AddrT>>;
+struct ForwardingInformationBaseTraits : ThriftMapNodeTraits<
+                                             ForwardingInformationBase<AddrT>,
+                                             ForwardingInformationBaseClass,
+                                             ForwardingInformationBaseType,
+                                             Route<AddrT>,
+                                             state::RouteFields,
+                                             thrift_cow::PersistentMapStorage> {
+  using KeyType = RoutePrefixKey<AddrT>;
+  using KeyCompare = std::less<KeyType>;
+};
 
 template <typename AddressT>
 class ForwardingInformationBase
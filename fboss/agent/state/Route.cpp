@@ -156,7 +156,21 @@ template struct RouteFields<LabelID>;
 
 template <typename AddrT>
 bool Route<AddrT>::isSame(const Route<AddrT>* rt) const {
-  return *this == *rt;
+  if (this == rt) {
+    return true;
+  }
+  // Compare member by member rather than serializing both routes, children
+  // shared between the routes (e.g. interned forwarding info, or client
+  // entries of a clone) are then compared by pointer.
+  const auto& fwd = this->template cref<switch_state_tags::fwd>();
+  const auto& otherFwd = rt->template cref<switch_state_tags::fwd>();
+  const auto& multi = this->template cref<switch_state_tags::nexthopsmulti>();
+  const auto& otherMulti =
+      rt->template cref<switch_state_tags::nexthopsmulti>();
+  return prefix() == rt->prefix() && flags() == rt->flags() &&
+      getClassID() == rt->getClassID() &&
+      (fwd == otherFwd || *fwd == *otherFwd) &&
+      (multi == otherMulti || *multi == *otherMulti);
 }
 
 template <typename AddrT>
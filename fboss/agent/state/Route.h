@@ -361,7 +361,7 @@ class Route : public ThriftStructNode<Route<AddrT>, ThriftFieldsT<AddrT>> {
     if constexpr (std::is_same_v<AddrT, LabelID>) {
       return prefix().value();
     } else {
-      return prefix().str();
+      return RoutePrefixKey<AddrT>(prefix());
     }
   }
   uint32_t flags() const {
@@ -464,9 +464,13 @@ class Route : public ThriftStructNode<Route<AddrT>, ThriftFieldsT<AddrT>> {
   void setConnected() {
     setFlags(flags() | CONNECTED);
   }
-  // THRIFT_COPY
   void setResolved(const RouteNextHopEntry& fwd) {
-    this->template set<switch_state_tags::fwd>(fwd.toThrift());
+    setResolved(RouteNextHopEntry::intern(fwd));
+  }
+  // fwd must be interned, see RouteNextHopEntry::intern()
+  void setResolved(const std::shared_ptr<RouteNextHopEntry>& fwd) {
+    CHECK(fwd->isPublished());
+    this->template ref<switch_state_tags::fwd>() = fwd;
     setFlags(flags() | RESOLVED);
     setFlags(flags() & (~(UNRESOLVABLE | PROCESSING)));
   }
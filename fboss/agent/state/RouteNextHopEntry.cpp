@@ -16,7 +16,10 @@
 #include <gflags/gflags.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 #include <iterator>
+#include <map>
+#include <mutex>
 #include <numeric>
+#include <tuple>
 #include "folly/IPAddress.h"
 
 namespace {
@@ -508,6 +511,117 @@ RouteNextHopEntry RouteNextHopEntry::from(
   return {RouteForwardAction::TO_CPU, adminDistance, counterID, classID};
 }
 
+namespace {
+/*
+ * Weakly referenced table of interned entries. Entries are freed by whichever
+ * thread drops the last reference to them (e.g. while destroying an old
+ * SwitchState), so the table is synchronized. It is never destroyed, since
+ * entries may outlive static destruction.
+ */
+class InternedRouteNextHopEntries {
+ public:
+  using Key = std::tuple<
+      AdminDistance,
+      RouteForwardAction,
+      RouteNextHopSet,
+      std::optional<RouteCounterID>,
+      std::optional<cfg::AclLookupClass>>;
+
+  static InternedRouteNextHopEntries& get() {
+    static auto* entries = new InternedRouteNextHopEntries();
+    return *entries;
+  }
+
+  template <typename MakeEntry>
+  std::shared_ptr<RouteNextHopEntry> intern(
+      const Key& key,
+      const MakeEntry& makeEntry) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(key);
+    if (it != entries_.end()) {
+      if (auto entry = it->second.lock()) {
+        return entry;
+      }
+    }
+    auto entry = makeEntry();
+    entry->publish();
+    std::shared_ptr<RouteNextHopEntry> sharedEntry(
+        entry.release(), [this, key](RouteNextHopEntry* toDelete) {
+          release(key);
+          delete toDelete;
+        });
+    if (it != entries_.end()) {
+      it->second = sharedEntry;
+    } else {
+      entries_.emplace(key, sharedEntry);
+    }
+    return sharedEntry;
+  }
+
+  size_t size() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return entries_.size();
+  }
+
+ private:
+  void release(const Key& key) {
+    std::lock_guard<std::mutex> guard(lock_);
+    auto it = entries_.find(key);
+    // Equal info may have been interned again since the last reference to
+    // this entry was dropped
+    if (it != entries_.end() && it->second.expired()) {
+      entries_.erase(it);
+    }
+  }
+
+  mutable std::mutex lock_;
+  std::map<Key, std::weak_ptr<RouteNextHopEntry>> entries_;
+};
+} // namespace
+
+std::shared_ptr<RouteNextHopEntry> RouteNextHopEntry::intern(
+    const RouteNextHopEntry& entry) {
+  return InternedRouteNextHopEntries::get().intern(
+      {entry.getAdminDistance(),
+       entry.getAction(),
+       entry.getNextHopSet(),
+       entry.getCounterID(),
+       entry.getClassID()},
+      [&entry]() {
+        return std::make_unique<RouteNextHopEntry>(entry.toThrift());
+      });
+}
+
+std::shared_ptr<RouteNextHopEntry> RouteNextHopEntry::intern(
+    NextHopSet nhopSet,
+    AdminDistance distance,
+    std::optional<RouteCounterID> counterID,
+    std::optional<AclLookupClass> classID) {
+  return InternedRouteNextHopEntries::get().intern(
+      {distance, Action::NEXTHOPS, nhopSet, counterID, classID},
+      [&nhopSet, distance, &counterID, &classID]() {
+        return std::make_unique<RouteNextHopEntry>(
+            nhopSet, distance, counterID, classID);
+      });
+}
+
+std::shared_ptr<RouteNextHopEntry> RouteNextHopEntry::intern(
+    Action action,
+    AdminDistance distance,
+    std::optional<RouteCounterID> counterID,
+    std::optional<AclLookupClass> classID) {
+  return InternedRouteNextHopEntries::get().intern(
+      {distance, action, NextHopSet(), counterID, classID},
+      [action, distance, &counterID, &classID]() {
+        return std::make_unique<RouteNextHopEntry>(
+            action, distance, counterID, classID);
+      });
+}
+
+size_t RouteNextHopEntry::numInterned() {
+  return InternedRouteNextHopEntries::get().size();
+}
+
 RouteNextHopEntry RouteNextHopEntry::createDrop(AdminDistance adminDistance) {
   return RouteNextHopEntry(RouteForwardAction::DROP, adminDistance);
 }
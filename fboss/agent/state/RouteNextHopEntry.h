@@ -166,6 +166,30 @@ class RouteNextHopEntry
       AdminDistance defaultAdminDistance,
       std::optional<RouteCounterID> counterID,
       std::optional<AclLookupClass> classID);
+  /*
+   * Return a published entry equal to the given forwarding info. It is shared
+   * with every other holder of equal interned info and dropped from the
+   * intern table once the last holder releases it. Routes hold their
+   * resolved forwarding info this way: a few hundred distinct ECMP sets are
+   * typically shared by hundreds of thousands of routes, so routes share
+   * next hop storage, and unchanged forwarding info compares equal by
+   * pointer.
+   */
+  static std::shared_ptr<RouteNextHopEntry> intern(
+      const RouteNextHopEntry& entry);
+  static std::shared_ptr<RouteNextHopEntry> intern(
+      NextHopSet nhopSet,
+      AdminDistance distance,
+      std::optional<RouteCounterID> counterID = std::nullopt,
+      std::optional<AclLookupClass> classID = std::nullopt);
+  static std::shared_ptr<RouteNextHopEntry> intern(
+      Action action,
+      AdminDistance distance,
+      std::optional<RouteCounterID> counterID = std::nullopt,
+      std::optional<AclLookupClass> classID = std::nullopt);
+  // Number of distinct interned entries currently in use
+  static size_t numInterned();
+
   static facebook::fboss::RouteNextHopEntry createDrop(
       AdminDistance adminDistance = AdminDistance::STATIC_ROUTE);
   static facebook::fboss::RouteNextHopEntry createToCpu(
@@ -86,6 +86,47 @@ void toAppend(const RoutePrefixV6& prefix, std::string* result) {
   result->append(prefix.str());
 }
 
+void toAppend(const RoutePrefixKeyV4& key, std::string* result) {
+  result->append(key.str());
+}
+
+void toAppend(const RoutePrefixKeyV6& key, std::string* result) {
+  result->append(key.str());
+}
+
+namespace {
+template <typename AddrT>
+folly::Expected<folly::StringPiece, folly::ConversionCode> parsePrefixKey(
+    folly::StringPiece in,
+    RoutePrefixKey<AddrT>& out) {
+  // Keep the network as is, keys must round trip with RoutePrefix::str()
+  auto network = folly::IPAddress::tryCreateNetwork(
+      in, -1 /* defaultCidr */, false /* mask */);
+  if (network.hasError() ||
+      network->first.isV6() != std::is_same_v<AddrT, folly::IPAddressV6>) {
+    return folly::makeUnexpected(folly::ConversionCode::NON_DIGIT_CHAR);
+  }
+  if constexpr (std::is_same_v<AddrT, folly::IPAddressV6>) {
+    out = RoutePrefixKey<AddrT>(network->first.asV6(), network->second);
+  } else {
+    out = RoutePrefixKey<AddrT>(network->first.asV4(), network->second);
+  }
+  return in.subpiece(in.size());
+}
+} // namespace
+
+folly::Expected<folly::StringPiece, folly::ConversionCode> parseTo(
+    folly::StringPiece in,
+    RoutePrefixKeyV4& out) {
+  return parsePrefixKey(in, out);
+}
+
+folly::Expected<folly::StringPiece, folly::ConversionCode> parseTo(
+    folly::StringPiece in,
+    RoutePrefixKeyV6& out) {
+  return parsePrefixKey(in, out);
+}
+
 void toAppend(const RouteKeyMpls& route, std::string* result) {
   result->append(fmt::format("{}", route.label()));
 }
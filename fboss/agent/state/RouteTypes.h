@@ -10,6 +10,7 @@
 // Copyright 2004-present Facebook.  All rights reserved.
 #pragma once
 
+#include <folly/Conv.h>
 #include <folly/FBString.h>
 #include <folly/IPAddress.h>
 #include <folly/dynamic.h>
@@ -21,6 +22,8 @@
 #include "folly/IPAddressV4.h"
 #include "folly/IPAddressV6.h"
 
+#include <array>
+
 namespace facebook::fboss {
 
 std::string forwardActionStr(RouteForwardAction action);
@@ -107,6 +110,67 @@ struct RoutePrefix {
   state::RoutePrefix data_;
 };
 
+/**
+ * Fixed size binary route prefix key: network address bytes followed by the
+ * mask length. FIBs are keyed by this rather than by the prefix string, so
+ * that lookups, inserts and deltas compare bytes instead of formatting and
+ * comparing strings. Converts to and from the "<network>/<mask>" string that
+ * keys FIBs in thrift (and so in warmboot state) via folly::to<>.
+ */
+template <typename AddrT>
+class RoutePrefixKey {
+ public:
+  static_assert(
+      std::is_same_v<folly::IPAddressV6, AddrT> ||
+          std::is_same_v<folly::IPAddressV4, AddrT>,
+      "Address is not V4 or V6");
+
+  RoutePrefixKey() {
+    bytes_.fill(0);
+  }
+
+  RoutePrefixKey(const AddrT& network, uint8_t mask) {
+    std::copy(
+        network.bytes(), network.bytes() + AddrT::byteCount(), bytes_.begin());
+    bytes_[AddrT::byteCount()] = mask;
+  }
+
+  explicit RoutePrefixKey(const RoutePrefix<AddrT>& prefix)
+      : RoutePrefixKey(prefix.network(), prefix.mask()) {}
+
+  AddrT network() const {
+    return AddrT::fromBinary(
+        folly::ByteRange(bytes_.data(), AddrT::byteCount()));
+  }
+  uint8_t mask() const {
+    return bytes_[AddrT::byteCount()];
+  }
+
+  std::string str() const {
+    return folly::to<std::string>(
+        network(), "/", static_cast<uint32_t>(mask()));
+  }
+
+  bool operator<(const RoutePrefixKey& other) const {
+    return bytes_ < other.bytes_;
+  }
+  bool operator>(const RoutePrefixKey& other) const {
+    return bytes_ > other.bytes_;
+  }
+  bool operator==(const RoutePrefixKey& other) const {
+    return bytes_ == other.bytes_;
+  }
+  bool operator!=(const RoutePrefixKey& other) const {
+    return !operator==(other);
+  }
+
+ private:
+  std::array<uint8_t, AddrT::byteCount() + 1> bytes_;
+};
+
+using RoutePrefixKeyV4 = RoutePrefixKey<folly::IPAddressV4>;
+using RoutePrefixKeyV6 = RoutePrefixKey<folly::IPAddressV6>;
+
 template <>
 struct is_fboss_key_object_type<RoutePrefix<folly::IPAddressV4>> {
   static constexpr bool value = true;
@@ -192,6 +256,14 @@ using RouteKeyMpls = Label;
 
 void toAppend(const RoutePrefixV4& prefix, std::string* result);
 void toAppend(const RoutePrefixV6& prefix, std::string* result);
+void toAppend(const RoutePrefixKeyV4& key, std::string* result);
+void toAppend(const RoutePrefixKeyV6& key, std::string* result);
+folly::Expected<folly::StringPiece, folly::ConversionCode> parseTo(
+    folly::StringPiece in,
+    RoutePrefixKeyV4& out);
+folly::Expected<folly::StringPiece, folly::ConversionCode> parseTo(
+    folly::StringPiece in,
+    RoutePrefixKeyV6& out);
 void toAppend(const RouteKeyMpls& route, std::string* result);
 void toAppend(const RouteForwardAction& action, std::string* result);
 std::ostream& operator<<(std::ostream& os, const RouteForwardAction& action);
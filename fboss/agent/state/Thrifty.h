@@ -282,12 +282,14 @@ template <
     typename MapThrift,
     typename NODE =
         thrift_cow::ThriftStructNode<typename MapThrift::mapped_type>,
-    typename NodeThrift = typename MapThrift::mapped_type>
+    typename NodeThrift = typename MapThrift::mapped_type,
+    typename MapStorageT = thrift_cow::StdMapStorage>
 struct ThriftMapNodeTraits {
   using TC = TypeClass;
   using Type = MapThrift;
   using KeyType = typename Type::key_type;
   using KeyCompare = std::less<KeyType>;
+  using MapStorage = MapStorageT;
   // for structure
   template <typename...>
   struct ValueTraits {
@@ -31,6 +31,7 @@ using std::make_shared;
 using std::shared_ptr;
 
 DECLARE_bool(enable_acl_table_group);
+DECLARE_int32(acl_priority_gap);
 
 TEST(Acl, applyConfig) {
   FLAGS_enable_acl_table_group = false;
@@ -933,6 +934,110 @@ TEST(Acl, InvalidTrafficCounter) {
       publishAndApplyConfig(stateV0, &config, platform.get()), FbossError);
 }
 
+TEST(Acl, InsertAclKeepsPriorities) {
+  FLAGS_enable_acl_table_group = false;
+  gflags::FlagSaver flagSaver;
+  FLAGS_acl_priority_gap = 16;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+
+  cfg::SwitchConfig config;
+  config.acls()->resize(10);
+  for (int i = 0; i < 10; ++i) {
+    *config.acls()[i].name() = folly::to<std::string>("acl", i);
+    *config.acls()[i].actionType() = cfg::AclActionType::DENY;
+    config.acls()[i].dscp() = i;
+  }
+  auto stateV1 = publishAndApplyConfig(stateV0, &config, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+
+  cfg::AclEntry head;
+  *head.name() = "head";
+  *head.actionType() = cfg::AclActionType::DENY;
+  head.dscp() = 10;
+  config.acls()->insert(config.acls()->begin(), head);
+  auto stateV2 = publishAndApplyConfig(stateV1, &config, platform.get());
+  ASSERT_NE(nullptr, stateV2);
+
+  // Only the inserted acl is added, others keep their priorities
+  StateDelta delta12(stateV1, stateV2);
+  auto aclDelta12 = delta12.getAclsDelta();
+  auto iter = aclDelta12.begin();
+  ASSERT_NE(iter, aclDelta12.end());
+  EXPECT_EQ(iter->getOld(), nullptr);
+  EXPECT_EQ(iter->getNew()->getID(), "head");
+  ++iter;
+  EXPECT_EQ(iter, aclDelta12.end());
+  auto headAcl = stateV2->getAcl("head");
+  ASSERT_NE(nullptr, headAcl);
+  EXPECT_GE(headAcl->getPriority(), AclTable::kDataplaneAclMaxPriority);
+  EXPECT_LT(headAcl->getPriority(), stateV2->getAcl("acl0")->getPriority());
+}
+
+TEST(Acl, UnchangedAclConfigNotReapplied) {
+  FLAGS_enable_acl_table_group = false;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+
+  cfg::SwitchConfig configV1;
+  configV1.ports()->resize(1);
+  preparedMockPortConfig(configV1.ports()[0], 1);
+  configV1.acls()->resize(1);
+  *configV1.acls()[0].name() = "acl1";
+  *configV1.acls()[0].actionType() = cfg::AclActionType::DENY;
+  configV1.acls()[0].srcPort() = 5;
+  auto stateV1 = publishAndApplyConfig(stateV0, &configV1, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+  stateV1->publish();
+
+  // Only ports changed, acls are kept as they are
+  auto configV2 = configV1;
+  configV2.ports()[0].description() = "port1";
+  auto stateV2 = applyThriftConfig(
+      stateV1,
+      &configV2,
+      platform.get(),
+      (RoutingInformationBase*)nullptr,
+      nullptr,
+      &configV1,
+      stateV1);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_EQ(stateV1->getAcls(), stateV2->getAcls());
+  stateV2->publish();
+
+  // Acls modified outside of config, e.g. by AclNexthopHandler, are reset on
+  // re-applying the same config
+  auto modifiedState = stateV2;
+  modifiedState->getAcl("acl1")->modify(&modifiedState)->setEnabled(false);
+  modifiedState->publish();
+  auto stateV3 = applyThriftConfig(
+      modifiedState,
+      &configV2,
+      platform.get(),
+      (RoutingInformationBase*)nullptr,
+      nullptr,
+      &configV2,
+      stateV2);
+  ASSERT_NE(nullptr, stateV3);
+  EXPECT_EQ(
+      stateV2->getAcl("acl1")->isEnabled(),
+      stateV3->getAcl("acl1")->isEnabled());
+  stateV3->publish();
+
+  auto configV4 = configV2;
+  configV4.acls()[0].srcPort() = 6;
+  auto stateV4 = applyThriftConfig(
+      stateV3,
+      &configV4,
+      platform.get(),
+      (RoutingInformationBase*)nullptr,
+      nullptr,
+      &configV2,
+      stateV3);
+  ASSERT_NE(nullptr, stateV4);
+  EXPECT_EQ(6, stateV4->getAcl("acl1")->getSrcPort());
+}
+
 TEST(Acl, GetRequiredAclTableQualifiers) {
   cfg::SwitchConfig config;
   config.acls();
@@ -125,7 +125,7 @@ TEST(ForwardingInformationBaseV6, IPv6DefaultPrefixFound) {
   RoutePrefixV6 defaultPrefixV6{folly::IPAddressV6("::"), 0};
 
   DeltaFunctions::forEachAdded(delta, [&](std::shared_ptr<RouteV6> newRoute) {
-    if (newRoute->getID() == defaultPrefixV6.str()) {
+    if (newRoute->getID() == RoutePrefixKeyV6(defaultPrefixV6)) {
       defaultRouteObserved = newRoute;
       return LoopAction::BREAK;
     }
@@ -135,6 +135,58 @@ TEST(ForwardingInformationBaseV6, IPv6DefaultPrefixFound) {
   EXPECT_NE(defaultRouteObserved, nullptr);
 }
 
+TEST(ForwardingInformationBaseV4, ThriftKeyedByPrefixString) {
+  auto fibV4 = getFibV4();
+  auto thrift = fibV4->toThrift();
+  EXPECT_EQ(thrift.size(), fibV4->size());
+  for (const auto& [key, route] : std::as_const(*fibV4)) {
+    EXPECT_EQ(key, route->getID());
+    EXPECT_NE(thrift.find(route->str()), thrift.end());
+  }
+
+  ForwardingInformationBaseV4 fib;
+  fib.fromThrift(thrift);
+  EXPECT_EQ(fib.size(), fibV4->size());
+  EXPECT_NE(
+      fib.exactMatch(RoutePrefixV4(folly::IPAddressV4("128.0.0.0"), 24)),
+      nullptr);
+}
+
+TEST(RoutePrefixKey, StringConversion) {
+  for (auto prefix :
+       {RoutePrefixV6(folly::IPAddressV6("::"), 0),
+        RoutePrefixV6(folly::IPAddressV6("2401:db00::1"), 64),
+        RoutePrefixV6(folly::IPAddressV6("::ffff:10.0.0.1"), 128)}) {
+    RoutePrefixKeyV6 key(prefix);
+    EXPECT_EQ(key.network(), prefix.network());
+    EXPECT_EQ(key.mask(), prefix.mask());
+    EXPECT_EQ(folly::to<std::string>(key), prefix.str());
+    EXPECT_EQ(folly::to<RoutePrefixKeyV6>(prefix.str()), key);
+  }
+  // network is not masked, keys round trip with route prefix strings
+  auto key = folly::to<RoutePrefixKeyV4>("10.0.0.1/24");
+  EXPECT_EQ(key.network(), folly::IPAddressV4("10.0.0.1"));
+  EXPECT_EQ(key.str(), "10.0.0.1/24");
+
+  EXPECT_FALSE(folly::tryTo<RoutePrefixKeyV4>("2401:db00::/64").hasValue());
+  EXPECT_FALSE(folly::tryTo<RoutePrefixKeyV6>("10.0.0.0/8").hasValue());
+  EXPECT_FALSE(folly::tryTo<RoutePrefixKeyV4>("10.0.0.0").hasValue());
+  EXPECT_FALSE(folly::tryTo<RoutePrefixKeyV4>("10.0.0.0/33").hasValue());
+}
+
+TEST(RoutePrefixKey, Ordering) {
+  RoutePrefixKeyV4 defaultRoute(folly::IPAddressV4("0.0.0.0"), 0);
+  RoutePrefixKeyV4 slash8(folly::IPAddressV4("10.0.0.0"), 8);
+  RoutePrefixKeyV4 slash24(folly::IPAddressV4("10.0.0.0"), 24);
+  RoutePrefixKeyV4 other(folly::IPAddressV4("9.0.0.0"), 24);
+  EXPECT_LT(defaultRoute, other);
+  EXPECT_LT(other, slash8);
+  EXPECT_LT(slash8, slash24);
+  EXPECT_GT(slash24, slash8);
+  EXPECT_EQ(slash8, RoutePrefixKeyV4(RoutePrefixV4::fromString("10.0.0.0/8")));
+  EXPECT_NE(slash8, slash24);
+}
+
 TEST(ForwardingInformationBaseContainer, Thrifty) {
   auto fibV4 = getFibV4();
   auto fibV6 = getFibV4();
@@ -428,6 +428,43 @@ TEST(QosPolicy, PortQosPolicyOverride) {
   ASSERT_EQ("qp1", stateV1->getPort(PortID(2))->getQosPolicy().value());
 }
 
+TEST(QosPolicy, DefaultQosPolicyOnlyChange) {
+  cfg::SwitchConfig configV1;
+  auto platform = createMockPlatform();
+  auto stateV0 = make_shared<SwitchState>();
+
+  configV1.qosPolicies()->resize(2);
+  *configV1.qosPolicies()[0].name() = "qp1";
+  *configV1.qosPolicies()[0].rules() = dscpRules({{0, {46}}});
+  *configV1.qosPolicies()[1].name() = "qp2";
+  *configV1.qosPolicies()[1].rules() = dscpRules({{1, {46}}});
+  cfg::TrafficPolicyConfig trafficPolicy;
+  trafficPolicy.defaultQosPolicy() = "qp1";
+  configV1.dataPlaneTrafficPolicy() = trafficPolicy;
+  auto stateV1 = publishAndApplyConfig(stateV0, &configV1, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+  stateV1->publish();
+  EXPECT_EQ(nullptr, stateV1->getQosPolicies()->getQosPolicyIf("qp1"));
+  EXPECT_NE(nullptr, stateV1->getQosPolicies()->getQosPolicyIf("qp2"));
+
+  // Qos policies are unchanged, only the default one is, which is kept out
+  // of the qos policy map
+  auto configV2 = configV1;
+  configV2.dataPlaneTrafficPolicy()->defaultQosPolicy() = "qp2";
+  auto stateV2 = applyThriftConfig(
+      stateV1,
+      &configV2,
+      platform.get(),
+      (RoutingInformationBase*)nullptr,
+      nullptr,
+      &configV1,
+      stateV1);
+  ASSERT_NE(nullptr, stateV2);
+  EXPECT_EQ("qp2", stateV2->getDefaultDataPlaneQosPolicy()->getName());
+  EXPECT_NE(nullptr, stateV2->getQosPolicies()->getQosPolicyIf("qp1"));
+  EXPECT_EQ(nullptr, stateV2->getQosPolicies()->getQosPolicyIf("qp2"));
+}
+
 TEST(QosPolicy, QosPolicyDelta) {
   cfg::SwitchConfig config;
   auto platform = createMockPlatform();
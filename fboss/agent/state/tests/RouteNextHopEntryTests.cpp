@@ -416,3 +416,49 @@ TEST(RouteNextHopEntry, Thrift) {
   validateThriftStructNodeSerialization<RouteNextHopEntry>(nhops0);
   validateThriftStructNodeSerialization<RouteNextHopEntry>(nhops1);
 }
+
+TEST(RouteNextHopEntry, Intern) {
+  auto numInterned = RouteNextHopEntry::numInterned();
+  RouteNextHopSet nhops;
+  nhops.emplace(ResolvedNextHop(nextHopAddr1, InterfaceID(1), ECMP_WEIGHT));
+  nhops.emplace(ResolvedNextHop(nextHopAddr2, InterfaceID(2), ECMP_WEIGHT));
+  {
+    auto entry = RouteNextHopEntry::intern(nhops, kDefaultAdminDistance);
+    EXPECT_TRUE(entry->isPublished());
+    EXPECT_EQ(entry->getNextHopSet(), nhops);
+    EXPECT_EQ(RouteNextHopEntry::numInterned(), numInterned + 1);
+
+    // equal forwarding info shares the entry
+    EXPECT_EQ(
+        RouteNextHopEntry::intern(nhops, kDefaultAdminDistance).get(),
+        entry.get());
+    EXPECT_EQ(
+        RouteNextHopEntry::intern(
+            RouteNextHopEntry(nhops, kDefaultAdminDistance))
+            .get(),
+        entry.get());
+
+    // anything else that differs does not
+    EXPECT_NE(
+        RouteNextHopEntry::intern(nhops, AdminDistance::STATIC_ROUTE).get(),
+        entry.get());
+    EXPECT_NE(
+        RouteNextHopEntry::intern(
+            nhops,
+            kDefaultAdminDistance,
+            std::optional<RouteCounterID>("counter"))
+            .get(),
+        entry.get());
+    auto drop = RouteNextHopEntry::intern(
+        RouteNextHopEntry::Action::DROP, kDefaultAdminDistance);
+    EXPECT_TRUE(drop->isDrop());
+    EXPECT_EQ(
+        RouteNextHopEntry::intern(
+            RouteNextHopEntry::createDrop(kDefaultAdminDistance))
+            .get(),
+        drop.get());
+    EXPECT_EQ(RouteNextHopEntry::numInterned(), numInterned + 2);
+  }
+  // released with the last reference
+  EXPECT_EQ(RouteNextHopEntry::numInterned(), numInterned);
+}
@@ -361,6 +361,36 @@ TEST(Udf, validateMissingUdfGroupConfig) {
       publishAndApplyConfig(stateV0, &config, platform.get()), FbossError);
 }
 
+TEST(Udf, validateUdfGroupOnLoadBalancerOnlyChange) {
+  auto platform = createMockPlatform();
+  auto stateV0 = std::make_shared<SwitchState>();
+
+  cfg::SwitchConfig configV1;
+  auto udfEntry = makeCfgUdfGroupEntry(kUdfGroupCfgName1.str());
+  auto udfPacketmatcherEntry =
+      makeCfgUdfPacketMatcherEntry(kPacketMatcherCfgName.str());
+  configV1.udfConfig() = makeUdfCfg({udfEntry}, {udfPacketmatcherEntry});
+  configV1.loadBalancers() = {makeLoadBalancerCfg({kUdfGroupCfgName1.str()})};
+  auto stateV1 = publishAndApplyConfig(stateV0, &configV1, platform.get());
+  ASSERT_NE(nullptr, stateV1);
+  stateV1->publish();
+
+  // Udf config is unchanged, but the load balancer now refers to UdfGroup foo2
+  // which has no configuration
+  auto configV2 = configV1;
+  configV2.loadBalancers() = {makeLoadBalancerCfg({kUdfGroupCfgName2.str()})};
+  EXPECT_THROW(
+      applyThriftConfig(
+          stateV1,
+          &configV2,
+          platform.get(),
+          (RoutingInformationBase*)nullptr,
+          nullptr,
+          &configV1,
+          stateV1),
+      FbossError);
+}
+
 TEST(Udf, removeUdfConfigStateDelta) {
   auto platform = createMockPlatform();
   auto stateV0 = std::make_shared<SwitchState>();
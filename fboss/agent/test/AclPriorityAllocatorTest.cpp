@@ -0,0 +1,115 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/AclPriorityAllocator.h"
+#include "fboss/agent/FbossError.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr auto kMinPriority = 100;
+constexpr auto kMaxPriority = 1000;
+
+std::vector<std::optional<int>> existing(const std::vector<int>& priorities) {
+  return std::vector<std::optional<int>>(priorities.begin(), priorities.end());
+}
+
+int numChanged(
+    const std::vector<std::optional<int>>& existingPriorities,
+    const std::vector<int>& priorities) {
+  int changed = 0;
+  for (size_t i = 0; i < priorities.size(); ++i) {
+    changed += existingPriorities[i] != priorities[i];
+  }
+  return changed;
+}
+} // namespace
+
+TEST(AclPriorityAllocator, dense) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 1);
+  EXPECT_EQ(
+      allocator.allocate({std::nullopt, std::nullopt, std::nullopt}),
+      std::vector<int>({100, 101, 102}));
+}
+
+TEST(AclPriorityAllocator, sparse) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 10);
+  EXPECT_EQ(
+      allocator.allocate({std::nullopt, std::nullopt, std::nullopt}),
+      std::vector<int>({109, 119, 129}));
+}
+
+TEST(AclPriorityAllocator, insertInGap) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 10);
+  // At head, in the middle and at the tail
+  EXPECT_EQ(
+      allocator.allocate(
+          {std::nullopt, 109, 119, std::nullopt, std::nullopt, 129}),
+      std::vector<int>({104, 109, 119, 122, 125, 129}));
+  EXPECT_EQ(
+      allocator.allocate({109, 119, std::nullopt}),
+      std::vector<int>({109, 119, 129}));
+}
+
+TEST(AclPriorityAllocator, removeKeepsPriorities) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 1);
+  EXPECT_EQ(
+      allocator.allocate(existing({100, 102, 105})),
+      std::vector<int>({100, 102, 105}));
+}
+
+TEST(AclPriorityAllocator, moveChangesOnlyMovedAcl) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 10);
+  // Last acl moved to the head
+  auto existingPriorities = existing({149, 109, 119, 129, 139});
+  auto priorities = allocator.allocate(existingPriorities);
+  EXPECT_EQ(numChanged(existingPriorities, priorities), 1);
+  EXPECT_TRUE(std::is_sorted(priorities.begin(), priorities.end()));
+}
+
+TEST(AclPriorityAllocator, respaceNeighboursWhenNoGap) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 1);
+  // No room between 101 and 102, respace the acls around them
+  auto existingPriorities =
+      std::vector<std::optional<int>>({100, 101, std::nullopt, 102, 200});
+  auto priorities = allocator.allocate(existingPriorities);
+  EXPECT_TRUE(std::is_sorted(priorities.begin(), priorities.end()));
+  EXPECT_EQ(
+      std::adjacent_find(priorities.begin(), priorities.end()),
+      priorities.end());
+  EXPECT_EQ(priorities.back(), 200);
+  EXPECT_LE(numChanged(existingPriorities, priorities), 3);
+}
+
+TEST(AclPriorityAllocator, insertAtHeadOfDensePriorities) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 1);
+  EXPECT_EQ(
+      allocator.allocate({std::nullopt, 100, 101, 102}),
+      std::vector<int>({100, 101, 102, 103}));
+}
+
+TEST(AclPriorityAllocator, ignoreExistingOutOfRange) {
+  AclPriorityAllocator allocator(kMinPriority, kMaxPriority, 1);
+  EXPECT_EQ(
+      allocator.allocate(existing({5, 2000})), std::vector<int>({100, 101}));
+}
+
+TEST(AclPriorityAllocator, outOfPriorities) {
+  AclPriorityAllocator allocator(1, 3, 1);
+  EXPECT_EQ(
+      allocator.allocate({std::nullopt, std::nullopt, std::nullopt}),
+      std::vector<int>({1, 2, 3}));
+  EXPECT_THROW(
+      allocator.allocate(
+          {std::nullopt, std::nullopt, std::nullopt, std::nullopt}),
+      FbossError);
+}
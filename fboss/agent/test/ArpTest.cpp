@@ -12,6 +12,7 @@
 #include <folly/io/Cursor.h>
 #include <folly/io/IOBuf.h>
 #include "fboss/agent/AddressUtil.h"
+#include "fboss/agent/ArpCache.h"
 #include "fboss/agent/ArpHandler.h"
 #include "fboss/agent/FbossError.h"
 #include "fboss/agent/NeighborUpdater.h"
@@ -28,6 +29,7 @@
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/Interface.h"
 #include "fboss/agent/state/PortDescriptor.h"
+#include "fboss/agent/state/StateDelta.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/state/VlanMap.h"
@@ -38,9 +40,11 @@
 
 #include <boost/range/combine.hpp>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <array>
 #include <future>
 #include <string>
+#include <thread>
 
 using namespace facebook::fboss;
 using facebook::network::toBinaryAddress;
@@ -227,6 +231,42 @@ getArpEntry(SwSwitch* sw, IPAddressV4 ip, VlanID vlanID = VlanID(1)) {
       ->getEntryIf(ip);
 }
 
+/*
+ * Creates an ArpCache for vlanID with a pending entry for each of targetIPs,
+ * and waits for the entries to be programmed. Pending entries expire after
+ * their single probe interval (setupTestHandle() allows one probe).
+ */
+std::shared_ptr<ArpCache> createArpCacheWithPendingEntries(
+    SwSwitch* sw,
+    VlanID vlanID,
+    const std::vector<IPAddressV4>& targetIPs) {
+  std::shared_ptr<ArpCache> cache;
+  sw->getNeighborCacheEvb()->runInEventBaseThreadAndWait([&]() {
+    auto state = sw->getState();
+    auto vlan = state->getVlans()->getVlan(vlanID);
+    cache = std::make_shared<ArpCache>(
+        sw, state.get(), vlanID, vlan->getName(), vlan->getInterfaceID());
+    for (const auto& ip : targetIPs) {
+      cache->setPendingEntry(ip);
+    }
+  });
+  waitForStateUpdates(sw);
+  for (const auto& ip : targetIPs) {
+    EXPECT_NE(getArpEntry(sw, ip, vlanID), nullptr);
+  }
+  return cache;
+}
+
+/*
+ * Keeps the neighbor cache thread busy until the pending entries created by
+ * createArpCacheWithPendingEntries() are due to expire, so that all of their
+ * timeouts fire in the same event loop iteration.
+ */
+void blockNeighborCacheThreadUntilExpiry(SwSwitch* sw) {
+  sw->getNeighborCacheEvb()->runInEventBaseThread(
+      []() { std::this_thread::sleep_for(std::chrono::milliseconds(1500)); });
+}
+
 /* This helper sends an arp request for targetIP and verifies it was correctly
    sent out. */
 void testSendArpRequest(
@@ -1137,6 +1177,128 @@ TEST(ArpTest, ArpExpiration) {
   EXPECT_TRUE(arpExpirations[0]->wait());
 }
 
+TEST(ArpTest, BatchedExpiryUpdatesStateOnce) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_batch_neighbor_expiry = true;
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+
+  VlanID vlanID(1);
+  std::vector<IPAddressV4> targetIPs = {
+      IPAddressV4("10.0.0.2"),
+      IPAddressV4("10.0.0.3"),
+      IPAddressV4("10.0.0.4"),
+      IPAddressV4("10.0.0.5")};
+  auto cache = createArpCacheWithPendingEntries(sw, vlanID, targetIPs);
+
+  // All entries expire in the same loop, and are removed in one update
+  EXPECT_HW_CALL(sw, stateChanged(_)).Times(1);
+  WaitForSwitchState expired(
+      sw,
+      [&targetIPs, vlanID](const StateDelta& delta) {
+        auto arpTable =
+            delta.newState()->getVlans()->getVlan(vlanID)->getArpTable();
+        return std::none_of(
+            targetIPs.begin(), targetIPs.end(), [&](const auto& ip) {
+              return arpTable->getEntryIf(ip) != nullptr;
+            });
+      },
+      "WaitForArpEntriesExpired");
+  blockNeighborCacheThreadUntilExpiry(sw);
+  EXPECT_TRUE(expired.wait());
+  waitForStateUpdates(sw);
+
+  sw->getNeighborCacheEvb()->runInEventBaseThreadAndWait(
+      [&cache]() { cache.reset(); });
+}
+
+TEST(ArpTest, ExpiredEntryReaddedBeforeFlush) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_batch_neighbor_expiry = true;
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  auto* evb = sw->getNeighborCacheEvb();
+
+  VlanID vlanID(1);
+  std::vector<IPAddressV4> targetIPs = {
+      IPAddressV4("10.0.0.2"), IPAddressV4("10.0.0.3")};
+  MacAddress targetMAC("02:10:20:30:40:22");
+  auto cache = createArpCacheWithPendingEntries(sw, vlanID, targetIPs);
+
+  // Resolve the first entry right after it expires, before the batched
+  // removal of the expired entries runs at the end of the loop
+  evb->runInEventBaseThreadAndWait([&]() {
+    evb->timer().scheduleTimeoutFn(
+        [&]() {
+          cache->setEntry(
+              targetIPs[0],
+              targetMAC,
+              PortDescriptor(PortID(1)),
+              NeighborEntryState::REACHABLE);
+        },
+        std::chrono::seconds(1));
+  });
+  WaitForArpEntryExpiration expired(sw, targetIPs[1], vlanID);
+  blockNeighborCacheThreadUntilExpiry(sw);
+  EXPECT_TRUE(expired.wait());
+  waitForStateUpdates(sw);
+
+  auto entry = getArpEntry(sw, targetIPs[0], vlanID);
+  ASSERT_NE(entry, nullptr);
+  EXPECT_FALSE(entry->isPending());
+  EXPECT_EQ(entry->getMac(), targetMAC);
+
+  evb->runInEventBaseThreadAndWait([&cache]() { cache.reset(); });
+}
+
+TEST(ArpTest, CacheDestroyedBeforeExpiryFlushApplied) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_batch_neighbor_expiry = true;
+  auto handle = setupTestHandle();
+  auto sw = handle->getSw();
+  auto* evb = sw->getNeighborCacheEvb();
+
+  VlanID vlanID(1);
+  std::vector<IPAddressV4> targetIPs = {
+      IPAddressV4("10.0.0.2"), IPAddressV4("10.0.0.3")};
+  auto cache = createArpCacheWithPendingEntries(sw, vlanID, targetIPs);
+
+  // Hold the update thread until the cache is gone, so that the removal of
+  // the expired entries is applied after the cache is destroyed
+  std::promise<void> cacheDestroyed;
+  sw->updateState(
+      "wait for cache destruction",
+      [destroyed = cacheDestroyed.get_future().share()](
+          const std::shared_ptr<SwitchState>& /*state*/) {
+        destroyed.wait();
+        return std::shared_ptr<SwitchState>();
+      });
+  evb->runInEventBaseThreadAndWait([&]() {
+    evb->timer().scheduleTimeoutFn(
+        [&]() {
+          // Runs after the loop callback flushing the expired entries
+          evb->runInLoop([&]() {
+            cache.reset();
+            cacheDestroyed.set_value();
+          });
+        },
+        std::chrono::seconds(1));
+  });
+  std::array<unique_ptr<WaitForArpEntryExpiration>, 2> arpExpirations;
+  std::transform(
+      targetIPs.begin(),
+      targetIPs.end(),
+      arpExpirations.begin(),
+      [&](const IPAddressV4& ip) {
+        return make_unique<WaitForArpEntryExpiration>(sw, ip, vlanID);
+      });
+  blockNeighborCacheThreadUntilExpiry(sw);
+  for (auto& arpExpiration : arpExpirations) {
+    EXPECT_TRUE(arpExpiration->wait());
+  }
+  EXPECT_EQ(cache, nullptr);
+}
+
 TEST(ArpTest, FlushEntryWithConcurrentUpdate) {
   auto handle = setupTestHandle();
   auto sw = handle->getSw();
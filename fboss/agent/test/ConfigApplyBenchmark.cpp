@@ -0,0 +1,143 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/ApplyThriftConfig.h"
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/platforms/common/wedge100/Wedge100PlatformMapping.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/test/TestUtils.h"
+
+using namespace facebook::fboss;
+
+DECLARE_bool(enable_acl_table_group);
+
+namespace {
+static constexpr size_t kNumPorts = 500;
+static constexpr int kNumAcls = 5000;
+// Wedge100 port ids are all below this
+static constexpr int kPortIdStride = 200;
+
+/*
+ * Wedge100 platform mapping with its ports repeated as if on more pims, for
+ * at least kNumPorts ports
+ */
+std::unique_ptr<PlatformMapping> largePlatformMapping() {
+  auto mapping = Wedge100PlatformMapping().toThrift();
+  const auto wedge100Ports = *mapping.ports();
+  for (int pim = 2; mapping.ports()->size() < kNumPorts; ++pim) {
+    auto offset = (pim - 1) * kPortIdStride;
+    for (auto [portID, port] : wedge100Ports) {
+      auto& portMapping = *port.mapping();
+      portMapping.id() = portID + offset;
+      portMapping.controllingPort() = *portMapping.controllingPort() + offset;
+      const auto& name = *portMapping.name();
+      portMapping.name() =
+          fmt::format("eth{}{}", pim, name.substr(name.find('/')));
+      for (auto& profile : *port.supportedProfiles()) {
+        if (auto subsumedPorts = profile.second.subsumedPorts()) {
+          for (auto& subsumedPort : *subsumedPorts) {
+            subsumedPort += offset;
+          }
+        }
+      }
+      (*mapping.ports())[portID + offset] = std::move(port);
+    }
+  }
+  return std::make_unique<PlatformMapping>(mapping);
+}
+
+cfg::SwitchConfig largeConfig(const PlatformMapping& platformMapping) {
+  cfg::SwitchConfig config;
+  config.ports()->resize(kNumPorts);
+  config.vlanPorts()->resize(kNumPorts);
+  auto platformPort = platformMapping.getPlatformPorts().begin();
+  for (size_t i = 0; i < kNumPorts; ++i, ++platformPort) {
+    preparedMockPortConfig(config.ports()[i], platformPort->first);
+    config.vlanPorts()[i].logicalPort() = platformPort->first;
+    config.vlanPorts()[i].vlanID() = 1;
+  }
+  config.vlans()->resize(1);
+  config.vlans()[0].id() = 1;
+  config.vlans()[0].name() = "Vlan1";
+  config.vlans()[0].intfID() = 1;
+  config.interfaces()->resize(1);
+  config.interfaces()[0].intfID() = 1;
+  config.interfaces()[0].vlanID() = 1;
+  config.interfaces()[0].mac() = "00:02:00:00:00:01";
+  config.interfaces()[0].ipAddresses() = {
+      "10.0.0.1/24", "2401:db00:2110:3001::0001/64"};
+
+  config.acls()->resize(kNumAcls);
+  for (auto i = 0; i < kNumAcls; ++i) {
+    auto& acl = config.acls()[i];
+    acl.name() = fmt::format("acl{}", i);
+    acl.actionType() = cfg::AclActionType::DENY;
+    acl.dstIp() = fmt::format("2401:db00:{:x}::/64", i);
+    acl.l4DstPort() = 1000 + i % 1000;
+  }
+  return config;
+}
+} // namespace
+
+/*
+ * Re-application of a config with kNumPorts ports and kNumAcls ACLs, after
+ * changing the description of a port, with and without the previously
+ * applied config to skip unchanged sections.
+ */
+void applyPortDescriptionChange(unsigned iters, bool incremental) {
+  std::unique_ptr<MockPlatform> platform;
+  std::shared_ptr<SwitchState> state;
+  cfg::SwitchConfig prevConfig;
+  BENCHMARK_SUSPEND {
+    FLAGS_enable_acl_table_group = false;
+    platform = createMockPlatform(largePlatformMapping());
+    prevConfig = largeConfig(*platform->getPlatformMapping());
+    state = publishAndApplyConfig(
+        std::make_shared<SwitchState>(), &prevConfig, platform.get());
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    cfg::SwitchConfig config;
+    BENCHMARK_SUSPEND {
+      config = prevConfig;
+      config.ports()[0].description() = fmt::format("port1 v{}", iter);
+      state->publish();
+    }
+    auto newState = applyThriftConfig(
+        state,
+        &config,
+        platform.get(),
+        (RoutingInformationBase*)nullptr,
+        nullptr,
+        incremental ? &prevConfig : nullptr,
+        incremental ? state : nullptr);
+    folly::doNotOptimizeAway(newState);
+    BENCHMARK_SUSPEND {
+      state = newState;
+      prevConfig = std::move(config);
+    }
+  }
+}
+
+BENCHMARK(ConfigApplyFull, iters) {
+  applyPortDescriptionChange(iters, false);
+}
+
+BENCHMARK_RELATIVE(ConfigApplyIncremental, iters) {
+  applyPortDescriptionChange(iters, true);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
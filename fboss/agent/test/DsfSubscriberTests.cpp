@@ -9,9 +9,12 @@
  */
 #include "fboss/agent/DsfSubscriber.h"
 #include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/gen-cpp2/switch_state_fatal_types.h"
 #include "fboss/agent/state/SwitchState.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/TestUtils.h"
+#include "fboss/fsdb/server/LocalFsdbServer.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
 
 #include <folly/logging/xlog.h>
 #include <gtest/gtest.h>
@@ -47,6 +50,36 @@ std::shared_ptr<InterfaceMap> makeRifs(const SystemPortMap* sysPorts) {
   }
   return rifs;
 }
+
+// Sys ports and rifs of a remote node, with a local neighbor on each rif
+state::SwitchState makeRemoteNodeState(
+    int64_t switchId,
+    int64_t firstSysPortId,
+    int numSysPorts) {
+  auto sysPorts = std::make_shared<SystemPortMap>();
+  for (auto sysPortId = firstSysPortId;
+       sysPortId < firstSysPortId + numSysPorts;
+       ++sysPortId) {
+    sysPorts->addNode(makeSysPort(std::nullopt, sysPortId, switchId));
+  }
+  auto rifs = makeRifs(sysPorts.get());
+  for (const auto& [id, rif] : *rifs) {
+    state::NeighborEntryFields nbr;
+    nbr.ipaddress() = folly::sformat("10.{}.{}.1", switchId % 256, id % 256);
+    nbr.mac() = "01:02:03:04:05:06";
+    cfg::PortDescriptor port;
+    port.portId() = id;
+    port.portType() = cfg::PortDescriptorType::SystemPort;
+    nbr.portId() = port;
+    nbr.interfaceId() = id;
+    nbr.isLocal() = true;
+    rif->setArpTable(state::NeighborEntries{{*nbr.ipaddress(), nbr}});
+  }
+  state::SwitchState state;
+  state.systemPortMap() = sysPorts->toThrift();
+  state.interfaceMap() = rifs->toThrift();
+  return state;
+}
 } // namespace
 
 namespace facebook::fboss {
@@ -76,6 +109,29 @@ TEST_F(DsfSubscriberTest, scheduleUpdate) {
   // state updates.
 }
 
+TEST_F(DsfSubscriberTest, changesKeptUntilApplied) {
+  gflags::FlagSaver flagSaver;
+  FLAGS_dsf_subscriber_skip_hw_writes = true;
+  auto sysPorts = makeSysPorts();
+  auto rifs = makeRifs(sysPorts.get());
+  dsfSubscriber_->scheduleUpdate(
+      sysPorts, rifs, "switch", SwitchID(kRemoteSwitchId));
+  waitForStateUpdates(sw_);
+  EXPECT_EQ(0, sw_->getState()->getRemoteSystemPorts()->size());
+  EXPECT_EQ(0, sw_->getState()->getRemoteInterfaces()->size());
+
+  // Changes skipped above are still pending
+  FLAGS_dsf_subscriber_skip_hw_writes = false;
+  sw_->updateStateBlocking(
+      "Apply pending remote changes",
+      [this](const std::shared_ptr<SwitchState>& in) {
+        return dsfSubscriber_->updateRemoteState(in);
+      });
+  EXPECT_EQ(
+      sysPorts->size(), sw_->getState()->getRemoteSystemPorts()->size());
+  EXPECT_EQ(rifs->size(), sw_->getState()->getRemoteInterfaces()->size());
+}
+
 TEST_F(DsfSubscriberTest, setupNeighbors) {
   auto updateAndCompareTables = [this](
                                     const auto& sysPorts,
@@ -202,4 +258,127 @@ TEST_F(DsfSubscriberTest, setupNeighbors) {
   verifySetupNeighbors(false /* publishState */);
   verifySetupNeighbors(true /* publishState */);
 }
+
+TEST_F(DsfSubscriberTest, remoteNodeDeltasScale) {
+  constexpr auto kNumNodes = 32;
+  constexpr auto kSysPortsPerNode = 64;
+  using RemoteFsdb = fsdb::LocalFsdbTree<state::SwitchState>;
+  using structure = apache::thrift::type_class::structure;
+  auto sysPortsPath = DsfSubscriber::getSystemPortsPath();
+  // Local FSDB trees are rooted at switch state
+  std::vector<std::string> switchStatePath(
+      sysPortsPath.begin(), sysPortsPath.end() - 1);
+
+  auto firstSysPortId = [](int node) {
+    return kSysPortRangeMin + 1 + node * kSysPortsPerNode;
+  };
+  auto nodeSwitchId = [](int node) { return kRemoteSwitchId + 1 + node; };
+  std::vector<std::unique_ptr<RemoteFsdb>> remoteFsdbs;
+  for (auto node = 0; node < kNumNodes; ++node) {
+    auto& remoteFsdb =
+        remoteFsdbs.emplace_back(std::make_unique<RemoteFsdb>());
+    fsdb::OperState state;
+    state.protocol() = fsdb::OperProtocol::BINARY;
+    state.contents() = thrift_cow::serialize<structure>(
+        fsdb::OperProtocol::BINARY,
+        makeRemoteNodeState(
+            nodeSwitchId(node), firstSysPortId(node), kSysPortsPerNode));
+    remoteFsdb->publishState({}, std::move(state));
+
+    auto nodeName = folly::to<std::string>("node", node);
+    auto switchId = SwitchID(nodeSwitchId(node));
+    for (const auto& path :
+         {sysPortsPath, DsfSubscriber::getInterfacesPath()}) {
+      remoteFsdb->subscribeDelta(
+          {path.back()},
+          fsdb::OperProtocol::BINARY,
+          [this, switchStatePath, nodeName, switchId](
+              const std::shared_ptr<const fsdb::OperDelta>& delta) {
+            fsdb::TaggedOperDelta change;
+            change.delta() = *delta;
+            for (auto& unit : *change.delta()->changes()) {
+              auto& unitPath = *unit.path()->raw();
+              unitPath.insert(
+                  unitPath.begin(),
+                  switchStatePath.begin(),
+                  switchStatePath.end());
+            }
+            fsdb::OperSubDeltaUnit operDeltaUnit;
+            operDeltaUnit.changes()->push_back(std::move(change));
+            dsfSubscriber_->handleFsdbUpdate(
+                std::move(operDeltaUnit), nodeName, switchId);
+          });
+    }
+  }
+  auto waitForRemoteUpdates = [&]() {
+    for (auto& remoteFsdb : remoteFsdbs) {
+      remoteFsdb->waitForUpdates();
+    }
+    waitForStateUpdates(sw_);
+  };
+  waitForRemoteUpdates();
+
+  auto state = sw_->getState();
+  EXPECT_EQ(
+      kNumNodes * kSysPortsPerNode, state->getRemoteSystemPorts()->size());
+  EXPECT_EQ(
+      kNumNodes * kSysPortsPerNode, state->getRemoteInterfaces()->size());
+  for (const auto& [id, rif] : std::as_const(*state->getRemoteInterfaces())) {
+    for (const auto& [ip, arpEntry] : *rif->toThrift().arpTable()) {
+      EXPECT_FALSE(*arpEntry.isLocal());
+    }
+  }
+
+  // Every node changes the neighbor on its first rif, and removes its last
+  // sys port
+  for (auto node = 0; node < kNumNodes; ++node) {
+    auto rifId = firstSysPortId(node);
+    auto nbr = state->getRemoteInterfaces()
+                   ->getNode(rifId)
+                   ->toThrift()
+                   .arpTable()
+                   ->begin()
+                   ->second;
+    nbr.mac() = "06:05:04:03:02:01";
+    nbr.isLocal() = true;
+    fsdb::OperState nbrState;
+    nbrState.protocol() = fsdb::OperProtocol::BINARY;
+    nbrState.contents() =
+        thrift_cow::serialize<structure>(fsdb::OperProtocol::BINARY, nbr);
+    remoteFsdbs[node]->publishState(
+        {"interfaceMap",
+         folly::to<std::string>(rifId),
+         "arpTable",
+         *nbr.ipaddress()},
+        std::move(nbrState));
+    auto lastSysPortId = firstSysPortId(node) + kSysPortsPerNode - 1;
+    fsdb::OperDelta removeSysPort;
+    removeSysPort.protocol() = fsdb::OperProtocol::BINARY;
+    fsdb::OperDeltaUnit unit;
+    unit.path()->raw() = {
+        "systemPortMap", folly::to<std::string>(lastSysPortId)};
+    removeSysPort.changes()->push_back(std::move(unit));
+    remoteFsdbs[node]->publishDelta({"agent"}, std::move(removeSysPort));
+  }
+  waitForRemoteUpdates();
+
+  auto newState = sw_->getState();
+  EXPECT_EQ(
+      kNumNodes * (kSysPortsPerNode - 1),
+      newState->getRemoteSystemPorts()->size());
+  for (auto node = 0; node < kNumNodes; ++node) {
+    auto rifId = firstSysPortId(node);
+    auto rif = newState->getRemoteInterfaces()->getNode(rifId)->toThrift();
+    const auto& nbr = rif.arpTable()->begin()->second;
+    EXPECT_EQ("06:05:04:03:02:01", *nbr.mac());
+    EXPECT_FALSE(*nbr.isLocal());
+    // Unchanged rifs are not rebuilt
+    EXPECT_EQ(
+        state->getRemoteInterfaces()->getNode(rifId + 1),
+        newState->getRemoteInterfaces()->getNode(rifId + 1));
+  }
+
+  // Stop serving remote FSDB updates before the subscriber goes away
+  remoteFsdbs.clear();
+}
 } // namespace facebook::fboss
@@ -0,0 +1,81 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/MacAddress.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/L2Entry.h"
+#include "fboss/agent/MacTableManager.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+using namespace facebook::fboss;
+
+namespace {
+const VlanID kVlan(1);
+static constexpr int kNumPorts = 10;
+
+L2Entry l2Entry(int index) {
+  return L2Entry(
+      folly::MacAddress::fromHBO(0x020000000000 + index),
+      kVlan,
+      PortDescriptor(PortID(index % kNumPorts + 1)),
+      L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
+}
+} // namespace
+
+/*
+ * A burst of numMacs learn callbacks, as delivered by the HwSwitch FDB event
+ * path, followed by a burst of age callbacks for the same MACs, with at most
+ * batchSize L2 learning updates applied per state update.
+ */
+void learnAndAge(unsigned iters, int numMacs, int batchSize) {
+  std::unique_ptr<HwTestHandle> handle;
+  SwSwitch* sw{nullptr};
+  BENCHMARK_SUSPEND {
+    FLAGS_mac_learning_batch_size = batchSize;
+    handle = createTestHandle(testStateA());
+    sw = handle->getSw();
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    for (auto i = 0; i < numMacs; ++i) {
+      sw->l2LearningUpdateReceived(
+          l2Entry(i), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+    }
+    waitForStateUpdates(sw);
+    for (auto i = 0; i < numMacs; ++i) {
+      sw->l2LearningUpdateReceived(
+          l2Entry(i), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+    }
+    waitForStateUpdates(sw);
+  }
+  BENCHMARK_SUSPEND {
+    handle.reset();
+  }
+}
+
+void learnAndAgeUnbatched(unsigned iters, int numMacs) {
+  learnAndAge(iters, numMacs, 1);
+}
+
+void learnAndAgeBatched(unsigned iters, int numMacs) {
+  learnAndAge(iters, numMacs, 1024);
+}
+
+BENCHMARK_NAMED_PARAM(learnAndAgeUnbatched, 1k, 1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(learnAndAgeBatched, 1k, 1000);
+BENCHMARK_NAMED_PARAM(learnAndAgeUnbatched, 10k, 10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(learnAndAgeBatched, 10k, 10000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
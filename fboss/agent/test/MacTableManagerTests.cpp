@@ -172,4 +172,38 @@ TEST_F(MacTableManagerTest, SameMacAgedCbTwice) {
   verifyMacIsDeleted();
 }
 
+TEST_F(MacTableManagerTest, LearnAndAgeBurst) {
+  constexpr auto kNumMacs = 100;
+  auto l2Entry = [this](int index) {
+    return L2Entry(
+        MacAddress::fromHBO(0x020000000000 + index),
+        kVlan(),
+        PortDescriptor(kPortID()),
+        L2Entry::L2EntryType::L2_ENTRY_TYPE_PENDING);
+  };
+  auto numMacs = [this]() {
+    auto vlan = getSw()->getState()->getVlans()->getVlan(kVlan());
+    return vlan->getMacTable()->size();
+  };
+
+  for (auto i = 0; i < kNumMacs; ++i) {
+    getSw()->l2LearningUpdateReceived(
+        l2Entry(i), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+  }
+  waitForStateUpdates(getSw());
+  EXPECT_EQ(numMacs(), kNumMacs);
+
+  // Age and re-learn of the same MAC within a burst are applied in order
+  for (auto i = 0; i < kNumMacs; ++i) {
+    getSw()->l2LearningUpdateReceived(
+        l2Entry(i), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_DELETE);
+    if (i % 2) {
+      getSw()->l2LearningUpdateReceived(
+          l2Entry(i), L2EntryUpdateType::L2_ENTRY_UPDATE_TYPE_ADD);
+    }
+  }
+  waitForStateUpdates(getSw());
+  EXPECT_EQ(numMacs(), kNumMacs / 2);
+}
+
 } // namespace facebook::fboss
@@ -0,0 +1,109 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/IPAddressV4.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/NeighborCacheImpl.h"
+#include "fboss/agent/SwSwitch.h"
+#include "fboss/agent/state/ArpTable.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
+#include "fboss/agent/state/VlanMap.h"
+#include "fboss/agent/test/HwTestHandle.h"
+#include "fboss/agent/test/TestUtils.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace facebook::fboss;
+
+namespace {
+const VlanID kVlan(4000);
+const InterfaceID kIntf(4000);
+
+std::shared_ptr<SwitchState> addVlanWithPendingEntries(
+    const std::shared_ptr<SwitchState>& in,
+    int numEntries) {
+  auto state = in->clone();
+  auto vlan = std::make_shared<Vlan>(kVlan, std::string("expiryVlan"));
+  vlan->setInterfaceID(kIntf);
+  auto arpTable = std::make_shared<ArpTable>();
+  for (auto i = 0; i < numEntries; ++i) {
+    arpTable->addPendingEntry(
+        folly::IPAddressV4::fromLongHBO(0xac100000 + i), kIntf);
+  }
+  vlan->setArpTable(arpTable);
+  state->addVlan(vlan);
+  return state;
+}
+
+size_t numArpEntries(SwSwitch* sw) {
+  return sw->getState()->getVlans()->getVlan(kVlan)->getArpTable()->size();
+}
+} // namespace
+
+/*
+ * numEntries pending ARP entries, repopulated into the neighbor cache when
+ * their VLAN is added, all expire after their single probe interval. Time
+ * until they are all removed from the SwitchState.
+ */
+void expireEntries(unsigned iters, int numEntries, bool batched) {
+  std::unique_ptr<HwTestHandle> handle;
+  SwSwitch* sw{nullptr};
+  BENCHMARK_SUSPEND {
+    FLAGS_batch_neighbor_expiry = batched;
+    handle = createTestHandle(testStateA());
+    sw = handle->getSw();
+    sw->updateStateBlocking("set timers", [](const auto& in) {
+      auto state = in->clone();
+      state->setMaxNeighborProbes(1);
+      return state;
+    });
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    BENCHMARK_SUSPEND {
+      sw->updateStateBlocking("add vlan", [numEntries](const auto& in) {
+        return addVlanWithPendingEntries(in, numEntries);
+      });
+    }
+    while (numArpEntries(sw)) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    BENCHMARK_SUSPEND {
+      sw->updateStateBlocking("remove vlan", [](const auto& in) {
+        auto state = in->clone();
+        state->getVlans()->modify(&state)->removeNode(kVlan);
+        return state;
+      });
+    }
+  }
+  BENCHMARK_SUSPEND {
+    handle.reset();
+  }
+}
+
+void expireEntriesUnbatched(unsigned iters, int numEntries) {
+  expireEntries(iters, numEntries, false);
+}
+
+void expireEntriesBatched(unsigned iters, int numEntries) {
+  expireEntries(iters, numEntries, true);
+}
+
+BENCHMARK_NAMED_PARAM(expireEntriesUnbatched, 10k, 10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(expireEntriesBatched, 10k, 10000);
+BENCHMARK_NAMED_PARAM(expireEntriesUnbatched, 100k, 100000);
+BENCHMARK_RELATIVE_NAMED_PARAM(expireEntriesBatched, 100k, 100000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,118 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/gen-cpp2/switch_config_types.h"
+#include "fboss/agent/rib/FibUpdateHelpers.h"
+#include "fboss/agent/rib/RoutingInformationBase.h"
+#include "fboss/agent/state/SwitchState.h"
+
+using namespace facebook::fboss;
+
+namespace {
+static constexpr int kNumInterfaces = 16;
+static constexpr int kNumStaticRoutes = 20000;
+static constexpr int kEcmpWidth = 4;
+
+folly::IPAddress interfaceAddr(int vrf, int intf) {
+  return folly::IPAddress(fmt::format("2401:db00:{:x}:{:x}::1", vrf, intf));
+}
+
+/*
+ * Interface routes and kNumStaticRoutes static routes, with next hops behind
+ * those interfaces, for each of numVrfs VRFs
+ */
+struct VrfConfigs {
+  RoutingInformationBase::RouterIDAndNetworkToInterfaceRoutes interfaceRoutes;
+  std::vector<cfg::StaticRouteWithNextHops> staticRoutes;
+
+  explicit VrfConfigs(int numVrfs) {
+    staticRoutes.reserve(numVrfs * kNumStaticRoutes);
+    for (auto vrf = 0; vrf < numVrfs; ++vrf) {
+      auto& vrfInterfaceRoutes = interfaceRoutes[RouterID(vrf)];
+      for (auto intf = 0; intf < kNumInterfaces; ++intf) {
+        auto addr = interfaceAddr(vrf, intf);
+        vrfInterfaceRoutes.emplace(
+            folly::IPAddress::createNetwork(
+                fmt::format("{}/64", addr.str()), -1, true /* applyMask */),
+            std::make_pair(InterfaceID(vrf * kNumInterfaces + intf + 1), addr));
+      }
+      for (auto i = 0; i < kNumStaticRoutes; ++i) {
+        cfg::StaticRouteWithNextHops route;
+        *route.routerID() = vrf;
+        *route.prefix() = fmt::format(
+            "2400:{:x}:{:x}::/48", (i >> 16) & 0xffff, i & 0xffff);
+        for (auto nhop = 0; nhop < kEcmpWidth; ++nhop) {
+          route.nexthops()->push_back(fmt::format(
+              "2401:db00:{:x}:{:x}::10", vrf, (i + nhop) % kNumInterfaces));
+        }
+        staticRoutes.push_back(std::move(route));
+      }
+    }
+  }
+};
+} // namespace
+
+/*
+ * Cold boot application of the interface and static routes of numVrfs VRFs,
+ * including the FIB updates, with config applied to rib_reconfigure_threads
+ * VRFs at a time.
+ */
+void reconfigure(unsigned iters, int numVrfs, int threads) {
+  std::unique_ptr<VrfConfigs> configs;
+  BENCHMARK_SUSPEND {
+    FLAGS_rib_reconfigure_threads = threads;
+    configs = std::make_unique<VrfConfigs>(numVrfs);
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    std::unique_ptr<RoutingInformationBase> rib;
+    auto state = std::make_shared<SwitchState>();
+    BENCHMARK_SUSPEND {
+      rib = std::make_unique<RoutingInformationBase>();
+    }
+    rib->reconfigure(
+        configs->interfaceRoutes,
+        configs->staticRoutes,
+        {} /* staticRoutesToNull */,
+        {} /* staticRoutesToCpu */,
+        {} /* staticIp2MplsRoutes */,
+        {} /* staticMplsRoutesWithNextHops */,
+        {} /* staticMplsRoutesToNull */,
+        {} /* staticMplsRoutesToCpu */,
+        ribToSwitchStateUpdate,
+        static_cast<void*>(&state));
+    folly::doNotOptimizeAway(state);
+    BENCHMARK_SUSPEND {
+      rib.reset();
+    }
+  }
+}
+
+void reconfigureSequential(unsigned iters, int numVrfs) {
+  reconfigure(iters, numVrfs, 1);
+}
+
+void reconfigureParallel(unsigned iters, int numVrfs) {
+  reconfigure(iters, numVrfs, 8);
+}
+
+BENCHMARK_NAMED_PARAM(reconfigureSequential, 1_vrf, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(reconfigureParallel, 1_vrf, 1);
+BENCHMARK_NAMED_PARAM(reconfigureSequential, 8_vrfs, 8);
+BENCHMARK_RELATIVE_NAMED_PARAM(reconfigureParallel, 8_vrfs, 8);
+BENCHMARK_NAMED_PARAM(reconfigureSequential, 32_vrfs, 32);
+BENCHMARK_RELATIVE_NAMED_PARAM(reconfigureParallel, 32_vrfs, 32);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/rib/RibResolutionIndex.h"
+#include "fboss/agent/rib/RouteUpdater.h"
+
+using namespace facebook::fboss;
+
+namespace {
+const AdminDistance kDefaultAdminDistance = AdminDistance::EBGP;
+static constexpr int kNumInterfaces = 32;
+static constexpr int kNumEcmpGroups = 256;
+static constexpr int kEcmpWidth = 8;
+static constexpr int kTableSize = 500000;
+
+folly::CIDRNetwork bgpPrefix(int index) {
+  // 2400:<hi>:<lo>::/48, unique for index < 2^32
+  return folly::IPAddress::createNetwork(fmt::format(
+      "2400:{:x}:{:x}::/48", (index >> 16) & 0xffff, index & 0xffff));
+}
+
+folly::IPAddress neighbor(int intf) {
+  return folly::IPAddress(fmt::format("2401:db00:{:x}::10", intf));
+}
+
+RouteNextHopEntry bgpNextHops(int index) {
+  auto group = index % kNumEcmpGroups;
+  RouteNextHopSet nhops;
+  for (auto i = 0; i < kEcmpWidth; ++i) {
+    nhops.emplace(UnresolvedNextHop(
+        neighbor((group + i) % kNumInterfaces), ECMP_WEIGHT));
+  }
+  return RouteNextHopEntry(nhops, kDefaultAdminDistance);
+}
+
+struct RibTables {
+  IPv4NetworkToRouteMap v4Routes;
+  IPv6NetworkToRouteMap v6Routes;
+  LabelToRouteMap mplsRoutes;
+  RibResolutionIndex index;
+
+  explicit RibTables(bool incremental) : incremental_(incremental) {
+    std::vector<RibRouteUpdater::RouteEntry> interfaceRoutes;
+    for (auto intf = 0; intf < kNumInterfaces; ++intf) {
+      ResolvedNextHop nhop(
+          folly::IPAddress(fmt::format("2401:db00:{:x}::1", intf)),
+          InterfaceID(intf + 1),
+          UCMP_DEFAULT_WEIGHT);
+      interfaceRoutes.emplace_back(
+          folly::IPAddress::createNetwork(
+              fmt::format("2401:db00:{:x}::/64", intf)),
+          RouteNextHopEntry(
+              static_cast<NextHop>(nhop), AdminDistance::DIRECTLY_CONNECTED));
+    }
+    update(ClientID::INTERFACE_ROUTE, interfaceRoutes, {});
+    std::vector<RibRouteUpdater::RouteEntry> bgpRoutes;
+    bgpRoutes.reserve(kTableSize);
+    for (auto i = 0; i < kTableSize; ++i) {
+      bgpRoutes.emplace_back(bgpPrefix(i), bgpNextHops(i));
+    }
+    update(ClientID::BGPD, bgpRoutes, {});
+  }
+
+  void update(
+      ClientID client,
+      const std::vector<RibRouteUpdater::RouteEntry>& toAdd,
+      const std::vector<folly::CIDRNetwork>& toDel) {
+    RibRouteUpdater updater(
+        &v4Routes, &v6Routes, &mplsRoutes, incremental_ ? &index : nullptr);
+    updater.update<RibRouteUpdater::RouteEntry, folly::CIDRNetwork>(
+        client, toAdd, toDel, false);
+  }
+
+ private:
+  bool incremental_;
+};
+
+RibTables& getRibTables(bool incremental) {
+  static RibTables fullTables(false);
+  static RibTables incrementalTables(true);
+  return incremental ? incrementalTables : fullTables;
+}
+} // namespace
+
+/*
+ * Latency of a single RIB update (route insertion + resolution) adding
+ * numRoutes routes to a kTableSize route table.
+ */
+void ribUpdateLatency(unsigned iters, bool incremental, int numRoutes) {
+  std::vector<RibRouteUpdater::RouteEntry> toAdd;
+  std::vector<folly::CIDRNetwork> toDel;
+  RibTables* tables;
+  BENCHMARK_SUSPEND {
+    tables = &getRibTables(incremental);
+    for (auto i = kTableSize; i < kTableSize + numRoutes; ++i) {
+      toAdd.emplace_back(bgpPrefix(i), bgpNextHops(i));
+      toDel.push_back(bgpPrefix(i));
+    }
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    tables->update(ClientID::BGPD, toAdd, {});
+    BENCHMARK_SUSPEND {
+      tables->update(ClientID::BGPD, {}, toDel);
+    }
+  }
+}
+
+BENCHMARK_NAMED_PARAM(ribUpdateLatency, full_1, false, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(ribUpdateLatency, incremental_1, true, 1);
+BENCHMARK_NAMED_PARAM(ribUpdateLatency, full_100, false, 100);
+BENCHMARK_RELATIVE_NAMED_PARAM(ribUpdateLatency, incremental_100, true, 100);
+BENCHMARK_NAMED_PARAM(ribUpdateLatency, full_10k, false, 10000);
+BENCHMARK_RELATIVE_NAMED_PARAM(ribUpdateLatency, incremental_10k, true, 10000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/memory/MallctlHelper.h>
+#include <folly/memory/Malloc.h>
+#include <malloc.h>
+#include "fboss/agent/state/Route.h"
+#include "fboss/agent/state/RouteNextHopEntry.h"
+
+using namespace facebook::fboss;
+
+namespace {
+const AdminDistance kDefaultAdminDistance = AdminDistance::EBGP;
+static constexpr int kNumInterfaces = 32;
+static constexpr int kNumEcmpGroups = 256;
+static constexpr int kEcmpWidth = 8;
+static constexpr int kNumRoutes = 1000000;
+
+size_t allocatedBytes() {
+  if (folly::usingJEMalloc()) {
+    // refresh cached stats
+    uint64_t epoch = 1;
+    folly::mallctlWrite("epoch", epoch);
+    size_t allocated = 0;
+    folly::mallctlRead("stats.allocated", &allocated);
+    return allocated;
+  }
+  return mallinfo2().uordblks;
+}
+
+RoutePrefixV6 prefix(int index) {
+  // 2400:<hi>:<lo>::/48, unique for index < 2^32
+  return RoutePrefixV6(
+      folly::IPAddressV6(fmt::format(
+          "2400:{:x}:{:x}::", (index >> 16) & 0xffff, index & 0xffff)),
+      48);
+}
+
+RouteNextHopSet nextHops(int group, bool resolved) {
+  RouteNextHopSet nhops;
+  for (auto i = 0; i < kEcmpWidth; ++i) {
+    auto intf = (group + i) % kNumInterfaces;
+    folly::IPAddress addr(fmt::format("2401:db00:{:x}::10", intf));
+    if (resolved) {
+      nhops.emplace(ResolvedNextHop(addr, InterfaceID(intf + 1), ECMP_WEIGHT));
+    } else {
+      nhops.emplace(UnresolvedNextHop(addr, ECMP_WEIGHT));
+    }
+  }
+  return nhops;
+}
+} // namespace
+
+/*
+ * Memory held by a table of kNumRoutes resolved routes sharing kNumEcmpGroups
+ * distinct ECMP groups, with the resolved forwarding info of each route
+ * interned (as RIB resolution does) or copied into every route.
+ */
+void routeTableMemory(
+    folly::UserCounters& counters,
+    unsigned iters,
+    bool interned) {
+  std::vector<RouteNextHopEntry> unresolved;
+  std::vector<RouteNextHopEntry> resolved;
+  BENCHMARK_SUSPEND {
+    for (auto group = 0; group < kNumEcmpGroups; ++group) {
+      unresolved.emplace_back(
+          nextHops(group, false /* resolved */), kDefaultAdminDistance);
+      resolved.emplace_back(
+          nextHops(group, true /* resolved */), kDefaultAdminDistance);
+    }
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    std::vector<std::shared_ptr<RouteV6>> routes;
+    auto before = allocatedBytes();
+    routes.reserve(kNumRoutes);
+    for (auto i = 0; i < kNumRoutes; ++i) {
+      auto group = i % kNumEcmpGroups;
+      auto route = std::make_shared<RouteV6>(
+          prefix(i), ClientID::BGPD, unresolved[group]);
+      if (interned) {
+        route->setResolved(resolved[group]);
+      } else {
+        route->template set<switch_state_tags::fwd>(
+            resolved[group].toThrift());
+      }
+      route->publish();
+      routes.push_back(std::move(route));
+    }
+    BENCHMARK_SUSPEND {
+      auto bytes = allocatedBytes() - before;
+      counters["table_mb"] = bytes >> 20;
+      counters["bytes_per_route"] = bytes / kNumRoutes;
+      routes.clear();
+    }
+  }
+}
+
+BENCHMARK_COUNTERS(RouteTableMemoryCopied, counters, iters) {
+  routeTableMemory(counters, iters, false /* interned */);
+}
+
+BENCHMARK_COUNTERS(RouteTableMemoryInterned, counters, iters) {
+  routeTableMemory(counters, iters, true /* interned */);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,145 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/RxPacketDispatcher.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <folly/Conv.h>
+#include <folly/synchronization/Baton.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace facebook::fboss;
+using RxClass = RxPacketDispatcher::RxClass;
+
+namespace {
+std::unique_ptr<MockRxPacket> makePacket(folly::StringPiece hex) {
+  auto pkt = MockRxPacket::fromHex(hex);
+  pkt->padToLength(68);
+  pkt->setSrcPort(PortID(1));
+  pkt->setSrcVlan(VlanID(1));
+  return pkt;
+}
+
+std::unique_ptr<MockRxPacket> lldpPacket() {
+  return makePacket(
+      // dst mac, src mac
+      "01 80 c2 00 00 0e  00 02 00 01 02 03"
+      // 802.1q, VLAN 1
+      "81 00  00 01"
+      // LLDP, chassis ID TLV
+      "88 cc  02 07 04 00 02 00 01 02 03");
+}
+
+std::unique_ptr<MockRxPacket> arpPacket() {
+  return makePacket(
+      // dst mac, src mac
+      "ff ff ff ff ff ff  00 02 00 01 02 03"
+      // ARP, htype: ethernet, ptype: IPv4, hlen: 6, plen: 4
+      "08 06  00 01  08 00  06  04"
+      // ARP Request
+      "00 01"
+      // Sender MAC, sender IP: 10.0.0.15
+      "00 02 00 01 02 03  0a 00 00 0f"
+      // Target MAC, target IP: 10.0.0.1
+      "00 00 00 00 00 00  0a 00 00 01");
+}
+
+std::unique_ptr<MockRxPacket> ipv4Packet(folly::StringPiece l4) {
+  return makePacket(folly::to<std::string>(
+      // dst mac, src mac
+      "00 02 00 00 00 01  00 02 00 01 02 03"
+      // IPv4, version 4, IHL 5, total length, id, flags, TTL 64
+      "08 00  45 00 00 28  00 00 00 00  40",
+      l4));
+}
+
+std::unique_ptr<MockRxPacket> ipv6Packet(folly::StringPiece l4) {
+  return makePacket(folly::to<std::string>(
+      // dst mac, src mac
+      "33 33 ff 00 00 01  00 02 00 01 02 03"
+      // IPv6, version 6, payload length
+      "86 dd  60 00 00 00  00 20",
+      l4));
+}
+
+constexpr auto kIpv6Addrs =
+    // Hop limit, source and destination address
+    " ff"
+    " fe 80 00 00 00 00 00 00 02 02 00 ff fe 01 02 03"
+    " ff 02 00 00 00 00 00 00 00 00 00 01 ff 00 00 01";
+} // namespace
+
+TEST(RxPacketDispatcherTest, classify) {
+  EXPECT_EQ(
+      RxClass::LINK_CONTROL, RxPacketDispatcher::classify(lldpPacket().get()));
+  EXPECT_EQ(
+      RxClass::NEIGHBOR_RESOLUTION,
+      RxPacketDispatcher::classify(arpPacket().get()));
+  // TCP to port 179, checksum, 10.0.0.15 -> 10.0.0.1
+  EXPECT_EQ(
+      RxClass::ROUTING_CONTROL,
+      RxPacketDispatcher::classify(
+          ipv4Packet("06 00 00  0a 00 00 0f  0a 00 00 01  c0 01 00 b3").get()));
+  // UDP to port 179
+  EXPECT_EQ(
+      RxClass::DEFAULT,
+      RxPacketDispatcher::classify(
+          ipv4Packet("11 00 00  0a 00 00 0f  0a 00 00 01  c0 01 00 b3").get()));
+  // TCP from port 179
+  EXPECT_EQ(
+      RxClass::ROUTING_CONTROL,
+      RxPacketDispatcher::classify(
+          ipv6Packet(folly::to<std::string>("06", kIpv6Addrs, " 00 b3 c0 01"))
+              .get()));
+  // ICMPv6 neighbor solicitation
+  EXPECT_EQ(
+      RxClass::NEIGHBOR_RESOLUTION,
+      RxPacketDispatcher::classify(
+          ipv6Packet(folly::to<std::string>("3a", kIpv6Addrs, " 87 00 00 00"))
+              .get()));
+  // ICMPv6 echo request
+  EXPECT_EQ(
+      RxClass::DEFAULT,
+      RxPacketDispatcher::classify(
+          ipv6Packet(folly::to<std::string>("3a", kIpv6Addrs, " 80 00 00 00"))
+              .get()));
+}
+
+TEST(RxPacketDispatcherTest, classifyTruncated) {
+  auto pkt = MockRxPacket::fromHex("00 02 00 00 00 01  00 02 00 01 02 03  86");
+  EXPECT_EQ(RxClass::DEFAULT, RxPacketDispatcher::classify(pkt.get()));
+}
+
+TEST(RxPacketDispatcherTest, dispatchInPriorityOrder) {
+  std::vector<RxClass> handled;
+  folly::Baton<> done;
+  // No packets are dropped, so the dispatcher does not need a SwSwitch
+  RxPacketDispatcher dispatcher(
+      nullptr, [&](std::unique_ptr<RxPacket> pkt) {
+        handled.push_back(RxPacketDispatcher::classify(pkt.get()));
+        if (handled.size() == 3) {
+          done.post();
+        }
+      });
+  EXPECT_TRUE(dispatcher.enqueue(
+      ipv4Packet("11 00 00  0a 00 00 0f  0a 00 00 01  c0 01 00 35")));
+  EXPECT_TRUE(dispatcher.enqueue(arpPacket()));
+  EXPECT_TRUE(dispatcher.enqueue(lldpPacket()));
+  dispatcher.start();
+  done.wait();
+  dispatcher.stop();
+  EXPECT_EQ(
+      std::vector<RxClass>(
+          {RxClass::LINK_CONTROL,
+           RxClass::NEIGHBOR_RESOLUTION,
+           RxClass::DEFAULT}),
+      handled);
+}
@@ -14,6 +14,7 @@
 #include "fboss/agent/FbossHwUpdateError.h"
 #include "fboss/agent/NeighborUpdater.h"
 #include "fboss/agent/PortStats.h"
+#include "fboss/agent/StateObserver.h"
 #include "fboss/agent/SwitchStats.h"
 #include "fboss/agent/state/ArpTable.h"
 #include "fboss/agent/state/Interface.h"
@@ -29,6 +30,8 @@
 #include <folly/MacAddress.h>
 
 #include <algorithm>
+#include <condition_variable>
+#include <mutex>
 
 using namespace facebook::fboss;
 using folly::IPAddressV4;
@@ -283,3 +286,154 @@ TEST_F(SwSwitchTest, overlappingUpdatesWithExit) {
   nonCoaelescingUpdates.join();
   blockingUpdates.join();
 }
+
+namespace {
+class OrderRecordingObserver : public StateObserver {
+ public:
+  OrderRecordingObserver(
+      std::atomic<int>* notifications,
+      bool concurrent,
+      std::vector<std::string> dependencies = {})
+      : notifications_(notifications),
+        concurrent_(concurrent),
+        dependencies_(std::move(dependencies)) {}
+
+  void stateUpdated(const StateDelta& /*delta*/) override {
+    order_ = (*notifications_)++;
+  }
+  bool notifyConcurrently() const override {
+    return concurrent_;
+  }
+  std::vector<std::string> stateObserverDependencies() const override {
+    return dependencies_;
+  }
+  int order() const {
+    return order_;
+  }
+
+ private:
+  std::atomic<int>* notifications_;
+  bool concurrent_;
+  std::vector<std::string> dependencies_;
+  std::atomic<int> order_{-1};
+};
+} // namespace
+
+TEST_F(SwSwitchTest, StateObserverDependencies) {
+  std::atomic<int> notifications{0};
+  OrderRecordingObserver first(&notifications, true /* concurrent */);
+  OrderRecordingObserver second(
+      &notifications, true /* concurrent */, {"first"});
+  OrderRecordingObserver third(
+      &notifications, false /* concurrent */, {"second", "unregistered"});
+  sw->registerStateObserver(&third, "third");
+  sw->registerStateObserver(&second, "second");
+  sw->registerStateObserver(&first, "first");
+
+  sw->updateStateBlocking(
+      "Flap port 1", [](const std::shared_ptr<SwitchState>& state) {
+        std::shared_ptr<SwitchState> newState(state);
+        auto* port = newState->getPorts()->getPortIf(PortID(1)).get();
+        port = port->modify(&newState);
+        port->setOperState(!port->isUp());
+        return newState;
+      });
+  EXPECT_EQ(first.order(), 0);
+  EXPECT_EQ(second.order(), 1);
+  EXPECT_EQ(third.order(), 2);
+
+  sw->unregisterStateObserver(&first);
+  sw->unregisterStateObserver(&second);
+  sw->unregisterStateObserver(&third);
+}
+
+namespace {
+// Lets observers check that they are notified at the same time
+class Rendezvous {
+ public:
+  explicit Rendezvous(int count) : count_(count) {}
+
+  // Returns whether all count observers arrived before the timeout
+  bool arriveAndWait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    ++arrived_;
+    cv_.notify_all();
+    return cv_.wait_for(
+        lock, std::chrono::seconds(5), [this] { return arrived_ >= count_; });
+  }
+
+ private:
+  const int count_;
+  int arrived_{0};
+  std::mutex mutex_;
+  std::condition_variable cv_;
+};
+
+class RendezvousObserver : public OrderRecordingObserver {
+ public:
+  RendezvousObserver(std::atomic<int>* notifications, Rendezvous* rendezvous)
+      : OrderRecordingObserver(notifications, true /* concurrent */),
+        rendezvous_(rendezvous) {}
+
+  void stateUpdated(const StateDelta& delta) override {
+    metOthers_ = rendezvous_->arriveAndWait();
+    OrderRecordingObserver::stateUpdated(delta);
+  }
+  bool metOthers() const {
+    return metOthers_;
+  }
+
+ private:
+  Rendezvous* rendezvous_;
+  std::atomic<bool> metOthers_{false};
+};
+
+class SwSwitchConcurrentObserversTest : public SwSwitchTest {
+ public:
+  void SetUp() override {
+    // The observer thread pool is created along with the switch
+    FLAGS_state_observer_threads = 4;
+    SwSwitchTest::SetUp();
+  }
+
+ private:
+  gflags::FlagSaver flagSaver_;
+};
+} // namespace
+
+TEST_F(SwSwitchConcurrentObserversTest, StateObserverConcurrency) {
+  std::atomic<int> notifications{0};
+  // Independent observers can only all get to the rendezvous if they are
+  // notified concurrently
+  Rendezvous rendezvous(2);
+  RendezvousObserver first(&notifications, &rendezvous);
+  RendezvousObserver second(&notifications, &rendezvous);
+  OrderRecordingObserver third(
+      &notifications, true /* concurrent */, {"first", "second"});
+  OrderRecordingObserver fourth(
+      &notifications, false /* concurrent */, {"third"});
+  sw->registerStateObserver(&fourth, "fourth");
+  sw->registerStateObserver(&third, "third");
+  sw->registerStateObserver(&second, "second");
+  sw->registerStateObserver(&first, "first");
+
+  sw->updateStateBlocking(
+      "Flap port 1", [](const std::shared_ptr<SwitchState>& state) {
+        std::shared_ptr<SwitchState> newState(state);
+        auto* port = newState->getPorts()->getPortIf(PortID(1)).get();
+        port = port->modify(&newState);
+        port->setOperState(!port->isUp());
+        return newState;
+      });
+  EXPECT_TRUE(first.metOthers());
+  EXPECT_TRUE(second.metOthers());
+  EXPECT_LT(first.order(), 2);
+  EXPECT_LT(second.order(), 2);
+  EXPECT_EQ(third.order(), 2);
+  EXPECT_EQ(fourth.order(), 3);
+
+  sw->unregisterStateObserver(&first);
+  sw->unregisterStateObserver(&second);
+  sw->unregisterStateObserver(&third);
+  sw->unregisterStateObserver(&fourth);
+}
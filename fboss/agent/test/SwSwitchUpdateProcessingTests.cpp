@@ -242,3 +242,82 @@ INSTANTIATE_TEST_CASE_P(
     SwSwitchUpdateProcessingTest,
     SwSwitchUpdateProcessingTest,
     ::testing::Values(true, false));
+
+class SwSwitchPipelinedUpdateProcessingTest
+    : public SwSwitchUpdateProcessingTest {
+ public:
+  void SetUp() override {
+    FLAGS_pipelined_state_updates = true;
+    FLAGS_state_update_pipeline_depth = 2;
+    SwSwitchUpdateProcessingTest::SetUp();
+  }
+
+ private:
+  gflags::FlagSaver flagSaver_;
+};
+
+TEST_P(SwSwitchPipelinedUpdateProcessingTest, UpdatesAppliedInOrder) {
+  auto origState = sw->getState();
+  // Each update is prepared on top of the previous one, possibly before the
+  // previous one has been programmed, so deltas must still chain in order
+  std::vector<std::shared_ptr<SwitchState>> states{origState};
+  for (auto i = 0; i < 4; ++i) {
+    auto state = states.back()->clone();
+    state->publish();
+    states.push_back(state);
+  }
+  // Matched by reference, so these must outlive the expectations. Updates
+  // are not HW failure protected, so stateChanged is called for both params.
+  std::vector<StateDelta> expectedDeltas;
+  expectedDeltas.reserve(states.size() - 1);
+  for (size_t i = 1; i < states.size(); ++i) {
+    expectedDeltas.emplace_back(states[i - 1], states[i]);
+  }
+  {
+    testing::InSequence seq;
+    for (size_t i = 1; i < states.size(); ++i) {
+      EXPECT_HW_CALL(
+          sw, stateChanged(Eq(testing::ByRef(expectedDeltas[i - 1]))))
+          .WillOnce(Return(states[i]));
+    }
+  }
+  for (size_t i = 1; i < states.size(); ++i) {
+    auto expectedOld = states[i - 1];
+    auto newState = states[i];
+    sw->updateStateNoCoalescing(
+        "Pipelined update",
+        [expectedOld, newState](const std::shared_ptr<SwitchState>& state) {
+          EXPECT_EQ(state, expectedOld);
+          return newState;
+        });
+  }
+  waitForStateUpdates(sw);
+  EXPECT_EQ(states.back(), sw->getState());
+}
+
+TEST_P(SwSwitchPipelinedUpdateProcessingTest, HwFailureProtectedUpdate) {
+  auto origState = sw->getState();
+  auto newState = bringAllPortsUp(origState->clone());
+  // A rejected protected update drains the pipeline and leaves the applied
+  // state as the base for the next update
+  setStateChangedReturn(origState);
+  EXPECT_THROW(
+      sw->updateStateWithHwFailureProtection(
+          "Reject update",
+          [=](const std::shared_ptr<SwitchState>& /*state*/) {
+            return newState;
+          }),
+      FbossHwUpdateError);
+  EXPECT_EQ(origState, sw->getState());
+  auto stateUpdateFn = [&origState](const std::shared_ptr<SwitchState>& state) {
+    EXPECT_EQ(state, origState);
+    return std::shared_ptr<SwitchState>();
+  };
+  sw->updateState("Noop update", stateUpdateFn);
+  waitForStateUpdates(sw);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    SwSwitchPipelinedUpdateProcessingTest,
+    SwSwitchPipelinedUpdateProcessingTest,
+    ::testing::Values(true, false));
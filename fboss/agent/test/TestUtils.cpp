@@ -431,6 +431,17 @@ unique_ptr<MockPlatform> createMockPlatform(
   return std::move(mock);
 }
 
+unique_ptr<MockPlatform> createMockPlatform(
+    std::unique_ptr<PlatformMapping> platformMapping) {
+  auto mock = make_unique<testing::NiceMock<MockPlatform>>(
+      std::move(platformMapping));
+  cfg::AgentConfig thrift;
+  thrift.sw()->switchSettings()->switchType() = cfg::SwitchType::NPU;
+  auto agentCfg = std::make_unique<AgentConfig>(thrift, "");
+  mock->init(std::move(agentCfg), 0);
+  return std::move(mock);
+}
+
 unique_ptr<HwTestHandle> createTestHandle(
     const shared_ptr<SwitchState>& state,
     SwitchFlags flags) {
@@ -33,6 +33,7 @@ class MockHwSwitch;
 class MockPlatform;
 class MockTunManager;
 class Platform;
+class PlatformMapping;
 class RxPacket;
 class SwitchState;
 class SwSwitch;
@@ -89,6 +90,9 @@ std::unique_ptr<HwTestHandle> createTestHandle(
 std::unique_ptr<MockPlatform> createMockPlatform(
     cfg::SwitchType switchType = cfg::SwitchType::NPU,
     std::optional<int64_t> switchId = std::nullopt);
+// Mock platform with the ports of platformMapping
+std::unique_ptr<MockPlatform> createMockPlatform(
+    std::unique_ptr<PlatformMapping> platformMapping);
 std::unique_ptr<SwSwitch> setupMockSwitchWithoutHW(
     std::unique_ptr<MockPlatform> platform,
     const std::shared_ptr<SwitchState>& state,
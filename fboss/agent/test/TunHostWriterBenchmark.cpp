@@ -0,0 +1,128 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include <folly/io/IOBuf.h>
+#include <folly/io/async/ScopedEventBaseThread.h>
+#include "fboss/agent/TunHostWriter.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <atomic>
+#include <thread>
+
+using namespace facebook::fboss;
+
+/*
+ * Cost on the sending thread of handing a burst of packets to the host, one
+ * write per packet as TunIntf does by default, or queued to a TunHostWriter
+ * with tun_intf_batch_io. A SOCK_SEQPACKET socket pair, drained by a reader
+ * thread, stands in for the tun interface.
+ */
+namespace {
+constexpr size_t kBurstSize = 512;
+constexpr size_t kPktSize = 256;
+
+class TunStandIn {
+ public:
+  TunStandIn() {
+    CHECK_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds_));
+    reader_ = std::thread([this] {
+      char buf[kPktSize];
+      while (recv(fds_[1], buf, sizeof(buf), 0) > 0) {
+        ++received_;
+      }
+    });
+  }
+
+  ~TunStandIn() {
+    shutdown(fds_[0], SHUT_WR);
+    reader_.join();
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+
+  int writeFd() const {
+    return fds_[0];
+  }
+
+  void waitForPackets(size_t count) {
+    while (received_ < count) {
+      std::this_thread::yield();
+    }
+  }
+
+ private:
+  int fds_[2];
+  std::atomic<size_t> received_{0};
+  std::thread reader_;
+};
+
+std::vector<std::unique_ptr<RxPacket>> makeBurst() {
+  std::vector<std::unique_ptr<RxPacket>> pkts;
+  for (size_t i = 0; i < kBurstSize; ++i) {
+    auto buf = folly::IOBuf::create(kPktSize);
+    buf->append(kPktSize);
+    pkts.push_back(std::make_unique<MockRxPacket>(std::move(buf)));
+  }
+  return pkts;
+}
+
+void sendBursts(unsigned iters, bool batched) {
+  std::unique_ptr<TunStandIn> tun;
+  std::unique_ptr<folly::ScopedEventBaseThread> evbThread;
+  std::unique_ptr<TunHostWriter> writer;
+  BENCHMARK_SUSPEND {
+    tun = std::make_unique<TunStandIn>();
+    evbThread = std::make_unique<folly::ScopedEventBaseThread>();
+    writer = std::make_unique<TunHostWriter>(
+        evbThread->getEventBase(), tun->writeFd(), "tun.bench", kBurstSize);
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    std::vector<std::unique_ptr<RxPacket>> pkts;
+    BENCHMARK_SUSPEND {
+      pkts = makeBurst();
+    }
+    for (auto& pkt : pkts) {
+      if (batched) {
+        writer->enqueue(std::move(pkt));
+      } else {
+        auto buf = pkt->buf();
+        folly::doNotOptimizeAway(
+            write(tun->writeFd(), buf->data(), buf->length()));
+      }
+    }
+    BENCHMARK_SUSPEND {
+      tun->waitForPackets((iter + 1) * kBurstSize);
+    }
+  }
+  BENCHMARK_SUSPEND {
+    evbThread->getEventBase()->runInEventBaseThreadAndWait(
+        [&writer]() { writer.reset(); });
+    evbThread.reset();
+    tun.reset();
+  }
+}
+} // namespace
+
+BENCHMARK(TunHostWritePerPacket, iters) {
+  sendBursts(iters, false);
+}
+
+BENCHMARK_RELATIVE(TunHostWriteBatched, iters) {
+  sendBursts(iters, true);
+}
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
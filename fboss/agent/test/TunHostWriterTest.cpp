@@ -0,0 +1,122 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+#include "fboss/agent/TunHostWriter.h"
+#include "fboss/agent/hw/mock/MockRxPacket.h"
+
+#include <fcntl.h>
+#include <folly/io/IOBuf.h>
+#include <gtest/gtest.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+using namespace facebook::fboss;
+
+namespace {
+constexpr size_t kQueueSize = 4;
+
+std::unique_ptr<RxPacket> makePacket(uint8_t id) {
+  auto buf = folly::IOBuf::create(64);
+  memset(buf->writableData(), id, 64);
+  buf->append(64);
+  return std::make_unique<MockRxPacket>(std::move(buf));
+}
+
+// A SOCK_SEQPACKET socket pair keeps packet boundaries, like a tun fd
+class TunHostWriterTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    ASSERT_EQ(0, socketpair(AF_UNIX, SOCK_SEQPACKET, 0, fds_));
+    writer_ = std::make_unique<TunHostWriter>(
+        &evb_, fds_[0], "tun.test", kQueueSize);
+  }
+
+  void TearDown() override {
+    writer_.reset();
+    close(fds_[0]);
+    close(fds_[1]);
+  }
+
+  std::vector<uint8_t> readPackets() {
+    std::vector<uint8_t> ids;
+    uint8_t buf[128];
+    int ret;
+    while ((ret = recv(fds_[1], buf, sizeof(buf), MSG_DONTWAIT)) > 0) {
+      EXPECT_EQ(64, ret);
+      ids.push_back(buf[0]);
+    }
+    return ids;
+  }
+
+ protected:
+  folly::EventBase evb_;
+  int fds_[2];
+  std::unique_ptr<TunHostWriter> writer_;
+};
+} // namespace
+
+TEST_F(TunHostWriterTest, writeBatch) {
+  for (uint8_t id = 1; id <= kQueueSize; ++id) {
+    EXPECT_TRUE(writer_->enqueue(makePacket(id)));
+  }
+  EXPECT_EQ(kQueueSize, writer_->queueDepth());
+  // Nothing is written until the event base runs the flush
+  EXPECT_TRUE(readPackets().empty());
+  evb_.loopOnce();
+  EXPECT_EQ(0, writer_->queueDepth());
+  EXPECT_EQ(std::vector<uint8_t>({1, 2, 3, 4}), readPackets());
+
+  // A later burst schedules another flush
+  EXPECT_TRUE(writer_->enqueue(makePacket(5)));
+  evb_.loopOnce();
+  EXPECT_EQ(std::vector<uint8_t>({5}), readPackets());
+}
+
+TEST_F(TunHostWriterTest, dropWhenFull) {
+  for (uint8_t id = 1; id <= kQueueSize; ++id) {
+    EXPECT_TRUE(writer_->enqueue(makePacket(id)));
+  }
+  EXPECT_FALSE(writer_->enqueue(makePacket(kQueueSize + 1)));
+  EXPECT_EQ(kQueueSize, writer_->flush());
+  EXPECT_EQ(std::vector<uint8_t>({1, 2, 3, 4}), readPackets());
+}
+
+TEST_F(TunHostWriterTest, noFlushAfterDestroy) {
+  EXPECT_TRUE(writer_->enqueue(makePacket(1)));
+  writer_.reset();
+  evb_.loopOnce();
+  EXPECT_TRUE(readPackets().empty());
+}
+
+TEST_F(TunHostWriterTest, resumeWhenWritable) {
+  // Fill up the socket, so that writes fail with EAGAIN
+  ASSERT_EQ(0, fcntl(fds_[0], F_SETFL, fcntl(fds_[0], F_GETFL) | O_NONBLOCK));
+  constexpr uint8_t kFillerId = 0xff;
+  auto filler = makePacket(kFillerId);
+  while (write(fds_[0], filler->buf()->data(), filler->buf()->length()) > 0) {
+  }
+  ASSERT_TRUE(errno == EAGAIN || errno == EWOULDBLOCK);
+
+  EXPECT_TRUE(writer_->enqueue(makePacket(1)));
+  EXPECT_TRUE(writer_->enqueue(makePacket(2)));
+  // The batch stops at the first packet, which is held by the writer
+  evb_.loopOnce();
+  EXPECT_EQ(1, writer_->queueDepth());
+
+  auto ids = readPackets();
+  EXPECT_TRUE(std::all_of(
+      ids.begin(), ids.end(), [](uint8_t id) { return id == kFillerId; }));
+  // Once the socket is writable again, the packets are written in order
+  evb_.loopOnce();
+  EXPECT_EQ(0, writer_->queueDepth());
+  EXPECT_EQ(std::vector<uint8_t>({1, 2}), readPackets());
+}
@@ -15,6 +15,10 @@
 #include "fboss/agent/SwSwitch.h"
 #include "fboss/agent/gen-cpp2/switch_config_types.h"
 #include "fboss/agent/hw/mock/MockPlatform.h"
+#include "fboss/agent/state/Interface.h"
+#include "fboss/agent/state/StateDelta.h"
+#include "fboss/agent/state/SwitchState.h"
+#include "fboss/agent/state/Vlan.h"
 #include "fboss/agent/test/HwTestHandle.h"
 #include "fboss/agent/test/MockTunManager.h"
 #include "fboss/agent/test/TestUtils.h"
@@ -23,6 +27,33 @@ using namespace facebook::fboss;
 
 using ::testing::_;
 
+namespace {
+std::shared_ptr<SwitchState> withArpEntry(
+    const std::shared_ptr<SwitchState>& state) {
+  auto newState = state->clone();
+  auto vlan = state->getVlans()->getVlan(VlanID(1));
+  auto arpTable = vlan->getArpTable()->modify(VlanID(1), &newState);
+  arpTable->addEntry(
+      folly::IPAddressV4("10.0.0.22"),
+      folly::MacAddress("02:09:00:00:00:22"),
+      PortDescriptor(PortID(1)),
+      InterfaceID(1),
+      NeighborState::REACHABLE);
+  newState->publish();
+  return newState;
+}
+
+std::shared_ptr<SwitchState> withInterfaceMtu(
+    const std::shared_ptr<SwitchState>& state,
+    int mtu) {
+  auto newState = state->clone();
+  auto intf = state->getInterfaces()->getInterface(InterfaceID(1));
+  intf->modify(&newState)->setMtu(mtu);
+  newState->publish();
+  return newState;
+}
+} // namespace
+
 TEST(TunInterfacesTest, Initialization) {
   auto sw = setupMockSwitchWithoutHW(
       createMockPlatform(), nullptr, SwitchFlags::ENABLE_TUN);
@@ -36,3 +67,41 @@ TEST(TunInterfacesTest, Initialization) {
   // event base. So wait for pending operations there to complete
   waitForBackgroundThread(sw.get());
 }
+
+TEST(TunInterfacesTest, SyncOnlyOnInterfaceChanges) {
+  auto state = testStateA();
+  state->publish();
+
+  // Neighbor changes don't affect tun interfaces
+  auto neighborState = withArpEntry(state);
+  EXPECT_FALSE(TunManager::isSyncNeeded(StateDelta(state, neighborState)));
+
+  auto mtuState = withInterfaceMtu(state, 9000);
+  EXPECT_TRUE(TunManager::isSyncNeeded(StateDelta(state, mtuState)));
+
+  // Interface statuses are derived from port statuses
+  auto portsUpState = bringAllPortsUp(state);
+  EXPECT_TRUE(TunManager::isSyncNeeded(StateDelta(state, portsUpState)));
+}
+
+TEST(TunInterfacesTest, CoalesceSyncs) {
+  auto sw = setupMockSwitchWithoutHW(
+      createMockPlatform(), nullptr, SwitchFlags::ENABLE_TUN);
+  auto tunMgr = dynamic_cast<MockTunManager*>(sw->getTunManager());
+  ASSERT_NE(nullptr, tunMgr);
+
+  auto state = testStateA();
+  state->publish();
+  std::vector<std::shared_ptr<SwitchState>> states{state};
+  for (auto mtu : {9000, 9001, 9002}) {
+    states.push_back(withInterfaceMtu(states.back(), mtu));
+  }
+  // Only the last of a burst of updates is synced
+  EXPECT_CALL(*tunMgr, sync(states.back())).Times(1);
+  sw->getBackgroundEvb()->runInEventBaseThreadAndWait([&]() {
+    for (size_t i = 1; i < states.size(); ++i) {
+      tunMgr->TunManager::stateUpdated(StateDelta(states[i - 1], states[i]));
+    }
+  });
+  waitForBackgroundThread(sw.get());
+}
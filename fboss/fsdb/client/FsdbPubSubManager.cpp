@@ -9,6 +9,9 @@
 #include "FsdbStreamClient.h"
 #include "fboss/fsdb/client/FsdbDeltaPublisher.h"
 #include "fboss/fsdb/client/FsdbStatePublisher.h"
+#include "fboss/fsdb/common/StatsColumns.h"
+
+#include <map>
 
 namespace {
 using namespace facebook::fboss::fsdb;
@@ -50,6 +53,32 @@ std::string toSubscriptionStr(
       ":/",
       extendedPathsStr(paths));
 }
+
+// Stat deltas may carry counters packed by column, expand them so that
+// subscribers only see OperDeltaUnits
+FsdbDeltaSubscriber::FsdbOperDeltaUpdateCb expandStatsColumns(
+    FsdbDeltaSubscriber::FsdbOperDeltaUpdateCb operDeltaCb) {
+  auto decoder = std::make_shared<StatsColumnDecoder>();
+  return [decoder, operDeltaCb = std::move(operDeltaCb)](OperDelta&& delta) {
+    decoder->expand(delta);
+    operDeltaCb(std::move(delta));
+  };
+}
+
+FsdbExtDeltaSubscriber::FsdbOperDeltaUpdateCb expandStatsColumns(
+    FsdbExtDeltaSubscriber::FsdbOperDeltaUpdateCb operDeltaCb) {
+  // Columns are numbered per publisher, keep them apart by changed path
+  auto decoders = std::make_shared<
+      std::map<std::vector<std::string>, StatsColumnDecoder>>();
+  return [decoders, operDeltaCb = std::move(operDeltaCb)](
+             OperSubDeltaUnit&& deltaUnit) {
+    for (auto& change : *deltaUnit.changes()) {
+      (*decoders)[*change.path()->path()].expand(*change.delta());
+    }
+    operDeltaCb(std::move(deltaUnit));
+  };
+}
+
 std::vector<ExtendedOperPath> toExtendedOperPath(
     const std::vector<std::vector<std::string>>& paths) {
   std::vector<ExtendedOperPath> extPaths;
@@ -282,7 +311,7 @@ void FsdbPubSubManager::addStatDeltaSubscription(
   addSubscriptionImpl<FsdbDeltaSubscriber>(
       subscribePath,
       stateChangeCb,
-      operDeltaCb,
+      expandStatsColumns(std::move(operDeltaCb)),
       true /*subscribeStat*/,
       FsdbStreamClient::ServerOptions(fsdbHost, fsdbPort));
 }
@@ -338,7 +367,7 @@ void FsdbPubSubManager::addStatDeltaSubscription(
   addSubscriptionImpl<FsdbExtDeltaSubscriber>(
       toExtendedOperPath(subscribePaths),
       stateChangeCb,
-      operDeltaCb,
+      expandStatsColumns(std::move(operDeltaCb)),
       true /*subscribeStat*/,
       FsdbStreamClient::ServerOptions(fsdbHost, fsdbPort));
 }
@@ -383,6 +412,19 @@ void FsdbPubSubManager::addStatePathSubscription(
       std::move(serverOptions));
 }
 
+void FsdbPubSubManager::addStateDeltaSubscription(
+    const MultiPath& subscribePaths,
+    FsdbStreamClient::FsdbStreamStateChangeCb stateChangeCb,
+    FsdbExtDeltaSubscriber::FsdbOperDeltaUpdateCb operDeltaCb,
+    FsdbStreamClient::ServerOptions&& serverOptions) {
+  addSubscriptionImpl<FsdbExtDeltaSubscriber>(
+      toExtendedOperPath(subscribePaths),
+      stateChangeCb,
+      operDeltaCb,
+      false /*subscribeStat*/,
+      std::move(serverOptions));
+}
+
 template <typename SubscriberT, typename PathElement>
 void FsdbPubSubManager::addSubscriptionImpl(
     const std::vector<PathElement>& subscribePath,
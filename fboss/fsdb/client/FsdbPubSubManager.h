@@ -123,6 +123,11 @@ class FsdbPubSubManager {
       FsdbStreamClient::FsdbStreamStateChangeCb stateChangeCb,
       FsdbExtStateSubscriber::FsdbOperStateUpdateCb operStateCb,
       FsdbStreamClient::ServerOptions&& serverOptions);
+  void addStateDeltaSubscription(
+      const MultiPath& subscribePaths,
+      FsdbStreamClient::FsdbStreamStateChangeCb stateChangeCb,
+      FsdbExtDeltaSubscriber::FsdbOperDeltaUpdateCb operDeltaCb,
+      FsdbStreamClient::ServerOptions&& serverOptions);
 
   /* Subscriber remove APIs */
   void removeStateDeltaSubscription(
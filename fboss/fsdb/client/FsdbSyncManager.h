@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include <fboss/fsdb/common/Flags.h>
 #include <fboss/fsdb/common/Utils.h>
 #include <fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h>
 #include <fboss/thrift_cow/visitors/DeltaVisitor.h>
@@ -13,6 +14,7 @@
 #include <folly/io/async/EventBase.h>
 #include <atomic>
 #include <memory>
+#include <optional>
 
 namespace facebook::fboss::fsdb {
 
@@ -47,6 +49,9 @@ class FsdbSyncManager {
           processDelta(oldState, newState);
         }) {
     CHECK(pubSubMr);
+    if (isStats_ && publishDeltas_ && FLAGS_publish_stats_columns) {
+      statsColumns_.emplace(basePath_, FLAGS_stats_columns_schema_interval);
+    }
     // make sure publisher is not already created for shared pubSubMgr
     if (publishDeltas_) {
       CHECK(!(pubSubMgr_->getDeltaPublisher(isStats)));
@@ -143,6 +148,10 @@ class FsdbSyncManager {
   void doInitialSync() {
     CHECK(storage_.getEventBase()->isInEventBaseThread());
     const auto currentState = storage_.getState();
+    if (statsColumns_) {
+      // Subscribers get the columns again from the full sync onwards
+      statsColumns_->reset();
+    }
     if (publishDeltas_) {
       auto deltaUnit = buildOperDeltaUnit(
           basePath_,
@@ -165,28 +174,11 @@ class FsdbSyncManager {
   void publishDelta(
       const std::shared_ptr<CowState>& oldState,
       const std::shared_ptr<CowState>& newState) {
-    std::vector<OperDeltaUnit> deltas;
-    auto processChange = [this, &deltas](
-                             const std::vector<std::string>& path,
-                             auto oldNode,
-                             auto newNode,
-                             thrift_cow::DeltaElemTag /* visitTag */) {
-      std::vector<std::string> fullPath;
-      fullPath.reserve(basePath_.size() + path.size());
-      fullPath.insert(fullPath.end(), basePath_.begin(), basePath_.end());
-      fullPath.insert(fullPath.end(), path.begin(), path.end());
-      // TODO: metadata
-      deltas.push_back(
-          buildOperDeltaUnit(fullPath, oldNode, newNode, OperProtocol::BINARY));
-    };
-
-    thrift_cow::RootDeltaVisitor::visit(
+    publish(buildOperDelta(
+        basePath_,
         oldState,
         newState,
-        thrift_cow::DeltaVisitMode::MINIMAL,
-        std::move(processChange));
-
-    publish(createDelta(std::move(deltas)));
+        statsColumns_ ? &*statsColumns_ : nullptr));
   }
 
   void publishPath(const std::shared_ptr<CowState>& newState) {
@@ -226,6 +218,7 @@ class FsdbSyncManager {
   std::vector<std::string> basePath_;
   bool isStats_;
   bool publishDeltas_;
+  std::optional<StatsColumnEncoder> statsColumns_;
   CowStorageManager storage_;
   std::atomic_bool readyForPublishing_ = false;
 };
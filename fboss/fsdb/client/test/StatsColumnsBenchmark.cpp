@@ -0,0 +1,128 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/gen-cpp2/agent_stats_fatal_types.h"
+#include "fboss/agent/gen-cpp2/agent_stats_types.h"
+#include "fboss/fsdb/common/StatsColumns.h"
+#include "fboss/fsdb/common/Utils.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+
+#include <iostream>
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::fsdb;
+
+namespace {
+using AgentStatsNode = thrift_cow::ThriftStructNode<AgentStats>;
+
+constexpr auto kNumQueues = 8;
+// Benchmark iterations cycle through these, wrapping around to the first
+constexpr auto kNumIntervals = 8;
+const std::vector<std::string> kBasePath{"agent"};
+
+template <typename T>
+void grow(T& counter, uint64_t rate) {
+  counter += rate + folly::Random::rand64(rate);
+}
+
+/*
+ * Port stats of consecutive collection intervals, every counter grows by a
+ * random amount each interval like on a switch passing traffic.
+ */
+std::vector<std::shared_ptr<AgentStatsNode>> makeIntervals(
+    int numIntervals,
+    int numPorts) {
+  std::vector<std::shared_ptr<AgentStatsNode>> intervals;
+  AgentStats stats;
+  for (auto interval = 0; interval < numIntervals; ++interval) {
+    for (auto port = 0; port < numPorts; ++port) {
+      auto& portStats =
+          stats.hwPortStats()[folly::to<std::string>("eth1/", port, "/1")];
+      grow(*portStats.inBytes_(), 1'000'000'000);
+      grow(*portStats.inUnicastPkts_(), 1'000'000);
+      grow(*portStats.inMulticastPkts_(), 1'000);
+      grow(*portStats.inBroadcastPkts_(), 100);
+      grow(*portStats.inDiscards_(), 10);
+      grow(*portStats.inErrors_(), 10);
+      grow(*portStats.outBytes_(), 1'000'000'000);
+      grow(*portStats.outUnicastPkts_(), 1'000'000);
+      grow(*portStats.outMulticastPkts_(), 1'000);
+      grow(*portStats.outBroadcastPkts_(), 100);
+      grow(*portStats.outDiscards_(), 10);
+      grow(*portStats.outCongestionDiscardPkts_(), 10);
+      grow(*portStats.fecCorrectableErrors(), 1'000);
+      portStats.timestamp_() = interval;
+      for (auto queue = 0; queue < kNumQueues; ++queue) {
+        grow(portStats.queueOutBytes_()[queue], 100'000'000);
+        grow(portStats.queueOutPackets_()[queue], 100'000);
+        grow(portStats.queueOutDiscardBytes_()[queue], 1'000);
+        grow(portStats.queueWatermarkBytes_()[queue], 10'000);
+      }
+    }
+    intervals.push_back(std::make_shared<AgentStatsNode>(stats));
+  }
+  return intervals;
+}
+
+// Size of the delta on the wire
+size_t publishDelta(
+    const std::shared_ptr<AgentStatsNode>& oldStats,
+    const std::shared_ptr<AgentStatsNode>& newStats,
+    StatsColumnEncoder* statsColumns) {
+  auto delta = buildOperDelta(kBasePath, oldStats, newStats, statsColumns);
+  return apache::thrift::CompactSerializer::serialize<std::string>(delta)
+      .size();
+}
+
+void publishIntervals(unsigned iters, int numPorts, bool useColumns) {
+  std::vector<std::shared_ptr<AgentStatsNode>> intervals;
+  std::optional<StatsColumnEncoder> statsColumns;
+  BENCHMARK_SUSPEND {
+    intervals = makeIntervals(kNumIntervals, numPorts);
+    if (useColumns) {
+      statsColumns.emplace(kBasePath);
+      // Column paths are only sent in the first interval
+      publishDelta(intervals[0], intervals[1], &*statsColumns);
+    }
+  }
+  size_t bytes = 0;
+  for (unsigned iter = 1; iter <= iters; ++iter) {
+    bytes += publishDelta(
+        intervals[iter % kNumIntervals],
+        intervals[(iter + 1) % kNumIntervals],
+        statsColumns ? &*statsColumns : nullptr);
+  }
+  folly::doNotOptimizeAway(bytes);
+}
+} // namespace
+
+void perLeafDeltaUnits(unsigned iters, int numPorts) {
+  publishIntervals(iters, numPorts, false);
+}
+
+void statsColumns(unsigned iters, int numPorts) {
+  publishIntervals(iters, numPorts, true);
+}
+
+BENCHMARK_NAMED_PARAM(perLeafDeltaUnits, 512_ports, 512);
+BENCHMARK_RELATIVE_NAMED_PARAM(statsColumns, 512_ports, 512);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+
+  auto intervals = makeIntervals(3, 512);
+  StatsColumnEncoder encoder(kBasePath);
+  auto firstBytes = publishDelta(intervals[0], intervals[1], &encoder);
+  std::cout << "Bytes per interval for 512 ports:"
+            << "\n  per leaf delta units: "
+            << publishDelta(intervals[1], intervals[2], nullptr)
+            << "\n  stats columns: "
+            << publishDelta(intervals[1], intervals[2], &encoder)
+            << " (" << firstBytes << " with column paths)" << std::endl;
+
+  folly::runBenchmarks();
+  return 0;
+}
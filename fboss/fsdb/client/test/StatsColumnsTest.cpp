@@ -0,0 +1,157 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/agent/gen-cpp2/agent_stats_fatal_types.h"
+#include "fboss/agent/gen-cpp2/agent_stats_types.h"
+#include "fboss/fsdb/common/StatsColumns.h"
+#include "fboss/fsdb/common/Utils.h"
+#include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
+
+#include <folly/String.h>
+#include <gtest/gtest.h>
+
+#include <map>
+
+namespace facebook::fboss::fsdb::test {
+
+namespace {
+using AgentStatsNode = thrift_cow::ThriftStructNode<AgentStats>;
+
+const std::vector<std::string> kBasePath{"agent"};
+
+std::shared_ptr<AgentStatsNode> makeStats(int64_t counter) {
+  AgentStats stats;
+  for (auto port : {"eth1/1/1", "eth1/2/1"}) {
+    auto& portStats = stats.hwPortStats()[port];
+    portStats.inBytes_() = counter;
+    portStats.outBytes_() = 1000;
+    portStats.queueOutBytes_()[0] = counter * 2;
+    portStats.portName_() = folly::to<std::string>(port, "_", counter);
+  }
+  return std::make_shared<AgentStatsNode>(stats);
+}
+
+using Units =
+    std::map<std::string, std::pair<std::optional<std::string>, std::string>>;
+
+Units getUnits(const OperDelta& delta) {
+  Units units;
+  for (const auto& unit : *delta.changes()) {
+    std::optional<std::string> oldState;
+    if (unit.oldState()) {
+      oldState = unit.oldState()->toStdString();
+    }
+    units[folly::join('/', *unit.path()->raw())] = {
+        oldState, unit.newState()->toStdString()};
+  }
+  return units;
+}
+} // namespace
+
+TEST(StatsColumnsTest, expandToDeltaUnits) {
+  StatsColumnEncoder encoder(kBasePath);
+  StatsColumnDecoder decoder;
+  auto stats1 = makeStats(100);
+  auto stats2 = makeStats(150);
+  auto stats3 = makeStats(120);
+
+  auto delta = buildOperDelta(kBasePath, stats1, stats2, &encoder);
+  // Port names are not counters
+  EXPECT_EQ(2, delta.changes()->size());
+  ASSERT_TRUE(delta.statsColumns());
+  EXPECT_EQ(0, *delta.statsColumns()->firstNewColumn());
+  EXPECT_EQ(4, delta.statsColumns()->newColumns()->size());
+
+  decoder.expand(delta);
+  EXPECT_FALSE(delta.statsColumns());
+  EXPECT_EQ(
+      getUnits(buildOperDelta(kBasePath, stats1, stats2)), getUnits(delta));
+
+  // Counters going down are sent as negative differences, with no new paths
+  delta = buildOperDelta(kBasePath, stats2, stats3, &encoder);
+  ASSERT_TRUE(delta.statsColumns());
+  EXPECT_EQ(4, *delta.statsColumns()->firstNewColumn());
+  EXPECT_TRUE(delta.statsColumns()->newColumns()->empty());
+  decoder.expand(delta);
+  EXPECT_EQ(
+      getUnits(buildOperDelta(kBasePath, stats2, stats3)), getUnits(delta));
+}
+
+TEST(StatsColumnsTest, noChangedCounters) {
+  StatsColumnEncoder encoder(kBasePath);
+  auto stats = makeStats(100);
+  auto delta = buildOperDelta(kBasePath, stats, makeStats(100), &encoder);
+  EXPECT_TRUE(delta.changes()->empty());
+  EXPECT_FALSE(delta.statsColumns());
+}
+
+TEST(StatsColumnsTest, resetStartsNewSchema) {
+  StatsColumnEncoder encoder(kBasePath);
+  StatsColumnDecoder decoder;
+  auto stats1 = makeStats(100);
+  auto stats2 = makeStats(150);
+  auto delta = buildOperDelta(kBasePath, stats1, stats2, &encoder);
+  auto schemaId = *delta.statsColumns()->schemaId();
+  decoder.expand(delta);
+
+  encoder.reset();
+  delta = buildOperDelta(kBasePath, stats2, stats1, &encoder);
+  EXPECT_NE(schemaId, *delta.statsColumns()->schemaId());
+  EXPECT_EQ(0, *delta.statsColumns()->firstNewColumn());
+  decoder.expand(delta);
+  EXPECT_EQ(6, delta.changes()->size());
+}
+
+TEST(StatsColumnsTest, counterChangedOutsideColumn) {
+  StatsColumnEncoder encoder(kBasePath);
+  StatsColumnDecoder decoder;
+  auto stats1 = makeStats(100);
+  auto stats2 = makeStats(150);
+  auto delta = buildOperDelta(kBasePath, stats1, stats2, &encoder);
+  decoder.expand(delta);
+
+  // The counters were last published as 150 in their columns, a difference
+  // from 100 would be added to the wrong value
+  auto stats3 = makeStats(120);
+  delta = buildOperDelta(kBasePath, stats1, stats3, &encoder);
+  EXPECT_FALSE(delta.statsColumns());
+  EXPECT_EQ(
+      getUnits(buildOperDelta(kBasePath, stats1, stats3)), getUnits(delta));
+}
+
+TEST(StatsColumnsTest, subscribeAfterColumnsStarted) {
+  StatsColumnEncoder encoder(kBasePath, 2);
+  auto stats1 = makeStats(100);
+  auto stats2 = makeStats(150);
+  buildOperDelta(kBasePath, stats1, stats2, &encoder);
+  auto delta = buildOperDelta(kBasePath, stats2, stats1, &encoder);
+
+  // Subscriber did not see the first delta, defining the columns
+  StatsColumnDecoder decoder;
+  decoder.expand(delta);
+  EXPECT_FALSE(delta.statsColumns());
+  EXPECT_EQ(2, delta.changes()->size());
+
+  // Columns start over after two deltas
+  delta = buildOperDelta(kBasePath, stats1, stats2, &encoder);
+  EXPECT_EQ(0, *delta.statsColumns()->firstNewColumn());
+  decoder.expand(delta);
+  EXPECT_EQ(
+      getUnits(buildOperDelta(kBasePath, stats1, stats2)), getUnits(delta));
+}
+
+TEST(StatsColumnsTest, truncatedColumns) {
+  StatsColumnEncoder encoder(kBasePath);
+  StatsColumnDecoder decoder;
+  auto delta =
+      buildOperDelta(kBasePath, makeStats(100), makeStats(150), &encoder);
+  auto& values = *delta.statsColumns()->values();
+  values.resize(values.size() - 1);
+  try {
+    decoder.expand(delta);
+    FAIL() << "Expected FsdbException";
+  } catch (const FsdbException& ex) {
+    EXPECT_EQ(FsdbErrorCode::INVALID_STATS_COLUMNS, *ex.errorCode_ref());
+  }
+}
+
+} // namespace facebook::fboss::fsdb::test
@@ -16,3 +16,12 @@ DEFINE_bool(
     subscribe_to_stats_from_fsdb,
     false,
     "Whether to subscribe to stats from fsdb");
+DEFINE_bool(
+    publish_stats_columns,
+    false,
+    "Whether to pack changed counters by column when publishing stat deltas");
+DEFINE_int32(
+    stats_columns_schema_interval,
+    60,
+    "Number of stat deltas after which new stats columns are started, so "
+    "subscribers that missed the start of the previous ones decode them again");
@@ -8,3 +8,5 @@ DECLARE_int32(fsdbPort);
 DECLARE_bool(publish_stats_to_fsdb);
 DECLARE_bool(publish_state_to_fsdb);
 DECLARE_bool(subscribe_to_stats_from_fsdb);
+DECLARE_bool(publish_stats_columns);
+DECLARE_int32(stats_columns_schema_interval);
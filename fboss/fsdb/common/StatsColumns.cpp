@@ -0,0 +1,187 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#include "fboss/fsdb/common/StatsColumns.h"
+
+#include "fboss/fsdb/if/gen-cpp2/fsdb_common_types.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+
+#include <folly/Random.h>
+#include <folly/Varint.h>
+#include <folly/hash/Hash.h>
+#include <folly/logging/xlog.h>
+
+namespace facebook::fboss::fsdb {
+
+namespace {
+
+void appendVarint(std::string& out, int64_t value) {
+  uint8_t buf[folly::kMaxVarintLength64];
+  auto len = folly::encodeVarint(folly::encodeZigZag(value), buf);
+  out.append(reinterpret_cast<const char*>(buf), len);
+}
+
+// Counters may wrap, keep the arithmetic unsigned
+int64_t difference(int64_t value, int64_t last) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(value) - static_cast<uint64_t>(last));
+}
+
+int64_t sum(int64_t last, int64_t diff) {
+  return static_cast<int64_t>(
+      static_cast<uint64_t>(last) + static_cast<uint64_t>(diff));
+}
+
+[[noreturn]] void throwInvalidColumns(const std::string& message) {
+  FsdbException ex;
+  ex.errorCode_ref() = FsdbErrorCode::INVALID_STATS_COLUMNS;
+  ex.message_ref() = message;
+  throw ex;
+}
+
+} // namespace
+
+namespace detail {
+
+size_t PathHash::operator()(const std::vector<std::string>& path) const {
+  return folly::hash::hash_range(path.begin(), path.end());
+}
+
+} // namespace detail
+
+StatsColumnEncoder::StatsColumnEncoder(
+    const std::vector<std::string>& basePath,
+    uint32_t schemaInterval)
+    : basePath_(basePath), schemaInterval_(schemaInterval) {
+  reset();
+}
+
+void StatsColumnEncoder::reset() {
+  schemaId_ = folly::Random::rand64();
+  schemaBatches_ = 0;
+  columnIds_.clear();
+  lastValues_.clear();
+  firstNewColumn_ = 0;
+  newColumns_.clear();
+  newColumnValues_.clear();
+  values_.clear();
+  lastColumn_ = 0;
+}
+
+bool StatsColumnEncoder::addChange(
+    const std::vector<std::string>& path,
+    int64_t oldValue,
+    int64_t newValue) {
+  auto [it, added] = columnIds_.try_emplace(path, lastValues_.size());
+  auto column = it->second;
+  if (added) {
+    OperPath fullPath;
+    fullPath.raw()->reserve(basePath_.size() + path.size());
+    fullPath.raw()->insert(
+        fullPath.raw()->end(), basePath_.begin(), basePath_.end());
+    fullPath.raw()->insert(fullPath.raw()->end(), path.begin(), path.end());
+    newColumns_.push_back(std::move(fullPath));
+    newColumnValues_.push_back(oldValue);
+    lastValues_.push_back(oldValue);
+  } else if (lastValues_[column] != oldValue) {
+    // Subscribers would add the difference to a stale value
+    return false;
+  }
+  appendVarint(
+      values_,
+      static_cast<int64_t>(column) - static_cast<int64_t>(lastColumn_));
+  appendVarint(values_, difference(newValue, oldValue));
+  lastColumn_ = column;
+  lastValues_[column] = newValue;
+  return true;
+}
+
+std::optional<OperStatsColumns> StatsColumnEncoder::finishBatch() {
+  if (values_.empty()) {
+    return std::nullopt;
+  }
+  OperStatsColumns columns;
+  columns.schemaId() = schemaId_;
+  columns.firstNewColumn() = firstNewColumn_;
+  columns.newColumns() = std::move(newColumns_);
+  columns.newColumnValues() = std::move(newColumnValues_);
+  columns.values() = folly::fbstring(values_.data(), values_.size());
+  if (schemaInterval_ && ++schemaBatches_ >= schemaInterval_) {
+    reset();
+    return columns;
+  }
+  firstNewColumn_ = lastValues_.size();
+  newColumns_.clear();
+  newColumnValues_.clear();
+  values_.clear();
+  lastColumn_ = 0;
+  return columns;
+}
+
+void StatsColumnDecoder::expand(OperDelta& delta) {
+  if (!delta.statsColumns()) {
+    return;
+  }
+  const auto& columns = *delta.statsColumns();
+  if (*columns.firstNewColumn() == 0) {
+    // Publisher started new columns
+    schemaId_ = *columns.schemaId();
+    columns_.clear();
+    lastValues_.clear();
+  } else if (
+      schemaId_ != *columns.schemaId() ||
+      *columns.firstNewColumn() != static_cast<int32_t>(columns_.size())) {
+    XLOG(DBG2) << "Dropping stats columns " << *columns.firstNewColumn()
+               << " onwards of schema " << *columns.schemaId()
+               << ", waiting for new columns";
+    schemaId_.reset();
+    columns_.clear();
+    lastValues_.clear();
+    delta.statsColumns().reset();
+    return;
+  }
+  if (columns.newColumns()->size() != columns.newColumnValues()->size()) {
+    throwInvalidColumns("Stats columns without their values");
+  }
+  columns_.insert(
+      columns_.end(),
+      columns.newColumns()->begin(),
+      columns.newColumns()->end());
+  lastValues_.insert(
+      lastValues_.end(),
+      columns.newColumnValues()->begin(),
+      columns.newColumnValues()->end());
+
+  auto protocol = *delta.protocol();
+  auto values = folly::ByteRange(folly::StringPiece(*columns.values()));
+  int64_t column = 0;
+  while (!values.empty()) {
+    auto columnDiff = folly::tryDecodeVarint(values);
+    if (!columnDiff) {
+      throwInvalidColumns("Truncated stats columns");
+    }
+    auto valueDiff = folly::tryDecodeVarint(values);
+    if (!valueDiff) {
+      throwInvalidColumns("Truncated stats columns");
+    }
+    column += folly::decodeZigZag(*columnDiff);
+    if (column < 0 || column >= static_cast<int64_t>(columns_.size())) {
+      throwInvalidColumns("Stats column out of range");
+    }
+    auto& lastValue = lastValues_[column];
+    auto value = sum(lastValue, folly::decodeZigZag(*valueDiff));
+
+    OperDeltaUnit unit;
+    unit.path() = columns_[column];
+    unit.oldState() =
+        thrift_cow::serialize<apache::thrift::type_class::integral>(
+            protocol, lastValue);
+    unit.newState() =
+        thrift_cow::serialize<apache::thrift::type_class::integral>(
+            protocol, value);
+    delta.changes()->push_back(std::move(unit));
+    lastValue = value;
+  }
+  delta.statsColumns().reset();
+}
+
+} // namespace facebook::fboss::fsdb
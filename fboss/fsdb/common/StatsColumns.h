@@ -0,0 +1,102 @@
+// (c) Meta Platforms, Inc. and affiliates. Confidential and proprietary.
+
+#pragma once
+
+#include <folly/container/F14Map.h>
+#include <thrift/lib/cpp2/TypeClass.h>
+#include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
+
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace facebook::fboss::fsdb {
+
+namespace detail {
+
+template <typename Node>
+struct IsStatsColumn : std::false_type {};
+
+// Primitive members of thrift_cow nodes are held in std::optional
+template <typename Node>
+struct IsStatsColumn<std::optional<Node>>
+    : std::bool_constant<
+          std::is_same_v<
+              typename Node::TC,
+              apache::thrift::type_class::integral> &&
+          sizeof(typename Node::ThriftType) == sizeof(int64_t)> {};
+
+struct PathHash {
+  size_t operator()(const std::vector<std::string>& path) const;
+};
+
+} // namespace detail
+
+// Whether a changed leaf of a delta visit can be published as a column
+template <typename Node>
+constexpr bool isStatsColumn = detail::IsStatsColumn<Node>::value;
+
+/*
+ * Packs the counters that changed in a stats delta into OperStatsColumns.
+ * Columns are keyed by path relative to the publish path, so a batch can be
+ * built straight from the delta visitor without copying the full path of
+ * every leaf.
+ *
+ * Every schemaInterval batches, if set, the encoder starts over with new
+ * columns, so that subscribers that joined in between can decode them.
+ */
+class StatsColumnEncoder {
+ public:
+  explicit StatsColumnEncoder(
+      const std::vector<std::string>& basePath,
+      uint32_t schemaInterval = 0);
+
+  // Forgets all columns, for a full sync to a new stream
+  void reset();
+
+  // Returns false if the change must be published as an OperDeltaUnit, as
+  // the counter changed outside of its column since it was last added
+  bool addChange(
+      const std::vector<std::string>& path,
+      int64_t oldValue,
+      int64_t newValue);
+
+  // Changes added since the last batch, if there are any
+  std::optional<OperStatsColumns> finishBatch();
+
+ private:
+  const std::vector<std::string> basePath_;
+  const uint32_t schemaInterval_;
+  int64_t schemaId_;
+  uint32_t schemaBatches_{0};
+  folly::F14FastMap<std::vector<std::string>, uint32_t, detail::PathHash>
+      columnIds_;
+  std::vector<int64_t> lastValues_;
+  uint32_t firstNewColumn_{0};
+  std::vector<OperPath> newColumns_;
+  std::vector<int64_t> newColumnValues_;
+  std::string values_;
+  uint32_t lastColumn_{0};
+};
+
+/*
+ * Subscriber side of StatsColumnEncoder, tracks the columns of one publisher
+ * to turn OperStatsColumns back into OperDeltaUnits.
+ */
+class StatsColumnDecoder {
+ public:
+  // Moves the counters of delta.statsColumns() to delta.changes(), encoded
+  // with delta.protocol(). Columns that do not follow the ones previously
+  // decoded, e.g. when subscribing after they started, are dropped until the
+  // publisher starts new columns. Throws FsdbException if the columns are
+  // malformed.
+  void expand(OperDelta& delta);
+
+ private:
+  std::optional<int64_t> schemaId_;
+  std::vector<OperPath> columns_;
+  std::vector<int64_t> lastValues_;
+};
+
+} // namespace facebook::fboss::fsdb
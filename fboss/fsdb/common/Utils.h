@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include <fboss/thrift_cow/visitors/DeltaVisitor.h>
 #include <fboss/thrift_storage/CowStorage.h>
+#include "fboss/fsdb/common/StatsColumns.h"
 #include "fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h"
 
 namespace facebook::fboss::fsdb {
@@ -24,4 +26,54 @@ OperDeltaUnit buildOperDeltaUnit(
   return unit;
 }
 
+/*
+ * BINARY encoded delta between two versions of a publisher root, with one
+ * OperDeltaUnit per minimal change. If statsColumns is given, 64 bit
+ * counters that changed in place are packed into columns instead.
+ */
+template <typename NodeT>
+OperDelta buildOperDelta(
+    const std::vector<std::string>& basePath,
+    const NodeT& oldState,
+    const NodeT& newState,
+    StatsColumnEncoder* statsColumns = nullptr) {
+  OperDelta delta;
+  delta.protocol() = OperProtocol::BINARY;
+  auto& deltas = *delta.changes();
+  auto processChange = [&](const std::vector<std::string>& path,
+                           auto oldNode,
+                           auto newNode,
+                           thrift_cow::DeltaElemTag /* visitTag */) {
+    if constexpr (isStatsColumn<decltype(newNode)>) {
+      if (statsColumns && oldNode && newNode &&
+          statsColumns->addChange(
+              path,
+              static_cast<int64_t>(oldNode->toThrift()),
+              static_cast<int64_t>(newNode->toThrift()))) {
+        return;
+      }
+    }
+    std::vector<std::string> fullPath;
+    fullPath.reserve(basePath.size() + path.size());
+    fullPath.insert(fullPath.end(), basePath.begin(), basePath.end());
+    fullPath.insert(fullPath.end(), path.begin(), path.end());
+    // TODO: metadata
+    deltas.push_back(
+        buildOperDeltaUnit(fullPath, oldNode, newNode, OperProtocol::BINARY));
+  };
+
+  thrift_cow::RootDeltaVisitor::visit(
+      oldState,
+      newState,
+      thrift_cow::DeltaVisitMode::MINIMAL,
+      std::move(processChange));
+
+  if (statsColumns) {
+    if (auto columns = statsColumns->finishBatch()) {
+      delta.statsColumns() = std::move(*columns);
+    }
+  }
+  return delta;
+}
+
 } // namespace facebook::fboss::fsdb
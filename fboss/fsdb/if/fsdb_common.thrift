@@ -40,6 +40,7 @@ enum FsdbErrorCode {
   ALL_PUBLISHERS_GONE = 13,
   DISCONNECTED = 14,
   PUBLISHER_NOT_READY = 15,
+  INVALID_STATS_COLUMNS = 16,
 }
 
 exception FsdbException {
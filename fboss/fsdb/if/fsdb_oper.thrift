@@ -59,10 +59,35 @@ struct OperDeltaUnit {
   3: optional fbbinary newState;
 }
 
+/*
+ * Stats counters packed by column instead of one OperDeltaUnit per leaf.
+ * A 64 bit integer leaf that changed in place is given a column id the first
+ * time it is published, and its full path is only sent in that delta. The
+ * publisher periodically starts over with new columns, so that subscribers
+ * that missed the start of the current ones can decode them again.
+ */
+struct OperStatsColumns {
+  // Changes whenever the publisher starts over with no columns, e.g. on
+  // every full sync
+  1: i64 schemaId;
+  // Paths of the columns first published in this delta, with ids
+  // firstNewColumn, firstNewColumn + 1, ...
+  2: i32 firstNewColumn;
+  3: list<OperPath> newColumns;
+  // Values of the new columns before the changes in this delta
+  5: list<i64> newColumnValues;
+  // For each changed counter, the zigzag varint difference of its column id
+  // from the previous counter's (or from 0), then the zigzag varint
+  // difference of its value from the last one published in the column (or
+  // from 0)
+  4: fbbinary values;
+}
+
 struct OperDelta {
   1: list<OperDeltaUnit> changes;
   2: OperProtocol protocol;
   3: optional OperMetadata metadata;
+  4: optional OperStatsColumns statsColumns;
 }
 
 struct TaggedOperDelta {
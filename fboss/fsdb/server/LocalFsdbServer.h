@@ -0,0 +1,322 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#pragma once
+
+#include <fboss/fsdb/common/StatsColumns.h>
+#include <fboss/fsdb/common/Utils.h>
+#include <fboss/fsdb/if/gen-cpp2/fsdb_oper_types.h>
+#include <fboss/thrift_cow/visitors/DeltaVisitor.h>
+#include <fboss/thrift_storage/CowStorage.h>
+#include <fboss/thrift_storage/CowStorageMgr.h>
+
+#include <folly/logging/xlog.h>
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace facebook::fboss::fsdb {
+
+/*
+ * One FSDB tree (state or stats) served in process, for tests and
+ * deployments that do not need a standalone fsdb. Publishes are applied to a
+ * CowStorageMgr, whose update thread coalesces them and then serves path and
+ * delta subscriptions.
+ *
+ * Subscriptions to the same path with the same protocol share one encoded
+ * OperState or OperDelta per update, and every change is only encoded once
+ * per protocol in use, however many subscriptions it is fanned out to.
+ * Subscription callbacks run on the update thread.
+ */
+template <typename Root>
+class LocalFsdbTree {
+ public:
+  using Path = std::vector<std::string>;
+  using SubscriptionId = uint64_t;
+  using OperStateCb =
+      std::function<void(const std::shared_ptr<const OperState>&)>;
+  using OperDeltaCb =
+      std::function<void(const std::shared_ptr<const OperDelta>&)>;
+  using CowStorageManager = CowStorageMgr<Root>;
+  using CowState = typename CowStorageManager::CowState;
+
+  LocalFsdbTree()
+      : storage_([this](const auto& oldState, const auto& newState) {
+          serveSubscriptions(oldState, newState);
+        }) {}
+
+  void publishState(const Path& path, OperState&& state) {
+    storage_.updateState(
+        "Publish state",
+        [path, state = std::move(state)](const std::shared_ptr<CowState>& in)
+            -> std::shared_ptr<CowState> {
+          CowStorage<Root> storage(in);
+          auto error = storage.set_encoded(path.begin(), path.end(), state);
+          if (error) {
+            XLOG(ERR) << "Failed to publish state to "
+                      << folly::join('/', path) << ": "
+                      << static_cast<int>(*error);
+            return nullptr;
+          }
+          return storage.root();
+        });
+  }
+
+  // Delta units are at full paths, publishPath identifies the publisher
+  void publishDelta(const Path& publishPath, OperDelta&& delta) {
+    storage_.updateState(
+        "Publish delta",
+        [this, publishPath, delta = std::move(delta)](
+            const std::shared_ptr<CowState>& in) mutable
+        -> std::shared_ptr<CowState> {
+          try {
+            statsColumns_[publishPath].expand(delta);
+          } catch (const FsdbException& ex) {
+            XLOG(ERR) << "Failed to publish delta to "
+                      << folly::join('/', publishPath) << ": "
+                      << *ex.message_ref();
+            return nullptr;
+          }
+          CowStorage<Root> storage(in);
+          if (auto error = storage.patch(delta)) {
+            XLOG(ERR) << "Failed to publish delta to "
+                      << folly::join('/', publishPath) << ": "
+                      << static_cast<int>(*error);
+            return nullptr;
+          }
+          return storage.root();
+        });
+  }
+
+  // The callback is first called with the current state at path
+  SubscriptionId
+  subscribeState(const Path& path, OperProtocol protocol, OperStateCb cb) {
+    return subscribe(
+        stateSubscriptions_, path, protocol, std::move(cb), [&]() {
+          return encodeState(storage_.getState(), path, protocol);
+        });
+  }
+
+  // The callback is first called with a delta adding the current state at
+  // path
+  SubscriptionId
+  subscribeDelta(const Path& path, OperProtocol protocol, OperDeltaCb cb) {
+    return subscribe(
+        deltaSubscriptions_, path, protocol, std::move(cb), [&]() {
+          return encodeDelta(nullptr, storage_.getState(), path, protocol);
+        });
+  }
+
+  // Must not be called from a subscription callback
+  void unsubscribe(SubscriptionId id) {
+    storage_.getEventBase()->runInEventBaseThreadAndWait([&]() {
+      unsubscribe(stateSubscriptions_, id);
+      unsubscribe(deltaSubscriptions_, id);
+    });
+  }
+
+  // Blocks until the updates published so far have been served
+  void waitForUpdates() {
+    storage_.updateStateBlocking(
+        "Wait for updates",
+        [](const std::shared_ptr<CowState>& /*in*/) { return nullptr; });
+  }
+
+  const std::shared_ptr<CowState> getState() const {
+    return storage_.getState();
+  }
+
+ private:
+  template <typename Cb>
+  using Subscriptions =
+      std::map<std::pair<Path, OperProtocol>, std::map<SubscriptionId, Cb>>;
+
+  static bool isPrefix(const Path& prefix, const Path& path) {
+    return prefix.size() <= path.size() &&
+        std::equal(prefix.begin(), prefix.end(), path.begin());
+  }
+
+  static std::optional<folly::fbstring> encode(
+      const std::shared_ptr<CowState>& state,
+      const Path& path,
+      OperProtocol protocol) {
+    if (!state) {
+      return std::nullopt;
+    }
+    auto result =
+        CowStorage<Root>(state).get_encoded(path.begin(), path.end(), protocol);
+    if (!result.hasValue() || !result->contents()) {
+      return std::nullopt;
+    }
+    return *result->contents();
+  }
+
+  static std::shared_ptr<const OperState> encodeState(
+      const std::shared_ptr<CowState>& state,
+      const Path& path,
+      OperProtocol protocol) {
+    auto operState = std::make_shared<OperState>();
+    operState->protocol() = protocol;
+    if (auto contents = encode(state, path, protocol)) {
+      operState->contents() = std::move(*contents);
+    }
+    return operState;
+  }
+
+  // Delta of the whole subtree at path
+  static std::shared_ptr<const OperDelta> encodeDelta(
+      const std::shared_ptr<CowState>& oldState,
+      const std::shared_ptr<CowState>& newState,
+      const Path& path,
+      OperProtocol protocol) {
+    auto delta = std::make_shared<OperDelta>();
+    delta->protocol() = protocol;
+    auto oldContents = encode(oldState, path, protocol);
+    auto newContents = encode(newState, path, protocol);
+    if (oldContents == newContents) {
+      return delta;
+    }
+    OperDeltaUnit unit;
+    unit.path()->raw() = path;
+    if (oldContents) {
+      unit.oldState() = std::move(*oldContents);
+    }
+    if (newContents) {
+      unit.newState() = std::move(*newContents);
+    }
+    delta->changes()->push_back(std::move(unit));
+    return delta;
+  }
+
+  template <typename Cb, typename InitialFn>
+  SubscriptionId subscribe(
+      Subscriptions<Cb>& subscriptions,
+      const Path& path,
+      OperProtocol protocol,
+      Cb cb,
+      InitialFn initial) {
+    SubscriptionId id;
+    storage_.getEventBase()->runInEventBaseThreadAndWait([&]() {
+      id = nextSubscriptionId_++;
+      cb(initial());
+      subscriptions[{path, protocol}].emplace(id, std::move(cb));
+    });
+    return id;
+  }
+
+  template <typename Cb>
+  void unsubscribe(Subscriptions<Cb>& subscriptions, SubscriptionId id) {
+    for (auto it = subscriptions.begin(); it != subscriptions.end(); ++it) {
+      if (it->second.erase(id)) {
+        if (it->second.empty()) {
+          subscriptions.erase(it);
+        }
+        return;
+      }
+    }
+  }
+
+  void serveSubscriptions(
+      const std::shared_ptr<CowState>& oldState,
+      const std::shared_ptr<CowState>& newState) {
+    if (stateSubscriptions_.empty() && deltaSubscriptions_.empty()) {
+      return;
+    }
+    std::set<OperProtocol> protocols;
+    for (const auto& [key, callbacks] : deltaSubscriptions_) {
+      protocols.insert(key.second);
+    }
+    // Minimal changes, each encoded once per protocol of delta subscriptions
+    std::vector<Path> changedPaths;
+    std::map<OperProtocol, std::vector<OperDeltaUnit>> changes;
+    auto processChange = [&](const std::vector<std::string>& path,
+                             auto oldNode,
+                             auto newNode,
+                             thrift_cow::DeltaElemTag /* visitTag */) {
+      changedPaths.push_back(path);
+      for (auto protocol : protocols) {
+        changes[protocol].push_back(
+            buildOperDeltaUnit(path, oldNode, newNode, protocol));
+      }
+    };
+    thrift_cow::RootDeltaVisitor::visit(
+        oldState,
+        newState,
+        thrift_cow::DeltaVisitMode::MINIMAL,
+        std::move(processChange));
+
+    for (const auto& [key, callbacks] : deltaSubscriptions_) {
+      const auto& [path, protocol] = key;
+      std::shared_ptr<const OperDelta> delta;
+      auto subtreeDelta = std::make_shared<OperDelta>();
+      subtreeDelta->protocol() = protocol;
+      const auto& units = changes[protocol];
+      for (size_t i = 0; i < changedPaths.size(); ++i) {
+        if (isPrefix(path, changedPaths[i])) {
+          subtreeDelta->changes()->push_back(units[i]);
+        } else if (isPrefix(changedPaths[i], path)) {
+          // Replaced along with an ancestor, the only change in the subtree
+          delta = encodeDelta(oldState, newState, path, protocol);
+          break;
+        }
+      }
+      if (!delta) {
+        delta = std::move(subtreeDelta);
+      }
+      if (delta->changes()->empty()) {
+        continue;
+      }
+      for (const auto& [id, cb] : callbacks) {
+        cb(delta);
+      }
+    }
+
+    for (const auto& [key, callbacks] : stateSubscriptions_) {
+      const auto& [path, protocol] = key;
+      auto changed = std::any_of(
+          changedPaths.begin(), changedPaths.end(), [&](const auto& changed) {
+            return isPrefix(path, changed) || isPrefix(changed, path);
+          });
+      if (!changed) {
+        continue;
+      }
+      auto state = encodeState(newState, path, protocol);
+      for (const auto& [id, cb] : callbacks) {
+        cb(state);
+      }
+    }
+  }
+
+  // Only accessed in the update thread
+  Subscriptions<OperStateCb> stateSubscriptions_;
+  Subscriptions<OperDeltaCb> deltaSubscriptions_;
+  std::map<Path, StatsColumnDecoder> statsColumns_;
+  SubscriptionId nextSubscriptionId_{0};
+  // Destroyed first, stopping the update thread
+  CowStorageManager storage_;
+};
+
+/*
+ * In process FSDB server, with the state and the stats trees of the given
+ * roots.
+ */
+template <typename StateRoot, typename StatsRoot>
+class LocalFsdbServer {
+ public:
+  LocalFsdbTree<StateRoot>& state() {
+    return state_;
+  }
+
+  LocalFsdbTree<StatsRoot>& stats() {
+    return stats_;
+  }
+
+ private:
+  LocalFsdbTree<StateRoot> state_;
+  LocalFsdbTree<StatsRoot> stats_;
+};
+
+} // namespace facebook::fboss::fsdb
@@ -0,0 +1,129 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/agent/gen-cpp2/agent_stats_fatal_types.h"
+#include "fboss/agent/gen-cpp2/agent_stats_types.h"
+#include "fboss/fsdb/common/Utils.h"
+#include "fboss/fsdb/server/LocalFsdbServer.h"
+
+#include <folly/Benchmark.h>
+#include <folly/Random.h>
+#include <folly/init/Init.h>
+#include <folly/synchronization/Baton.h>
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::fsdb;
+
+namespace {
+using AgentStatsNode = thrift_cow::ThriftStructNode<AgentStats>;
+using StatsTree = LocalFsdbTree<AgentStats>;
+
+constexpr auto kNumPorts = 64;
+constexpr auto kNumQueues = 8;
+// Published deltas cycle through these, wrapping around to the first
+constexpr auto kNumIntervals = 8;
+const std::vector<std::string> kPublishPath{"agent"};
+
+template <typename T>
+void grow(T& counter, uint64_t rate) {
+  counter += rate + folly::Random::rand64(rate);
+}
+
+std::vector<std::shared_ptr<AgentStatsNode>> makeIntervals() {
+  std::vector<std::shared_ptr<AgentStatsNode>> intervals;
+  AgentStats stats;
+  for (auto interval = 0; interval < kNumIntervals; ++interval) {
+    for (auto port = 0; port < kNumPorts; ++port) {
+      auto& portStats =
+          stats.hwPortStats()[folly::to<std::string>("eth1/", port, "/1")];
+      grow(*portStats.inBytes_(), 1'000'000'000);
+      grow(*portStats.inUnicastPkts_(), 1'000'000);
+      grow(*portStats.inDiscards_(), 10);
+      grow(*portStats.outBytes_(), 1'000'000'000);
+      grow(*portStats.outUnicastPkts_(), 1'000'000);
+      grow(*portStats.outDiscards_(), 10);
+      for (auto queue = 0; queue < kNumQueues; ++queue) {
+        grow(portStats.queueOutBytes_()[queue], 100'000'000);
+        grow(portStats.queueOutPackets_()[queue], 100'000);
+      }
+    }
+    intervals.push_back(std::make_shared<AgentStatsNode>(stats));
+  }
+  return intervals;
+}
+
+/*
+ * numSubscribers delta subscriptions to the port stats, while a publisher
+ * sends one delta per stats interval. If waitForEachDelta, time from
+ * publishing each delta until all subscribers got it, otherwise time to
+ * publish all deltas and serve them to the subscribers.
+ */
+void publishToSubscribers(
+    unsigned iters,
+    int numSubscribers,
+    bool waitForEachDelta) {
+  std::unique_ptr<StatsTree> tree;
+  std::vector<OperDelta> deltas;
+  folly::Baton<> delivered;
+  BENCHMARK_SUSPEND {
+    auto intervals = makeIntervals();
+    for (auto interval = 0; interval < kNumIntervals; ++interval) {
+      deltas.push_back(buildOperDelta(
+          {},
+          intervals[interval],
+          intervals[(interval + 1) % kNumIntervals]));
+    }
+    tree = std::make_unique<StatsTree>();
+    OperState state;
+    state.protocol() = OperProtocol::BINARY;
+    state.contents() = intervals[0]->encode(OperProtocol::BINARY);
+    tree->publishState({}, std::move(state));
+    for (auto i = 0; i < numSubscribers; ++i) {
+      bool last = waitForEachDelta && i == numSubscribers - 1;
+      tree->subscribeDelta(
+          {"hwPortStats"},
+          OperProtocol::BINARY,
+          [&delivered, last](const std::shared_ptr<const OperDelta>& delta) {
+            folly::doNotOptimizeAway(delta->changes()->size());
+            if (last) {
+              delivered.post();
+            }
+          });
+    }
+    tree->waitForUpdates();
+    delivered.reset();
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    tree->publishDelta(kPublishPath, OperDelta(deltas[iter % kNumIntervals]));
+    if (waitForEachDelta) {
+      delivered.wait();
+      delivered.reset();
+    }
+  }
+  tree->waitForUpdates();
+  BENCHMARK_SUSPEND {
+    tree.reset();
+  }
+}
+} // namespace
+
+void publishLatency(unsigned iters, int numSubscribers) {
+  publishToSubscribers(iters, numSubscribers, true);
+}
+
+void publishThroughput(unsigned iters, int numSubscribers) {
+  publishToSubscribers(iters, numSubscribers, false);
+}
+
+BENCHMARK_NAMED_PARAM(publishLatency, 1_subscriber, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(publishLatency, 16_subscribers, 16);
+BENCHMARK_RELATIVE_NAMED_PARAM(publishLatency, 128_subscribers, 128);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(publishThroughput, 1_subscriber, 1);
+BENCHMARK_RELATIVE_NAMED_PARAM(publishThroughput, 16_subscribers, 16);
+BENCHMARK_RELATIVE_NAMED_PARAM(publishThroughput, 128_subscribers, 128);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
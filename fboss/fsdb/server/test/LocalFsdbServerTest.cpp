@@ -0,0 +1,147 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+
+#include "fboss/fsdb/server/LocalFsdbServer.h"
+#include "fboss/fsdb/tests/gen-cpp2/thriftpath_test_fatal_types.h"
+#include "fboss/fsdb/tests/gen-cpp2/thriftpath_test_types.h"
+#include "fboss/thrift_cow/nodes/Serializer.h"
+
+#include <folly/String.h>
+#include <gtest/gtest.h>
+
+#include <map>
+#include <mutex>
+
+namespace facebook::fboss::fsdb::test {
+
+namespace {
+using integral = apache::thrift::type_class::integral;
+using structure = apache::thrift::type_class::structure;
+
+template <typename TC, typename T>
+folly::fbstring encode(const T& value) {
+  return thrift_cow::serialize<TC>(OperProtocol::BINARY, value);
+}
+
+template <typename TC, typename T>
+T decode(const folly::fbstring& encoded) {
+  return thrift_cow::deserialize<TC, T>(OperProtocol::BINARY, encoded);
+}
+
+template <typename TC, typename T>
+OperState makeState(const T& value) {
+  OperState state;
+  state.protocol() = OperProtocol::BINARY;
+  state.contents() = encode<TC>(value);
+  return state;
+}
+
+// Everything a subscription was called back with
+template <typename SubUnit>
+class Received {
+ public:
+  auto callback() {
+    return [this](const std::shared_ptr<const SubUnit>& unit) {
+      std::lock_guard<std::mutex> g(lock_);
+      units_.push_back(unit);
+    };
+  }
+
+  std::vector<std::shared_ptr<const SubUnit>> units() {
+    std::lock_guard<std::mutex> g(lock_);
+    return units_;
+  }
+
+ private:
+  std::mutex lock_;
+  std::vector<std::shared_ptr<const SubUnit>> units_;
+};
+} // namespace
+
+class LocalFsdbTreeTest : public ::testing::Test {
+ protected:
+  LocalFsdbTree<TestStruct> tree_;
+};
+
+TEST_F(LocalFsdbTreeTest, subscribeState) {
+  Received<OperState> received;
+  tree_.subscribeState({"member"}, OperProtocol::BINARY, received.callback());
+  ASSERT_EQ(1, received.units().size());
+
+  tree_.publishState({"member", "min"}, makeState<integral>(int32_t(10)));
+  // Not under the subscribed path
+  tree_.publishState(
+      {"name"},
+      makeState<apache::thrift::type_class::string>(std::string("test")));
+  tree_.waitForUpdates();
+
+  auto units = received.units();
+  ASSERT_EQ(2, units.size());
+  auto member = decode<structure, TestStructSimple>(*units[1]->contents());
+  EXPECT_EQ(10, *member.min());
+}
+
+TEST_F(LocalFsdbTreeTest, subscribersShareDelta) {
+  Received<OperDelta> received1, received2, otherPath;
+  tree_.subscribeDelta({"member"}, OperProtocol::BINARY, received1.callback());
+  tree_.subscribeDelta({"member"}, OperProtocol::BINARY, received2.callback());
+  tree_.subscribeDelta(
+      {"structMap"}, OperProtocol::BINARY, otherPath.callback());
+
+  OperDelta delta;
+  delta.protocol() = OperProtocol::BINARY;
+  OperDeltaUnit unit;
+  unit.path()->raw() = {"member", "max"};
+  unit.newState() = encode<integral>(int32_t(5));
+  delta.changes()->push_back(unit);
+  tree_.publishDelta({"test"}, std::move(delta));
+  tree_.waitForUpdates();
+
+  auto units = received1.units();
+  ASSERT_EQ(2, units.size());
+  EXPECT_EQ(units[1], received2.units()[1]);
+  ASSERT_EQ(1, units[1]->changes()->size());
+  const auto& change = units[1]->changes()->front();
+  EXPECT_EQ(
+      std::vector<std::string>({"member", "max"}), *change.path()->raw());
+  EXPECT_EQ(0, decode<integral, int32_t>(*change.oldState()));
+  EXPECT_EQ(5, decode<integral, int32_t>(*change.newState()));
+  EXPECT_EQ(1, otherPath.units().size());
+}
+
+TEST_F(LocalFsdbTreeTest, changeAboveSubscribedPath) {
+  Received<OperDelta> received;
+  tree_.subscribeDelta(
+      {"structMap", "3", "min"}, OperProtocol::BINARY, received.callback());
+
+  // Adds the map entry the subscribed path is in
+  std::map<int32_t, TestStructSimple> structMap;
+  structMap[3].min() = 7;
+  tree_.publishState(
+      {"structMap"},
+      makeState<
+          apache::thrift::type_class::map<integral, structure>>(structMap));
+  tree_.waitForUpdates();
+
+  auto units = received.units();
+  ASSERT_EQ(2, units.size());
+  ASSERT_EQ(1, units[1]->changes()->size());
+  const auto& change = units[1]->changes()->front();
+  EXPECT_EQ(
+      std::vector<std::string>({"structMap", "3", "min"}),
+      *change.path()->raw());
+  EXPECT_FALSE(change.oldState());
+  EXPECT_EQ(7, decode<integral, int32_t>(*change.newState()));
+}
+
+TEST_F(LocalFsdbTreeTest, unsubscribe) {
+  Received<OperDelta> received;
+  auto id = tree_.subscribeDelta(
+      {"member"}, OperProtocol::BINARY, received.callback());
+  tree_.unsubscribe(id);
+
+  tree_.publishState({"member", "min"}, makeState<integral>(int32_t(10)));
+  tree_.waitForUpdates();
+  EXPECT_EQ(1, received.units().size());
+}
+
+} // namespace facebook::fboss::fsdb::test
@@ -0,0 +1,123 @@
+// Copyright 2004-present Facebook. All Rights Reserved.
+#include "fboss/agent/hw/HwFb303Stats.h"
+#include "fboss/agent/hw/HwPortFb303Stats.h"
+
+#include <fmt/format.h>
+#include <folly/Benchmark.h>
+#include "common/init/Init.h"
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+using namespace facebook::fboss;
+using namespace folly;
+
+namespace {
+constexpr auto kNumPorts = 256;
+constexpr auto kNumQueues = 8;
+
+HwPortFb303Stats::QueueId2Name queueId2Name() {
+  HwPortFb303Stats::QueueId2Name queues;
+  for (auto queueId = 0; queueId < kNumQueues; ++queueId) {
+    queues.emplace(queueId, fmt::format("queue{}", queueId));
+  }
+  return queues;
+}
+
+std::string portName(int port) {
+  return fmt::format("eth1/{}/1", port + 1);
+}
+
+HwPortStats portStats(int64_t val) {
+  HwPortStats stats;
+  for (auto queueId = 0; queueId < kNumQueues; ++queueId) {
+    (*stats.queueOutBytes_())[queueId] = val;
+    (*stats.queueOutPackets_())[queueId] = val;
+    (*stats.queueOutDiscardBytes_())[queueId] = val;
+    (*stats.queueOutDiscardPackets_())[queueId] = val;
+  }
+  return stats;
+}
+} // namespace
+
+/*
+ * Update all port and queue stats of kNumPorts ports n times, looking up
+ * every counter by its full stat name on each update
+ */
+BENCHMARK(PortStatsUpdateByName, n) {
+  HwFb303Stats stats;
+  HwPortFb303Stats::QueueId2Name queues;
+  std::vector<folly::StringPiece> portStatKeys;
+  std::vector<folly::StringPiece> queueStatKeys;
+  BENCHMARK_SUSPEND {
+    queues = queueId2Name();
+    HwPortFb303Stats keys("keys");
+    portStatKeys = keys.kPortStatKeys();
+    queueStatKeys = keys.kQueueStatKeys();
+    for (auto port = 0; port < kNumPorts; ++port) {
+      for (auto statKey : portStatKeys) {
+        stats.reinitStat(
+            HwPortFb303Stats::statName(statKey, portName(port)), std::nullopt);
+      }
+      for (const auto& [queueId, queueName] : queues) {
+        for (auto statKey : queueStatKeys) {
+          stats.reinitStat(
+              HwPortFb303Stats::statName(
+                  statKey, portName(port), queueId, queueName),
+              std::nullopt);
+        }
+      }
+    }
+  }
+  std::vector<std::string> portNames;
+  for (auto port = 0; port < kNumPorts; ++port) {
+    portNames.push_back(portName(port));
+  }
+  for (unsigned i = 0; i < n; ++i) {
+    std::chrono::seconds now(i);
+    for (const auto& name : portNames) {
+      for (auto statKey : portStatKeys) {
+        stats.updateStat(now, HwPortFb303Stats::statName(statKey, name), i);
+      }
+      for (const auto& [queueId, queueName] : queues) {
+        for (auto statKey : queueStatKeys) {
+          stats.updateStat(
+              now,
+              HwPortFb303Stats::statName(statKey, name, queueId, queueName),
+              i);
+        }
+      }
+    }
+  }
+}
+
+/*
+ * Same updates through HwPortFb303Stats, which resolves its counters when
+ * ports and queues are (re)initialized
+ */
+BENCHMARK_RELATIVE(PortStatsUpdateByHandle, n) {
+  std::vector<std::unique_ptr<HwPortFb303Stats>> stats;
+  std::vector<HwPortStats> values;
+  BENCHMARK_SUSPEND {
+    for (auto port = 0; port < kNumPorts; ++port) {
+      stats.push_back(
+          std::make_unique<HwPortFb303Stats>(portName(port), queueId2Name()));
+    }
+    for (unsigned i = 0; i < n; ++i) {
+      values.push_back(portStats(i));
+    }
+  }
+  for (unsigned i = 0; i < n; ++i) {
+    std::chrono::seconds now(i);
+    for (auto& portStat : stats) {
+      portStat->updateStats(values[i], now);
+    }
+  }
+}
+
+int main(int argc, char** argv) {
+  facebook::initFacebook(&argc, &argv);
+  runBenchmarks();
+  return 0;
+}
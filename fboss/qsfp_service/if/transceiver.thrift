@@ -381,6 +381,8 @@ struct TransceiverStats {
   5: i64 numWriteAttempted;
   // Number of times the write transaction failed
   6: i64 numWriteFailed;
+  // Number of bytes the read transactions asked for
+  7: i64 numReadBytes;
 }
 
 struct ModuleStatus {
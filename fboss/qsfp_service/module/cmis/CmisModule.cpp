@@ -4,6 +4,7 @@
 
 #include <boost/assign.hpp>
 #include <boost/bimap.hpp>
+#include <algorithm>
 #include <cmath>
 #include <iomanip>
 #include <string>
@@ -27,6 +28,17 @@
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+DEFINE_bool(
+    cmis_adaptive_refresh,
+    true,
+    "Only read the CMIS fields that can change between refreshes, instead of "
+    "every cached page");
+DEFINE_int32(
+    cmis_control_page_refresh_interval,
+    10,
+    "Number of CMIS data refreshes between reads of the host control page, "
+    "which is otherwise only read again after being written");
+
 using folly::IOBuf;
 using std::lock_guard;
 using std::memcpy;
@@ -422,20 +434,34 @@ void CmisModule::readCmisField(
     bool skipPageChange) {
   int dataLength, dataPage, dataOffset;
   getQsfpFieldAddress(field, dataPage, dataOffset, dataLength);
-  if (static_cast<CmisPages>(dataPage) != CmisPages::LOWER && !flatMem_ &&
-      !skipPageChange) {
+  readCmisRange(
+      static_cast<CmisPages>(dataPage),
+      dataOffset,
+      dataLength,
+      data,
+      skipPageChange);
+}
+
+void CmisModule::readCmisRange(
+    CmisPages page,
+    int offset,
+    int length,
+    uint8_t* data,
+    bool skipPageChange) {
+  if (page != CmisPages::LOWER && !flatMem_ && !skipPageChange) {
     // Only change page when it's not a flatMem module (which don't allow
     // changing page) and when the skipPageChange argument is not true
-    uint8_t page = static_cast<uint8_t>(dataPage);
+    uint8_t pageId = static_cast<uint8_t>(page);
     qsfpImpl_->writeTransceiver(
         {TransceiverI2CApi::ADDR_QSFP,
          127,
-         sizeof(page),
+         sizeof(pageId),
          static_cast<int>(CmisPages::LOWER)},
-        &page);
+        &pageId);
   }
   qsfpImpl_->readTransceiver(
-      {TransceiverI2CApi::ADDR_QSFP, dataOffset, dataLength, dataPage}, data);
+      {TransceiverI2CApi::ADDR_QSFP, offset, length, static_cast<int>(page)},
+      data);
 }
 
 void CmisModule::writeCmisField(
@@ -458,6 +484,9 @@ void CmisModule::writeCmisField(
   }
   qsfpImpl_->writeTransceiver(
       {TransceiverI2CApi::ADDR_QSFP, dataOffset, dataLength, dataPage}, data);
+  if (static_cast<CmisPages>(dataPage) == CmisPages::PAGE10) {
+    controlPageStale_ = true;
+  }
 }
 
 FlagLevels CmisModule::getQsfpSensorFlags(CmisField fieldName, int offset) {
@@ -1620,14 +1649,35 @@ void CmisModule::updateQsfpData(bool allPages) {
   try {
     QSFP_LOG(DBG2, this) << "Performing " << ((allPages) ? "full" : "partial")
                          << " qsfp data cache refresh";
-    readCmisField(CmisField::PAGE_LOWER, lowerPage_);
+    bool readAll = allPages || !FLAGS_cmis_adaptive_refresh;
+    if (readAll) {
+      readCmisField(CmisField::PAGE_LOWER, lowerPage_);
+    } else {
+      updateLowerPageMonitorsLocked();
+    }
     lastRefreshTime_ = std::time(nullptr);
     dirty_ = false;
     setQsfpFlatMem();
 
-    readCmisField(CmisField::PAGE_UPPER00H, page0_);
+    // The module state changed flag is latched, so this only sees it on the
+    // first refresh after the change. It stays in the cache for
+    // updateCmisStateChanged().
+    bool moduleStateChanged = !readAll &&
+        getSettingsValue(CmisField::MODULE_FLAG, MODULE_STATE_CHANGED_MASK);
+    if (moduleStateChanged) {
+      updateLowerPageStaticLocked();
+    }
+    if (readAll || moduleStateChanged) {
+      readCmisField(CmisField::PAGE_UPPER00H, page0_);
+    }
     if (!flatMem_) {
-      readCmisField(CmisField::PAGE_UPPER10H, page10_);
+      if (readAll || moduleStateChanged || controlPageStale_ ||
+          ++refreshesSinceControlPageRead_ >=
+              FLAGS_cmis_control_page_refresh_interval) {
+        readCmisField(CmisField::PAGE_UPPER10H, page10_);
+        controlPageStale_ = false;
+        refreshesSinceControlPageRead_ = 0;
+      }
       readCmisField(CmisField::PAGE_UPPER11H, page11_);
 
       bool isReady =
@@ -1672,6 +1722,76 @@ void CmisModule::updateQsfpData(bool allPages) {
   }
 }
 
+namespace {
+// Lower page fields that change without the module state changing, they are
+// contiguous so a single read covers them. Every other lower page field in
+// cmisFields is treated as static and only read when the module state changes
+const std::array<CmisField, 10> kLowerPageMonitorFields = {
+    CmisField::MODULE_STATE,
+    CmisField::BANK0_FLAGS,
+    CmisField::BANK1_FLAGS,
+    CmisField::BANK2_FLAGS,
+    CmisField::BANK3_FLAGS,
+    CmisField::MODULE_FLAG,
+    CmisField::MODULE_ALARMS,
+    CmisField::TEMPERATURE,
+    CmisField::VCC,
+    CmisField::MODULE_CONTROL,
+};
+
+// Returns the [begin, end) lower page range covering kLowerPageMonitorFields.
+// Checks it against cmisFields so that a lower page field added inside the
+// range has to be added to kLowerPageMonitorFields as well, and so that no
+// static field is split by the range
+std::pair<int, int> computeLowerPageMonitorRange() {
+  int begin = MAX_QSFP_PAGE_SIZE, end = 0;
+  for (auto field : kLowerPageMonitorFields) {
+    auto info = QsfpFieldInfo<CmisField, CmisPages>::getQsfpFieldAddress(
+        cmisFields, field);
+    CHECK_EQ(info.dataAddress, static_cast<int>(CmisPages::LOWER));
+    begin = std::min(begin, info.offset);
+    end = std::max(end, info.offset + info.length);
+  }
+  for (const auto& [field, info] : cmisFields) {
+    if (info.dataAddress != static_cast<int>(CmisPages::LOWER) ||
+        field == CmisField::PAGE_LOWER) {
+      continue;
+    }
+    bool monitored = std::find(
+                         kLowerPageMonitorFields.begin(),
+                         kLowerPageMonitorFields.end(),
+                         field) != kLowerPageMonitorFields.end();
+    bool overlaps = info.offset < end && info.offset + info.length > begin;
+    CHECK_EQ(monitored, overlaps)
+        << "Lower page field " << static_cast<int>(field)
+        << " at offset " << info.offset
+        << " is not classified consistently with the monitored range [" << begin
+        << ", " << end << ")";
+  }
+  return {begin, end};
+}
+
+const std::pair<int, int>& lowerPageMonitorRange() {
+  static const auto range = computeLowerPageMonitorRange();
+  return range;
+}
+} // namespace
+
+void CmisModule::updateLowerPageMonitorsLocked() {
+  auto [begin, end] = lowerPageMonitorRange();
+  readCmisRange(CmisPages::LOWER, begin, end - begin, lowerPage_ + begin);
+}
+
+void CmisModule::updateLowerPageStaticLocked() {
+  // Identifier, revision and flat mem don't change while the module is present
+  int begin = lowerPageMonitorRange().second;
+  readCmisRange(
+      CmisPages::LOWER,
+      begin,
+      MAX_QSFP_PAGE_SIZE - begin,
+      lowerPage_ + begin);
+}
+
 void CmisModule::setApplicationCodeLocked(cfg::PortSpeed speed) {
   auto applicationIter = speedApplicationMapping.find(speed);
 
@@ -350,6 +350,14 @@ class CmisModule : public QsfpModule {
   readCmisField(CmisField field, uint8_t* data, bool skipPageChange = false);
   void
   writeCmisField(CmisField field, uint8_t* data, bool skipPageChange = false);
+  /* Read length bytes of a page starting at offset, like readCmisField for
+   * part of a field */
+  void readCmisRange(
+      CmisPages page,
+      int offset,
+      int length,
+      uint8_t* data,
+      bool skipPageChange = false);
 
   void getFieldValueLocked(CmisField fieldName, uint8_t* fieldValue) const;
   /*
@@ -425,10 +433,23 @@ class CmisModule : public QsfpModule {
       const phy::PrbsStats& lastStats) override;
 
   void updateVdmCacheLocked();
+  /*
+   * Refresh the lower page fields that change while the module is in the same
+   * state: module state, flags and monitors. The rest of the lower page and
+   * page 00h are only read again when the module state changed.
+   */
+  void updateLowerPageMonitorsLocked();
+  void updateLowerPageStaticLocked();
 
   void updateCmisStateChanged(
       ModuleStatus& moduleStatus,
       std::optional<ModuleStatus> curModuleStatus = std::nullopt) override;
+
+  // Page 10h only holds host controls. It is read again after being written,
+  // and every FLAGS_cmis_control_page_refresh_interval refreshes in case it
+  // was written through the raw register APIs.
+  bool controlPageStale_{true};
+  int refreshesSinceControlPageRead_{0};
 };
 
 } // namespace fboss
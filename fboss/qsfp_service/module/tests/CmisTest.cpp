@@ -15,6 +15,8 @@
 #include "fboss/qsfp_service/module/tests/TransceiverTestsHelper.h"
 #include "fboss/qsfp_service/test/hw_test/HwTransceiverUtils.h"
 
+DECLARE_bool(cmis_adaptive_refresh);
+
 namespace facebook::fboss {
 
 class MockCmisModule : public CmisModule {
@@ -36,6 +38,8 @@ class MockCmisModule : public CmisModule {
   MOCK_METHOD0(getModuleStateChanged, bool());
   MOCK_METHOD0(ensureTransceiverReadyLocked, bool());
 
+  using QsfpModule::getTransceiverStats;
+
  private:
   uint8_t moduleStateChangedReadTimes_{0};
 };
@@ -373,4 +377,33 @@ TEST_F(CmisTest, cmis400GCr8TransceiverInfoTest) {
   auto diagsCap = transceiverManager_->getDiagsCapability(xcvrID);
   EXPECT_FALSE(diagsCap.has_value());
 }
+
+// Tests that partial refreshes read less than full refreshes of the same
+// module, when its state hasn't changed
+TEST_F(CmisTest, adaptiveRefreshReadsLess) {
+  gflags::FlagSaver flagSaver;
+  auto xcvr = overrideCmisModule<Cmis200GTransceiver>(TransceiverID(0));
+
+  auto readDuringRefresh = [xcvr]() {
+    auto before = *xcvr->getTransceiverStats();
+    xcvr->refresh();
+    auto after = *xcvr->getTransceiverStats();
+    return std::make_pair(
+        *after.numReadAttempted() - *before.numReadAttempted(),
+        *after.numReadBytes() - *before.numReadBytes());
+  };
+
+  FLAGS_cmis_adaptive_refresh = false;
+  auto [fullReads, fullBytes] = readDuringRefresh();
+  FLAGS_cmis_adaptive_refresh = true;
+  auto [adaptiveReads, adaptiveBytes] = readDuringRefresh();
+
+  EXPECT_GT(adaptiveReads, 0);
+  EXPECT_LT(adaptiveReads, fullReads);
+  EXPECT_LT(adaptiveBytes, fullBytes);
+  // Nothing changed in the fake eeprom, so the cached data is the same
+  auto info = xcvr->getTransceiverInfo();
+  TransceiverTestsHelper tests(info);
+  tests.verifyVendorName("FACETEST");
+}
 } // namespace facebook::fboss
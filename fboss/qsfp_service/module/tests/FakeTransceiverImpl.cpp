@@ -31,6 +31,8 @@ int FakeTransceiverImpl::readTransceiver(
   auto offset = param.offset;
   auto len = param.len;
   EXPECT_TRUE(dataAddress == 0x50 || dataAddress == 0x51);
+  stats_.numReadAttempted() = stats_.numReadAttempted().value() + 1;
+  stats_.numReadBytes() = stats_.numReadBytes().value() + len;
 
   if (offset < QsfpModule::MAX_QSFP_PAGE_SIZE) {
     read = len;
@@ -34,6 +34,10 @@ class FakeTransceiverImpl : public TransceiverImpl {
   /* Returns the name for the port */
   folly::StringPiece getName() override;
   int getNum() const override;
+  /* Counts the reads served from the fake eeprom */
+  std::optional<TransceiverStats> getTransceiverStats() override {
+    return stats_;
+  }
 
  private:
   int module_{0};
@@ -41,6 +45,7 @@ class FakeTransceiverImpl : public TransceiverImpl {
   int page_{0};
   std::map<uint8_t, std::map<int, std::array<uint8_t, 128>>> upperPages_;
   std::map<uint8_t, std::array<uint8_t, 128>> lowerPages_;
+  TransceiverStats stats_;
 };
 
 class SffDacTransceiver : public FakeTransceiverImpl {
@@ -86,7 +86,7 @@ int WedgeQsfp::readTransceiver(
     uint8_t* fieldValue) {
   auto offset = param.offset;
   auto len = param.len;
-  wedgeQsfpstats_.recordReadAttempted();
+  wedgeQsfpstats_.recordReadAttempted(len);
   try {
     SCOPE_EXIT {
       wedgeQsfpstats_.updateReadDownTime();
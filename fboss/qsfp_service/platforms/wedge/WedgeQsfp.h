@@ -48,9 +48,10 @@ class WedgeQsfpStats {
     lastSuccessfulWrite_ = std::chrono::steady_clock::now();
   }
 
-  void recordReadAttempted() {
+  void recordReadAttempted(int len) {
     std::lock_guard<std::mutex> g(statsMutex_);
     stats_.numReadAttempted() = stats_.numReadAttempted().value() + 1;
+    stats_.numReadBytes() = stats_.numReadBytes().value() + len;
   }
 
   void recordWriteAttempted() {
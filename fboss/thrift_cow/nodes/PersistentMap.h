@@ -0,0 +1,809 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace facebook::fboss::thrift_cow {
+
+/*
+ * PersistentMap is an ordered map with the subset of the std::map interface
+ * used by thrift_cow map nodes, stored as a B+ tree whose nodes are shared
+ * between copies of the map. Copying a PersistentMap is O(1). Modifying a
+ * copy only copies the O(log n) tree nodes on the path to the modified
+ * entry; the rest of the tree remains shared with the original.
+ *
+ * Tree nodes and entries are only modified in place by the map that created
+ * them, and only until that map is copied: copying a map hands both maps a
+ * new owner id, so nodes shared by the copies are copied before being
+ * modified. Ownership is explicit rather than inferred from shared_ptr use
+ * counts, which readers on other threads may drop concurrently. Unlike
+ * std::map, inserting or erasing invalidates all iterators into the map.
+ *
+ * freeze() supports publishing a map node without visiting every child:
+ * it only visits entries added or modified since the previous freeze().
+ */
+template <typename K, typename V, typename Compare = std::less<K>>
+class PersistentMap {
+  // Max entries per leaf and children per inner node. Nodes other than the
+  // root are kept at least half full.
+  static constexpr size_t kMaxNodeSize = 32;
+  static constexpr size_t kMinNodeSize = kMaxNodeSize / 2;
+  // Enough for more than 2 * 16^10 leaves
+  static constexpr size_t kMaxDepth = 12;
+
+ public:
+  using key_type = K;
+  using mapped_type = V;
+  using value_type = std::pair<const K, V>;
+  using key_compare = Compare;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using reference = value_type&;
+  using const_reference = const value_type&;
+
+ private:
+  // Identifies the map allowed to modify a node or entry in place
+  using OwnerId = uint64_t;
+
+  struct Entry : value_type {
+    template <typename... Args>
+    explicit Entry(OwnerId ownerId, Args&&... args)
+        : value_type(std::forward<Args>(args)...), owner(ownerId) {}
+
+    OwnerId owner;
+  };
+
+  using EntryPtr = std::shared_ptr<Entry>;
+  using KeyPtr = std::shared_ptr<const K>;
+  struct Node;
+  using NodePtr = std::shared_ptr<Node>;
+
+  struct Node {
+    Node(bool isLeaf, OwnerId ownerId) : leaf(isLeaf), owner(ownerId) {}
+    // copies are never frozen, and are owned by the map copying them
+    Node(const Node& other, OwnerId ownerId)
+        : entries(other.entries),
+          children(other.children),
+          keys(other.keys),
+          leaf(other.leaf),
+          owner(ownerId) {}
+
+    size_t size() const {
+      return leaf ? entries.size() : children.size();
+    }
+
+    // sorted entries of a leaf
+    std::vector<EntryPtr> entries;
+    // children of an inner node. keys[i] separates children[i] and
+    // children[i + 1]: keys in children[i] are less than keys[i] and keys
+    // in children[i + 1] are not.
+    std::vector<NodePtr> children;
+    std::vector<KeyPtr> keys;
+    bool leaf{true};
+    OwnerId owner;
+    // entries in this subtree have been visited by freeze() and the
+    // subtree has not been modified since
+    bool frozen{false};
+  };
+
+  struct Step {
+    Node* node;
+    uint32_t index;
+  };
+  using Path = std::array<Step, kMaxDepth>;
+
+ public:
+  template <bool IsConst>
+  class Iterator {
+   public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = typename PersistentMap::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer =
+        std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference =
+        std::conditional_t<IsConst, const value_type&, value_type&>;
+    using MapPtr =
+        std::conditional_t<IsConst, const PersistentMap*, PersistentMap*>;
+
+    Iterator() {}
+
+    template <bool C = IsConst, std::enable_if_t<C, bool> = true>
+    /* implicit */ Iterator(const Iterator<false>& other)
+        : map_(other.map_), path_(other.path_), depth_(other.depth_) {}
+
+    reference operator*() const {
+      DCHECK_GT(depth_, 0);
+      if constexpr (IsConst) {
+        const auto& leaf = path_[depth_ - 1];
+        return *leaf.node->entries[leaf.index];
+      } else {
+        // the entry may be modified through the returned reference, so
+        // unshare the path to it first
+        return map_->writableEntry(path_, depth_);
+      }
+    }
+
+    pointer operator->() const {
+      return &**this;
+    }
+
+    Iterator& operator++() {
+      increment();
+      return *this;
+    }
+
+    Iterator operator++(int) {
+      Iterator tmp(*this);
+      increment();
+      return tmp;
+    }
+
+    Iterator& operator--() {
+      decrement();
+      return *this;
+    }
+
+    Iterator operator--(int) {
+      Iterator tmp(*this);
+      decrement();
+      return tmp;
+    }
+
+    template <bool C>
+    bool operator==(const Iterator<C>& other) const {
+      if (depth_ != other.depth_) {
+        return false;
+      }
+      for (auto level = 0; level < depth_; ++level) {
+        if (path_[level].index != other.path_[level].index) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    template <bool C>
+    bool operator!=(const Iterator<C>& other) const {
+      return !(*this == other);
+    }
+
+   private:
+    friend class PersistentMap;
+    template <bool>
+    friend class Iterator;
+
+    explicit Iterator(MapPtr map) : map_(map) {}
+
+    void pushLeftmost(Node* node) {
+      while (true) {
+        CHECK_LT(depth_, kMaxDepth);
+        path_[depth_++] = Step{node, 0};
+        if (node->leaf) {
+          return;
+        }
+        node = node->children.front().get();
+      }
+    }
+
+    void pushRightmost(Node* node) {
+      while (true) {
+        CHECK_LT(depth_, kMaxDepth);
+        path_[depth_++] =
+            Step{node, static_cast<uint32_t>(node->size()) - 1};
+        if (node->leaf) {
+          return;
+        }
+        node = node->children.back().get();
+      }
+    }
+
+    void increment() {
+      DCHECK_GT(depth_, 0);
+      auto level = depth_ - 1;
+      if (++path_[level].index < path_[level].node->entries.size()) {
+        return;
+      }
+      while (level > 0) {
+        auto& step = path_[--level];
+        if (++step.index < step.node->children.size()) {
+          depth_ = level + 1;
+          pushLeftmost(step.node->children[step.index].get());
+          return;
+        }
+      }
+      // past the last entry
+      depth_ = 0;
+    }
+
+    void decrement() {
+      if (depth_ == 0) {
+        DCHECK(map_->root_);
+        pushRightmost(map_->root_.get());
+        return;
+      }
+      auto level = depth_ - 1;
+      if (path_[level].index > 0) {
+        --path_[level].index;
+        return;
+      }
+      while (level > 0) {
+        auto& step = path_[--level];
+        if (step.index > 0) {
+          --step.index;
+          depth_ = level + 1;
+          pushRightmost(step.node->children[step.index].get());
+          return;
+        }
+      }
+      LOG(FATAL) << "Decrementing begin() of PersistentMap";
+    }
+
+    MapPtr map_{nullptr};
+    // (node, index) from the root to the current entry. Mutable since
+    // dereferencing a non-const iterator may replace nodes on the path with
+    // unshared copies.
+    mutable Path path_;
+    // 0 for end()
+    uint8_t depth_{0};
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  PersistentMap() {}
+
+  explicit PersistentMap(const Compare& comp) : comp_(comp) {}
+
+  template <typename InputIt>
+  PersistentMap(InputIt first, InputIt last) {
+    insert(first, last);
+  }
+
+  PersistentMap(std::initializer_list<value_type> init) {
+    insert(init.begin(), init.end());
+  }
+
+  // Neither map may modify the nodes they now share in place
+  PersistentMap(const PersistentMap& other)
+      : root_(other.root_), size_(other.size_), comp_(other.comp_) {
+    other.owner_ = newOwner();
+  }
+
+  PersistentMap(PersistentMap&& other) noexcept
+      : root_(std::move(other.root_)),
+        size_(std::exchange(other.size_, 0)),
+        comp_(other.comp_),
+        owner_(other.owner_.exchange(newOwner())) {}
+
+  PersistentMap& operator=(const PersistentMap& other) {
+    if (this != &other) {
+      root_ = other.root_;
+      size_ = other.size_;
+      comp_ = other.comp_;
+      owner_ = newOwner();
+      other.owner_ = newOwner();
+    }
+    return *this;
+  }
+
+  PersistentMap& operator=(PersistentMap&& other) noexcept {
+    if (this != &other) {
+      root_ = std::move(other.root_);
+      size_ = std::exchange(other.size_, 0);
+      comp_ = other.comp_;
+      owner_ = other.owner_.exchange(newOwner());
+    }
+    return *this;
+  }
+
+  // iterators
+
+  iterator begin() {
+    iterator it(this);
+    if (root_) {
+      it.pushLeftmost(root_.get());
+    }
+    return it;
+  }
+
+  const_iterator begin() const {
+    return cbegin();
+  }
+
+  const_iterator cbegin() const {
+    const_iterator it(this);
+    if (root_) {
+      it.pushLeftmost(root_.get());
+    }
+    return it;
+  }
+
+  iterator end() {
+    return iterator(this);
+  }
+
+  const_iterator end() const {
+    return cend();
+  }
+
+  const_iterator cend() const {
+    return const_iterator(this);
+  }
+
+  // capacity
+
+  bool empty() const {
+    return size_ == 0;
+  }
+
+  size_type size() const {
+    return size_;
+  }
+
+  // lookup
+
+  iterator find(const K& key) {
+    return findImpl<iterator>(this, key);
+  }
+
+  const_iterator find(const K& key) const {
+    return findImpl<const_iterator>(this, key);
+  }
+
+  size_type count(const K& key) const {
+    return find(key) != end() ? 1 : 0;
+  }
+
+  iterator lower_bound(const K& key) {
+    return lowerBoundImpl<iterator>(this, key);
+  }
+
+  const_iterator lower_bound(const K& key) const {
+    return lowerBoundImpl<const_iterator>(this, key);
+  }
+
+  V& at(const K& key) {
+    auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("PersistentMap::at");
+    }
+    return it->second;
+  }
+
+  const V& at(const K& key) const {
+    auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("PersistentMap::at");
+    }
+    return it->second;
+  }
+
+  V& operator[](const K& key) {
+    return try_emplace(key).first->second;
+  }
+
+  // modifiers
+
+  std::pair<iterator, bool> insert(const value_type& value) {
+    return emplace(value);
+  }
+
+  std::pair<iterator, bool> insert(value_type&& value) {
+    return emplace(std::move(value));
+  }
+
+  template <typename InputIt>
+  void insert(InputIt first, InputIt last) {
+    for (; first != last; ++first) {
+      emplace(*first);
+    }
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args&&... args) {
+    return insertEntry(
+        std::make_shared<Entry>(owner(), std::forward<Args>(args)...));
+  }
+
+  template <typename... Args>
+  iterator emplace_hint(const_iterator /* hint */, Args&&... args) {
+    return emplace(std::forward<Args>(args)...).first;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> try_emplace(const K& key, Args&&... args) {
+    if (auto it = find(key); it != end()) {
+      return {it, false};
+    }
+    return insertEntry(std::make_shared<Entry>(
+        owner(),
+        std::piecewise_construct,
+        std::forward_as_tuple(key),
+        std::forward_as_tuple(std::forward<Args>(args)...)));
+  }
+
+  size_type erase(const K& key) {
+    if (find(key) == end()) {
+      // don't unshare anything if there is nothing to erase
+      return 0;
+    }
+    makeWritable(root_);
+    eraseFrom(*root_, key);
+    if (!root_->leaf && root_->children.size() == 1) {
+      auto child = std::move(root_->children.front());
+      root_ = std::move(child);
+    } else if (root_->leaf && root_->entries.empty()) {
+      root_.reset();
+    }
+    --size_;
+    return 1;
+  }
+
+  iterator erase(const_iterator pos) {
+    K key = pos->first;
+    erase(key);
+    return lower_bound(key);
+  }
+
+  iterator erase(iterator pos) {
+    return erase(const_iterator(pos));
+  }
+
+  void clear() {
+    root_.reset();
+    size_ = 0;
+  }
+
+  /*
+   * Invoke fn on every entry added or modified since the last call to
+   * freeze(), and mark the whole map as visited.
+   */
+  template <typename Fn>
+  void freeze(Fn fn) {
+    if (root_) {
+      freezeNode(*root_, fn);
+    }
+  }
+
+  bool operator==(const PersistentMap& other) const {
+    if (size_ != other.size_) {
+      return false;
+    }
+    return root_ == other.root_ || std::equal(begin(), end(), other.begin());
+  }
+
+  bool operator!=(const PersistentMap& other) const {
+    return !(*this == other);
+  }
+
+ private:
+  bool keyLess(const K& lhs, const K& rhs) const {
+    return comp_(lhs, rhs);
+  }
+
+  // index of the child of an inner node that key belongs to
+  size_t childIndex(const Node& node, const K& key) const {
+    return std::upper_bound(
+               node.keys.begin(),
+               node.keys.end(),
+               key,
+               [this](const K& k, const KeyPtr& sep) {
+                 return keyLess(k, *sep);
+               }) -
+        node.keys.begin();
+  }
+
+  // index of the first entry in a leaf not less than key
+  size_t entryIndex(const Node& node, const K& key) const {
+    return std::lower_bound(
+               node.entries.begin(),
+               node.entries.end(),
+               key,
+               [this](const EntryPtr& entry, const K& k) {
+                 return keyLess(entry->first, k);
+               }) -
+        node.entries.begin();
+  }
+
+  template <typename It, typename MapPtr>
+  static It lowerBoundImpl(MapPtr map, const K& key) {
+    It it(map);
+    if (!map->root_) {
+      return it;
+    }
+    auto node = map->root_.get();
+    while (!node->leaf) {
+      auto index = map->childIndex(*node, key);
+      CHECK_LT(it.depth_, kMaxDepth);
+      it.path_[it.depth_++] = Step{node, static_cast<uint32_t>(index)};
+      node = node->children[index].get();
+    }
+    auto index = map->entryIndex(*node, key);
+    CHECK_LT(it.depth_, kMaxDepth);
+    if (index < node->entries.size()) {
+      it.path_[it.depth_++] = Step{node, static_cast<uint32_t>(index)};
+    } else {
+      // every key in this leaf is less than key, so the lower bound is the
+      // first entry of the next leaf
+      it.path_[it.depth_++] =
+          Step{node, static_cast<uint32_t>(node->entries.size()) - 1};
+      it.increment();
+    }
+    return it;
+  }
+
+  template <typename It, typename MapPtr>
+  static It findImpl(MapPtr map, const K& key) {
+    auto it = lowerBoundImpl<It>(map, key);
+    if (it.depth_ == 0) {
+      return it;
+    }
+    const auto& leaf = it.path_[it.depth_ - 1];
+    if (map->keyLess(key, leaf.node->entries[leaf.index]->first)) {
+      return It(map);
+    }
+    return it;
+  }
+
+  static OwnerId newOwner() {
+    static std::atomic<OwnerId> nextOwner{1};
+    return nextOwner.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  OwnerId owner() const {
+    return owner_.load(std::memory_order_relaxed);
+  }
+
+  /*
+   * Make node safe to modify in place: copy it unless this map owns it.
+   * Callers must make each node writable before its children.
+   */
+  void makeWritable(NodePtr& node) {
+    if (node->owner != owner()) {
+      node = std::make_shared<Node>(std::as_const(*node), owner());
+    } else {
+      node->frozen = false;
+    }
+  }
+
+  value_type& writableEntry(Path& path, uint8_t depth) {
+    NodePtr* node = &root_;
+    for (auto level = 0; level < depth; ++level) {
+      makeWritable(*node);
+      path[level].node = node->get();
+      if (level + 1 < depth) {
+        node = &(*node)->children[path[level].index];
+      }
+    }
+    auto& leaf = path[depth - 1];
+    auto& entry = leaf.node->entries[leaf.index];
+    if (entry->owner != owner()) {
+      entry = std::make_shared<Entry>(
+          owner(), static_cast<const value_type&>(*entry));
+    }
+    return *entry;
+  }
+
+  std::pair<iterator, bool> insertEntry(EntryPtr entry) {
+    const K& key = entry->first;
+    if (auto it = find(key); it != end()) {
+      return {it, false};
+    }
+    if (!root_) {
+      root_ = std::make_shared<Node>(true, owner());
+      root_->entries.push_back(entry);
+    } else {
+      makeWritable(root_);
+      if (auto split = insertInto(*root_, entry)) {
+        auto newRoot = std::make_shared<Node>(false, owner());
+        newRoot->children.push_back(std::move(root_));
+        newRoot->children.push_back(std::move(split->second));
+        newRoot->keys.push_back(std::move(split->first));
+        root_ = std::move(newRoot);
+      }
+    }
+    ++size_;
+    return {find(key), true};
+  }
+
+  /*
+   * Insert entry under node, which must be writable. If node overflows,
+   * it is split and the separator and new right sibling are returned.
+   */
+  std::optional<std::pair<KeyPtr, NodePtr>> insertInto(
+      Node& node,
+      const EntryPtr& entry) {
+    if (node.leaf) {
+      auto index = entryIndex(node, entry->first);
+      node.entries.insert(node.entries.begin() + index, entry);
+      if (node.entries.size() <= kMaxNodeSize) {
+        return std::nullopt;
+      }
+      auto right = std::make_shared<Node>(true, owner());
+      auto half = node.entries.begin() + node.entries.size() / 2;
+      right->entries.assign(
+          std::make_move_iterator(half),
+          std::make_move_iterator(node.entries.end()));
+      node.entries.erase(half, node.entries.end());
+      auto separator = std::make_shared<const K>(right->entries.front()->first);
+      return std::make_pair(std::move(separator), std::move(right));
+    }
+
+    auto index = childIndex(node, entry->first);
+    makeWritable(node.children[index]);
+    auto split = insertInto(*node.children[index], entry);
+    if (!split) {
+      return std::nullopt;
+    }
+    node.children.insert(
+        node.children.begin() + index + 1, std::move(split->second));
+    node.keys.insert(node.keys.begin() + index, std::move(split->first));
+    if (node.children.size() <= kMaxNodeSize) {
+      return std::nullopt;
+    }
+    auto right = std::make_shared<Node>(false, owner());
+    auto half = node.children.size() / 2;
+    right->children.assign(
+        std::make_move_iterator(node.children.begin() + half),
+        std::make_move_iterator(node.children.end()));
+    node.children.resize(half);
+    auto separator = std::move(node.keys[half - 1]);
+    right->keys.assign(
+        std::make_move_iterator(node.keys.begin() + half),
+        std::make_move_iterator(node.keys.end()));
+    node.keys.resize(half - 1);
+    return std::make_pair(std::move(separator), std::move(right));
+  }
+
+  /*
+   * Erase key, which must exist, from under node, which must be writable
+   */
+  void eraseFrom(Node& node, const K& key) {
+    if (node.leaf) {
+      auto index = entryIndex(node, key);
+      DCHECK(
+          index < node.entries.size() &&
+          !keyLess(key, node.entries[index]->first));
+      node.entries.erase(node.entries.begin() + index);
+      return;
+    }
+    auto index = childIndex(node, key);
+    makeWritable(node.children[index]);
+    eraseFrom(*node.children[index], key);
+    if (node.children[index]->size() < kMinNodeSize) {
+      rebalance(node, index);
+    }
+  }
+
+  /*
+   * Merge the underflowed child at index with a sibling, or if they don't
+   * fit in one node, move entries/children over from the sibling
+   */
+  void rebalance(Node& node, size_t index) {
+    auto left = index > 0 ? index - 1 : index;
+    makeWritable(node.children[left]);
+    makeWritable(node.children[left + 1]);
+    auto& lhs = *node.children[left];
+    auto& rhs = *node.children[left + 1];
+    if (lhs.size() + rhs.size() <= kMaxNodeSize) {
+      if (lhs.leaf) {
+        lhs.entries.insert(
+            lhs.entries.end(),
+            std::make_move_iterator(rhs.entries.begin()),
+            std::make_move_iterator(rhs.entries.end()));
+      } else {
+        lhs.keys.push_back(std::move(node.keys[left]));
+        lhs.keys.insert(
+            lhs.keys.end(),
+            std::make_move_iterator(rhs.keys.begin()),
+            std::make_move_iterator(rhs.keys.end()));
+        lhs.children.insert(
+            lhs.children.end(),
+            std::make_move_iterator(rhs.children.begin()),
+            std::make_move_iterator(rhs.children.end()));
+      }
+      node.children.erase(node.children.begin() + left + 1);
+      node.keys.erase(node.keys.begin() + left);
+      return;
+    }
+
+    if (lhs.leaf) {
+      std::vector<EntryPtr> entries;
+      entries.reserve(lhs.entries.size() + rhs.entries.size());
+      std::move(
+          lhs.entries.begin(), lhs.entries.end(), std::back_inserter(entries));
+      std::move(
+          rhs.entries.begin(), rhs.entries.end(), std::back_inserter(entries));
+      auto half = entries.begin() + entries.size() / 2;
+      lhs.entries.assign(
+          std::make_move_iterator(entries.begin()),
+          std::make_move_iterator(half));
+      rhs.entries.assign(
+          std::make_move_iterator(half),
+          std::make_move_iterator(entries.end()));
+      node.keys[left] = std::make_shared<const K>(rhs.entries.front()->first);
+      return;
+    }
+
+    std::vector<NodePtr> children;
+    children.reserve(lhs.children.size() + rhs.children.size());
+    std::move(
+        lhs.children.begin(),
+        lhs.children.end(),
+        std::back_inserter(children));
+    std::move(
+        rhs.children.begin(),
+        rhs.children.end(),
+        std::back_inserter(children));
+    std::vector<KeyPtr> keys;
+    keys.reserve(children.size() - 1);
+    std::move(lhs.keys.begin(), lhs.keys.end(), std::back_inserter(keys));
+    keys.push_back(std::move(node.keys[left]));
+    std::move(rhs.keys.begin(), rhs.keys.end(), std::back_inserter(keys));
+
+    auto half = children.size() / 2;
+    lhs.children.assign(
+        std::make_move_iterator(children.begin()),
+        std::make_move_iterator(children.begin() + half));
+    rhs.children.assign(
+        std::make_move_iterator(children.begin() + half),
+        std::make_move_iterator(children.end()));
+    lhs.keys.assign(
+        std::make_move_iterator(keys.begin()),
+        std::make_move_iterator(keys.begin() + half - 1));
+    node.keys[left] = std::move(keys[half - 1]);
+    rhs.keys.assign(
+        std::make_move_iterator(keys.begin() + half),
+        std::make_move_iterator(keys.end()));
+  }
+
+  template <typename Fn>
+  static void freezeNode(Node& node, Fn& fn) {
+    if (node.frozen) {
+      return;
+    }
+    if (node.leaf) {
+      for (const auto& entry : node.entries) {
+        fn(std::as_const(*entry));
+      }
+    } else {
+      for (auto& child : node.children) {
+        freezeNode(*child, fn);
+      }
+    }
+    node.frozen = true;
+  }
+
+  NodePtr root_;
+  size_type size_{0};
+  Compare comp_;
+  // Copying a map changes the owner of the source as well, hence mutable
+  mutable std::atomic<OwnerId> owner_{newOwner()};
+};
+
+} // namespace facebook::fboss::thrift_cow
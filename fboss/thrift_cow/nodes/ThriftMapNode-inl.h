@@ -37,6 +37,16 @@ struct ExtractTypeClass<
   using value_type = ValueTypeClass;
 };
 
+template <typename Traits, typename = void>
+struct MapStorage {
+  using type = StdMapStorage;
+};
+
+template <typename Traits>
+struct MapStorage<Traits, std::void_t<typename Traits::MapStorage>> {
+  using type = typename Traits::MapStorage;
+};
+
 } // namespace map_helpers
 
 template <typename Traits>
@@ -53,10 +63,15 @@ struct ThriftMapFields {
   using ValueTType = typename TType::mapped_type;
   using ValueTraits =
       typename Traits::template ConvertToNodeTraits<ValueTypeClass, ValueTType>;
-  using key_type = typename TType::key_type;
+  // Traits may key the map by a type other than the thrift key type (e.g. a
+  // binary encoding of a string key), converted with folly::to<> at the
+  // thrift boundary
+  using ThriftKeyType = typename TType::key_type;
+  using key_type = typename Traits::KeyType;
   using value_type = typename ValueTraits::type;
-  using StorageType =
-      std::map<key_type, value_type, typename Traits::KeyCompare>;
+  using MapStorage = typename map_helpers::MapStorage<Traits>::type;
+  using StorageType = typename MapStorage::
+      template type<key_type, value_type, typename Traits::KeyCompare>;
   using iterator = typename StorageType::iterator;
   using const_iterator = typename StorageType::const_iterator;
 
@@ -86,7 +101,11 @@ struct ThriftMapFields {
     TType thrift;
 
     for (auto&& [key, elem] : storage_) {
-      thrift.emplace(key, elem->toThrift());
+      if constexpr (std::is_same_v<key_type, ThriftKeyType>) {
+        thrift.emplace(key, elem->toThrift());
+      } else {
+        thrift.emplace(folly::to<ThriftKeyType>(key), elem->toThrift());
+      }
     }
     return thrift;
   }
@@ -97,7 +116,11 @@ struct ThriftMapFields {
   void fromThrift(T&& thrift) {
     storage_.clear();
     for (const auto& [key, elem] : thrift) {
-      emplace(key, elem);
+      if constexpr (std::is_same_v<key_type, ThriftKeyType>) {
+        emplace(key, elem);
+      } else {
+        emplace(folly::to<key_type>(key), elem);
+      }
     }
   }
 
@@ -169,9 +192,7 @@ struct ThriftMapFields {
       if (fatal::enum_traits<key_type>::try_parse(enumKey, token)) {
         return remove(enumKey);
       }
-    } else if constexpr (std::is_same_v<
-                             KeyTypeClass,
-                             apache::thrift::type_class::string>) {
+    } else if constexpr (std::is_same_v<key_type, std::string>) {
       return storage_.erase(token);
     }
 
@@ -184,11 +205,8 @@ struct ThriftMapFields {
   }
 
   template <typename T = Self>
-  auto remove(const key_type& key) -> std::enable_if_t<
-      !std::is_same_v<
-          typename T::KeyTypeClass,
-          apache::thrift::type_class::string>,
-      bool> {
+  auto remove(const key_type& key) -> std::
+      enable_if_t<!std::is_same_v<typename T::key_type, std::string>, bool> {
     return storage_.erase(key);
   }
 
@@ -236,8 +254,14 @@ struct ThriftMapFields {
   template <typename Fn>
   void forEachChild(Fn fn) {
     if constexpr (HasChildNodes) {
-      for (auto&& [key, value] : storage_) {
-        fn(value.get());
+      if constexpr (std::is_same_v<MapStorage, PersistentMapStorage>) {
+        // only used to publish children, skip the parts of the map shared
+        // with (and so already published by) the node this was cloned from
+        storage_.freeze([&fn](const auto& entry) { fn(entry.second.get()); });
+      } else {
+        for (auto&& [key, value] : std::as_const(storage_)) {
+          fn(value.get());
+        }
       }
     }
   }
@@ -375,11 +399,8 @@ class ThriftMapNode
   }
 
   template <typename T = Fields>
-  auto remove(const key_type& key) -> std::enable_if_t<
-      !std::is_same_v<
-          typename T::KeyTypeClass,
-          apache::thrift::type_class::string>,
-      bool> {
+  auto remove(const key_type& key) -> std::
+      enable_if_t<!std::is_same_v<typename T::key_type, std::string>, bool> {
     return this->writableFields()->remove(key);
   }
 
@@ -10,8 +10,10 @@
 
 #pragma once
 
+#include <fboss/thrift_cow/nodes/PersistentMap.h>
 #include <fboss/thrift_cow/nodes/Types.h>
 #include <thrift/lib/cpp2/reflection/reflection.h>
+#include <map>
 #include <type_traits>
 
 namespace facebook::fboss::thrift_cow {
@@ -91,15 +93,32 @@ struct ConvertToNodeTraits<apache::thrift::type_class::list<ValueT>, TType> {
   using isChild = std::true_type;
 };
 
+// Storage for the children of a ThriftMapNode, selected by the MapStorage
+// member of the map traits. Defaults to std::map.
+struct StdMapStorage {
+  template <typename KeyT, typename ValueT, typename Compare>
+  using type = std::map<KeyT, ValueT, Compare>;
+};
+
+// Shares unmodified children between a map node and its clones, so that
+// modifying a cloned node is O(log n) rather than a copy of the whole map.
+// Meant for large maps that are modified often, e.g. the FIB.
+struct PersistentMapStorage {
+  template <typename KeyT, typename ValueT, typename Compare>
+  using type = PersistentMap<KeyT, ValueT, Compare>;
+};
+
 template <
     typename TypeClass,
     typename TType,
-    template <typename...> typename ConvertToNodeTraitsT = ConvertToNodeTraits>
+    template <typename...> typename ConvertToNodeTraitsT = ConvertToNodeTraits,
+    typename MapStorageT = StdMapStorage>
 struct ThriftMapTraits {
   using TC = TypeClass;
   using Type = TType;
   using KeyType = typename TType::key_type;
   using KeyCompare = std::less<KeyType>;
+  using MapStorage = MapStorageT;
   template <typename... T>
   using ConvertToNodeTraits = ConvertToNodeTraitsT<T...>;
 };
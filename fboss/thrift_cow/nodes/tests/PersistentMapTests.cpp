@@ -0,0 +1,202 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include "fboss/thrift_cow/nodes/PersistentMap.h"
+
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace facebook::fboss::thrift_cow;
+
+namespace {
+
+using TestMap = PersistentMap<std::string, std::shared_ptr<int>>;
+using ReferenceMap = std::map<std::string, std::shared_ptr<int>>;
+
+void verifyMap(const TestMap& map, const ReferenceMap& expected) {
+  ASSERT_EQ(map.size(), expected.size());
+  auto it = map.begin();
+  for (const auto& [key, value] : expected) {
+    ASSERT_NE(it, map.end());
+    EXPECT_EQ(it->first, key);
+    EXPECT_EQ(it->second, value);
+    ++it;
+  }
+  EXPECT_EQ(it, map.end());
+
+  auto rit = map.end();
+  for (auto eit = expected.rbegin(); eit != expected.rend(); ++eit) {
+    --rit;
+    EXPECT_EQ(rit->first, eit->first);
+  }
+  EXPECT_EQ(rit, map.begin());
+}
+
+size_t countUnfrozen(TestMap& map) {
+  size_t count = 0;
+  map.freeze([&count](const auto& /* entry */) { ++count; });
+  return count;
+}
+
+} // namespace
+
+TEST(PersistentMapTests, InsertFindErase) {
+  TestMap map;
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+
+  for (auto i = 0; i < 1000; ++i) {
+    auto [it, inserted] =
+        map.emplace(std::to_string(i), std::make_shared<int>(i));
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(*it->second, i);
+  }
+  EXPECT_EQ(map.size(), 1000);
+  EXPECT_FALSE(map.emplace("5", std::make_shared<int>(0)).second);
+  EXPECT_FALSE(map.try_emplace("5", std::make_shared<int>(0)).second);
+  EXPECT_EQ(*map.at("5"), 5);
+  EXPECT_EQ(map.count("5"), 1);
+  EXPECT_EQ(map.count("1000"), 0);
+  EXPECT_THROW(map.at("1000"), std::out_of_range);
+
+  map["5"] = std::make_shared<int>(55);
+  EXPECT_EQ(*map.at("5"), 55);
+  EXPECT_EQ(map["1000"], nullptr);
+  EXPECT_EQ(map.size(), 1001);
+
+  EXPECT_EQ(map.erase("1000"), 1);
+  EXPECT_EQ(map.erase("1000"), 0);
+  auto it = map.erase(map.find("5"));
+  EXPECT_EQ(it->first, "50");
+  EXPECT_EQ(map.size(), 999);
+
+  map.clear();
+  EXPECT_TRUE(map.empty());
+  EXPECT_EQ(map.begin(), map.end());
+}
+
+TEST(PersistentMapTests, LowerBound) {
+  PersistentMap<int, int> map;
+  for (auto i = 0; i < 10000; i += 2) {
+    map.emplace(i, i);
+  }
+  for (auto i = -1; i < 10000; ++i) {
+    auto it = map.lower_bound(i);
+    if (i >= 9999) {
+      EXPECT_EQ(it, map.end());
+    } else {
+      EXPECT_EQ(it->first, i < 0 ? 0 : i + i % 2);
+    }
+  }
+  EXPECT_EQ(std::distance(map.begin(), map.end()), 5000);
+}
+
+TEST(PersistentMapTests, CopiesAreIndependent) {
+  std::mt19937 gen(0);
+  TestMap map;
+  ReferenceMap expected;
+  std::vector<std::pair<TestMap, ReferenceMap>> snapshots;
+  for (auto i = 0; i < 50000; ++i) {
+    auto key = std::to_string(gen() % 5000);
+    switch (gen() % 4) {
+      case 0:
+      case 1: {
+        auto value = std::make_shared<int>(i);
+        EXPECT_EQ(
+            map.insert({key, value}).second,
+            expected.insert({key, value}).second);
+        break;
+      }
+      case 2:
+        EXPECT_EQ(map.erase(key), expected.erase(key));
+        break;
+      case 3:
+        if (auto it = map.find(key); it != map.end()) {
+          it->second = expected[key] = std::make_shared<int>(i);
+        }
+        break;
+    }
+    if (i % 1000 == 0) {
+      snapshots.emplace_back(map, expected);
+    }
+    if (i % 3000 == 0) {
+      map.freeze([](const auto& /* entry */) {});
+    }
+  }
+  verifyMap(map, expected);
+  for (const auto& [snapshot, snapshotExpected] : snapshots) {
+    verifyMap(snapshot, snapshotExpected);
+  }
+
+  for (auto it = map.begin(); it != map.end();) {
+    it = map.erase(it);
+  }
+  EXPECT_TRUE(map.empty());
+  for (const auto& [snapshot, snapshotExpected] : snapshots) {
+    verifyMap(snapshot, snapshotExpected);
+  }
+}
+
+TEST(PersistentMapTests, ModifyCopySharesStructure) {
+  TestMap map;
+  for (auto i = 0; i < 100000; ++i) {
+    map.emplace(std::to_string(i), std::make_shared<int>(i));
+  }
+  EXPECT_EQ(countUnfrozen(map), 100000);
+  EXPECT_EQ(countUnfrozen(map), 0);
+
+  auto copy = map;
+  EXPECT_EQ(copy, map);
+  copy["500"] = std::make_shared<int>(0);
+  EXPECT_NE(copy, map);
+  EXPECT_EQ(*map.at("500"), 500);
+  EXPECT_EQ(*copy.at("500"), 0);
+  // only the leaf holding the modified entry was copied
+  auto unfrozen = countUnfrozen(copy);
+  EXPECT_GT(unfrozen, 0);
+  EXPECT_LE(unfrozen, 32);
+
+  copy.erase("501");
+  copy.emplace("foo", std::make_shared<int>(0));
+  EXPECT_LE(countUnfrozen(copy), 3 * 32);
+  EXPECT_EQ(map.size(), 100000);
+  EXPECT_EQ(copy.size(), 100000);
+}
+
+TEST(PersistentMapTests, CopiedEntriesNotModifiedInPlace) {
+  TestMap map;
+  for (auto i = 0; i < 100; ++i) {
+    map.emplace(std::to_string(i), std::make_shared<int>(i));
+  }
+  // entries created by the map are modified in place
+  const auto* entry = &*map.find("50");
+  map["50"] = std::make_shared<int>(0);
+  EXPECT_EQ(&*map.find("50"), entry);
+
+  // once the map is copied, shared entries are copied before being
+  // modified, even if the map is left holding the only reference to them
+  auto copy = std::make_unique<TestMap>(map);
+  copy.reset();
+  map["50"] = std::make_shared<int>(1);
+  EXPECT_NE(&*map.find("50"), entry);
+  entry = &*map.find("50");
+  map["50"] = std::make_shared<int>(2);
+  EXPECT_EQ(&*map.find("50"), entry);
+
+  // the source of a copy doesn't modify shared entries either
+  TestMap other(map);
+  map["50"] = std::make_shared<int>(3);
+  EXPECT_EQ(*other.at("50"), 2);
+  other["51"] = std::make_shared<int>(0);
+  EXPECT_EQ(*map.at("51"), 51);
+}
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (c) 2004-present, Facebook, Inc.
+ *  All rights reserved.
+ *
+ *  This source code is licensed under the BSD-style license found in the
+ *  LICENSE file in the root directory of this source tree. An additional grant
+ *  of patent rights can be found in the PATENTS file in the same directory.
+ *
+ */
+
+#include <folly/Benchmark.h>
+#include <folly/init/Init.h>
+#include "fboss/agent/gen-cpp2/switch_config_fatal_types.h"
+#include "fboss/thrift_cow/nodes/Types.h"
+
+using namespace facebook::fboss;
+using namespace facebook::fboss::thrift_cow;
+
+using sk = cfg::switch_config_tags::strings;
+
+namespace {
+
+using MapTypeClass = apache::thrift::type_class::map<
+    apache::thrift::type_class::integral,
+    apache::thrift::type_class::structure>;
+using MapThriftType = std::map<int, cfg::L4PortRange>;
+
+using StdMapNode = ThriftMapNode<
+    ThriftMapTraits<MapTypeClass, MapThriftType, ConvertToNodeTraits>>;
+using PersistentMapNode = ThriftMapNode<ThriftMapTraits<
+    MapTypeClass,
+    MapThriftType,
+    ConvertToNodeTraits,
+    PersistentMapStorage>>;
+
+template <typename MapNode>
+std::shared_ptr<MapNode> buildMap(int size) {
+  MapThriftType data;
+  for (auto i = 0; i < size; ++i) {
+    cfg::L4PortRange portRange;
+    portRange.min() = i;
+    portRange.max() = i + 1;
+    data.emplace(i, std::move(portRange));
+  }
+  auto map = std::make_shared<MapNode>(data);
+  map->publish();
+  return map;
+}
+
+} // namespace
+
+/*
+ * Copy-on-write update of a single child of a published map node of the
+ * given size: clone the map, modify and publish one child.
+ */
+template <typename MapNode>
+void modifyOneChild(unsigned iters, int size) {
+  std::shared_ptr<MapNode> map;
+  BENCHMARK_SUSPEND {
+    map = buildMap<MapNode>(size);
+  }
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    auto key = static_cast<int>(iter % size);
+    MapNode::modify(&map, folly::to<std::string>(key));
+    map->ref(key)->template set<sk::max>(iter);
+    map->publish();
+  }
+  folly::doNotOptimizeAway(map);
+}
+
+/*
+ * Full iteration over a published map node of the given size
+ */
+template <typename MapNode>
+void iterate(unsigned iters, int size) {
+  std::shared_ptr<const MapNode> map;
+  BENCHMARK_SUSPEND {
+    map = buildMap<MapNode>(size);
+  }
+  int64_t sum = 0;
+  for (unsigned iter = 0; iter < iters; ++iter) {
+    for (const auto& [key, child] : *map) {
+      sum += key;
+    }
+  }
+  folly::doNotOptimizeAway(sum);
+}
+
+void modifyOneChildStd(unsigned iters, int size) {
+  modifyOneChild<StdMapNode>(iters, size);
+}
+
+void modifyOneChildPersistent(unsigned iters, int size) {
+  modifyOneChild<PersistentMapNode>(iters, size);
+}
+
+void iterateStd(unsigned iters, int size) {
+  iterate<StdMapNode>(iters, size);
+}
+
+void iteratePersistent(unsigned iters, int size) {
+  iterate<PersistentMapNode>(iters, size);
+}
+
+BENCHMARK_NAMED_PARAM(modifyOneChildStd, 1k, 1000);
+BENCHMARK_RELATIVE_NAMED_PARAM(modifyOneChildPersistent, 1k, 1000);
+BENCHMARK_NAMED_PARAM(modifyOneChildStd, 100k, 100000);
+BENCHMARK_RELATIVE_NAMED_PARAM(modifyOneChildPersistent, 100k, 100000);
+BENCHMARK_DRAW_LINE();
+BENCHMARK_NAMED_PARAM(iterateStd, 100k, 100000);
+BENCHMARK_RELATIVE_NAMED_PARAM(iteratePersistent, 100k, 100000);
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -22,6 +22,7 @@
 #include "fboss/agent/state/MapDelta.h"
 
 #include <gtest/gtest.h>
+#include <set>
 #include <type_traits>
 
 using namespace facebook::fboss;
@@ -637,3 +638,121 @@ TEST(ThriftMapNodeTests, MapDelta) {
     EXPECT_EQ(newNode->toThrift(), buildPortRange(1001, 1999));
   });
 }
+
+namespace {
+using PersistentMapOfI32ToStruct = ThriftMapNode<ThriftMapTraits<
+    apache::thrift::type_class::map<
+        apache::thrift::type_class::integral,
+        apache::thrift::type_class::structure>,
+    std::map<int, cfg::L4PortRange>,
+    ConvertToNodeTraits,
+    PersistentMapStorage>>;
+
+std::map<int, cfg::L4PortRange> buildPortRanges(int count) {
+  std::map<int, cfg::L4PortRange> data;
+  for (auto i = 0; i < count; ++i) {
+    data.emplace(i, buildPortRange(i, i + 1000));
+  }
+  return data;
+}
+} // namespace
+
+TEST(ThriftMapNodeTests, ThriftMapNodePersistentPrimitivesGetSet) {
+  ThriftMapNode<ThriftMapTraits<
+      apache::thrift::type_class::map<
+          apache::thrift::type_class::integral,
+          apache::thrift::type_class::integral>,
+      std::map<int, int>,
+      ConvertToNodeTraits,
+      PersistentMapStorage>>
+      node;
+  for (auto i = 0; i < 1000; ++i) {
+    node.emplace(i, i * 2);
+  }
+  ASSERT_EQ(node.size(), 1000);
+  ASSERT_EQ(node.at(3), 6);
+
+  node.ref(3) = 11;
+  ASSERT_EQ(node.at(3), 11);
+
+  ASSERT_TRUE(node.remove(3));
+  ASSERT_FALSE(node.remove(3));
+  ASSERT_TRUE(node.remove("4"));
+  ASSERT_EQ(node.size(), 998);
+  ASSERT_EQ(node.find(3), node.end());
+
+  auto thrift = node.toThrift();
+  ASSERT_EQ(thrift.size(), 998);
+  ASSERT_EQ(thrift[5], 10);
+  ASSERT_EQ(thrift.begin()->first, 0);
+  ASSERT_EQ(thrift.rbegin()->first, 999);
+}
+
+TEST(ThriftMapNodeTests, ThriftMapNodePersistentStructsModify) {
+  auto data = buildPortRanges(1000);
+  auto node = std::make_shared<PersistentMapOfI32ToStruct>(data);
+  node->publish();
+  ASSERT_TRUE(node->cref(500)->isPublished());
+
+  auto newNode = node->clone();
+  PersistentMapOfI32ToStruct::modify(&newNode, "500");
+  newNode->ref(500)->template set<sk::min>(1);
+  newNode->remove(10);
+  newNode->emplace(1000, buildPortRange(1000, 2000));
+
+  // the original node is unchanged
+  ASSERT_EQ(node->size(), 1000);
+  ASSERT_EQ(node->toThrift(), data);
+  ASSERT_TRUE(node->cref(500)->isPublished());
+
+  ASSERT_EQ(newNode->size(), 1000);
+  ASSERT_EQ(newNode->cref(500)->template get<sk::min>(), 1);
+  ASSERT_EQ(newNode->find(10), newNode->end());
+  ASSERT_NE(newNode->find(1000), newNode->end());
+
+  // unmodified children are shared
+  ASSERT_NE(newNode->cref(500), node->cref(500));
+  ASSERT_EQ(newNode->cref(501), node->cref(501));
+
+  ASSERT_FALSE(newNode->cref(500)->isPublished());
+  ASSERT_FALSE(newNode->cref(1000)->isPublished());
+  newNode->publish();
+  ASSERT_TRUE(newNode->cref(500)->isPublished());
+  ASSERT_TRUE(newNode->cref(1000)->isPublished());
+
+  // publishing skips shared children, so every modified child must still be
+  // published when modified again through a clone of a clone
+  auto newerNode = newNode->clone();
+  newerNode->emplace(1001, buildPortRange(1001, 2001));
+  newerNode->publish();
+  for (const auto& [key, child] : std::as_const(*newerNode)) {
+    ASSERT_TRUE(child->isPublished()) << key;
+  }
+}
+
+TEST(ThriftMapNodeTests, PersistentMapDelta) {
+  auto map = std::make_shared<PersistentMapOfI32ToStruct>(buildPortRanges(100));
+  map->publish();
+  auto map1 = map->clone();
+  map1->remove(50);
+  map1->emplace(100, buildPortRange(100, 1100));
+  map1->remove(20);
+  map1->emplace(20, buildPortRange(21, 1020));
+
+  std::set<int> added, removed, changed;
+  auto delta = ThriftMapDelta(map.get(), map1.get());
+  DeltaFunctions::forEachChanged(
+      delta,
+      [&](auto oldNode, auto newNode) {
+        EXPECT_EQ(*oldNode->toThrift().min(), 20);
+        EXPECT_EQ(*newNode->toThrift().min(), 21);
+        changed.insert(*oldNode->toThrift().min());
+      },
+      [&](auto addedNode) { added.insert(*addedNode->toThrift().min()); },
+      [&](auto removedNode) {
+        removed.insert(*removedNode->toThrift().min());
+      });
+  EXPECT_EQ(added, std::set<int>({100}));
+  EXPECT_EQ(removed, std::set<int>({50}));
+  EXPECT_EQ(changed, std::set<int>({20}));
+}
@@ -92,7 +92,9 @@ template <typename TC, typename TType>
 std::optional<std::string> matchingToken(
     const TType& val,
     const fsdb::OperPathElem& elem) {
-  if constexpr (std::is_same_v<TC, apache::thrift::type_class::string>) {
+  if constexpr (
+      std::is_same_v<TC, apache::thrift::type_class::string> &&
+      std::is_convertible_v<const TType&, const std::string&>) {
     if (matchesStrToken(val, elem)) {
       return val;
     }